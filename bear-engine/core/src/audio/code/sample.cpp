@@ -18,6 +18,7 @@
 
 /*----------------------------------------------------------------------------*/
 std::size_t bear::audio::sample::s_next_id(1);
+const bear::audio::sound_effect bear::audio::sample::s_default_effect;
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -152,9 +153,9 @@ void bear::audio::sample::stop( double d )
 /**
  * \brief Get the effect of the sample.
  */
-bear::audio::sound_effect bear::audio::sample::get_effect() const
+const bear::audio::sound_effect& bear::audio::sample::get_effect() const
 {
-  return sound_effect();
+  return s_default_effect;
 } // sample::get_effect()
 
 /*----------------------------------------------------------------------------*/
@@ -177,6 +178,26 @@ void bear::audio::sample::set_volume( double v )
 
 } // sample::set_volume()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells if the sample must keep on playing without any channel
+ *        (for sound_manager only).
+ * \param v Tells if the sample is virtual.
+ */
+void bear::audio::sample::set_virtual( bool v )
+{
+
+} // sample::set_virtual()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells if the sample is playing without any channel.
+ */
+bool bear::audio::sample::is_virtual() const
+{
+  return false;
+} // sample::is_virtual()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Tells if this sample is currently playing.
@@ -123,7 +123,9 @@ bear::audio::sdl_sample::s_playing_channels;
  * \param owner The instance of sound_manager who manage the sound.
  */
 bear::audio::sdl_sample::sdl_sample( const sdl_sound& s, sound_manager& owner )
-  : sample(s.get_sound_name(), owner), m_channel(-1), m_sound(&s)
+  : sample(s.get_sound_name(), owner), m_channel(-1), m_sound(&s),
+    m_virtual(false), m_paused(false), m_start_date(0), m_pause_date(0),
+    m_chunk(NULL), m_remaining_loops(0)
 {
 
 } // sdl_sample::sdl_sample()
@@ -164,6 +166,12 @@ void bear::audio::sdl_sample::play( const sound_effect& effect )
  */
 void bear::audio::sdl_sample::pause()
 {
+  if ( !m_paused )
+    {
+      m_paused = true;
+      m_pause_date = SDL_GetTicks();
+    }
+
   if ( m_channel != -1 )
     Mix_Pause( m_channel );
 } // sdl_sample::pause()
@@ -174,6 +182,12 @@ void bear::audio::sdl_sample::pause()
  */
 void bear::audio::sdl_sample::resume()
 {
+  if ( m_paused )
+    {
+      m_paused = false;
+      m_start_date += SDL_GetTicks() - m_pause_date;
+    }
+
   if ( m_channel != -1 )
     Mix_Resume( m_channel );
 } // sdl_sample::resume()
@@ -184,10 +198,14 @@ void bear::audio::sdl_sample::resume()
  */
 void bear::audio::sdl_sample::stop()
 {
+  m_virtual = false;
+  m_remaining_loops = 0;
+
   if ( m_channel != -1 )
     Mix_HaltChannel( m_channel );
 
   m_channel = -1;
+  release_chunk();
 
   sample_finished();
 } // sdl_sample::stop()
@@ -202,19 +220,23 @@ void bear::audio::sdl_sample::stop( double d )
   if ( m_channel != -1 )
     {
       const int ms( d * 1000 + 0.5 );
+      m_remaining_loops = 0;
 
       if ( ms <= 0 )
         stop();
       else if ( Mix_FadeOutChannel( m_channel, ms ) != 1 )
         stop();
     }
+  else if ( m_virtual )
+    stop();
 } // sdl_sample::stop()
 
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the effect applied to this sample.
  */
-bear::audio::sound_effect bear::audio::sdl_sample::get_effect() const
+const bear::audio::sound_effect&
+bear::audio::sdl_sample::get_effect() const
 {
   if ( m_channel != -1 )
     return s_playing_channels[m_channel]->get_effect();
@@ -252,6 +274,63 @@ void bear::audio::sdl_sample::set_volume( double v )
     Mix_Volume( m_channel, (int)(v * MIX_MAX_VOLUME) );
 } // sdl_sample::set_volume()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells if the sample must keep on playing without any channel
+ *        (for sound_manager only).
+ * \param v Tells if the sample is virtual.
+ *
+ * A virtual sample releases its channel but its position keeps on advancing
+ * with the time. When it becomes real again, it is played in a new channel
+ * from this position, or from the beginning of the loops left if it has been
+ * made virtual by finished() at the end of the tail of a loop. Setting a
+ * virtual sample virtual again finishes it if its last loop is over.
+ */
+void bear::audio::sdl_sample::set_virtual( bool v )
+{
+  if ( v )
+    {
+      if ( m_channel != -1 )
+        {
+          // The mixer calls finished() when the channel is halted, which
+          // will keep the sample playing since it is virtual. It will be
+          // played again from its position, even in the tail of a loop.
+          m_virtual = true;
+          m_remaining_loops = 0;
+          Mix_HaltChannel( m_channel );
+          release_chunk();
+        }
+      else if ( m_virtual )
+        {
+          // The loops left have not been started in time, they will be
+          // played from the position of the sample.
+          m_remaining_loops = 0;
+
+          if ( is_over() )
+            {
+              m_virtual = false;
+              sample_finished();
+            }
+        }
+    }
+  else if ( m_virtual )
+    {
+      if ( m_remaining_loops != 0 )
+        play_remaining_loops();
+      else
+        attach( get_position() );
+    }
+} // sdl_sample::set_virtual()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells if the sample is playing without any channel.
+ */
+bool bear::audio::sdl_sample::is_virtual() const
+{
+  return m_virtual;
+} // sdl_sample::is_virtual()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Callback function called when a channel is finished.
@@ -403,24 +482,140 @@ void bear::audio::sdl_sample::volume
  */
 void bear::audio::sdl_sample::inside_play()
 {
-  if ( m_channel != -1 )
+  if ( (m_channel != -1) || m_virtual )
     stop();
 
+  m_paused = false;
+  m_start_date = SDL_GetTicks();
+
   if ( m_sound != NULL )
+    attach( 0 );
+} // sdl_sample::inside_play()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Plays the sample in a channel, from a given position. If there is no
+ *        channel available, the sample keeps on playing virtually.
+ * \param position The time elapsed since the beginning of the sample, in
+ *        milliseconds.
+ * \pre m_channel == -1
+ */
+void bear::audio::sdl_sample::attach( unsigned int position )
+{
+  CLAW_PRECOND( m_channel == -1 );
+
+  release_chunk();
+  m_remaining_loops = 0;
+
+  if ( position == 0 )
     m_channel = m_sound->play(m_effect.get_loops());
+  else
+    {
+      m_chunk =
+        m_sound->create_chunk
+        ( m_effect.get_loops(), position, m_remaining_loops );
+
+      if ( m_chunk == NULL )
+        {
+          m_virtual = false;
+          sample_finished();
+          return;
+        }
+
+      m_channel =
+        Mix_PlayChannel
+        ( -1, m_chunk, (m_effect.get_loops() == 0) ? -1 : 0 );
+    }
+
+  bind_channel();
+} // sdl_sample::attach()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Plays the full loops of the sample following the chunk played by
+ *        attach(). If there is no channel available, the sample keeps on
+ *        playing virtually.
+ * \pre m_channel == -1
+ */
+void bear::audio::sdl_sample::play_remaining_loops()
+{
+  CLAW_PRECOND( m_channel == -1 );
+
+  release_chunk();
+
+  m_channel = m_sound->play( m_remaining_loops );
+  m_remaining_loops = 0;
+
+  bind_channel();
+} // sdl_sample::play_remaining_loops()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Registers the sample in the channel in which it has just been
+ *        played, or makes it virtual if it did not get any channel.
+ */
+void bear::audio::sdl_sample::bind_channel()
+{
+  m_virtual = (m_channel == -1);
+  set_playing();
 
   if ( m_channel != -1 )
     {
-      set_playing();
-
       global_add_channel();
       Mix_Volume
         ( m_channel,
           (int)(m_sound->get_manager().get_volume(this) * MIX_MAX_VOLUME) );
 
       inside_set_effect();
+
+      if ( m_paused )
+        Mix_Pause( m_channel );
     }
-} // sdl_sample::inside_play()
+  else
+    release_chunk();
+} // sdl_sample::bind_channel()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the time elapsed since the beginning of the sample, pauses
+ *        excluded, in milliseconds.
+ */
+unsigned int bear::audio::sdl_sample::get_position() const
+{
+  if ( m_paused )
+    return m_pause_date - m_start_date;
+  else
+    return SDL_GetTicks() - m_start_date;
+} // sdl_sample::get_position()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells if the last loop of the sample would be over if it had been
+ *        played in a channel.
+ */
+bool bear::audio::sdl_sample::is_over() const
+{
+  const unsigned int loops( m_effect.get_loops() );
+
+  return (loops != 0)
+    && ( get_position() >= loops * m_sound->get_duration() );
+} // sdl_sample::is_over()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Releases the chunk created to play the sample from its position.
+ * \pre m_channel == -1
+ */
+void bear::audio::sdl_sample::release_chunk()
+{
+  CLAW_PRECOND( m_channel == -1 );
+
+  if ( m_chunk != NULL )
+    {
+      Mix_FreeChunk( m_chunk );
+      m_chunk = NULL;
+    }
+} // sdl_sample::release_chunk()
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -490,7 +685,13 @@ void bear::audio::sdl_sample::global_add_channel()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Remove a finished channel from the playing list.
+ * \brief Remove a finished channel from the playing list. If the channel was
+ *        playing the tail of a loop, the sample becomes virtual and the loops
+ *        left are played in a new channel when the sound_manager makes it real
+ *        again.
+ *
+ * This method is called by the mixer, possibly from the audio thread, thus
+ * the channel cannot be played from here.
  * \pre m_channel >= 0
  * \post sdl_sample::s_playing_channels[channel]->is_empty() = true.
  * \post m_channels.find( channel ) == m_channels.end().
@@ -508,5 +709,8 @@ void bear::audio::sdl_sample::finished()
 
   m_channel = -1;
 
-  sample_finished();
+  if ( m_remaining_loops != 0 )
+    m_virtual = true;
+  else if ( !m_virtual )
+    sample_finished();
 } // sdl_sample::finished()
@@ -20,6 +20,8 @@
 #include <claw/exception.hpp>
 #include <claw/logger.hpp>
 
+#include <algorithm>
+
 /*----------------------------------------------------------------------------*/
 unsigned int bear::audio::sdl_sound::s_audio_rate = 44100;
 unsigned int bear::audio::sdl_sound::s_audio_format = AUDIO_S16;
@@ -60,6 +62,8 @@ bear::audio::sdl_sound::sdl_sound
 ( const sdl_sound& that, sound_manager& owner )
   : sound(that.get_sound_name(), owner), m_sound(NULL), m_loader(NULL)
 {
+  that.ensure_loaded();
+
   const Uint32 buffer_length( that.m_sound->alen );
   m_raw_audio = new Uint8[buffer_length];
   
@@ -99,6 +103,17 @@ bear::audio::sample* bear::audio::sdl_sound::new_sample()
   return new sdl_sample( *this, get_manager() );
 } // sdl_sound::new_sample()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the size of the memory used by the decoded audio, in bytes.
+ */
+std::size_t bear::audio::sdl_sound::get_memory_size() const
+{
+  ensure_loaded();
+
+  return m_sound->alen;
+} // sdl_sound::get_memory_size()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Start to play the sound.
@@ -119,6 +134,105 @@ int bear::audio::sdl_sound::play( unsigned int loops ) const
   return channel;
 } // sdl_sound::play()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Creates a chunk playing the sound from a given position, as if it had
+ *        been started with play() this amount of time ago.
+ * \param loops Number of loops, 0 for infinite.
+ * \param position The time elapsed since the beginning of the first loop, in
+ *        milliseconds.
+ * \param remaining_loops (out) The count of full plays of the sound that must
+ *        follow the chunk, always zero if \a loops == 0.
+ * \return NULL if the sound would have finished at this position. Otherwise,
+ *         a chunk to play once, or forever if \a loops == 0. The caller must
+ *         release it with Mix_FreeChunk().
+ *
+ * The chunk of a finite sound is the tail of the current loop and shares the
+ * data of the sound. The chunk of an infinite sound is a rotated copy of the
+ * sound, such that it can be played forever.
+ */
+Mix_Chunk* bear::audio::sdl_sound::create_chunk
+( unsigned int loops, unsigned int position,
+  unsigned int& remaining_loops ) const
+{
+  ensure_loaded();
+
+  unsigned int rate;
+  unsigned int frame_size;
+  get_output_spec( rate, frame_size );
+
+  const Uint32 length( m_sound->alen - m_sound->alen % frame_size );
+
+  if ( length == 0 )
+    return NULL;
+
+  const Uint64 elapsed( (Uint64)position * rate / 1000 * frame_size );
+  const Uint64 loop( elapsed / length );
+
+  if ( (loops != 0) && (loop >= loops) )
+    return NULL;
+
+  const Uint32 offset( elapsed % length );
+
+  remaining_loops = (loops == 0) ? 0 : loops - loop - 1;
+
+  Uint8* buffer( m_sound->abuf + offset );
+  Uint32 buffer_length( length - offset );
+  bool copied( false );
+
+  if ( loops == 0 )
+    {
+      buffer_length = length;
+
+      if ( offset == 0 )
+        buffer = m_sound->abuf;
+      else
+        {
+          copied = true;
+          buffer = static_cast<Uint8*>( SDL_malloc( length ) );
+
+          if ( buffer == NULL )
+            return NULL;
+
+          std::copy
+            ( m_sound->abuf, m_sound->abuf + offset,
+              std::copy
+              ( m_sound->abuf + offset, m_sound->abuf + length, buffer ) );
+        }
+    }
+
+  Mix_Chunk* const result( Mix_QuickLoad_RAW( buffer, buffer_length ) );
+
+  if ( result == NULL )
+    {
+      claw::logger << claw::log_warning << "sdl_sound::create_chunk(): "
+                   << Mix_GetError() << std::endl;
+
+      if ( copied )
+        SDL_free( buffer );
+    }
+  else if ( copied )
+    // let SDL_mixer release the copy with the chunk.
+    result->allocated = 1;
+
+  return result;
+} // sdl_sound::create_chunk()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the duration of one play of the sound, in milliseconds.
+ */
+unsigned int bear::audio::sdl_sound::get_duration() const
+{
+  ensure_loaded();
+
+  unsigned int rate;
+  unsigned int frame_size;
+  get_output_spec( rate, frame_size );
+
+  return (Uint64)m_sound->alen * 1000 / frame_size / rate;
+} // sdl_sound::get_duration()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Initialize the SDL.
@@ -196,3 +310,23 @@ void bear::audio::sdl_sound::ensure_loaded() const
 
   m_loader->join();
 } // sdl_sound::ensure_loaded()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the characteristics of the output audio stream, as opened by
+ *        the mixer.
+ * \param rate (out) The count of frames per second.
+ * \param frame_size (out) The size of a frame, in bytes.
+ */
+void bear::audio::sdl_sound::get_output_spec
+( unsigned int& rate, unsigned int& frame_size )
+{
+  int frequency( s_audio_rate );
+  Uint16 format( s_audio_format );
+  int channels( s_audio_channels );
+
+  Mix_QuerySpec( &frequency, &format, &channels );
+
+  rate = frequency;
+  frame_size = SDL_AUDIO_BITSIZE( format ) / 8 * channels;
+} // sdl_sound::get_output_spec()
@@ -47,6 +47,15 @@ bear::audio::sample* bear::audio::sound::new_sample()
   return new sample( get_sound_name(), get_manager() );
 } // sound::play()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the size of the memory used by the data of this sound, in bytes.
+ */
+std::size_t bear::audio::sound::get_memory_size() const
+{
+  return 0;
+} // sound::get_memory_size()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the sound_manager who owns this sound.
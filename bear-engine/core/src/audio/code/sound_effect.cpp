@@ -25,7 +25,7 @@
  * - no position
  */
 bear::audio::sound_effect::sound_effect()
-  : m_volume(1), m_loops(1), m_position(NULL)
+  : m_volume(1), m_loops(1), m_priority(0), m_position(NULL)
 {
 
 } // sound_effect::sound_effect()
@@ -36,7 +36,7 @@ bear::audio::sound_effect::sound_effect()
  * \param volume The volume of the sound.
  */
 bear::audio::sound_effect::sound_effect( double volume )
-  : m_volume(volume), m_loops(1), m_position(NULL)
+  : m_volume(volume), m_loops(1), m_priority(0), m_position(NULL)
 {
   if ( m_volume < 0 )
     m_volume = 0;
@@ -51,7 +51,7 @@ bear::audio::sound_effect::sound_effect( double volume )
  * \param volume The volume of the sound. Will be croped in [0, 1].
  */
 bear::audio::sound_effect::sound_effect( unsigned int loops, double volume )
-  : m_volume(volume), m_loops(loops), m_position(NULL)
+  : m_volume(volume), m_loops(loops), m_priority(0), m_position(NULL)
 {
   if ( m_volume < 0 )
     m_volume = 0;
@@ -66,7 +66,7 @@ bear::audio::sound_effect::sound_effect( unsigned int loops, double volume )
  */
 bear::audio::sound_effect::sound_effect
 ( const claw::math::coordinate_2d<double>& pos )
-  : m_volume(1), m_loops(1),
+  : m_volume(1), m_loops(1), m_priority(0),
     m_position( new claw::math::coordinate_2d<double>(pos) )
 {
 
@@ -78,7 +78,8 @@ bear::audio::sound_effect::sound_effect
  * \param that The instance to copy from.
  */
 bear::audio::sound_effect::sound_effect( const sound_effect& that )
-  : m_volume(that.m_volume), m_loops(that.m_loops), m_position(NULL)
+  : m_volume(that.m_volume), m_loops(that.m_loops),
+    m_priority(that.m_priority), m_position(NULL)
 {
   if ( that.has_a_position() )
     m_position = new claw::math::coordinate_2d<double>( that.get_position() );
@@ -108,6 +109,7 @@ bear::audio::sound_effect::operator=( const sound_effect& that )
 
       m_volume = that.m_volume;
       m_loops = that.m_loops;
+      m_priority = that.m_priority;
 
       if ( that.has_a_position() )
         m_position = new claw::math::coordinate_2d<double>
@@ -162,6 +164,26 @@ int bear::audio::sound_effect::get_loops() const
   return m_loops;
 } // sound_effect::get_loops()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the priority of the sound. When there are more sounds than
+ *        channels, the sounds with the highest priority are played first.
+ * \param priority The priority. The default value is zero.
+ */
+void bear::audio::sound_effect::set_priority( int priority )
+{
+  m_priority = priority;
+} // sound_effect::set_priority()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the priority of the sound.
+ */
+int bear::audio::sound_effect::get_priority() const
+{
+  return m_priority;
+} // sound_effect::get_priority()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Tell if the effect has a position.
@@ -18,11 +18,55 @@
 
 #include <claw/assert.hpp>
 #include <claw/exception.hpp>
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <vector>
 
+namespace bear
+{
+  namespace audio
+  {
+    namespace detail
+    {
+      /**
+       * \brief A playing sample and the values telling how much it deserves
+       *        a channel.
+       */
+      struct voice
+      {
+        /** \brief The sample. */
+        sample* s;
+
+        /** \brief The priority of the sample. */
+        int priority;
+
+        /** \brief How loud the sample would be heard. */
+        double audibility;
+
+      }; // struct voice
+
+      /**
+       * \brief Orders the voices by decreasing priority, then by decreasing
+       *        audibility.
+       */
+      struct voice_importance_greater
+      {
+        bool operator()( const voice& a, const voice& b ) const
+        {
+          if ( a.priority != b.priority )
+            return a.priority > b.priority;
+          else
+            return a.audibility > b.audibility;
+        }
+      }; // struct voice_importance_greater
+    }
+  }
+}
+
 /*----------------------------------------------------------------------------*/
 bool bear::audio::sound_manager::s_initialized = false;
+const double bear::audio::sound_manager::s_voice_margin = 0.1;
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -31,7 +75,7 @@ bool bear::audio::sound_manager::s_initialized = false;
 bear::audio::sound_manager::sound_manager()
   : m_ears_position(0, 0), m_current_music(NULL), m_sound_volume(1),
     m_music_volume(1), m_silence_distance(1200), m_full_volume_distance(200),
-    m_distance_unit(1)
+    m_distance_unit(1), m_max_voices(32)
 {
 
 } // sound_manager::sound_manager()
@@ -105,6 +149,22 @@ void bear::audio::sound_manager::copy_sound
     m_sounds[name] = new sound(name, *this);
 } // sound_manager::copy_sound()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Removes a sound.
+ * \param name The name of the sound.
+ * \pre sound_exists(name) is true and there is no sample of this sound.
+ */
+void bear::audio::sound_manager::remove_sound( const std::string& name )
+{
+  CLAW_PRECOND( sound_exists(name) );
+
+  const std::map<std::string, sound*>::iterator it( m_sounds.find(name) );
+
+  delete it->second;
+  m_sounds.erase( it );
+} // sound_manager::remove_sound()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Start to play a sound.
@@ -118,6 +178,7 @@ void bear::audio::sound_manager::play_sound( const std::string& name )
   m_samples[s] = true;
 
   s->play();
+  update_voices();
 } // sound_manager::play_sound()
 
 /*----------------------------------------------------------------------------*/
@@ -135,6 +196,7 @@ void bear::audio::sound_manager::play_sound
   m_samples[s] = true;
 
   s->play( effect );
+  update_voices();
 } // sound_manager::play_sound()
 
 /*----------------------------------------------------------------------------*/
@@ -259,6 +321,7 @@ void bear::audio::sound_manager::set_ears_position
 ( const claw::math::coordinate_2d<double>& position )
 {
   m_ears_position = position;
+  update_voices();
 } // sound_manager::set_ears_position()
 
 /*----------------------------------------------------------------------------*/
@@ -289,6 +352,8 @@ void bear::audio::sound_manager::set_sound_volume( double v )
   for ( it=m_samples.begin(); it!=m_samples.end(); ++it )
     if ( !is_music(it->first) )
       it->first->set_volume(m_sound_volume);
+
+  update_voices();
 } // sound_manager::set_sound_volume()
 
 /*----------------------------------------------------------------------------*/
@@ -349,6 +414,20 @@ bool bear::audio::sound_manager::sound_exists(const std::string& name) const
   return m_sounds.find(name) != m_sounds.end();
 } // sound_manager::sound_exists()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the size of the memory used by the data of a sound, in bytes.
+ * \param name The name of the sound.
+ * \pre sound_exists(name) is true.
+ */
+std::size_t
+bear::audio::sound_manager::get_memory_size( const std::string& name ) const
+{
+  CLAW_PRECOND( sound_exists(name) );
+
+  return m_sounds.find(name)->second->get_memory_size();
+} // sound_manager::get_memory_size()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Inform the manager that a sample is finished. If the sample is managed
@@ -491,6 +570,33 @@ bool bear::audio::sound_manager::is_music( const sample* m ) const
   return result;
 } // sound_manager::is_music()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Estimates how loud a sound would be heard.
+ * \param effect The effect applied to the sound.
+ * \param margin The relative advantage given to the sound: the distance to the
+ *        ears is divided by 1 + margin and the result is multiplied by
+ *        1 + margin.
+ * \return A positive value, zero meaning that the sound cannot be heard.
+ */
+double bear::audio::sound_manager::get_audibility
+( const sound_effect& effect, double margin ) const
+{
+  double result( effect.get_volume() * m_sound_volume * (1 + margin) );
+
+  if ( effect.has_a_position() )
+    {
+      const claw::math::coordinate_2d<double>& pos( effect.get_position() );
+
+      result *=
+        get_volume_for_distance
+        ( ( std::abs(m_ears_position.x - pos.x)
+            + std::abs(m_ears_position.y - pos.y) ) / (1 + margin) );
+    }
+
+  return result;
+} // sound_manager::get_audibility()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Sets the distance under which sounds are at maximum volume.
@@ -579,3 +685,77 @@ double bear::audio::sound_manager::get_volume_for_distance( double d ) const
 
   return result;
 } // sound_manager::get_volume_for_distance()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Sets the maximum count of sounds played in a channel at once.
+ * \param n The count of sounds.
+ */
+void bear::audio::sound_manager::set_max_voices( std::size_t n )
+{
+  m_max_voices = n;
+  update_voices();
+} // sound_manager::set_max_voices()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the maximum count of sounds played in a channel at once.
+ */
+std::size_t bear::audio::sound_manager::get_max_voices() const
+{
+  return m_max_voices;
+} // sound_manager::get_max_voices()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gives the channels to the sounds of highest priority, then to the
+ *        loudest ones. The sounds left and the inaudible ones are virtual:
+ *        they keep on playing without any channel and are played again from
+ *        their current position when they get a channel back. The musics
+ *        always keep their channel.
+ *
+ * The samples whose channel has finished the tail of a loop are virtual too,
+ * such that their loops left are played from here rather than from the audio
+ * thread.
+ *
+ * The samples already played in a channel are favoured by s_voice_margin,
+ * thus a sample moving around the silence distance, or two samples of close
+ * audibility competing for the last voice, do not switch between the channel
+ * and the virtual state at each update.
+ */
+void bear::audio::sound_manager::update_voices()
+{
+  std::vector<detail::voice> voices;
+  voices.reserve( m_samples.size() );
+
+  std::map<sample*, bool>::const_iterator it;
+
+  for ( it=m_samples.begin(); it!=m_samples.end(); ++it )
+    if ( it->first->is_playing() && !is_music(it->first) )
+      {
+        const sound_effect& effect( it->first->get_effect() );
+        const double margin
+          ( it->first->is_virtual() ? 0 : s_voice_margin );
+        const detail::voice v =
+          { it->first, effect.get_priority(),
+            get_audibility(effect, margin) };
+        voices.push_back( v );
+      }
+
+  std::sort
+    ( voices.begin(), voices.end(), detail::voice_importance_greater() );
+
+  std::size_t real_count( 0 );
+
+  while ( (real_count != voices.size()) && (real_count != m_max_voices)
+          && (voices[real_count].audibility > 0) )
+    ++real_count;
+
+  // The channels are released before the other samples are attached again
+  // such that they can be reused.
+  for ( std::size_t i(real_count); i != voices.size(); ++i )
+    voices[i].s->set_virtual( true );
+
+  for ( std::size_t i(0); i != real_count; ++i )
+    voices[i].s->set_virtual( false );
+} // sound_manager::update_voices()
@@ -50,11 +50,13 @@ namespace bear
       virtual void stop();
       virtual void stop( double d );
 
-      virtual sound_effect get_effect() const;
+      virtual const sound_effect& get_effect() const;
       virtual void set_effect( const sound_effect& effect );
 
       /* for sound_manager only. */
       virtual void set_volume( double v );
+      virtual void set_virtual( bool v );
+      virtual bool is_virtual() const;
 
       bool is_playing() const;
 
@@ -78,6 +80,9 @@ namespace bear
       /** \brief The next available identifier. */
       static std::size_t s_next_id;
 
+      /** \brief The effect of the samples that do not play anything. */
+      static const sound_effect s_default_effect;
+
     }; // class sample
   } // namespace audio
 } // namespace bear
@@ -20,6 +20,8 @@
 #include "audio/class_export.hpp"
 #include <vector>
 
+struct Mix_Chunk;
+
 namespace bear
 {
   namespace audio
@@ -71,11 +73,13 @@ namespace bear
       void stop();
       void stop( double d );
 
-      sound_effect get_effect() const;
+      const sound_effect& get_effect() const;
       void set_effect( const sound_effect& effect );
 
       /* for sound_manager only. */
       void set_volume( double v );
+      void set_virtual( bool v );
+      bool is_virtual() const;
 
       static void channel_finished(int channel);
 
@@ -90,6 +94,13 @@ namespace bear
       void inside_play();
       void stop_sample();
 
+      void attach( unsigned int position );
+      void play_remaining_loops();
+      void bind_channel();
+      unsigned int get_position() const;
+      bool is_over() const;
+      void release_chunk();
+
       void inside_set_effect();
 
       void global_add_channel();
@@ -105,6 +116,27 @@ namespace bear
       /** \brief The effects applied to the sample, by default. */
       sound_effect m_effect;
 
+      /** \brief Tells if the sample keeps on playing without any channel. */
+      bool m_virtual;
+
+      /** \brief Tells if the sample is paused. */
+      bool m_paused;
+
+      /** \brief The date at which the sample would have started to play if it
+          had never been paused, in milliseconds. */
+      unsigned int m_start_date;
+
+      /** \brief The date at which the sample has been paused. */
+      unsigned int m_pause_date;
+
+      /** \brief The chunk played in the channel when the sample has been
+          attached to it after its beginning. */
+      Mix_Chunk* m_chunk;
+
+      /** \brief The count of full plays of the sound to start once m_chunk is
+          finished, when the sample is made real again. */
+      unsigned int m_remaining_loops;
+
       /** \brief Global vector giving, for a channel, the sample currently
           played. */
       static std::vector<channel_attribute*> s_playing_channels;
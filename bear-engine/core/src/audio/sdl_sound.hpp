@@ -41,8 +41,13 @@ namespace bear
       ~sdl_sound();
 
       sample* new_sample();
+      std::size_t get_memory_size() const;
 
       int play( unsigned int loops ) const;
+      Mix_Chunk* create_chunk
+      ( unsigned int loops, unsigned int position,
+        unsigned int& remaining_loops ) const;
+      unsigned int get_duration() const;
 
       static bool initialize();
       static void release();
@@ -54,6 +59,9 @@ namespace bear
 
       void ensure_loaded() const;
 
+      static void get_output_spec
+      ( unsigned int& rate, unsigned int& frame_size );
+
     private:
       /** \brief The sound allocated by SDL_mixer. */
       Mix_Chunk* m_sound;
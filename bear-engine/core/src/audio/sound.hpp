@@ -34,6 +34,7 @@ namespace bear
       virtual ~sound();
 
       virtual sample* new_sample();
+      virtual std::size_t get_memory_size() const;
 
       sound_manager& get_manager();
       const sound_manager& get_manager() const;
@@ -42,6 +42,9 @@ namespace bear
       void set_loops( unsigned int loops );
       int get_loops() const;
 
+      void set_priority( int priority );
+      int get_priority() const;
+
       bool has_a_position() const;
       void set_position( const claw::math::coordinate_2d<double>& pos );
       const claw::math::coordinate_2d<double>& get_position() const;
@@ -53,6 +56,10 @@ namespace bear
       /** \brief Number of loops (added to a first default play). */
       int m_loops;
 
+      /** \brief The priority of the sound when the channels are shared among
+          the sounds. */
+      int m_priority;
+
       /** \brief The position, if any. */
       claw::math::coordinate_2d<double>* m_position;
 
@@ -50,6 +50,7 @@ namespace bear
       void clear();
       void load_sound( const std::string& name, std::istream& file );
       void copy_sound( const std::string& name, const sound_manager& source );
+      void remove_sound( const std::string& name );
 
       void play_sound( const std::string& name );
       void play_sound( const std::string& name, const sound_effect& effect );
@@ -72,6 +73,7 @@ namespace bear
       double get_volume( const sample* s ) const;
 
       bool sound_exists( const std::string& name ) const;
+      std::size_t get_memory_size( const std::string& name ) const;
 
       void sample_finished( sample* s );
       void sample_deleted( sample* s );
@@ -91,12 +93,19 @@ namespace bear
 
       double get_volume_for_distance( double d ) const;
 
+      void set_max_voices( std::size_t n );
+      std::size_t get_max_voices() const;
+
+      void update_voices();
+
       static void initialize();
       static void release();
 
     private:
       void remove_muted_music( sample* m );
       bool is_music( const sample* m ) const;
+      double
+      get_audibility( const sound_effect& effect, double margin ) const;
 
     private:
       /** \brief All sounds. */
@@ -131,9 +140,18 @@ namespace bear
           distances for the sound effects. */
       double m_distance_unit;
 
+      /** \brief The maximum count of samples played in a channel. The other
+          samples are virtual. */
+      std::size_t m_max_voices;
+
       /** \brief Tell if the sound system is initialized. */
       static bool s_initialized;
 
+      /** \brief The relative margin given to the samples played in a channel
+          when the voices are updated, such that a sample near the silence
+          distance or near the last voice does not switch at each update. */
+      static const double s_voice_margin;
+
     }; // class sound_manager
   } // namespace audio
 } // namespace bear
@@ -0,0 +1,271 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::concept::slot_map class.
+ * \author Julien Jorge.
+ */
+#include <limits>
+
+/*----------------------------------------------------------------------------*/
+template<class T>
+const std::size_t bear::concept::slot_map<T>::s_no_slot
+( std::numeric_limits<std::size_t>::max() );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor. The handle does not refer to any value.
+ */
+template<class T>
+bear::concept::slot_map<T>::handle::handle()
+  : m_index(s_no_slot), m_generation(0)
+{
+
+} // slot_map::handle::handle()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if two handles refer to the same value.
+ * \param that The handle to compare to.
+ */
+template<class T>
+bool bear::concept::slot_map<T>::handle::operator==( const handle& that ) const
+{
+  return (m_index == that.m_index) && (m_generation == that.m_generation);
+} // slot_map::handle::operator==()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if two handles refer to different values.
+ * \param that The handle to compare to.
+ */
+template<class T>
+bool bear::concept::slot_map<T>::handle::operator!=( const handle& that ) const
+{
+  return !(*this == that);
+} // slot_map::handle::operator!=()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param index The index of the slot of the value.
+ * \param generation The generation of the slot.
+ */
+template<class T>
+bear::concept::slot_map<T>::handle::handle
+( std::size_t index, std::size_t generation )
+  : m_index(index), m_generation(generation)
+{
+
+} // slot_map::handle::handle()
+
+
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+template<class T>
+bear::concept::slot_map<T>::slot_map()
+  : m_free_slot(s_no_slot)
+{
+
+} // slot_map::slot_map()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Insert a value in the map.
+ * \param v The value to insert.
+ * \return The handle of the value.
+ */
+template<class T>
+typename bear::concept::slot_map<T>::handle
+bear::concept::slot_map<T>::insert( const value_type& v )
+{
+  std::size_t index;
+
+  if ( m_free_slot == s_no_slot )
+    {
+      index = m_slots.size();
+      m_slots.push_back( slot() );
+      m_slots.back().generation = 0;
+    }
+  else
+    {
+      index = m_free_slot;
+      m_free_slot = m_slots[index].index;
+    }
+
+  m_slots[index].index = m_values.size();
+  m_values.push_back(v);
+  m_value_slot.push_back(index);
+
+  return handle( index, m_slots[index].generation );
+} // slot_map::insert()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove a value from the map. Nothing is done if the handle does not
+ *        refer to a value of the map.
+ * \param h The handle of the value to remove.
+ */
+template<class T>
+void bear::concept::slot_map<T>::erase( const handle& h )
+{
+  if ( !is_valid(h) )
+    return;
+
+  slot& s( m_slots[h.m_index] );
+  const std::size_t last( m_values.size() - 1 );
+
+  if ( s.index != last )
+    {
+      m_values[s.index] = m_values[last];
+      m_value_slot[s.index] = m_value_slot[last];
+      m_slots[ m_value_slot[s.index] ].index = s.index;
+    }
+
+  m_values.pop_back();
+  m_value_slot.pop_back();
+
+  ++s.generation;
+  s.index = m_free_slot;
+  m_free_slot = h.m_index;
+} // slot_map::erase()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove all the values. The handles given so far remain invalid.
+ */
+template<class T>
+void bear::concept::slot_map<T>::clear()
+{
+  for ( std::size_t i=0; i!=m_value_slot.size(); ++i )
+    {
+      slot& s( m_slots[ m_value_slot[i] ] );
+
+      ++s.generation;
+      s.index = m_free_slot;
+      m_free_slot = m_value_slot[i];
+    }
+
+  m_values.clear();
+  m_value_slot.clear();
+} // slot_map::clear()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the value referenced by a handle.
+ * \param h The handle of the value.
+ * \return NULL if the handle does not refer to a value of the map.
+ */
+template<class T>
+typename bear::concept::slot_map<T>::value_type*
+bear::concept::slot_map<T>::find( const handle& h )
+{
+  if ( is_valid(h) )
+    return &m_values[ m_slots[h.m_index].index ];
+  else
+    return NULL;
+} // slot_map::find()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the value referenced by a handle.
+ * \param h The handle of the value.
+ * \return NULL if the handle does not refer to a value of the map.
+ */
+template<class T>
+const typename bear::concept::slot_map<T>::value_type*
+bear::concept::slot_map<T>::find( const handle& h ) const
+{
+  if ( is_valid(h) )
+    return &m_values[ m_slots[h.m_index].index ];
+  else
+    return NULL;
+} // slot_map::find()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of values in the map.
+ */
+template<class T>
+std::size_t bear::concept::slot_map<T>::size() const
+{
+  return m_values.size();
+} // slot_map::size()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the map contains no value.
+ */
+template<class T>
+bool bear::concept::slot_map<T>::empty() const
+{
+  return m_values.empty();
+} // slot_map::empty()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get an iterator on the first value.
+ */
+template<class T>
+typename bear::concept::slot_map<T>::iterator
+bear::concept::slot_map<T>::begin()
+{
+  return m_values.begin();
+} // slot_map::begin()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get an iterator just past the last value.
+ */
+template<class T>
+typename bear::concept::slot_map<T>::iterator
+bear::concept::slot_map<T>::end()
+{
+  return m_values.end();
+} // slot_map::end()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get an iterator on the first value.
+ */
+template<class T>
+typename bear::concept::slot_map<T>::const_iterator
+bear::concept::slot_map<T>::begin() const
+{
+  return m_values.begin();
+} // slot_map::begin()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get an iterator just past the last value.
+ */
+template<class T>
+typename bear::concept::slot_map<T>::const_iterator
+bear::concept::slot_map<T>::end() const
+{
+  return m_values.end();
+} // slot_map::end()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if a handle refers to a value of the map.
+ * \param h The handle to check.
+ */
+template<class T>
+bool bear::concept::slot_map<T>::is_valid( const handle& h ) const
+{
+  // The generation of a slot changes when its value is removed, thus a
+  // handle with the current generation of the slot refers to its value.
+  return (h.m_index < m_slots.size())
+    && (m_slots[h.m_index].generation == h.m_generation);
+} // slot_map::is_valid()
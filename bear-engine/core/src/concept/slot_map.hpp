@@ -0,0 +1,139 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A container giving a stable handle to each inserted value, with
+ *        constant time insertion, removal and access.
+ * \author Julien Jorge.
+ */
+#ifndef __CONCEPT_SLOT_MAP_HPP__
+#define __CONCEPT_SLOT_MAP_HPP__
+
+#include <cstddef>
+#include <vector>
+
+namespace bear
+{
+  namespace concept
+  {
+    /**
+     * \brief A container giving a stable handle to each inserted value, with
+     *        constant time insertion, removal and access.
+     *
+     * The values are stored contiguously, thus the iteration is as fast as
+     * for a vector, but the removal of a value moves the last value at its
+     * place: the order of the values is unspecified.
+     *
+     * The handles refer to slots that are reused after the removal of their
+     * value. Each slot has a generation incremented at each removal, that is
+     * stored in the handles, thus a handle to a removed value never gives
+     * access to a value inserted later in the same slot.
+     *
+     * \author Julien Jorge.
+     */
+    template<class T>
+    class slot_map
+    {
+    public:
+      /** \brief The type of the stored values. */
+      typedef T value_type;
+
+      /** \brief The type of the iterators on the values. */
+      typedef typename std::vector<value_type>::iterator iterator;
+
+      /** \brief The type of the iterators on the values. */
+      typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+      /**
+       * \brief The identifier of a value in the map.
+       */
+      class handle
+      {
+        friend class slot_map<T>;
+
+      public:
+        handle();
+
+        bool operator==( const handle& that ) const;
+        bool operator!=( const handle& that ) const;
+
+      private:
+        handle( std::size_t index, std::size_t generation );
+
+      private:
+        /** \brief The index of the slot of the value. */
+        std::size_t m_index;
+
+        /** \brief The generation of the slot when the value was inserted. */
+        std::size_t m_generation;
+
+      }; // class handle
+
+    public:
+      slot_map();
+
+      handle insert( const value_type& v );
+      void erase( const handle& h );
+      void clear();
+
+      value_type* find( const handle& h );
+      const value_type* find( const handle& h ) const;
+
+      std::size_t size() const;
+      bool empty() const;
+
+      iterator begin();
+      iterator end();
+      const_iterator begin() const;
+      const_iterator end() const;
+
+    private:
+      /**
+       * \brief A slot, giving the position of a value or of the next free
+       *        slot.
+       */
+      struct slot
+      {
+        /** \brief The index of the value, if the slot is used, or of the next
+            free slot. */
+        std::size_t index;
+
+        /** \brief The count of removals of the values of this slot. */
+        std::size_t generation;
+
+      }; // struct slot
+
+    private:
+      bool is_valid( const handle& h ) const;
+
+    private:
+      /** \brief The values. */
+      std::vector<value_type> m_values;
+
+      /** \brief The index of the slot of each value. */
+      std::vector<std::size_t> m_value_slot;
+
+      /** \brief The slots referenced by the handles. */
+      std::vector<slot> m_slots;
+
+      /** \brief The index of the first free slot. */
+      std::size_t m_free_slot;
+
+      /** \brief An invalid slot index. */
+      static const std::size_t s_no_slot;
+
+    }; // class slot_map
+
+  } // namespace concept
+} // namespace bear
+
+// template methods
+#include "concept/impl/slot_map.tpp"
+
+#endif // __CONCEPT_SLOT_MAP_HPP__
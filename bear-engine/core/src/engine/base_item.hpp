@@ -22,7 +22,7 @@
 #include "universe/physical_item.hpp"
 #include "engine/item_flag_type.hpp"
 #include "engine/level_object.hpp"
-#include "engine/scene_visual.hpp"
+#include "engine/scene_visual_sink.hpp"
 #include "engine/loader/item_loader_map.hpp"
 #include "text_interface/base_exportable.hpp"
 #include "audio/sample.hpp"
@@ -112,8 +112,8 @@ namespace bear
       virtual void pre_cache();
       virtual void progress( universe::time_type elapsed_time );
 
-      scene_visual get_visual() const;
-      virtual void get_visual( std::list<scene_visual>& visuals ) const;
+      void insert_visual( scene_visual_sink& visuals ) const;
+      virtual void get_visual( scene_visual_sink& visuals ) const;
 
       virtual bool set_u_integer_field
       ( const std::string& name, unsigned int value );
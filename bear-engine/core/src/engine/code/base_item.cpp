@@ -14,6 +14,7 @@
 #include "engine/base_item.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <claw/logger.hpp>
 
 #include "engine/layer/layer.hpp"
@@ -22,7 +23,6 @@
 #include "engine/level.hpp"
 #include "universe/collision_info.hpp"
 
-#include "visual/scene_element_sequence.hpp"
 #include "visual/scene_shader_pop.hpp"
 #include "visual/scene_shader_push.hpp"
 
@@ -294,48 +294,37 @@ void bear::engine::base_item::progress( universe::time_type elapsed_time )
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Gets the visual of the item.
+ * \brief Inserts the visuals of the item in a group of the sink, at the
+ *        z-position of the item.
+ * \param visuals (out) The sink receiving the visuals.
  *
- * This method uses get_visual( std::list<>& ) to get the visuals and make a
- * visual::scene_element_sequence of them.
+ * This method uses get_visual( scene_visual_sink& ) to get the visuals. They
+ * are sorted among themselves and surrounded by the shader of the item, if
+ * any.
  */
-bear::engine::scene_visual bear::engine::base_item::get_visual() const
+void
+bear::engine::base_item::insert_visual( scene_visual_sink& visuals ) const
 {
   BEAR_CREATE_SCOPED_TIMELOG
     ( std::string("insert_visual ") + get_class_name() );
 
-  visual::scene_element_sequence result;
-
-  std::list<scene_visual> v;
-  get_visual( v );
+  visuals.begin_group( get_z_position() );
 
-  v.sort( scene_visual::z_position_compare() );
-
-  for ( ; !v.empty() ; v.pop_front() )
-    {
-#ifndef NDEBUG
-      const visual::scene_element& elem( v.front().scene_element );
-
-      if ( !elem.always_displayed()
-           && elem.get_bounding_box().empty() )
-        claw::logger << claw::log_warning
-                     << "Empty visual::scene_element is inserted in a "
-                     << "visual::scene_element_sequence by '"
-                     << get_class_name() << "'. This should be avoided."
-                     << std::endl;
-#endif // NDEBUG
-
-      result.push_back( v.front().scene_element );
-    }
+  get_visual( visuals );
 
   if ( m_shader.is_valid() )
     {
-      result.push_front( visual::scene_shader_push( m_shader ) );
-      result.push_back( visual::scene_shader_pop() );
+      visuals.push_front
+        ( scene_visual
+          ( visual::scene_shader_push( m_shader ),
+            std::numeric_limits<int>::min() ) );
+      visuals.push_back
+        ( scene_visual
+          ( visual::scene_shader_pop(), std::numeric_limits<int>::max() ) );
     }
 
-  return scene_visual( result, get_z_position() );
-} // base_item::get_visual()
+  visuals.end_group();
+} // base_item::insert_visual()
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -343,7 +332,7 @@ bear::engine::scene_visual bear::engine::base_item::get_visual() const
  * \param visuals (out) The sprites of the item, and their positions.
  */
 void
-bear::engine::base_item::get_visual( std::list<scene_visual>& visuals ) const
+bear::engine::base_item::get_visual( scene_visual_sink& visuals ) const
 {
   // nothing to do
 } // base_item::get_visual()
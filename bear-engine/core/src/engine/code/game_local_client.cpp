@@ -25,6 +25,7 @@
 #include "engine/level.hpp"
 #include "engine/level_globals.hpp"
 #include "engine/level_loader.hpp"
+#include "engine/resource_cache.hpp"
 #include "engine/resource_pool.hpp"
 #include "engine/version.hpp"
 
@@ -99,6 +100,7 @@ bear::engine::game_local_client::game_local_client
 bear::engine::game_local_client::~game_local_client()
 {
   delete m_event_manager;
+  delete m_step_report;
 
   clear();
   close_environment();
@@ -124,6 +126,9 @@ void bear::engine::game_local_client::run()
       
       run_level();
 
+      if ( m_step_report != NULL )
+        m_step_report->output( std::cout );
+
       end_game();
 
       clear();
@@ -721,6 +726,12 @@ void bear::engine::game_local_client::constructor_common_init_members()
   m_time_scale = 1;
   m_frames_per_second = 60;
   m_synchronized_render = false;
+  m_headless = false;
+  m_render_enabled = true;
+  m_simulation_speed = 1;
+  m_simulation_date = 0;
+  m_real_date = 0;
+  m_step_report = NULL;
   m_level_paused_sync = false;
   m_event_manager = NULL;
 } // game_local_client::constructor_common_init_members()
@@ -828,9 +839,29 @@ std::string bear::engine::game_local_client::get_formatted_game_name() const
  */
 void bear::engine::game_local_client::set_last_progress_date()
 {
-  m_last_progress = systime::get_date_ms();
+  m_last_progress = get_date();
 } // game_local_client::set_last_progress_date()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the current date of the clock of the simulation, which runs
+ *        m_simulation_speed times faster than the real clock. When the game
+ *        runs as fast as possible, this clock moves forward by one time step
+ *        at each iteration.
+ */
+bear::systime::milliseconds_type
+bear::engine::game_local_client::get_date() const
+{
+  if ( m_simulation_speed == 1 )
+    return systime::get_date_ms();
+  else if ( m_simulation_speed == 0 )
+    return m_simulation_date;
+  else
+    return m_simulation_date
+      + (systime::milliseconds_type)
+      ( (systime::get_date_ms() - m_real_date) * m_simulation_speed );
+} // game_local_client::get_date()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Run the current_level.
@@ -838,6 +869,11 @@ void bear::engine::game_local_client::set_last_progress_date()
 void bear::engine::game_local_client::run_level()
 {
   m_status = status_run;
+  m_real_date = systime::get_date_ms();
+  m_simulation_date = m_real_date;
+
+  if ( m_step_report != NULL )
+    m_step_report->start();
 
   while (m_status != status_quit)
     {
@@ -867,7 +903,10 @@ void bear::engine::game_local_client::run_level()
  */
 void bear::engine::game_local_client::one_step_beyond()
 {
-  systime::milliseconds_type current_time( systime::get_date_ms() );
+  if ( m_simulation_speed == 0 )
+    m_simulation_date += m_time_step;
+
+  systime::milliseconds_type current_time( get_date() );
 
   // The value of m_time_scale may be changed by an item during the progress
   const universe::time_type time_scale( m_time_scale );
@@ -879,11 +918,15 @@ void bear::engine::game_local_client::one_step_beyond()
       progress( current_time, dt, time_range, time_scale );
       render();
 
-      current_time = systime::get_date_ms();
+      current_time = get_date();
     }
   
-  if ( current_time < m_last_progress + m_time_step )
-    systime::sleep( m_last_progress + m_time_step - current_time );
+  if ( (m_simulation_speed != 0)
+       && (current_time < m_last_progress + m_time_step) )
+    systime::sleep
+      ( (systime::milliseconds_type)
+        ( (m_last_progress + m_time_step - current_time)
+          / m_simulation_speed ) );
 } // game_local_client::one_step_beyond()
 
 /*----------------------------------------------------------------------------*/
@@ -969,7 +1012,7 @@ bear::engine::game_local_client::asynchronous_progress
 
       dt -= m_time_step;
 
-      overload = (systime::get_date_ms() - current_time > time_range);
+      overload = (get_date() - current_time > time_range);
     }
   while ( (dt >= m_time_step) && (m_time_step > 0) && !overload );
 
@@ -1021,7 +1064,13 @@ void bear::engine::game_local_client::progress
       
   input::system::get_instance().refresh();
 
+  if ( m_step_report != NULL )
+    m_step_report->start_progress();
+
   m_current_level->progress( elapsed_time );
+
+  if ( m_step_report != NULL )
+    m_step_report->stop_progress();
 } // game_local_client::progress()
 
 /*----------------------------------------------------------------------------*/
@@ -1030,23 +1079,32 @@ void bear::engine::game_local_client::progress
  */
 void bear::engine::game_local_client::render()
 {
+  if ( !m_render_enabled )
+    return;
+
   if ( (m_frames_per_second != 0) && !m_synchronized_render )
     {
       const systime::milliseconds_type render_date
         ( m_last_render + 1000 / m_frames_per_second );
-      const systime::milliseconds_type current_date( systime::get_date_ms() );
+      const systime::milliseconds_type current_date( get_date() );
 
       if ( (current_date < render_date)
            && (render_date - current_date > m_time_step) )
         return;
     }
 
+  if ( m_step_report != NULL )
+    m_step_report->start_render();
+
   // effective procedure
   m_screen->begin_render();
   m_current_level->render( *m_screen );
   m_screen->end_render();
 
-  m_last_render = systime::get_date_ms();
+  if ( m_step_report != NULL )
+    m_step_report->stop_render();
+
+  m_last_render = get_date();
 } // game_local_client::render()
 
 /*----------------------------------------------------------------------------*/
@@ -1058,7 +1116,10 @@ void bear::engine::game_local_client::init_environment() const
   claw::logger << claw::log_verbose << "Initializing screen environment."
                << std::endl;
 
-  visual::screen::initialize( visual::screen::screen_gl );
+  if ( m_headless )
+    visual::screen::initialize( visual::screen::screen_null );
+  else
+    visual::screen::initialize( visual::screen::screen_gl );
 
   claw::logger << claw::log_verbose << "Initializing input environment."
                << std::endl;
@@ -1084,6 +1145,10 @@ void bear::engine::game_local_client::init_environment() const
  */
 void bear::engine::game_local_client::close_environment() const
 {
+  // The resources of the cache must be released while the screen and the
+  // sound system are still available.
+  resource_cache::get_instance().clear();
+
   claw::logger << claw::log_verbose << "Closing sound environment."
                << std::endl;
 
@@ -1252,6 +1317,15 @@ void bear::engine::game_local_client::load_level( const std::string& path )
               << ( (double)(systime::get_date_ms() - loading_date) ) / 1000
               << " s." << std::endl;
 
+  const resource_cache& cache( resource_cache::get_instance() );
+
+  claw::logger << claw::log_verbose << "Resource cache: "
+               << cache.get_hit_count() << " hits, "
+               << cache.get_miss_count() << " misses, "
+               << cache.get_entry_count() << " entries, "
+               << cache.get_resident_size() << " bytes resident."
+               << std::endl;
+
   set_current_level( loader.drop_level() );
 } // game_local_client::load_level()
 
@@ -1454,6 +1528,34 @@ bool bear::engine::game_local_client::check_arguments( int& argc, char** &argv )
         help = "--fps=" + arg.get_string("--fps");
     }
 
+  m_headless = arg.get_bool("--headless");
+  m_render_enabled = !arg.get_bool("--no-render");
+
+  if ( arg.has_value("--simulation-speed") )
+    {
+      const std::string v( arg.get_string("--simulation-speed") );
+
+      if ( claw::text::is_of_type<double>(v) && (std::stod(v) >= 0) )
+        m_simulation_speed = std::stod(v);
+      else
+        help = "--simulation-speed=" + v;
+    }
+
+  if ( arg.get_bool("--step-report") )
+    m_step_report = new step_report( m_time_step );
+
+  if ( arg.has_value("--resource-cache-budget") )
+    {
+      if ( arg.only_integer_values("--resource-cache-budget")
+           && (arg.get_integer("--resource-cache-budget") >= 0) )
+        resource_cache::get_instance().set_budget
+          ( (std::size_t)arg.get_integer("--resource-cache-budget")
+            * 1024 * 1024 );
+      else
+        help = "--resource-cache-budget="
+          + arg.get_string("--resource-cache-budget");
+    }
+
   if ( !help.empty() )
     {
       std::cout << bear_gettext("Bad argument value: '") << help
@@ -1597,6 +1699,32 @@ claw::arguments_table bear::engine::game_local_client::get_arguments_table()
       bear_gettext
       ("Tells to do a rendering of the scene for each progress of the game."),
       true );
+  arg.add_long
+    ( "--headless",
+      bear_gettext
+      ("Runs the game without window, with a screen which displays nothing."),
+      true );
+  arg.add_long
+    ( "--no-render",
+      bear_gettext("Does not render the levels."), true );
+  arg.add_long
+    ( "--simulation-speed",
+      bear_gettext
+      ("Tells how many times faster than the real time the game runs. Zero"
+       " runs the game as fast as possible. Default is 1."),
+      true, bear_gettext("value") );
+  arg.add_long
+    ( "--step-report",
+      bear_gettext
+      ("Prints the statistics about the duration of the progresses and of the"
+       " renders when the game ends."),
+      true );
+  arg.add_long
+    ( "--resource-cache-budget",
+      bear_gettext
+      ("Sets the size, in mebibytes, of the resources kept in memory for the"
+       " next levels when they are not used anymore. Default is 64."),
+      true, bear_gettext("integer") );
   arg.add
     ( "-v", "--version",
       bear_gettext("Prints the version of the engine and exit."),
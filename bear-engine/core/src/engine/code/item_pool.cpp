@@ -0,0 +1,127 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::engine::item_pool class.
+ * \author Julien Jorge
+ */
+#include "engine/item_pool.hpp"
+
+#include <claw/assert.hpp>
+
+#include <algorithm>
+#include <new>
+
+/*----------------------------------------------------------------------------*/
+const std::size_t bear::engine::item_pool::s_blocks_per_chunk( 32 );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param size The size of the instances of the class.
+ */
+bear::engine::item_pool::item_pool( std::size_t size )
+  : m_size( size ),
+    m_block_size
+    ( ( std::max( size, sizeof(void*) ) + alignof(std::max_align_t) - 1 )
+      / alignof(std::max_align_t) * alignof(std::max_align_t) ),
+    m_free( NULL ), m_blocks_in_use( 0 )
+{
+
+} // item_pool::item_pool()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Allocate the memory of an item.
+ * \param size The size of the item.
+ */
+void* bear::engine::item_pool::allocate( std::size_t size )
+{
+  if ( size != m_size )
+    return ::operator new( size );
+
+  if ( m_free == NULL )
+    add_chunk();
+
+  void* const result( m_free );
+  m_free = *static_cast<void**>( m_free );
+  ++m_blocks_in_use;
+
+  return result;
+} // item_pool::allocate()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Release the memory of an item.
+ * \param p The memory of the item.
+ * \param size The size of the item.
+ */
+void bear::engine::item_pool::release( void* p, std::size_t size )
+{
+  if ( p == NULL )
+    return;
+
+  if ( size != m_size )
+    ::operator delete( p );
+  else
+    {
+      CLAW_PRECOND( m_blocks_in_use != 0 );
+
+      *static_cast<void**>( p ) = m_free;
+      m_free = p;
+      --m_blocks_in_use;
+    }
+} // item_pool::release()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the size of the instances of the class.
+ */
+std::size_t bear::engine::item_pool::get_item_size() const
+{
+  return m_size;
+} // item_pool::get_item_size()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of blocks given to the items.
+ */
+std::size_t bear::engine::item_pool::get_blocks_in_use() const
+{
+  return m_blocks_in_use;
+} // item_pool::get_blocks_in_use()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of blocks allocated by the pool.
+ */
+std::size_t bear::engine::item_pool::get_blocks_count() const
+{
+  return m_chunks.size() * s_blocks_per_chunk;
+} // item_pool::get_blocks_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Allocate a chunk of blocks and put them in the free list.
+ */
+void bear::engine::item_pool::add_chunk()
+{
+  char* const chunk
+    ( static_cast<char*>
+      ( ::operator new( m_block_size * s_blocks_per_chunk ) ) );
+
+  m_chunks.push_back( chunk );
+
+  for ( std::size_t i=s_blocks_per_chunk; i!=0; --i )
+    {
+      void* const block( chunk + (i - 1) * m_block_size );
+      *static_cast<void**>( block ) = m_free;
+      m_free = block;
+    }
+} // item_pool::add_chunk()
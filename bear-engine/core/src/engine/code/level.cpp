@@ -211,11 +211,11 @@ void bear::engine::level::shot
               add_region( r, area, area.size() );
 
               universe::rectangle_type active( r.front() );
-              std::list<scene_visual> visuals;
 
-              m_layers[i]->get_visual( visuals, active );
+              m_visuals.clear();
+              m_layers[i]->get_visual( m_visuals, active );
 
-              render( visuals, area.bottom_left(), screen, ratio, ratio );
+              render( m_visuals, area.bottom_left(), screen, ratio, ratio );
             }
         screen.end_render();
 
@@ -639,8 +639,8 @@ void bear::engine::level::render_layers
       universe::rectangle_type active( r.front() );
       get_layer_area(i, active); // the active area scaled in the layer
 
-      std::list<scene_visual> visuals;
-      m_layers[i]->get_visual( visuals, active );
+      m_visuals.clear();
+      m_layers[i]->get_visual( screen, m_visuals, active );
 
       universe::rectangle_type area( view );
       get_layer_area(i, area);   // the camera scaled in the layer
@@ -652,7 +652,7 @@ void bear::engine::level::render_layers
         ( std::max
           ( r_y, (double)screen.get_size().y / m_layers[i]->get_size().y ) );
 
-      render( visuals, area.bottom_left(), screen, layer_r_x, layer_r_y );
+      render( m_visuals, area.bottom_left(), screen, layer_r_x, layer_r_y );
     }
 } // level::render_layers()
 
@@ -680,11 +680,11 @@ void bear::engine::level::render_gui( visual::screen& screen ) const
  * \param r_h Ratio on the height of the sprites.
  */
 void bear::engine::level::render
-( const std::list<scene_visual>& visuals,
+( const scene_visual_sink& visuals,
   const universe::position_type& cam_pos, visual::screen& screen,
   double r_w, double r_h ) const
 {
-  std::list<scene_visual>::const_iterator it;
+  scene_visual_sink::const_iterator it;
 
   for ( it=visuals.begin(); it!=visuals.end(); ++it )
     screen.render
@@ -15,11 +15,13 @@
 
 #include "engine/bitmap_font_loader.hpp"
 #include "engine/model_loader.hpp"
+#include "engine/resource_cache.hpp"
 #include "engine/resource_pool.hpp"
 #include "engine/shader_loader.hpp"
 #include "engine/sprite_loader.hpp"
 #include "engine/spritepos.hpp"
 
+#include <algorithm>
 #include <sstream>
 #include <cassert>
 #include <claw/logger.hpp>
@@ -38,7 +40,8 @@ bool bear::engine::level_globals::s_music_muted(false);
  * \brief Constructor.
  */
 bear::engine::level_globals::level_globals()
-  : m_shared_resources(NULL), m_temporary_resources(NULL), m_frozen(false)
+  : m_shared_resources(NULL), m_temporary_resources(NULL),
+    m_decoding_depth(0), m_frozen(false)
 {
   constructor_default();
 } // level_globals::level_globals()
@@ -54,11 +57,27 @@ bear::engine::level_globals::level_globals()
 bear::engine::level_globals::level_globals
 ( const level_globals* shared, const level_globals* temporary_resources )
   : m_shared_resources( shared ), m_temporary_resources( temporary_resources ),
-    m_frozen(false)
+    m_decoding_depth(0), m_frozen(false)
 {
   constructor_default();
 } // level_globals::level_globals()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor. The sounds decoded by this instance are given to the
+ *        resource_cache and the entries of the cache are released.
+ */
+bear::engine::level_globals::~level_globals()
+{
+  resource_cache& cache( resource_cache::get_instance() );
+
+  for ( std::size_t i=0; i!=m_decoded_sounds.size(); ++i )
+    cache.keep_sound( m_decoded_sounds[i], m_sound_manager );
+
+  for ( std::size_t i=0; i!=m_cached_resources.size(); ++i )
+    cache.release( m_cached_resources[i] );
+} // level_globals::~level_globals()
+
 void bear::engine::level_globals::add_image
 ( const std::string& file_name, const bear::visual::image& image )
 {
@@ -75,10 +94,16 @@ void bear::engine::level_globals::add_image
  */
 void bear::engine::level_globals::load_image( const std::string& file_name )
 {
+  request( resource_cache::image_resource, file_name );
+
   if ( image_exists(file_name) )
     return;
 
-  if ( (m_temporary_resources != NULL)
+  resource_cache& cache( resource_cache::get_instance() );
+
+  if ( cache.find_image( file_name, m_image_manager ) )
+    hold( resource_cache::image_resource, file_name );
+  else if ( (m_temporary_resources != NULL)
        && m_temporary_resources->image_exists( file_name ) )
     m_image_manager.add_image
       ( file_name, m_temporary_resources->get_existing_image( file_name ) );
@@ -91,7 +116,12 @@ void bear::engine::level_globals::load_image( const std::string& file_name )
       resource_pool::get_instance().get_file(file_name, f);
 
       if (f)
-        m_image_manager.load_image(file_name, f);
+        {
+          m_image_manager.load_image(file_name, f);
+          cache.add_image
+            ( file_name, m_image_manager.get_image(file_name) );
+          hold( resource_cache::image_resource, file_name );
+        }
       else
         claw::logger << claw::log_error << "can not open file '" << file_name
                      << "'." << std::endl;
@@ -105,6 +135,8 @@ void bear::engine::level_globals::load_image( const std::string& file_name )
  */
 void bear::engine::level_globals::load_sound( const std::string& file_name )
 {
+  request( resource_cache::sound_resource, file_name );
+
   if ( m_sound_manager.sound_exists(file_name) )
     return;
 
@@ -119,6 +151,9 @@ void bear::engine::level_globals::load_sound( const std::string& file_name )
 
   if ( source != NULL )
     m_sound_manager.copy_sound( file_name, source->m_sound_manager );
+  else if ( resource_cache::get_instance().find_sound
+            ( file_name, m_sound_manager ) )
+    hold( resource_cache::sound_resource, file_name );
   else
     {
       claw::logger << claw::log_verbose << "loading sound '" << file_name
@@ -128,7 +163,10 @@ void bear::engine::level_globals::load_sound( const std::string& file_name )
       resource_pool::get_instance().get_file(file_name, f);
 
       if (f)
-        m_sound_manager.load_sound(file_name, f);
+        {
+          m_sound_manager.load_sound(file_name, f);
+          m_decoded_sounds.push_back( file_name );
+        }
       else
         claw::logger << claw::log_error << "can not open file '" << file_name
                      << "'." << std::endl;
@@ -142,7 +180,22 @@ void bear::engine::level_globals::load_sound( const std::string& file_name )
  */
 void bear::engine::level_globals::load_model( const std::string& file_name )
 {
-  if ( !model_exists(file_name) )
+  request( resource_cache::model_resource, file_name );
+
+  if ( model_exists(file_name) )
+    return;
+
+  resource_cache& cache( resource_cache::get_instance() );
+  resource_cache::dependency_list deps;
+  model_actor cached;
+
+  if ( cache.find_model( file_name, cached, deps ) )
+    {
+      hold( resource_cache::model_resource, file_name );
+      load_dependencies( deps );
+      m_model[file_name] = cached;
+    }
+  else
     {
       claw::logger << claw::log_verbose << "loading model '" << file_name
                    << "'." << std::endl;
@@ -152,10 +205,26 @@ void bear::engine::level_globals::load_model( const std::string& file_name )
 
       if (f)
         {
-          model_loader ldr( f, *this );
-          model_actor* m = ldr.run();
+          const std::size_t first( begin_dependencies() );
+          model_actor* m;
+
+          try
+            {
+              model_loader ldr( f, *this );
+              m = ldr.run();
+            }
+          catch( ... )
+            {
+              end_dependencies( first );
+              throw;
+            }
+
+          deps = end_dependencies( first );
           m_model[file_name] = *m;
           delete m;
+
+          cache.add_model( file_name, m_model[file_name], deps );
+          hold( resource_cache::model_resource, file_name );
         }
       else
         claw::logger << claw::log_error << "can not open file '" << file_name
@@ -170,7 +239,22 @@ void bear::engine::level_globals::load_model( const std::string& file_name )
  */
 void bear::engine::level_globals::load_animation( const std::string& file_name )
 {
-  if ( !animation_exists(file_name) )
+  request( resource_cache::animation_resource, file_name );
+
+  if ( animation_exists(file_name) )
+    return;
+
+  resource_cache& cache( resource_cache::get_instance() );
+  resource_cache::dependency_list deps;
+  visual::animation cached;
+
+  if ( cache.find_animation( file_name, cached, deps ) )
+    {
+      hold( resource_cache::animation_resource, file_name );
+      load_dependencies( deps );
+      m_animation[file_name] = cached;
+    }
+  else
     {
       claw::logger << claw::log_verbose << "loading animation '" << file_name
                    << "'." << std::endl;
@@ -180,9 +264,26 @@ void bear::engine::level_globals::load_animation( const std::string& file_name )
 
       if (f)
         {
-          compiled_file cf(f, true);
-          sprite_loader ldr;
-          m_animation[file_name] = ldr.load_animation( cf, *this );
+          const std::size_t first( begin_dependencies() );
+          visual::animation anim;
+
+          try
+            {
+              compiled_file cf(f, true);
+              sprite_loader ldr;
+              anim = ldr.load_animation( cf, *this );
+            }
+          catch( ... )
+            {
+              end_dependencies( first );
+              throw;
+            }
+
+          deps = end_dependencies( first );
+          m_animation[file_name] = anim;
+
+          cache.add_animation( file_name, anim, deps );
+          hold( resource_cache::animation_resource, file_name );
         }
       else
         claw::logger << claw::log_error << "can not open file '" << file_name
@@ -198,7 +299,20 @@ void bear::engine::level_globals::load_animation( const std::string& file_name )
  */
 void bear::engine::level_globals::load_font( const std::string& file_name )
 {
-  if ( !font_exists(file_name) )
+  request( resource_cache::font_resource, file_name );
+
+  if ( font_exists(file_name) )
+    return;
+
+  resource_cache& cache( resource_cache::get_instance() );
+  resource_cache::dependency_list deps;
+
+  if ( cache.find_font( file_name, m_font_manager, deps ) )
+    {
+      hold( resource_cache::font_resource, file_name );
+      load_dependencies( deps );
+    }
+  else
     {
       claw::logger << claw::log_verbose << "loading font '" << file_name
                    << "'." << std::endl;
@@ -210,11 +324,32 @@ void bear::engine::level_globals::load_font( const std::string& file_name )
         {
           if ( boost::algorithm::ends_with( file_name, ".fnt" ) )
             {
-              bitmap_font_loader ldr( f, *this );
-              m_font_manager.load_font( file_name, ldr.run() );
+              const std::size_t first( begin_dependencies() );
+              visual::bitmap_charmap m;
+
+              try
+                {
+                  bitmap_font_loader ldr( f, *this );
+                  m = ldr.run();
+                }
+              catch( ... )
+                {
+                  end_dependencies( first );
+                  throw;
+                }
+
+              deps = end_dependencies( first );
+              m_font_manager.load_font( file_name, m );
+              cache.add_font( file_name, m, deps );
             }
           else
-            m_font_manager.load_font( file_name, f );
+            {
+              const visual::true_type_memory_file file( f );
+              m_font_manager.load_font( file_name, file );
+              cache.add_font( file_name, file );
+            }
+
+          hold( resource_cache::font_resource, file_name );
         }
       else
         claw::logger << claw::log_error << "can not open file '" << file_name
@@ -254,6 +389,8 @@ void bear::engine::level_globals::load_shader( const std::string& file_name )
 bear::visual::image
 bear::engine::level_globals::get_image( const std::string& name )
 {
+  request( resource_cache::image_resource, name );
+
   if ( !image_exists(name) )
     {
       warn_missing_ressource( name );
@@ -322,6 +459,8 @@ bear::engine::level_globals::get_existing_model( const std::string& name ) const
 const bear::visual::animation&
 bear::engine::level_globals::get_animation( const std::string& name )
 {
+  request( resource_cache::animation_resource, name );
+
   if ( !animation_exists(name) )
     {
       warn_missing_ressource( name );
@@ -449,8 +588,9 @@ std::string bear::engine::level_globals::get_spritepos_path
  *        file associated with the image.
  * \param image_name The name of the image.
  * \param sprite_name The name of the sprite in the spritepos file.
- * \remark The spritepos file in opened in each call and read until the sprite
- *         is found.
+ * \remark The spritepos file is parsed once, then the clips of its sprites are
+ *         kept in an index shared with the instances using this one as their
+ *         shared resources.
  */
 bear::visual::sprite bear::engine::level_globals::auto_sprite
 ( const std::string& image_name, const std::string& sprite_name )
@@ -462,31 +602,21 @@ bear::visual::sprite bear::engine::level_globals::auto_sprite
   if ( it != m_auto_sprite_cache.end() )
     return it->second;
 
-  const std::string spritepos_file( get_spritepos_path(image_name) );
+  const spritepos_index* const index( get_spritepos_index(image_name) );
   visual::sprite result;
 
-  if ( !spritepos_file.empty() )
+  if ( index != NULL )
     {
-      std::stringstream f;
-      resource_pool::get_instance().get_file( spritepos_file, f );
+      const spritepos_index::const_iterator clip( index->find(sprite_name) );
 
-      if (f)
+      if ( clip != index->end() )
         {
-          const spritepos s(f);
-          const spritepos::const_iterator it( s.find( sprite_name ) );
-
-          if ( it != s.end() )
-            {
-              const visual::image& img( get_image(image_name) );
-              result = visual::sprite( img, it->get_clip() );
-            }
-          else
-            claw::logger << claw::log_error << "can not find a valid sprite '"
-                         << sprite_name << "' in the spritepos file of '"
-                         << image_name << "'." << std::endl;
+          const visual::image& img( get_image(image_name) );
+          result = visual::sprite( img, clip->second );
         }
       else
-        claw::logger << claw::log_error << "can not open spritepos file for '"
+        claw::logger << claw::log_error << "can not find a valid sprite '"
+                     << sprite_name << "' in the spritepos file of '"
                      << image_name << "'." << std::endl;
     }
 
@@ -999,12 +1129,110 @@ bear::engine::level_globals::warn_missing_ressource( std::string name ) const
                  << "'." << std::endl;
 } // level_globals::warn_missing_ressource()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the clips of the sprites of the spritepos file associated with a
+ *        given image. The file is parsed if it has not been yet.
+ * \param image_name The name of the image.
+ * \return NULL if there is no spritepos file for this image.
+ */
+const bear::engine::level_globals::spritepos_index*
+bear::engine::level_globals::get_spritepos_index
+( const std::string& image_name )
+{
+  const spritepos_index* result;
+
+  if ( !find_spritepos_index( image_name, result ) )
+    result = load_spritepos_index( image_name );
+
+  return result;
+} // level_globals::get_spritepos_index()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Search the clips of the sprites of the spritepos file associated with
+ *        a given image in this instance and in the shared resources.
+ * \param image_name The name of the image.
+ * \param index (out) The clips of the sprites, or NULL if it is known that
+ *        there is no spritepos file for this image.
+ * \return false if the spritepos file has not been parsed yet.
+ */
+bool bear::engine::level_globals::find_spritepos_index
+( const std::string& image_name, const spritepos_index*& index ) const
+{
+  const spritepos_index_map::const_iterator it
+    ( m_spritepos_index.find( image_name ) );
+
+  if ( it != m_spritepos_index.end() )
+    {
+      index = &it->second;
+      return true;
+    }
+
+  if ( m_missing_spritepos.find( image_name ) != m_missing_spritepos.end() )
+    {
+      index = NULL;
+      return true;
+    }
+
+  if ( m_shared_resources != NULL )
+    return m_shared_resources->find_spritepos_index( image_name, index );
+
+  return false;
+} // level_globals::find_spritepos_index()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Parse the spritepos file associated with a given image and keep the
+ *        clips of its sprites.
+ * \param image_name The name of the image.
+ * \return NULL if there is no spritepos file for this image.
+ */
+const bear::engine::level_globals::spritepos_index*
+bear::engine::level_globals::load_spritepos_index
+( const std::string& image_name )
+{
+  const std::string spritepos_file( get_spritepos_path(image_name) );
+
+  if ( !spritepos_file.empty() )
+    {
+      std::stringstream f;
+      resource_pool::get_instance().get_file( spritepos_file, f );
+
+      if (f)
+        {
+          const spritepos s(f);
+          spritepos_index& result( m_spritepos_index[ image_name ] );
+
+          // insert() keeps the first entry of a given name, as does
+          // spritepos::find().
+          for ( spritepos::const_iterator it( s.begin() ); it != s.end();
+                ++it )
+            result.insert
+              ( spritepos_index::value_type
+                ( it->get_name(), it->get_clip() ) );
+
+          return &result;
+        }
+      else
+        claw::logger << claw::log_error << "can not open spritepos file for '"
+                     << image_name << "'." << std::endl;
+    }
+
+  m_missing_spritepos.insert( image_name );
+  return NULL;
+} // level_globals::load_spritepos_index()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Reload the images.
  */
 void bear::engine::level_globals::restore_images()
 {
+  // The images of the cache which are not used by a level would not be
+  // restored.
+  resource_cache::get_instance().clear_unused();
+
   std::vector<std::string> names;
 
   m_image_manager.get_image_names(names);
@@ -1070,6 +1298,101 @@ void bear::engine::level_globals::restore_shader_programs()
     }
 } // level_globals::restore_shader_programs()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Keeps a reference on an entry of the resource_cache until the
+ *        destruction of this instance.
+ * \param type The type of the resource.
+ * \param name The name of the resource.
+ */
+void bear::engine::level_globals::hold
+( resource_cache::resource_type type, const std::string& name )
+{
+  m_cached_resources.push_back( resource_cache::key_type( type, name ) );
+} // level_globals::hold()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Records that a resource is requested, if a resource added in the
+ *        resource_cache is being decoded.
+ * \param type The type of the resource.
+ * \param name The name of the resource.
+ */
+void bear::engine::level_globals::request
+( resource_cache::resource_type type, const std::string& name )
+{
+  if ( m_decoding_depth != 0 )
+    m_requested_resources.push_back( resource_cache::key_type( type, name ) );
+} // level_globals::request()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Starts recording the resources requested while decoding a resource.
+ * \return The value to pass to end_dependencies().
+ */
+std::size_t bear::engine::level_globals::begin_dependencies()
+{
+  ++m_decoding_depth;
+  return m_requested_resources.size();
+} // level_globals::begin_dependencies()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Stops recording the resources requested while decoding a resource.
+ * \param first The value returned by the matching call to
+ *        begin_dependencies().
+ * \return The resources requested since the call to begin_dependencies(),
+ *         without duplicates.
+ */
+bear::engine::resource_cache::dependency_list
+bear::engine::level_globals::end_dependencies( std::size_t first )
+{
+  CLAW_PRECOND( m_decoding_depth != 0 );
+
+  resource_cache::dependency_list result
+    ( m_requested_resources.begin() + first, m_requested_resources.end() );
+
+  std::sort( result.begin(), result.end() );
+  result.erase( std::unique( result.begin(), result.end() ), result.end() );
+
+  --m_decoding_depth;
+
+  if ( m_decoding_depth == 0 )
+    m_requested_resources.clear();
+
+  return result;
+} // level_globals::end_dependencies()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Loads the resources used by a resource taken from the
+ *        resource_cache.
+ * \param deps The resources to load.
+ */
+void bear::engine::level_globals::load_dependencies
+( const resource_cache::dependency_list& deps )
+{
+  for ( std::size_t i=0; i!=deps.size(); ++i )
+    switch ( deps[i].first )
+      {
+      case resource_cache::image_resource:
+        load_image( deps[i].second );
+        break;
+      case resource_cache::sound_resource:
+        load_sound( deps[i].second );
+        break;
+      case resource_cache::animation_resource:
+        load_animation( deps[i].second );
+        break;
+      case resource_cache::model_resource:
+        load_model( deps[i].second );
+        break;
+      case resource_cache::font_resource:
+        load_font( deps[i].second );
+        break;
+      }
+} // level_globals::load_dependencies()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Do the initializations that must be done in each constructor.
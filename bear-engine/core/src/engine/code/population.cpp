@@ -33,14 +33,25 @@ bear::engine::population::~population()
 void bear::engine::population::insert( base_item* item )
 {
   CLAW_PRECOND( item != NULL );
-  CLAW_PRECOND( !exists( item->get_id() )
-                || ( m_dropped_items.find(item->get_id())
-                    != m_dropped_items.end() ) );
 
-  if ( m_dropped_items.find(item->get_id()) != m_dropped_items.end() )
-    m_dropped_items.erase(item->get_id());
+  entry* const e( find( item->get_id() ) );
 
-  m_items[ item->get_id() ] = item;
+  CLAW_PRECOND( (e == NULL) || (e->state == state_dropped) );
+
+  if ( e != NULL )
+    {
+      e->item = item;
+      e->state = state_alive;
+    }
+  else
+    {
+      entry new_entry;
+      new_entry.item = item;
+      new_entry.id = item->get_id();
+      new_entry.state = state_alive;
+
+      m_handles[ item->get_id() ] = m_items.insert( new_entry );
+    }
 } // population::insert()
 
 /*----------------------------------------------------------------------------*/
@@ -52,8 +63,20 @@ void bear::engine::population::kill( const base_item* item )
 {
   CLAW_PRECOND( item != NULL );
 
-  m_dead_items.insert( item->get_id() );
-  m_dropped_items.erase( item->get_id() );
+  // The item may be killed before its insertion, in which case it is killed
+  // again after the insertion.
+  const handle_map::const_iterator it( m_handles.find( item->get_id() ) );
+
+  if ( it == m_handles.end() )
+    return;
+
+  entry* const e( m_items.find( it->second ) );
+
+  if ( e->state != state_dead )
+    {
+      e->state = state_dead;
+      m_dead_items.push_back( it->second );
+    }
 } // population::kill()
 
 /*----------------------------------------------------------------------------*/
@@ -65,8 +88,18 @@ void bear::engine::population::drop( const base_item* item )
 {
   CLAW_PRECOND( item != NULL );
 
-  if ( m_dead_items.find( item->get_id() ) == m_dead_items.end() )
-    m_dropped_items.insert( item->get_id() );
+  const handle_map::const_iterator it( m_handles.find( item->get_id() ) );
+
+  if ( it == m_handles.end() )
+    return;
+
+  entry* const e( m_items.find( it->second ) );
+
+  if ( e->state == state_alive )
+    {
+      e->state = state_dropped;
+      m_dropped_items.push_back( it->second );
+    }
 } // population::drop()
 
 /*----------------------------------------------------------------------------*/
@@ -76,7 +109,7 @@ void bear::engine::population::drop( const base_item* item )
  */
 bool bear::engine::population::exists( base_item::id_type id ) const
 {
-  return m_items.find(id) != m_items.end();
+  return m_handles.find(id) != m_handles.end();
 } // population::exists()
 
 /*----------------------------------------------------------------------------*/
@@ -85,19 +118,35 @@ bool bear::engine::population::exists( base_item::id_type id ) const
  */
 void bear::engine::population::remove_dead_items()
 {
-  std::set<base_item::id_type>::const_iterator it;
+  // The deletion of an item may kill or drop other items, thus the lists are
+  // visited by index.
+  for ( std::size_t i=0; i!=m_dead_items.size(); ++i )
+    {
+      const entry* const e( m_items.find( m_dead_items[i] ) );
 
-  for (it=m_dead_items.begin(); it!=m_dead_items.end(); ++it)
-    if ( exists(*it) )
-      {
-        delete m_items[*it];
-        m_items.erase(*it);
-      }
+      // The item may have been inserted again after being dropped and killed.
+      if ( (e != NULL) && (e->state == state_dead) )
+        {
+          base_item* const item( e->item );
+
+          m_handles.erase( e->id );
+          m_items.erase( m_dead_items[i] );
+          delete item;
+        }
+    }
 
   m_dead_items.clear();
 
-  for ( it=m_dropped_items.begin(); it!=m_dropped_items.end(); ++it )
-    m_items.erase(*it);
+  for ( std::size_t i=0; i!=m_dropped_items.size(); ++i )
+    {
+      const entry* const e( m_items.find( m_dropped_items[i] ) );
+
+      if ( (e != NULL) && (e->state == state_dropped) )
+        {
+          m_handles.erase( e->id );
+          m_items.erase( m_dropped_items[i] );
+        }
+    }
 
   m_dropped_items.clear();
 } // population::remove_dead_items()
@@ -110,16 +159,25 @@ void bear::engine::population::clear()
 {
   remove_dead_items();
 
-  std::map< base_item::id_type, base_item* >::const_iterator it;
+  std::vector<base_item::id_type> ids;
+  ids.reserve( m_items.size() );
+
+  for ( item_map::const_iterator it=m_items.begin(); it!=m_items.end(); ++it )
+    ids.push_back( it->id );
 
-  for (it=m_items.begin(); it!=m_items.end(); ++it)
+  for ( std::size_t i=0; i!=ids.size(); ++i )
     {
+      const entry* const e( find( ids[i] ) );
+
       // The item may have been dropped by the deletion of another item.
-      if ( m_dropped_items.find( it->first ) == m_dropped_items.end() )
-        delete it->second;
+      if ( (e != NULL) && (e->state != state_dropped) )
+        delete e->item;
     }
 
   m_items.clear();
+  m_handles.clear();
+  m_dead_items.clear();
+  m_dropped_items.clear();
 } // population::clear()
 
 /*----------------------------------------------------------------------------*/
@@ -139,3 +197,20 @@ bear::engine::population::const_iterator bear::engine::population::end() const
 {
   return m_items.end();
 } // population::end()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the entry of an item in the population.
+ * \param id The identifier of the item.
+ * \return NULL if there is no item with this identifier.
+ */
+bear::engine::population::entry*
+bear::engine::population::find( base_item::id_type id )
+{
+  const handle_map::const_iterator it( m_handles.find(id) );
+
+  if ( it == m_handles.end() )
+    return NULL;
+  else
+    return m_items.find( it->second );
+} // population::find()
@@ -0,0 +1,683 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::engine::resource_cache class.
+ * \author Julien Jorge
+ */
+#include "engine/resource_cache.hpp"
+
+#include "engine/model/model_action.hpp"
+#include "engine/model/model_actor.hpp"
+#include "visual/animation.hpp"
+#include "visual/font/bitmap_charmap.hpp"
+#include "visual/font/font_manager.hpp"
+#include "visual/font/true_type_memory_file.hpp"
+#include "visual/image_manager.hpp"
+
+#include <claw/assert.hpp>
+
+#include <iterator>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief An entry of the cache.
+ */
+class bear::engine::resource_cache::entry
+{
+public:
+  explicit entry( std::size_t s );
+  virtual ~entry();
+
+public:
+  /** \brief The size of the resource, in bytes. */
+  const std::size_t size;
+
+  /** \brief How many users hold the resource. */
+  std::size_t references;
+
+  /** \brief The position of the entry in m_unused, when it has no
+      reference. */
+  key_list::iterator unused_position;
+
+  /** \brief The resources used by the resource. */
+  dependency_list dependencies;
+
+  /** \brief The entries of the dependencies on which this entry holds a
+      reference. */
+  std::vector<key_type> held;
+
+}; // class resource_cache::entry
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief An entry of the cache storing a copy of the resource.
+ */
+template<typename T>
+class bear::engine::resource_cache::value_entry:
+  public entry
+{
+public:
+  value_entry( const T& v, std::size_t s );
+
+public:
+  /** \brief The resource. */
+  const T value;
+
+}; // class resource_cache::value_entry
+
+namespace bear
+{
+  namespace engine
+  {
+    namespace detail
+    {
+      /**
+       * \brief Gets the size of the pixels of an image, in bytes.
+       * \param img The image.
+       */
+      static std::size_t get_resource_size( const visual::image& img )
+      {
+        if ( img.is_valid() )
+          return img.width() * img.height() * 4;
+        else
+          return 0;
+      } // get_resource_size()
+
+      /**
+       * \brief Gets the size of the actions of a model, in bytes. The images
+       *        of the model are counted in their own entries.
+       * \param m The model.
+       */
+      static std::size_t get_resource_size( const model_actor& m )
+      {
+        return sizeof(model_actor)
+          + std::distance( m.action_begin(), m.action_end() )
+          * sizeof(model_action);
+      } // get_resource_size()
+
+      /**
+       * \brief Gets the size of the frames of an animation, in bytes. The
+       *        images of the animation are counted in their own entries.
+       * \param anim The animation.
+       */
+      static std::size_t get_resource_size( const visual::animation& anim )
+      {
+        return sizeof(visual::animation)
+          + ( anim.get_max_index() + 1 ) * sizeof(visual::sprite);
+      } // get_resource_size()
+
+      /**
+       * \brief Gets the size of the character map of a bitmap font, in bytes.
+       *        The images of the font are counted in their own entries.
+       * \param m The character map.
+       */
+      static std::size_t get_resource_size( const visual::bitmap_charmap& m )
+      {
+        return sizeof(visual::bitmap_charmap)
+          + m.characters.size()
+          * sizeof(visual::bitmap_charmap::character_map::value_type);
+      } // get_resource_size()
+
+      /**
+       * \brief Gets the size of the content of a true type font file, in
+       *        bytes.
+       * \param f The file.
+       */
+      static std::size_t
+      get_resource_size( const visual::true_type_memory_file& f )
+      {
+        return f.end() - f.begin();
+      } // get_resource_size()
+
+    } // namespace detail
+  } // namespace engine
+} // namespace bear
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param s The size of the resource, in bytes.
+ */
+bear::engine::resource_cache::entry::entry( std::size_t s )
+  : size(s), references(0)
+{
+
+} // resource_cache::entry::entry()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor.
+ */
+bear::engine::resource_cache::entry::~entry()
+{
+
+} // resource_cache::entry::~entry()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param v The resource.
+ * \param s The size of the resource, in bytes.
+ */
+template<typename T>
+bear::engine::resource_cache::value_entry<T>::value_entry
+( const T& v, std::size_t s )
+  : entry(s), value(v)
+{
+
+} // resource_cache::value_entry::value_entry()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the instance.
+ */
+bear::engine::resource_cache& bear::engine::resource_cache::get_instance()
+{
+  return super::get_instance();
+} // resource_cache::get_instance()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+bear::engine::resource_cache::resource_cache()
+  : m_resident_size(0), m_budget(64 * 1024 * 1024), m_hit_count(0),
+    m_miss_count(0)
+{
+
+} // resource_cache::resource_cache()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor.
+ */
+bear::engine::resource_cache::~resource_cache()
+{
+  clear();
+} // resource_cache::~resource_cache()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Removes all the entries, even those having references. Must be called
+ *        before the release of the screen and of the sound system.
+ */
+void bear::engine::resource_cache::clear()
+{
+  for ( entry_map::iterator it=m_entries.begin(); it!=m_entries.end(); ++it )
+    delete it->second;
+
+  m_entries.clear();
+  m_unused.clear();
+  m_sounds.clear();
+  m_resident_size = 0;
+} // resource_cache::clear()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Removes all the entries without reference, whatever the budget is.
+ */
+void bear::engine::resource_cache::clear_unused()
+{
+  while ( !m_unused.empty() )
+    erase( m_unused.front() );
+} // resource_cache::clear_unused()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Sets the maximum size of the resources of the cache. The entries
+ *        without reference are removed to stay under this size.
+ * \param bytes The size, in bytes.
+ */
+void bear::engine::resource_cache::set_budget( std::size_t bytes )
+{
+  m_budget = bytes;
+  trim();
+} // resource_cache::set_budget()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the maximum size of the resources of the cache, in bytes.
+ */
+std::size_t bear::engine::resource_cache::get_budget() const
+{
+  return m_budget;
+} // resource_cache::get_budget()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the size of the resources of the cache, in bytes.
+ */
+std::size_t bear::engine::resource_cache::get_resident_size() const
+{
+  return m_resident_size;
+} // resource_cache::get_resident_size()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the number of resources in the cache.
+ */
+std::size_t bear::engine::resource_cache::get_entry_count() const
+{
+  return m_entries.size();
+} // resource_cache::get_entry_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets how many resources have been found in the cache.
+ */
+std::size_t bear::engine::resource_cache::get_hit_count() const
+{
+  return m_hit_count;
+} // resource_cache::get_hit_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets how many resources have been searched and not found in the
+ *        cache.
+ */
+std::size_t bear::engine::resource_cache::get_miss_count() const
+{
+  return m_miss_count;
+} // resource_cache::get_miss_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Adds an image of the cache in an image manager. If the image is found,
+ *        the caller holds a reference on it.
+ * \param name The name of the image.
+ * \param target The manager in which the image is added.
+ * \return true if the image was in the cache.
+ */
+bool bear::engine::resource_cache::find_image
+( const std::string& name, visual::image_manager& target )
+{
+  const entry* const e( find( key_type( image_resource, name ) ) );
+
+  if ( e == NULL )
+    return false;
+
+  target.add_image
+    ( name, static_cast<const value_entry<visual::image>*>(e)->value );
+  return true;
+} // resource_cache::find_image()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Adds an image in the cache. The caller holds a reference on it.
+ * \param name The name of the image.
+ * \param img The image, shared with the cache.
+ */
+void bear::engine::resource_cache::add_image
+( const std::string& name, const visual::image& img )
+{
+  insert
+    ( key_type( image_resource, name ), img, detail::get_resource_size(img),
+      dependency_list() );
+} // resource_cache::add_image()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Copies a sound of the cache in a sound manager. If the sound is
+ *        found, the caller holds a reference on it.
+ * \param name The name of the sound.
+ * \param target The manager in which the sound is copied.
+ * \return true if the sound was in the cache.
+ */
+bool bear::engine::resource_cache::find_sound
+( const std::string& name, audio::sound_manager& target )
+{
+  if ( find( key_type( sound_resource, name ) ) == NULL )
+    return false;
+
+  target.copy_sound( name, m_sounds );
+  return true;
+} // resource_cache::find_sound()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Keeps a copy of a sound which is not used anymore, such that it is
+ *        not decoded again if it is used later. The caller does not hold a
+ *        reference on the sound.
+ *
+ * The sounds are decoded in the background, thus they are copied in the cache
+ * when they are released instead of when they are loaded, to avoid waiting
+ * for the end of their decoding. The sound is not copied if it does not fit in
+ * the budget, since it would be removed immediately.
+ *
+ * \param name The name of the sound.
+ * \param source The manager from which the sound is copied.
+ */
+void bear::engine::resource_cache::keep_sound
+( const std::string& name, const audio::sound_manager& source )
+{
+  const key_type key( sound_resource, name );
+
+  if ( (m_entries.find( key ) != m_entries.end())
+       || (source.get_memory_size( name ) > m_budget) )
+    return;
+
+  m_sounds.copy_sound( name, source );
+  insert( key, new entry( m_sounds.get_memory_size( name ) ) );
+  release( key );
+} // resource_cache::keep_sound()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets a copy of a model of the cache. If the model is found, the caller
+ *        holds a reference on it.
+ * \param name The name of the model.
+ * \param m (out) The model.
+ * \param deps (out) The resources used by the model.
+ * \return true if the model was in the cache.
+ */
+bool bear::engine::resource_cache::find_model
+( const std::string& name, model_actor& m, dependency_list& deps )
+{
+  const entry* const e( find( key_type( model_resource, name ) ) );
+
+  if ( e == NULL )
+    return false;
+
+  m = static_cast<const value_entry<model_actor>*>(e)->value;
+  deps = e->dependencies;
+  return true;
+} // resource_cache::find_model()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Adds a copy of a model in the cache. The caller holds a reference on
+ *        it.
+ * \param name The name of the model.
+ * \param m The model.
+ * \param deps The resources used by the model.
+ */
+void bear::engine::resource_cache::add_model
+( const std::string& name, const model_actor& m,
+  const dependency_list& deps )
+{
+  insert
+    ( key_type( model_resource, name ), m, detail::get_resource_size(m),
+      deps );
+} // resource_cache::add_model()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets a copy of an animation of the cache. If the animation is found,
+ *        the caller holds a reference on it.
+ * \param name The name of the animation.
+ * \param anim (out) The animation.
+ * \param deps (out) The resources used by the animation.
+ * \return true if the animation was in the cache.
+ */
+bool bear::engine::resource_cache::find_animation
+( const std::string& name, visual::animation& anim, dependency_list& deps )
+{
+  const entry* const e( find( key_type( animation_resource, name ) ) );
+
+  if ( e == NULL )
+    return false;
+
+  anim = static_cast<const value_entry<visual::animation>*>(e)->value;
+  deps = e->dependencies;
+  return true;
+} // resource_cache::find_animation()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Adds a copy of an animation in the cache. The caller holds a
+ *        reference on it.
+ * \param name The name of the animation.
+ * \param anim The animation.
+ * \param deps The resources used by the animation.
+ */
+void bear::engine::resource_cache::add_animation
+( const std::string& name, const visual::animation& anim,
+  const dependency_list& deps )
+{
+  insert
+    ( key_type( animation_resource, name ), anim,
+      detail::get_resource_size(anim), deps );
+} // resource_cache::add_animation()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Adds a font of the cache in a font manager. If the font is found, the
+ *        caller holds a reference on it.
+ * \param name The name of the font.
+ * \param target The manager in which the font is added.
+ * \param deps (out) The resources used by the font.
+ * \return true if the font was in the cache.
+ */
+bool bear::engine::resource_cache::find_font
+( const std::string& name, visual::font_manager& target,
+  dependency_list& deps )
+{
+  const entry* const e( find( key_type( font_resource, name ) ) );
+
+  if ( e == NULL )
+    return false;
+
+  const value_entry<visual::bitmap_charmap>* const bitmap
+    ( dynamic_cast<const value_entry<visual::bitmap_charmap>*>(e) );
+
+  if ( bitmap != NULL )
+    target.load_font( name, bitmap->value );
+  else
+    target.load_font
+      ( name,
+        static_cast<const value_entry<visual::true_type_memory_file>*>(e)
+        ->value );
+
+  deps = e->dependencies;
+  return true;
+} // resource_cache::find_font()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Adds a copy of the character map of a bitmap font in the cache. The
+ *        caller holds a reference on it.
+ * \param name The name of the font.
+ * \param m The character map.
+ * \param deps The resources used by the font.
+ */
+void bear::engine::resource_cache::add_font
+( const std::string& name, const visual::bitmap_charmap& m,
+  const dependency_list& deps )
+{
+  insert
+    ( key_type( font_resource, name ), m, detail::get_resource_size(m),
+      deps );
+} // resource_cache::add_font()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Adds the content of a true type font file in the cache. The caller
+ *        holds a reference on it.
+ * \param name The name of the font.
+ * \param f The content of the file, shared with the cache.
+ */
+void bear::engine::resource_cache::add_font
+( const std::string& name, const visual::true_type_memory_file& f )
+{
+  insert
+    ( key_type( font_resource, name ), f, detail::get_resource_size(f),
+      dependency_list() );
+} // resource_cache::add_font()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Releases a reference on an entry. The entries without reference are
+ *        removed when the budget is exceeded.
+ * \param key The entry to release. Nothing is done if the entry is not in the
+ *        cache, i.e. if the cache has been cleared since the entry was taken.
+ */
+void bear::engine::resource_cache::release( const key_type& key )
+{
+  if ( m_entries.find( key ) == m_entries.end() )
+    return;
+
+  unreference( key );
+  trim();
+} // resource_cache::release()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Searches an entry and updates the counters of hits and misses. If the
+ *        entry is found, the caller holds a reference on it.
+ * \param key The entry to search.
+ * \return NULL if there is no such entry.
+ */
+const bear::engine::resource_cache::entry*
+bear::engine::resource_cache::find( const key_type& key )
+{
+  const entry_map::const_iterator it( m_entries.find( key ) );
+
+  if ( it == m_entries.end() )
+    {
+      ++m_miss_count;
+      return NULL;
+    }
+
+  ++m_hit_count;
+  acquire( key );
+
+  return it->second;
+} // resource_cache::find()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Adds a copy of a resource in the cache. The caller holds a reference
+ *        on it.
+ * \param key The key of the resource.
+ * \param value The resource.
+ * \param size The size of the resource, in bytes.
+ * \param deps The resources used by the resource.
+ */
+template<typename T>
+void bear::engine::resource_cache::insert
+( const key_type& key, const T& value, std::size_t size,
+  const dependency_list& deps )
+{
+  entry* const e( new value_entry<T>( value, size ) );
+  e->dependencies = deps;
+
+  insert( key, e );
+} // resource_cache::insert()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Adds an entry in the cache. The caller holds a reference on it. If
+ *        there is already an entry with the same key, the caller gets a
+ *        reference on the existing entry and the new one is deleted.
+ * \param key The key of the entry.
+ * \param e The entry, which is then owned by the cache.
+ */
+void bear::engine::resource_cache::insert( const key_type& key, entry* e )
+{
+  if ( m_entries.find( key ) != m_entries.end() )
+    {
+      delete e;
+      acquire( key );
+      return;
+    }
+
+  e->references = 1;
+
+  for ( std::size_t i(0); i!=e->dependencies.size(); ++i )
+    if ( m_entries.find( e->dependencies[i] ) != m_entries.end() )
+      {
+        acquire( e->dependencies[i] );
+        e->held.push_back( e->dependencies[i] );
+      }
+
+  m_entries[ key ] = e;
+  m_resident_size += e->size;
+
+  trim();
+} // resource_cache::insert()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Adds a reference on an entry.
+ * \param key The entry.
+ * \pre The entry is in the cache.
+ */
+void bear::engine::resource_cache::acquire( const key_type& key )
+{
+  CLAW_PRECOND( m_entries.find( key ) != m_entries.end() );
+
+  entry* const e( m_entries.find( key )->second );
+
+  if ( e->references == 0 )
+    m_unused.erase( e->unused_position );
+
+  ++e->references;
+} // resource_cache::acquire()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Removes a reference from an entry, without applying the budget.
+ * \param key The entry.
+ * \pre The entry is in the cache and has a reference.
+ */
+void bear::engine::resource_cache::unreference( const key_type& key )
+{
+  CLAW_PRECOND( m_entries.find( key ) != m_entries.end() );
+
+  entry* const e( m_entries.find( key )->second );
+
+  CLAW_PRECOND( e->references > 0 );
+
+  --e->references;
+
+  if ( e->references == 0 )
+    e->unused_position = m_unused.insert( m_unused.end(), key );
+} // resource_cache::unreference()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Removes an entry without reference from the cache.
+ * \param key The entry.
+ * \pre The entry is in the cache and has no reference.
+ */
+void bear::engine::resource_cache::erase( const key_type& key )
+{
+  CLAW_PRECOND( m_entries.find( key ) != m_entries.end() );
+
+  const entry_map::iterator it( m_entries.find( key ) );
+  entry* const e( it->second );
+
+  CLAW_PRECOND( e->references == 0 );
+
+  m_unused.erase( e->unused_position );
+  m_resident_size -= e->size;
+
+  if ( key.first == sound_resource )
+    m_sounds.remove_sound( key.second );
+
+  const std::vector<key_type> held( e->held );
+
+  delete e;
+  m_entries.erase( it );
+
+  for ( std::size_t i(0); i!=held.size(); ++i )
+    unreference( held[i] );
+} // resource_cache::erase()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Removes the least recently used entries without reference until the
+ *        size of the cache is under the budget.
+ */
+void bear::engine::resource_cache::trim()
+{
+  while ( (m_resident_size > m_budget) && !m_unused.empty() )
+    erase( m_unused.front() );
+} // resource_cache::trim()
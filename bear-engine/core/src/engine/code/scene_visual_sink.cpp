@@ -0,0 +1,299 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::engine::scene_visual_sink class.
+ * \author Julien Jorge
+ */
+#include "engine/scene_visual_sink.hpp"
+
+#include <claw/assert.hpp>
+
+#include <algorithm>
+#include <utility>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compares the entries on the z-position of the visuals. The visuals of
+ *        a group stay together, and the visuals with the same z-position keep
+ *        their order.
+ * \param a The left operand.
+ * \param b The right operand.
+ */
+bool bear::engine::scene_visual_sink::z_position_compare::operator()
+  ( const entry& a, const entry& b ) const
+{
+  if ( a.z != b.z )
+    return a.z < b.z;
+
+  if ( a.first != b.first )
+    return a.first < b.first;
+
+  if ( a.inner_z != b.inner_z )
+    return a.inner_z < b.inner_z;
+
+  return a.position < b.position;
+} // scene_visual_sink::z_position_compare::operator()()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructs an empty sink.
+ */
+bear::engine::scene_visual_sink::scene_visual_sink()
+  : m_group(0), m_group_z(0), m_group_first(0), m_last_group(0)
+{
+
+} // scene_visual_sink::scene_visual_sink()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Adds a visual after the other visuals, or after the other visuals of
+ *        the current group.
+ * \param v The visual to add.
+ */
+void bear::engine::scene_visual_sink::push_back( scene_visual v )
+{
+  m_entries.push_back( make_entry( v.z_position ) );
+  m_visuals.push_back( std::move(v) );
+} // scene_visual_sink::push_back()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Adds a visual before the other visuals, or before the other visuals
+ *        of the current group.
+ * \param v The visual to add.
+ */
+void bear::engine::scene_visual_sink::push_front( scene_visual v )
+{
+  if ( m_group == 0 )
+    m_front_entries.push_back( make_entry( v.z_position ) );
+  else
+    m_entries.insert
+      ( m_entries.begin() + m_group_first, make_entry( v.z_position ) );
+
+  m_visuals.push_back( std::move(v) );
+} // scene_visual_sink::push_front()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Starts a group of visuals. The visuals added until the call to
+ *        end_group() are displayed together at a given z-position.
+ * \param z The z-position of the group.
+ * \pre There is no group in progress.
+ */
+void bear::engine::scene_visual_sink::begin_group( int z )
+{
+  CLAW_PRECOND( m_group == 0 );
+
+  move_front_entries();
+
+  ++m_last_group;
+  m_group = m_last_group;
+  m_group_z = z;
+  m_group_first = m_entries.size();
+} // scene_visual_sink::begin_group()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Ends the current group of visuals.
+ * \pre There is a group in progress.
+ */
+void bear::engine::scene_visual_sink::end_group()
+{
+  CLAW_PRECOND( m_group != 0 );
+
+  m_group = 0;
+} // scene_visual_sink::end_group()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the number of visuals inserted in the sink since it has been
+ *        cleared. The visuals inserted after this call are retrieved with
+ *        get_inserted_visual() from this number.
+ */
+std::size_t bear::engine::scene_visual_sink::get_insertion_count() const
+{
+  return m_visuals.size();
+} // scene_visual_sink::get_insertion_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets a visual from its rank in the order of insertion, whatever its
+ *        position in the sink.
+ * \param i The rank of the visual.
+ * \pre i < get_insertion_count()
+ */
+bear::engine::scene_visual&
+bear::engine::scene_visual_sink::get_inserted_visual( std::size_t i )
+{
+  CLAW_PRECOND( i < m_visuals.size() );
+
+  return m_visuals[i];
+} // scene_visual_sink::get_inserted_visual()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Sorts the visuals by increasing z-position. The sort is stable and
+ *        the visuals of a group are sorted among themselves.
+ *
+ * After the sort, the visuals of the groups are ordinary visuals with the
+ * z-position of their group.
+ *
+ * \pre There is no group in progress.
+ */
+void bear::engine::scene_visual_sink::sort()
+{
+  CLAW_PRECOND( m_group == 0 );
+
+  move_front_entries();
+
+  for ( std::size_t i=0; i!=m_entries.size(); ++i )
+    {
+      entry& e( m_entries[i] );
+      e.position = i;
+
+      if ( (e.group != 0) && (i != 0) && (m_entries[i-1].group == e.group) )
+        e.first = m_entries[i-1].first;
+      else
+        e.first = i;
+    }
+
+  std::sort( m_entries.begin(), m_entries.end(), z_position_compare() );
+
+  for ( entry_list::iterator it=m_entries.begin(); it!=m_entries.end(); ++it )
+    {
+      it->inner_z = 0;
+      it->group = 0;
+    }
+} // scene_visual_sink::sort()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Removes all the visuals. The memory is kept for the next visuals.
+ * \pre There is no group in progress.
+ */
+void bear::engine::scene_visual_sink::clear()
+{
+  CLAW_PRECOND( m_group == 0 );
+
+  m_entries.clear();
+  m_front_entries.clear();
+  m_visuals.clear();
+  m_last_group = 0;
+} // scene_visual_sink::clear()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells if there is no visual in the sink.
+ */
+bool bear::engine::scene_visual_sink::empty() const
+{
+  return m_visuals.empty();
+} // scene_visual_sink::empty()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the number of visuals in the sink.
+ */
+std::size_t bear::engine::scene_visual_sink::size() const
+{
+  return m_visuals.size();
+} // scene_visual_sink::size()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets an iterator on the first visual.
+ */
+bear::engine::scene_visual_sink::iterator
+bear::engine::scene_visual_sink::begin()
+{
+  move_front_entries();
+
+  return iterator( m_entries.begin(), m_visuals );
+} // scene_visual_sink::begin()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets an iterator just past the last visual.
+ */
+bear::engine::scene_visual_sink::iterator
+bear::engine::scene_visual_sink::end()
+{
+  move_front_entries();
+
+  return iterator( m_entries.end(), m_visuals );
+} // scene_visual_sink::end()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets an iterator on the first visual.
+ */
+bear::engine::scene_visual_sink::const_iterator
+bear::engine::scene_visual_sink::begin() const
+{
+  move_front_entries();
+
+  return const_iterator( m_entries.begin(), m_visuals );
+} // scene_visual_sink::begin()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets an iterator just past the last visual.
+ */
+bear::engine::scene_visual_sink::const_iterator
+bear::engine::scene_visual_sink::end() const
+{
+  move_front_entries();
+
+  return const_iterator( m_entries.end(), m_visuals );
+} // scene_visual_sink::end()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Creates the entry of a visual added in the sink.
+ * \param z The z-position of the visual.
+ */
+bear::engine::scene_visual_sink::entry
+bear::engine::scene_visual_sink::make_entry( int z ) const
+{
+  entry result;
+
+  if ( m_group == 0 )
+    {
+      result.z = z;
+      result.inner_z = 0;
+    }
+  else
+    {
+      result.z = m_group_z;
+      result.inner_z = z;
+    }
+
+  result.group = m_group;
+  result.first = 0;
+  result.position = 0;
+  result.index = m_visuals.size();
+
+  return result;
+} // scene_visual_sink::make_entry()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Moves the entries of the visuals pushed in front of the sink before
+ *        the other entries.
+ */
+void bear::engine::scene_visual_sink::move_front_entries() const
+{
+  if ( m_front_entries.empty() )
+    return;
+
+  m_entries.insert
+    ( m_entries.begin(), m_front_entries.rbegin(), m_front_entries.rend() );
+  m_front_entries.clear();
+} // scene_visual_sink::move_front_entries()
@@ -0,0 +1,142 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::engine::step_report class.
+ * \author Julien Jorge
+ */
+#include "engine/step_report.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <ostream>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param time_step The duration of the time step of the simulation, in
+ *        milliseconds.
+ */
+bear::engine::step_report::step_report( systime::milliseconds_type time_step )
+  : m_time_step( time_step ), m_start_date( clock_type::now() ),
+    m_measure_date( m_start_date )
+{
+
+} // step_report::step_report()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Forgets the previous measures and starts the measure of the real
+ *        time.
+ */
+void bear::engine::step_report::start()
+{
+  m_progress.clear();
+  m_render.clear();
+  m_start_date = clock_type::now();
+} // step_report::start()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Starts the measure of the duration of a progress.
+ */
+void bear::engine::step_report::start_progress()
+{
+  m_measure_date = clock_type::now();
+} // step_report::start_progress()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Stops the measure of the duration of a progress.
+ */
+void bear::engine::step_report::stop_progress()
+{
+  m_progress.push_back( get_elapsed_time() );
+} // step_report::stop_progress()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Starts the measure of the duration of a render.
+ */
+void bear::engine::step_report::start_render()
+{
+  m_measure_date = clock_type::now();
+} // step_report::start_render()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Stops the measure of the duration of a render.
+ */
+void bear::engine::step_report::stop_render()
+{
+  m_render.push_back( get_elapsed_time() );
+} // step_report::stop_render()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Writes the statistics of the measures.
+ * \param os The stream in which the statistics are written.
+ */
+void bear::engine::step_report::output( std::ostream& os ) const
+{
+  const double real_time
+    ( std::chrono::duration<double, std::milli>
+      ( clock_type::now() - m_start_date ).count() );
+  const double simulated_time( (double)m_progress.size() * m_time_step );
+
+  os << "Steps: " << m_progress.size() << '\n'
+     << "Simulated time: " << simulated_time / 1000 << " s\n"
+     << "Real time: " << real_time / 1000 << " s\n";
+
+  if ( real_time > 0 )
+    os << "Speed: " << simulated_time / real_time << "x\n";
+
+  output_durations( os, "Progress", m_progress );
+  output_durations( os, "Render", m_render );
+
+  os.flush();
+} // step_report::output()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the time elapsed since the start of the current measure, in
+ *        milliseconds.
+ */
+double bear::engine::step_report::get_elapsed_time() const
+{
+  return std::chrono::duration<double, std::milli>
+    ( clock_type::now() - m_measure_date ).count();
+} // step_report::get_elapsed_time()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Writes the distribution of some durations.
+ * \param os The stream in which the distribution is written.
+ * \param name The name of the measured operation.
+ * \param d The durations, in milliseconds.
+ */
+void bear::engine::step_report::output_durations
+( std::ostream& os, const std::string& name, duration_list d )
+{
+  os << name << ": " << d.size() << " calls";
+
+  if ( !d.empty() )
+    {
+      std::sort( d.begin(), d.end() );
+
+      const double sum( std::accumulate( d.begin(), d.end(), 0.0 ) );
+
+      os << ", total " << sum << " ms, mean " << sum / d.size()
+         << " ms, min " << d.front() << " ms, median " << d[ d.size() / 2 ]
+         << " ms, 99% " << d[ d.size() * 99 / 100 ] << " ms, max "
+         << d.back() << " ms";
+    }
+
+  os << '\n';
+} // step_report::output_durations()
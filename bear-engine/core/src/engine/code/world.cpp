@@ -69,7 +69,7 @@ void bear::engine::world::progress_entities
  * \param camera_box The part of the world visible through the camera.
  */
 void bear::engine::world::get_visual
-( std::list<scene_visual>& visuals,
+( scene_visual_sink& visuals,
   const universe::rectangle_type& camera_box ) const
 {
   item_list items;
@@ -87,7 +87,7 @@ void bear::engine::world::get_visual
                      << "item is not a base_item. Not rendered: "
                      << **it << std::endl;
       else
-        visuals.push_back( i->get_visual() );
+        i->insert_visual( visuals );
     }
 } // world::get_visual()
 
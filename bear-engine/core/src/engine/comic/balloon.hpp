@@ -14,8 +14,10 @@
 #ifndef __BEAR_BALLOON_HPP__
 #define __BEAR_BALLOON_HPP__
 
-#include "gui/static_text.hpp"
+#include "gui/visual_component.hpp"
 #include "universe/types.hpp"
+#include "visual/font/font.hpp"
+#include "visual/writing.hpp"
 
 #include "engine/class_export.hpp"
 
@@ -29,6 +31,13 @@ namespace bear
   {
     /**
      * \brief A balloon in which we display what a speaker_item says.
+     *
+     * The text of a speech is arranged once, at the final size of the
+     * balloon. While the balloon grows or shrinks, the glyphs fitting in the
+     * current size are revealed by increasing the count of visible sprites in
+     * the writing. The visuals of the balloon are kept until its size, its
+     * position or its text changes.
+     *
      * \author Sebastien Angibaud
      */
     class ENGINE_EXPORT balloon
@@ -50,6 +59,7 @@ namespace bear
       visual::size_box_type get_final_size() const;
       void set_position
       ( const visual::position_type& pos, bool on_top, bool on_right );
+      void move( const visual::position_type& delta );
       visual::position_type get_position() const;
 
       bool is_on_top() const;
@@ -78,6 +88,10 @@ namespace bear
 
       void write_text();
 
+      void update_visible_glyphs( bool restart );
+      bool is_glyph_visible( std::size_t i ) const;
+      void update_visuals();
+
     private:
       /** \brief The speech. */
       std::list<std::string> m_speeches;
@@ -100,8 +114,8 @@ namespace bear
       /** \brief Indicates if the balloon is at its maximum size. */
       bool m_has_started;
 
-      /** \brief The component in which we show the text. */
-      gui::static_text m_text;
+      /** \brief The area of the balloon in which we show the text. */
+      gui::visual_component m_content;
 
       /** \brief Elapsed time since the creation. */
       universe::time_type m_time;
@@ -122,6 +136,25 @@ namespace bear
       /** \brief Indicates increasing duration. */
       universe::time_type m_increasing_duration;
 
+      /** \brief The font used to display the text. */
+      visual::font m_font;
+
+      /** \brief The text of the current speech, arranged at its final size. */
+      visual::writing m_writing;
+
+      /** \brief The size of the text of the current speech. */
+      visual::size_box_type m_text_size;
+
+      /** \brief The number of glyphs of m_writing fitting in m_content. */
+      std::size_t m_visible_glyphs;
+
+      /** \brief The visuals of the balloon, built by update_visuals(). */
+      std::list<visual::scene_element> m_visuals;
+
+      /** \brief Tell if m_visuals matches the current state of the
+          balloon. */
+      bool m_visuals_are_valid;
+
     }; // class balloon
 
   } // namespace engine
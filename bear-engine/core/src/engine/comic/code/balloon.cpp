@@ -13,7 +13,13 @@
  */
 #include "engine/comic/balloon.hpp"
 
+#include "visual/bitmap_writing.hpp"
+#include "visual/scene_rectangle.hpp"
 #include "visual/scene_sprite.hpp"
+#include "visual/scene_writing.hpp"
+#include "visual/text_layout.hpp"
+#include "visual/text_layout_display_size.hpp"
+#include "visual/text_metric.hpp"
 
 #include <limits>
 
@@ -24,13 +30,10 @@
 bear::engine::balloon::balloon()
   : m_size_frame(0, 0), m_has_started(false), m_time(0), m_play_time(0),
     m_on_top(true), m_on_right(true), m_active(false),
-    m_increasing_duration(0.25)
+    m_increasing_duration(0.25), m_text_size(0, 0), m_visible_glyphs(0),
+    m_visuals_are_valid(false)
 {
-  m_text.set_background_color( claw::graphic::white_pixel );
-  m_text.get_text_rendering_attributes().set_intensity(0,0,0);
-  
-  m_text.set_size( 0, 0 );
-  m_text.set_margin(0, 0);
+  m_content.set_size( 0, 0 );
 } // balloon::balloon()
 
 /*----------------------------------------------------------------------------*/
@@ -75,64 +78,13 @@ void bear::engine::balloon::progress( universe::time_type elapsed_time )
  */
 void bear::engine::balloon::render( std::list<visual::scene_element>& e )
 {
-  if ( (m_text.width() == 0) || (m_text.height() == 0) )
+  if ( (m_content.width() == 0) || (m_content.height() == 0) )
     return;
 
-  m_text.render( e );
+  if ( !m_visuals_are_valid )
+    update_visuals();
 
-  m_horizontal_border.flip(false);
-  e.push_back
-    ( visual::scene_sprite
-      (m_text.left(), m_text.bottom() - m_horizontal_border.height(),
-       m_horizontal_border) );
-
-  m_horizontal_border.flip(true);
-  e.push_back
-    ( visual::scene_sprite
-      (m_text.left(), m_text.top(), m_horizontal_border) );
-
-  m_vertical_border.mirror(false);
-  e.push_back
-    ( visual::scene_sprite
-      (m_text.left() - m_vertical_border.width(), m_text.bottom(),
-       m_vertical_border) );
-
-  m_vertical_border.mirror(true);
-  e.push_back
-    ( visual::scene_sprite
-      (m_text.right(), m_text.bottom(), m_vertical_border) );
-
-  if ( m_on_right )
-    {
-      if (m_on_top)
-        {
-          render_bottom_left_corner(e, m_spike);
-          render_bottom_right_corner(e, m_corner);
-          render_top_left_corner(e, m_corner);
-          render_top_right_corner(e, m_corner);
-        }
-      else
-        {
-          render_bottom_left_corner(e, m_corner);
-          render_bottom_right_corner(e, m_corner);
-          render_top_left_corner(e, m_spike);
-          render_top_right_corner(e, m_corner);
-        }
-    }
-  else if (m_on_top)
-    {
-      render_bottom_left_corner(e, m_corner);
-      render_bottom_right_corner(e, m_spike);
-      render_top_left_corner(e, m_corner);
-      render_top_right_corner(e, m_corner);
-    }
-  else
-    {
-      render_bottom_left_corner(e, m_corner);
-      render_bottom_right_corner(e, m_corner);
-      render_top_left_corner(e, m_corner);
-      render_top_right_corner(e, m_spike);
-    }
+  e.insert( e.end(), m_visuals.begin(), m_visuals.end() );
 } // balloon::render()
 
 /*----------------------------------------------------------------------------*/
@@ -143,6 +95,7 @@ void bear::engine::balloon::render( std::list<visual::scene_element>& e )
 void bear::engine::balloon::set_spike_sprite( visual::sprite spr )
 {
   m_spike = spr;
+  m_visuals_are_valid = false;
 } // balloon::set_spike_sprite()
 
 /*----------------------------------------------------------------------------*/
@@ -155,6 +108,7 @@ void bear::engine::balloon::set_spike_sprite( visual::sprite spr )
 void bear::engine::balloon::set_corner_sprite( visual::sprite spr )
 {
   m_corner = spr;
+  m_visuals_are_valid = false;
 } // balloon::set_corner_sprite()
 
 /*----------------------------------------------------------------------------*/
@@ -167,6 +121,7 @@ void bear::engine::balloon::set_corner_sprite( visual::sprite spr )
 void bear::engine::balloon::set_horizontal_border_sprite( visual::sprite spr )
 {
   m_horizontal_border = spr;
+  m_visuals_are_valid = false;
 } // balloon::set_horizontal_border_sprite()
 
 /*----------------------------------------------------------------------------*/
@@ -179,16 +134,18 @@ void bear::engine::balloon::set_horizontal_border_sprite( visual::sprite spr )
 void bear::engine::balloon::set_vertical_border_sprite( visual::sprite spr )
 {
   m_vertical_border = spr;
+  m_visuals_are_valid = false;
 } // balloon::set_vertical_border_sprite()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Sets the font to use to render the text.
+ * \brief Sets the font to use to render the text. The font is used from the
+ *        next speech.
  * \param f The font to use.
  */
 void bear::engine::balloon::set_font( visual::font f )
 {
-  m_text.set_font( f );
+  m_font = f;
 } // balloon::set_font()
 
 /*----------------------------------------------------------------------------*/
@@ -208,8 +165,9 @@ bear::visual::size_box_type bear::engine::balloon::get_size() const
 {
   visual::size_box_type result;
 
-  result.x = m_text.width() + m_vertical_border.width() + m_spike.width();
-  result.y = m_text.height() + m_horizontal_border.height() + m_spike.height();
+  result.x = m_content.width() + m_vertical_border.width() + m_spike.width();
+  result.y =
+    m_content.height() + m_horizontal_border.height() + m_spike.height();
 
   return result;
 } // balloon::get_size()
@@ -246,16 +204,36 @@ void bear::engine::balloon::set_position
   if (m_on_right)
     delta.x = m_spike.width();
   else
-    delta.x = m_vertical_border.width() + (m_size_frame.x - m_text.width());
+    delta.x =
+      m_vertical_border.width() + (m_size_frame.x - m_content.width());
 
   if (m_on_top)
     delta.y = m_spike.height();
   else
-    delta.y = m_horizontal_border.height() + (m_size_frame.y - m_text.height());
+    delta.y =
+      m_horizontal_border.height() + (m_size_frame.y - m_content.height());
 
-  m_text.set_position(pos + delta);
+  if ( m_content.get_position() != pos + delta )
+    {
+      m_content.set_position(pos + delta);
+      m_visuals_are_valid = false;
+    }
 } // balloon::set_position()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Move the balloon without changing its placement around the speaker.
+ * \param delta The distance to move on each axis.
+ */
+void bear::engine::balloon::move( const visual::position_type& delta )
+{
+  if ( (delta.x == 0) && (delta.y == 0) )
+    return;
+
+  m_content.set_position( m_content.get_position() + delta );
+  m_visuals_are_valid = false;
+} // balloon::move()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the position of the balloon.
@@ -274,7 +252,7 @@ bear::visual::position_type bear::engine::balloon::get_position() const
   else
     delta.y = -m_horizontal_border.height();
 
-  return m_text.bottom_left() + delta;
+  return m_content.bottom_left() + delta;
 } // balloon::get_position()
 
 /*----------------------------------------------------------------------------*/
@@ -310,9 +288,10 @@ bear::engine::balloon::set_speeches( const std::list<std::string>& speeches )
   if ( !m_speeches.empty() )
     write_text();
 
-  m_size_frame = m_text.get_size();
+  m_size_frame = m_content.get_size();
 
-  m_text.set_size( 0, 0 );
+  m_content.set_size( 0, 0 );
+  update_visible_glyphs(true);
   m_active = true;
 } // balloon::set_speeches()
 
@@ -323,7 +302,8 @@ bear::engine::balloon::set_speeches( const std::list<std::string>& speeches )
 void bear::engine::balloon::close()
 {
   m_speeches.clear();
-  m_text.set_size( 0, 0 );
+  m_content.set_size( 0, 0 );
+  update_visible_glyphs(true);
   m_active = false;
 } // balloon::close()
 
@@ -341,7 +321,7 @@ void bear::engine::balloon::render_bottom_left_corner
 
   e.push_back
     ( visual::scene_sprite
-      (m_text.left() - s.width(), m_text.bottom() - s.height(), s) );
+      (m_content.left() - s.width(), m_content.bottom() - s.height(), s) );
 } // balloon::render_bottom_left_corner()
 
 /*----------------------------------------------------------------------------*/
@@ -358,7 +338,7 @@ void bear::engine::balloon::render_bottom_right_corner
 
   e.push_back
     ( visual::scene_sprite
-      (m_text.right(), m_text.bottom() - s.height(), s) );
+      (m_content.right(), m_content.bottom() - s.height(), s) );
 } // balloon::render_bottom_right_corner()
 
 /*----------------------------------------------------------------------------*/
@@ -374,7 +354,7 @@ void bear::engine::balloon::render_top_left_corner
   s.flip(true);
 
   e.push_back
-    ( visual::scene_sprite(m_text.left() - s.width(), m_text.top(), s) );
+    ( visual::scene_sprite(m_content.left() - s.width(), m_content.top(), s) );
 } // balloon::render_top_left_corner()
 
 /*----------------------------------------------------------------------------*/
@@ -389,7 +369,7 @@ void bear::engine::balloon::render_top_right_corner
   s.mirror(true);
   s.flip(true);
 
-  e.push_back( visual::scene_sprite(m_text.right(), m_text.top(), s) );
+  e.push_back( visual::scene_sprite(m_content.right(), m_content.top(), s) );
 } // balloon::render_top_right_corner()
 
 /*----------------------------------------------------------------------------*/
@@ -402,7 +382,7 @@ void bear::engine::balloon::increase( universe::time_type elapsed_time )
   const visual::size_box_type enlargement
     ( m_size_frame / m_increasing_duration * elapsed_time );
 
-  visual::size_box_type size( m_text.get_size() );
+  visual::size_box_type size( m_content.get_size() );
   size.x = std::min( size.x + enlargement.x, m_size_frame.x );
   size.y = std::min( size.y + enlargement.y, m_size_frame.y );
 
@@ -419,7 +399,7 @@ void bear::engine::balloon::decrease( universe::time_type elapsed_time )
   const visual::size_box_type enlargement
     ( m_size_frame / m_increasing_duration * elapsed_time );
 
-  visual::size_box_type size( m_text.get_size() );
+  visual::size_box_type size( m_content.get_size() );
 
   size.x = std::max( size.x - enlargement.x, 0.0 );
   size.y = std::max( size.y - enlargement.y, 0.0 );
@@ -435,15 +415,20 @@ void bear::engine::balloon::decrease( universe::time_type elapsed_time )
  */
 void bear::engine::balloon::set_content_size( const visual::size_box_type& s )
 {
-  m_text.set_size(s);
+  const bool shrinking
+    ( (s.x < m_content.width()) || (s.y < m_content.height()) );
+
+  m_content.set_size(s);
   m_horizontal_border.set_width(s.x);
   m_vertical_border.set_height(s.y);
 
   if ( !m_on_top )
-    m_text.set_bottom( m_text.top() - m_text.height() );
+    m_content.set_bottom( m_content.top() - m_content.height() );
 
   if ( !m_on_right )
-    m_text.set_left( m_text.right() - m_text.width() );
+    m_content.set_left( m_content.right() - m_content.width() );
+
+  update_visible_glyphs(shrinking);
 } // balloon::set_content_size()
 
 /*----------------------------------------------------------------------------*/
@@ -452,19 +437,35 @@ void bear::engine::balloon::set_content_size( const visual::size_box_type& s )
  */
 void bear::engine::balloon::write_text()
 {
-  m_text.set_position( 0, 0 );
-  m_text.set_auto_size(true);
-  m_text.set_text(m_speeches.front());
-  m_text.set_auto_size(false);
+  const std::string& text( m_speeches.front() );
+  const visual::text_metric tm( text, m_font );
+  visual::size_box_type size( tm.width(), tm.height() );
 
-  if ( m_text.width() > 200 )
+  if ( size.x > 200 )
     {
-      m_text.set_width(200);
-      m_text.expand_vertically();
+      size.x = 200;
+      size.y = m_font.get_line_spacing() * text.length();
+
+      visual::text_layout_display_size func( text, m_font, size.y );
+      visual::text_layout layout
+        ( m_font, text, size, visual::text_align::align_left );
+
+      layout.arrange_text<visual::text_layout_display_size&>( func );
+      size = func.get_bounding_box().size();
     }
 
-  set_content_size(m_text.get_size());
-  m_play_time = m_speeches.front().length()/10;
+  // the previous visuals share the writing, which would be copied otherwise.
+  m_visuals.clear();
+  m_visuals_are_valid = false;
+
+  m_writing.create( m_font, text, size );
+  m_text_size = size;
+
+  m_visible_glyphs = 0;
+  m_content.set_position( 0, 0 );
+  set_content_size(size);
+
+  m_play_time = text.length()/10;
 
   if ( m_play_time < 2 )
     m_play_time = 2;
@@ -473,3 +474,129 @@ void bear::engine::balloon::write_text()
 
   m_speeches.pop_front();
 } // balloon::write_text()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Update the number of glyphs of the text fitting in the content of
+ *        the balloon.
+ * \param restart Tell to count the glyphs from the beginning of the text,
+ *        otherwise the count only increases from its current value, which is
+ *        enough when the balloon grows.
+ */
+void bear::engine::balloon::update_visible_glyphs( bool restart )
+{
+  const std::size_t count( m_writing->get_sprites_count() );
+
+  if ( (m_content.width() >= m_text_size.x)
+       && (m_content.height() >= m_text_size.y) )
+    m_visible_glyphs = count;
+  else
+    {
+      if ( restart || (m_visible_glyphs > count) )
+        m_visible_glyphs = 0;
+
+      while ( (m_visible_glyphs != count)
+              && is_glyph_visible(m_visible_glyphs) )
+        ++m_visible_glyphs;
+    }
+
+  m_writing->set_visible_sprites_count( m_visible_glyphs );
+  m_visuals_are_valid = false;
+} // balloon::update_visible_glyphs()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if a glyph of the text is completely inside the content of the
+ *        balloon. The top of the text is aligned with the top of the content.
+ * \param i The index of the glyph in the writing.
+ */
+bool bear::engine::balloon::is_glyph_visible( std::size_t i ) const
+{
+  const visual::placed_sprite s( m_writing->get_sprite(i) );
+
+  return ( s.get_position().x + s.get_sprite().width() <= m_content.width() )
+    && ( s.get_position().y >= m_text_size.y - m_content.height() );
+} // balloon::is_glyph_visible()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Build the visuals of the balloon.
+ */
+void bear::engine::balloon::update_visuals()
+{
+  m_visuals.clear();
+
+  const visual::rectangle_type box
+    ( visual::position_type(0, 0),
+      visual::position_type( m_content.width(), m_content.height() ) );
+
+  m_visuals.push_back
+    ( visual::scene_rectangle
+      ( m_content.left(), m_content.bottom(), claw::graphic::white_pixel,
+        box ) );
+
+  if ( m_visible_glyphs != 0 )
+    {
+      visual::scene_writing text
+        ( m_content.left(), m_content.top() - m_text_size.y, m_writing );
+      text.get_rendering_attributes().set_intensity(0, 0, 0);
+
+      m_visuals.push_back( text );
+    }
+
+  m_horizontal_border.flip(false);
+  m_visuals.push_back
+    ( visual::scene_sprite
+      (m_content.left(), m_content.bottom() - m_horizontal_border.height(),
+       m_horizontal_border) );
+
+  m_horizontal_border.flip(true);
+  m_visuals.push_back
+    ( visual::scene_sprite
+      (m_content.left(), m_content.top(), m_horizontal_border) );
+
+  m_vertical_border.mirror(false);
+  m_visuals.push_back
+    ( visual::scene_sprite
+      (m_content.left() - m_vertical_border.width(), m_content.bottom(),
+       m_vertical_border) );
+
+  m_vertical_border.mirror(true);
+  m_visuals.push_back
+    ( visual::scene_sprite
+      (m_content.right(), m_content.bottom(), m_vertical_border) );
+
+  if ( m_on_right )
+    {
+      if (m_on_top)
+        {
+          render_bottom_left_corner(m_visuals, m_spike);
+          render_bottom_right_corner(m_visuals, m_corner);
+          render_top_left_corner(m_visuals, m_corner);
+          render_top_right_corner(m_visuals, m_corner);
+        }
+      else
+        {
+          render_bottom_left_corner(m_visuals, m_corner);
+          render_bottom_right_corner(m_visuals, m_corner);
+          render_top_left_corner(m_visuals, m_spike);
+          render_top_right_corner(m_visuals, m_corner);
+        }
+    }
+  else if (m_on_top)
+    {
+      render_bottom_left_corner(m_visuals, m_corner);
+      render_bottom_right_corner(m_visuals, m_spike);
+      render_top_left_corner(m_visuals, m_corner);
+      render_top_right_corner(m_visuals, m_corner);
+    }
+  else
+    {
+      render_bottom_left_corner(m_visuals, m_corner);
+      render_bottom_right_corner(m_visuals, m_corner);
+      render_top_left_corner(m_visuals, m_corner);
+      render_top_right_corner(m_visuals, m_spike);
+    }
+
+  m_visuals_are_valid = true;
+} // balloon::update_visuals()
@@ -22,6 +22,7 @@
 
 #include <string>
 #include <list>
+#include <vector>
 
 namespace bear
 {
@@ -31,6 +32,12 @@ namespace bear
 
     /**
      * \brief The balloon displays the balloons of the speaker_item.
+     *
+     * The placement of the balloons is computed again only when a speaker
+     * comes or leaves, when a balloon changes its size or when a speaker
+     * moves farther than a given distance since the last placement. Between
+     * two placements, the balloons follow their speakers.
+     *
      * \author Angibaud Sebastien
      */
     class ENGINE_EXPORT balloon_layer:
@@ -48,6 +55,32 @@ namespace bear
       /** \brief The type of the list of all speakers. */
       typedef std::list<handle_type> speaker_list;
 
+    private:
+      /** \brief The state of a speaker when the balloons were placed. */
+      struct speaker_placement
+      {
+        /** \brief The bounding box of the speaker on the screen when the
+            balloons were placed. */
+        universe::rectangle_type placed_box;
+
+        /** \brief The bounding box of the speaker on the screen at the last
+            progression. */
+        universe::rectangle_type box;
+
+        /** \brief The final size of the balloon when the balloons were
+            placed. */
+        universe::size_box_type balloon_size;
+
+        /** \brief Tell if the balloon was finished when the balloons were
+            placed. */
+        bool finished;
+
+      }; // struct speaker_placement
+
+      /** \brief The type of the list of the states of the speakers, in the
+          order of m_speakers. */
+      typedef std::vector<speaker_placement> placement_list;
+
     public:
       balloon_layer( const std::string& name );
 
@@ -58,6 +91,9 @@ namespace bear
       void add_speaker( speaker_item* speaker );
 
     private:
+      void place_balloons();
+      void follow_speakers();
+
       universe::rectangle_type
       get_bounding_box_on_screen(handle_type& speaker) const;
 
@@ -68,6 +104,16 @@ namespace bear
       /** \brief  The size of the border. */
       unsigned int m_border;
 
+      /** \brief The state of the speakers at the last placement. */
+      placement_list m_placements;
+
+      /** \brief Tell if the placement of the balloons is still valid. */
+      bool m_placement_is_valid;
+
+      /** \brief The distance a speaker can travel before the balloons are
+          placed again. */
+      universe::coordinate_type m_placement_tolerance;
+
     }; // class balloon_layer
 
   } // namespace engine
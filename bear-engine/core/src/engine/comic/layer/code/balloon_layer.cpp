@@ -20,13 +20,16 @@
 #include "engine/level.hpp"
 #include "engine/level_globals.hpp"
 
+#include <cmath>
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
  * \param name The name of the layer.
  */
 bear::engine::balloon_layer::balloon_layer( const std::string& name )
-  : communication::messageable(name), m_border(20)
+  : communication::messageable(name), m_border(20),
+    m_placement_is_valid(false), m_placement_tolerance(10)
 {
 
 } // balloon_layer::balloon_layer()
@@ -51,18 +54,21 @@ void bear::engine::balloon_layer::progress( universe::time_type elapsed_time )
     return;
 
   speaker_list::iterator it;
-  balloon_placement placement(get_size().x, get_size().y);
 
   for ( it = m_speakers.begin(); it != m_speakers.end(); )
     if ( (*it) == (speaker_item*)(NULL) )
-      it = m_speakers.erase(it);
-    else
       {
-        placement.add_speaker( **it, get_bounding_box_on_screen(*it) );
-        ++it;
+        it = m_speakers.erase(it);
+        m_placement_is_valid = false;
       }
+    else
+      ++it;
 
-  placement.place_balloons();
+  if ( m_placement_is_valid )
+    follow_speakers();
+
+  if ( !m_placement_is_valid )
+    place_balloons();
 } // balloon_layer::progress()
 
 /*----------------------------------------------------------------------------*/
@@ -99,8 +105,70 @@ void bear::engine::balloon_layer::add_speaker( speaker_item* speaker )
 #endif
 
   m_speakers.push_back( universe::item_handle_from(speaker) );
+  m_placement_is_valid = false;
 } // balloon_layer::add_speaker()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compute the position of the balloons of all the speakers.
+ */
+void bear::engine::balloon_layer::place_balloons()
+{
+  speaker_list::iterator it;
+  balloon_placement placement(get_size().x, get_size().y);
+
+  m_placements.clear();
+
+  for ( it = m_speakers.begin(); it != m_speakers.end(); ++it )
+    {
+      speaker_placement p;
+      p.box = get_bounding_box_on_screen(*it);
+      p.placed_box = p.box;
+      p.balloon_size = (*it)->get_balloon().get_final_size();
+      p.finished = (*it)->get_balloon().is_finished();
+
+      placement.add_speaker( **it, p.box );
+      m_placements.push_back(p);
+    }
+
+  placement.place_balloons();
+  m_placement_is_valid = true;
+} // balloon_layer::place_balloons()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Move the balloons with their speakers, or invalidate the placement
+ *        if a speaker has changed too much since the last placement.
+ */
+void bear::engine::balloon_layer::follow_speakers()
+{
+  CLAW_PRECOND( m_placements.size() == m_speakers.size() );
+
+  speaker_list::iterator it;
+  placement_list::iterator p( m_placements.begin() );
+
+  for ( it = m_speakers.begin();
+        m_placement_is_valid && (it != m_speakers.end()); ++it, ++p )
+    {
+      const universe::rectangle_type box( get_bounding_box_on_screen(*it) );
+      balloon& b( (*it)->get_balloon() );
+
+      if ( (b.is_finished() != p->finished)
+           || (b.get_final_size() != p->balloon_size)
+           || (box.size() != p->placed_box.size())
+           || ( std::abs( box.left() - p->placed_box.left() )
+                > m_placement_tolerance )
+           || ( std::abs( box.bottom() - p->placed_box.bottom() )
+                > m_placement_tolerance ) )
+        m_placement_is_valid = false;
+      else
+        {
+          b.move( box.bottom_left() - p->box.bottom_left() );
+          p->box = box;
+        }
+    }
+} // balloon_layer::follow_speakers()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the bounding box of a speaker of the screen.
@@ -23,6 +23,7 @@
 #endif // ndef EXPORT
 
 #include "engine/item_factory.hpp"
+#include "engine/item_pool.hpp"
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -52,6 +53,10 @@
  *  - <tt>base_item* clone() const</tt>
  * of base_item with
  *  - <tt>my_class* clone() const</tt>
+ *
+ * Finally, the instances of the class are allocated in an engine::item_pool
+ * specific to the class, through the <tt>operator new</tt> and <tt>operator
+ * delete</tt> added by this macro.
  */
 #define DECLARE_BASE_ITEM( class_name )                                 \
   public:                                                               \
@@ -65,6 +70,23 @@
     return s_ ## class_name ## _class_name;                             \
   }                                                                     \
                                                                         \
+  static void* operator new( std::size_t size )                         \
+  {                                                                     \
+    return get_item_pool().allocate( size );                            \
+  }                                                                     \
+                                                                        \
+  static void operator delete( void* p, std::size_t size )              \
+  {                                                                     \
+    get_item_pool().release( p, size );                                 \
+  }                                                                     \
+                                                                        \
+  static bear::engine::item_pool& get_item_pool()                       \
+  {                                                                     \
+    static bear::engine::item_pool* const pool                          \
+      ( new bear::engine::item_pool( sizeof(class_name) ) );            \
+    return *pool;                                                       \
+  }                                                                     \
+                                                                        \
   private:                                                              \
   static const char* s_ ## class_name ## _class_name
 
@@ -24,6 +24,7 @@
 #include "engine/i18n/translator.hpp"
 #include "engine/libraries_pool.hpp"
 #include "engine/stat_variable.hpp"
+#include "engine/step_report.hpp"
 #include "engine/system/base_system_event_manager.hpp"
 #include "engine/system/game_filesystem.hpp"
 #include "engine/variable/var_map.hpp"
@@ -189,6 +190,7 @@ namespace bear
       std::string get_formatted_game_name() const;
 
       void set_last_progress_date();
+      systime::milliseconds_type get_date() const;
 
       void run_level();
       void one_step_beyond();
@@ -295,6 +297,29 @@ namespace bear
       /** \brief Tell to do one render for each progress. */
       bool m_synchronized_render;
 
+      /** \brief Tell to use a screen which displays nothing. */
+      bool m_headless;
+
+      /** \brief Tell to render the levels. */
+      bool m_render_enabled;
+
+      /** \brief How many times the game runs faster than the real time. Zero
+          means as fast as possible. */
+      double m_simulation_speed;
+
+      /** \brief The date of the clock of the simulation when it was
+          synchronized with the real clock, or its current date when the
+          game runs as fast as possible. */
+      systime::milliseconds_type m_simulation_date;
+
+      /** \brief The real date at which the clock of the simulation was
+          synchronized with the real clock. */
+      systime::milliseconds_type m_real_date;
+
+      /** \brief The measures of the durations of the iterations, if they
+          are requested. */
+      step_report* m_step_report;
+
       /** \brief The statistics sent at the end of the game. */
       game_stats m_stats;
 
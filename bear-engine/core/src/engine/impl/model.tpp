@@ -92,7 +92,7 @@ void bear::engine::model<Base>::progress( universe::time_type elapsed_time )
  */
 template<class Base>
 void
-bear::engine::model<Base>::get_visual( std::list<scene_visual>& visuals ) const
+bear::engine::model<Base>::get_visual( scene_visual_sink& visuals ) const
 {
   if ( m_action!=NULL )
     if ( m_snapshot != m_action->snapshot_end() )
@@ -417,6 +417,8 @@ void bear::engine::model<Base>::set_mark_angle_in_action
       it->set_mark_placement(m);
     }
 
+  m_action->compile_tracks();
+
   m_current_snapshot->get_mark_placement(id).set_angle( angle );
 } // model::set_mark_angle_in_action()
 
@@ -447,6 +449,8 @@ void bear::engine::model<Base>::set_mark_position_in_action
       it->set_mark_placement(m);
     }
 
+  m_action->compile_tracks();
+
   m_current_snapshot->get_mark_placement(id).set_position( position );
 } // model::set_mark_position_in_action()
 
@@ -716,38 +720,54 @@ bear::engine::model<Base>::get_oriented_mark_placement
         result = true;
         m = m_current_snapshot->get_mark_placement( m.get_mark_id() );
 
-        const double rot( this->get_visual_angle() );
+        universe::position_type pos;
+        double a;
+        get_oriented_position_and_angle( m, pos, a );
 
-        universe::coordinate_type dx(m.get_position().x);
-        universe::coordinate_type dy(m.get_position().y);
-        double a( m.get_angle() );
+        m.set_position( pos );
+        m.set_angle(a);
+      }
 
-        if ( this->get_rendering_attributes().is_mirrored() )
-          {
-            dx = this->get_width() - dx;
-            a = 3.14159265 - a;
-          }
+  return result;
+} // model::get_oriented_mark_placement()
 
-        if ( this->get_rendering_attributes().is_flipped() )
-          {
-            dy = this->get_height() - dy;
-            a = -a;
-          }
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the position and the angle of a mark placement, relatively to the
+ *        orientation of the model.
+ * \param m The placement of the mark in the current snapshot.
+ * \param pos (out) The position of the mark.
+ * \param a (out) The angle of the mark.
+ */
+template<class Base>
+void bear::engine::model<Base>::get_oriented_position_and_angle
+( const model_mark_placement& m, universe::position_type& pos,
+  double& a ) const
+{
+  const double rot( this->get_visual_angle() );
 
-        dx -= this->get_width() / 2;
-        dy -=  this->get_height() / 2;
-        const universe::coordinate_type save_dx(dx);
+  universe::coordinate_type dx(m.get_position().x);
+  universe::coordinate_type dy(m.get_position().y);
+  a = m.get_angle();
 
-        dx = dx * std::cos(rot) - dy * std::sin(rot) + this->get_width() / 2;
-        dy = save_dx * std::sin(rot) + dy * std::cos(rot)
-          + this->get_height() / 2;
+  if ( this->get_rendering_attributes().is_mirrored() )
+    {
+      dx = this->get_width() - dx;
+      a = 3.14159265 - a;
+    }
 
-        m.set_position( dx, dy );
-        m.set_angle(a);
-      }
+  if ( this->get_rendering_attributes().is_flipped() )
+    {
+      dy = this->get_height() - dy;
+      a = -a;
+    }
 
-  return result;
-} // model::get_oriented_mark_placement()
+  dx -= this->get_width() / 2;
+  dy -=  this->get_height() / 2;
+
+  pos.x = dx * std::cos(rot) - dy * std::sin(rot) + this->get_width() / 2;
+  pos.y = dx * std::sin(rot) + dy * std::cos(rot) + this->get_height() / 2;
+} // model::get_oriented_position_and_angle()
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -975,14 +995,20 @@ void bear::engine::model<Base>::update_mark_items_positions()
 
   for ( std::size_t i=0; i!=m_snapshot->get_mark_placements_count(); ++i )
     {
-      model_mark_placement m;
-      get_mark_placement(i, m);
+      // The placement is read in place to avoid the copy of its easing and
+      // collision functions at each progression.
+      const model_mark_placement& m
+        ( m_current_snapshot->get_mark_placement(i) );
+
+      universe::position_type pos;
+      double a;
+      get_oriented_position_and_angle( m, pos, a );
 
       model_mark_item& item = m_action->get_mark(i).get_box_item();
 
       item.set_size( m.get_size() );
-      item.set_center_of_mass( m.get_position() );
-      item.set_z_position( m.get_depth_position() );
+      item.set_center_of_mass( pos + this->get_bottom_left() );
+      item.set_z_position( m.get_depth_position() + this->get_z_position() );
 
       const bool empty_mark( (m.get_size().x == 0) || (m.get_size().y == 0) );
 
@@ -1150,8 +1176,9 @@ void bear::engine::model<Base>::create_tweeners()
   CLAW_PRECOND( m_action != NULL );
   CLAW_PRECOND( m_snapshot != m_action->snapshot_end() );
 
-  delete m_current_snapshot;
-  m_current_snapshot = NULL;
+  // The buffer of the placements is kept from a snapshot to the next one.
+  if ( m_current_snapshot == NULL )
+    m_current_snapshot = new model_snapshot_tweener;
 
   model_action::const_snapshot_iterator it(m_snapshot);
   ++it;
@@ -1161,7 +1188,7 @@ void bear::engine::model<Base>::create_tweeners()
   else if ( !m_action->get_next_action().empty() )
     create_tweeners_to_action( *get_action(m_action->get_next_action()) );
   else
-    m_current_snapshot = new model_snapshot_tweener(*m_snapshot);
+    m_current_snapshot->reset(*m_snapshot);
 } // model::create_tweeners()
 
 /*----------------------------------------------------------------------------*/
@@ -1176,10 +1203,13 @@ void bear::engine::model<Base>::create_tweeners_to_snapshot
   CLAW_PRECOND( m_action != NULL );
   CLAW_PRECOND( m_snapshot != m_action->snapshot_end() );
 
-  m_current_snapshot =
-      new model_snapshot_tweener
-      ( *m_snapshot, s, *m_action, *m_action,
-        s.get_date() - m_snapshot->get_date());
+  CLAW_PRECOND( m_current_snapshot != NULL );
+
+  // The tracks toward the next snapshot of the action have been computed
+  // when the action was loaded.
+  m_current_snapshot->reset
+    ( *m_snapshot, m_snapshot->get_tracks(),
+      s.get_date() - m_snapshot->get_date() );
 } // model::create_tweeners_to_snapshot()
 
 /*----------------------------------------------------------------------------*/
@@ -1197,9 +1227,11 @@ void bear::engine::model<Base>::create_tweeners_to_action
   const universe::time_type d =
     std::max( 0.0, m_action->get_duration() - m_snapshot->get_date() );
 
-  m_current_snapshot =
-    new model_snapshot_tweener
-    ( *m_snapshot, *a.snapshot_begin(), *m_action, a, d );
+  CLAW_PRECOND( m_current_snapshot != NULL );
+
+  model_snapshot_tweener::compute_tracks
+    ( *m_snapshot, *a.snapshot_begin(), *m_action, a, m_transition_tracks );
+  m_current_snapshot->reset( *m_snapshot, m_transition_tracks, d );
 } // model::create_tweeners_to_action()
 
 /*----------------------------------------------------------------------------*/
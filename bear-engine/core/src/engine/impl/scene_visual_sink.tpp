@@ -0,0 +1,106 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the template methods of the
+ *        bear::engine::scene_visual_sink class.
+ * \author Julien Jorge
+ */
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param it The entry of the visual.
+ * \param visuals The visuals of the sink.
+ */
+template<typename Value, typename Storage>
+bear::engine::scene_visual_sink::basic_iterator<Value, Storage>::basic_iterator
+( entry_list::const_iterator it, Storage& visuals )
+  : m_iterator(it), m_visuals(&visuals)
+{
+
+} // scene_visual_sink::basic_iterator::basic_iterator()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the visual pointed by the iterator.
+ */
+template<typename Value, typename Storage>
+typename
+bear::engine::scene_visual_sink::basic_iterator<Value, Storage>::reference
+bear::engine::scene_visual_sink::basic_iterator<Value, Storage>::operator*()
+  const
+{
+  return (*m_visuals)[ m_iterator->index ];
+} // scene_visual_sink::basic_iterator::operator*()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets a pointer on the visual pointed by the iterator.
+ */
+template<typename Value, typename Storage>
+typename
+bear::engine::scene_visual_sink::basic_iterator<Value, Storage>::pointer
+bear::engine::scene_visual_sink::basic_iterator<Value, Storage>::operator->()
+  const
+{
+  return &(*m_visuals)[ m_iterator->index ];
+} // scene_visual_sink::basic_iterator::operator->()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Moves to the next visual.
+ */
+template<typename Value, typename Storage>
+bear::engine::scene_visual_sink::basic_iterator<Value, Storage>&
+bear::engine::scene_visual_sink::basic_iterator<Value, Storage>::operator++()
+{
+  ++m_iterator;
+  return *this;
+} // scene_visual_sink::basic_iterator::operator++()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Moves to the next visual.
+ */
+template<typename Value, typename Storage>
+bear::engine::scene_visual_sink::basic_iterator<Value, Storage>
+bear::engine::scene_visual_sink::basic_iterator<Value, Storage>::operator++
+(int)
+{
+  basic_iterator result(*this);
+  ++m_iterator;
+  return result;
+} // scene_visual_sink::basic_iterator::operator++()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells if two iterators point the same visual.
+ * \param that The iterator to compare to.
+ */
+template<typename Value, typename Storage>
+bool
+bear::engine::scene_visual_sink::basic_iterator<Value, Storage>::operator==
+( const basic_iterator& that ) const
+{
+  return m_iterator == that.m_iterator;
+} // scene_visual_sink::basic_iterator::operator==()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells if two iterators point different visuals.
+ * \param that The iterator to compare to.
+ */
+template<typename Value, typename Storage>
+bool
+bear::engine::scene_visual_sink::basic_iterator<Value, Storage>::operator!=
+( const basic_iterator& that ) const
+{
+  return m_iterator != that.m_iterator;
+} // scene_visual_sink::basic_iterator::operator!=()
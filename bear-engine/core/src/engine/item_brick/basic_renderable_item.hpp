@@ -14,7 +14,7 @@
 #ifndef __ENGINE_BASIC_RENDERABLE_ITEM_HPP__
 #define __ENGINE_BASIC_RENDERABLE_ITEM_HPP__
 
-#include "engine/scene_visual.hpp"
+#include "engine/scene_visual_sink.hpp"
 #include "engine/item_brick/with_rendering_attributes.hpp"
 #include "visual/sprite_sequence.hpp"
 
@@ -73,12 +73,12 @@ namespace bear
     protected:
       void add_visual
       ( const visual::scene_element& v,
-        std::list<scene_visual>& visuals ) const;
+        scene_visual_sink& visuals ) const;
       void add_visual
-      ( const visual::sprite& spr, std::list<scene_visual>& visuals ) const;
+      ( const visual::sprite& spr, scene_visual_sink& visuals ) const;
       void add_visual
       ( const visual::sprite_sequence& seq,
-        std::list<scene_visual>& visuals ) const;
+        scene_visual_sink& visuals ) const;
       scene_visual get_scene_visual( const visual::scene_element& e ) const;
       scene_visual get_scene_visual( const visual::sprite& spr ) const;
       scene_visual get_scene_visual( const visual::sprite_sequence& seq ) const;
@@ -14,7 +14,7 @@
 #ifndef __ENGINE_DECORATED_ITEM_WITH_TOGGLE_HPP__
 #define __ENGINE_DECORATED_ITEM_WITH_TOGGLE_HPP__
 
-#include "engine/scene_visual.hpp"
+#include "engine/scene_visual_sink.hpp"
 #include "engine/item_brick/item_with_toggle.hpp"
 #include "universe/types.hpp"
 
@@ -51,7 +51,7 @@ namespace bear
       bool set_animation_field
       ( const std::string& name, const visual::animation& value );
 
-      void get_visual( std::list<scene_visual>& visuals ) const;
+      void get_visual( scene_visual_sink& visuals ) const;
 
     protected:
       void set_toggle_visual_on( const visual::animation& anim );
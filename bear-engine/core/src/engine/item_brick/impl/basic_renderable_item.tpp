@@ -323,7 +323,7 @@ void bear::engine::basic_renderable_item<Base>::set_auto_angular_speed_factor
  */
 template<class Base>
 void bear::engine::basic_renderable_item<Base>::add_visual
-( const visual::scene_element& v, std::list<scene_visual>& visuals ) const
+( const visual::scene_element& v, scene_visual_sink& visuals ) const
 {
   visuals.push_front( get_scene_visual(v) );
 } // basic_renderable_item::add_visual()
@@ -336,7 +336,7 @@ void bear::engine::basic_renderable_item<Base>::add_visual
  */
 template<class Base>
 void bear::engine::basic_renderable_item<Base>::add_visual
-( const visual::sprite& spr, std::list<scene_visual>& visuals ) const
+( const visual::sprite& spr, scene_visual_sink& visuals ) const
 {
   if ( spr.is_valid() )
     visuals.push_front( get_scene_visual(spr) );
@@ -350,7 +350,7 @@ void bear::engine::basic_renderable_item<Base>::add_visual
  */
 template<class Base>
 void bear::engine::basic_renderable_item<Base>::add_visual
-( const visual::sprite_sequence& seq, std::list<scene_visual>& visuals ) const
+( const visual::sprite_sequence& seq, scene_visual_sink& visuals ) const
 {
   if ( seq.is_valid() )
     add_visual( seq.get_sprite(), visuals );
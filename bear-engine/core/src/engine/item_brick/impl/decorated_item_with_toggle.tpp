@@ -44,7 +44,7 @@ bool bear::engine::decorated_item_with_toggle<Base>::set_animation_field
  */
 template<class Base>
 void bear::engine::decorated_item_with_toggle<Base>::get_visual
-( std::list<scene_visual>& visuals ) const
+( scene_visual_sink& visuals ) const
 {
   super::get_visual(visuals);
 
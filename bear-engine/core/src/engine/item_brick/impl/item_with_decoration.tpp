@@ -140,7 +140,19 @@ void bear::engine::item_with_decoration<Base>::progress
 ( universe::time_type elapsed_time )
 {
   super::progress(elapsed_time);
+  progress_animation(elapsed_time);
+} // item_with_decoration::progress()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Move the decoration forward, without the other progressions of the
+ *        item.
+ * \param elapsed_time The duration to play in the animation.
+ */
+template<class Base>
+void bear::engine::item_with_decoration<Base>::progress_animation
+( universe::time_type elapsed_time )
+{
   if ( m_animation.is_valid() )
     {
       m_animation.next(elapsed_time);
@@ -148,7 +160,7 @@ void bear::engine::item_with_decoration<Base>::progress
       if ( m_extend_on_bounding_box )
         m_animation.set_size(this->get_width(), this->get_height());
     }
-} // item_with_decoration::progress()
+} // item_with_decoration::progress_animation()
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -157,7 +169,7 @@ void bear::engine::item_with_decoration<Base>::progress
  */
 template<class Base>
 void bear::engine::item_with_decoration<Base>::get_visual
-( std::list<scene_visual>& visuals ) const
+( scene_visual_sink& visuals ) const
 {
   super::get_visual(visuals);
 
@@ -165,18 +177,20 @@ void bear::engine::item_with_decoration<Base>::get_visual
 
   if (m_item_to_mimic != NULL)
     {
-      std::list<scene_visual> mimic;
-      m_item_to_mimic->get_visual(mimic);
-      
-      for ( ; !mimic.empty(); mimic.pop_front() )
+      m_item_to_mimic->get_visual(m_mimic_visuals);
+
+      for ( scene_visual_sink::iterator it=m_mimic_visuals.begin();
+            it!=m_mimic_visuals.end(); ++it )
         {
           if ( m_extend_on_bounding_box )
-            mimic.front().scene_element.get_rendering_attributes().set_size
+            it->scene_element.get_rendering_attributes().set_size
               (this->get_size());
-          
-          mimic.front().scene_element.set_position(0,0);
-          this->add_visual( mimic.front().scene_element, visuals );
-        } 
+
+          it->scene_element.set_position(0,0);
+          this->add_visual( it->scene_element, visuals );
+        }
+
+      m_mimic_visuals.clear();
     }
 } // item_with_decoration::get_visual()
 
@@ -139,7 +139,7 @@ void bear::engine::item_with_text<Base>::progress
  */
 template<class Base>
 void bear::engine::item_with_text<Base>::get_visual
-( std::list<scene_visual>& visuals ) const
+( scene_visual_sink& visuals ) const
 {
   super::get_visual(visuals);
 
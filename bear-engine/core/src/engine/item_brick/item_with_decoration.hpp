@@ -15,7 +15,7 @@
 #define __ENGINE_ITEM_WITH_DECORATION_HPP__
 
 #include "engine/base_item.hpp"
-#include "engine/scene_visual.hpp"
+#include "engine/scene_visual_sink.hpp"
 #include "universe/types.hpp"
 #include "visual/animation.hpp"
 
@@ -60,7 +60,8 @@ namespace bear
       bool set_bool_field( const std::string& name, bool value );
 
       void progress( universe::time_type elapsed_time );
-      void get_visual( std::list<scene_visual>& visuals ) const;
+      void progress_animation( universe::time_type elapsed_time );
+      void get_visual( scene_visual_sink& visuals ) const;
 
       void set_animation( const visual::animation& anim );
       void set_sprite( const visual::sprite& spr );
@@ -84,6 +85,10 @@ namespace bear
           on the bounding box. */
       bool m_extend_on_bounding_box;
 
+      /** \brief The visuals of the mimicked item, kept from a frame to the
+          next one such that its memory is reused. */
+      mutable scene_visual_sink m_mimic_visuals;
+
     }; // class item_with_decoration
   } // namespace engine
 } // namespace bear
@@ -14,7 +14,7 @@
 #ifndef __ENGINE_ITEM_WITH_TEXT_HPP__
 #define __ENGINE_ITEM_WITH_TEXT_HPP__
 
-#include "engine/scene_visual.hpp"
+#include "engine/scene_visual_sink.hpp"
 #include "engine/item_brick/with_text.hpp"
 #include "universe/types.hpp"
 #include "visual/font/font.hpp"
@@ -64,7 +64,7 @@ namespace bear
       bool set_font_field( const std::string& name, visual::font value );
 
       void progress( universe::time_type elapsed_time );
-      void get_visual( std::list<scene_visual>& visuals ) const;
+      void get_visual( scene_visual_sink& visuals ) const;
 
       void set_text_inside( bool b );
       void set_scale_to_fit( bool b );
@@ -0,0 +1,89 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A pool of memory blocks for the instances of a class of items.
+ * \author Julien Jorge
+ */
+#ifndef __ENGINE_ITEM_POOL_HPP__
+#define __ENGINE_ITEM_POOL_HPP__
+
+#include "engine/class_export.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace bear
+{
+  namespace engine
+  {
+    /**
+     * \brief A pool of memory blocks for the instances of a class of items.
+     *
+     * The blocks are allocated by chunks and the released blocks are kept in
+     * a free list to be reused by the next instances of the class, thus the
+     * items spawned and killed at a high rate do not go through the global
+     * allocator.
+     *
+     * A request for a size different from the size of the blocks is passed to
+     * the global allocator. This happens when a class inheriting from a class
+     * of items does not declare its own pool with DECLARE_BASE_ITEM.
+     *
+     * The memory of the pool is never given back to the system, since the
+     * items may be deleted after the destruction of the static objects. The
+     * pool must be used by a single thread.
+     *
+     * \author Julien Jorge
+     */
+    class ENGINE_EXPORT item_pool
+    {
+    public:
+      explicit item_pool( std::size_t block_size );
+
+      void* allocate( std::size_t size );
+      void release( void* p, std::size_t size );
+
+      std::size_t get_item_size() const;
+      std::size_t get_blocks_in_use() const;
+      std::size_t get_blocks_count() const;
+
+    private:
+      void add_chunk();
+
+      // not implemented
+      item_pool( const item_pool& that );
+      item_pool& operator=( const item_pool& that );
+
+    private:
+      /** \brief The size of the instances of the class. */
+      const std::size_t m_size;
+
+      /** \brief The size of the blocks, including the padding required by
+          the alignment of the items. */
+      const std::size_t m_block_size;
+
+      /** \brief The first free block. Each free block starts with a pointer to
+          the next free block. */
+      void* m_free;
+
+      /** \brief The chunks allocated by the pool. */
+      std::vector<void*> m_chunks;
+
+      /** \brief The number of blocks given to the items. */
+      std::size_t m_blocks_in_use;
+
+      /** \brief The number of blocks in a chunk. */
+      static const std::size_t s_blocks_per_chunk;
+
+    }; // class item_pool
+
+  } // namespace engine
+} // namespace bear
+
+#endif // __ENGINE_ITEM_POOL_HPP__
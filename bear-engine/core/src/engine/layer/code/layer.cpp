@@ -13,6 +13,8 @@
  */
 #include "engine/layer/layer.hpp"
 
+#include "engine/layer/layer_render_cache.hpp"
+
 #include <claw/logger.hpp>
 #include <claw/assert.hpp>
 
@@ -26,7 +28,7 @@
  */
 bear::engine::layer::layer( const universe::size_box_type& size )
   : m_size( size ), m_visible( true ), m_active( true ),
-    m_currently_updating( false )
+    m_render_cache( NULL ), m_currently_updating( false )
 {
   CLAW_PRECOND( size.x != 0 );
   CLAW_PRECOND( size.y != 0 );
@@ -38,7 +40,7 @@ bear::engine::layer::layer( const universe::size_box_type& size )
  */
 bear::engine::layer::~layer()
 {
-  // nothing to do
+  delete m_render_cache;
 } // layer::~layer()
 
 /*----------------------------------------------------------------------------*/
@@ -105,25 +107,39 @@ void bear::engine::layer::update
  * \param visible_area The visible part of the layer.
  */
 void bear::engine::layer::get_visual
-( std::list<scene_visual>& visuals,
+( scene_visual_sink& visuals,
   const universe::rectangle_type& visible_area ) const
 {
   if ( !is_visible() )
     return;
 
-  std::set<base_item*>::const_iterator it;
-
-  for ( it=m_always_displayed.begin(); it!=m_always_displayed.end(); ++it )
-    if ( !visible_area.intersects( (*it)->get_bounding_box() ) )
-      visuals.push_back( (*it)->get_visual() );
-
-  do_get_visual(visuals, visible_area);
-  visuals.sort( scene_visual::z_position_compare() );
+  collect_visual(visuals, visible_area);
+  apply_shader(visuals);
+} // layer::get_visual()
 
-  if ( m_shader.is_valid() )
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the visible sprites of this layer, taking them from the render
+ *        cache if the layer is render cached.
+ * \param scr The screen used to render the content of the cache.
+ * \param visuals (out) The sprites in the visible area, and their positions.
+ * \param visible_area The visible part of the layer.
+ */
+void bear::engine::layer::get_visual
+( visual::screen& scr, scene_visual_sink& visuals,
+  const universe::rectangle_type& visible_area )
+{
+  if ( m_render_cache == NULL )
+    get_visual(visuals, visible_area);
+  else if ( has_moving_items() )
     {
-      visuals.push_front( visual::scene_shader_push( m_shader ) );
-      visuals.push_back( visual::scene_shader_pop() );
+      m_render_cache->invalidate();
+      get_visual(visuals, visible_area);
+    }
+  else if ( is_visible() )
+    {
+      m_render_cache->get_visual(scr, visuals, visible_area);
+      apply_shader(visuals);
     }
 } // layer::get_visual()
 
@@ -139,6 +155,8 @@ void bear::engine::layer::add_item( base_item& item )
   CLAW_PRECOND( !item.is_fixed() );
   CLAW_PRECOND( !item.is_in_layer() );
 
+  invalidate_render_cache();
+
   claw::logger << claw::log_verbose << "Adding item #" << item.get_id()
                << " '" << item.get_class_name() << "' in layer." << std::endl;
 
@@ -163,6 +181,9 @@ void bear::engine::layer::add_item( base_item& item )
   switch ( mark_as_built( item ) )
     {
     case add:
+      if ( !item.is_fixed() )
+        m_non_fixed_items[ &item ] = item.get_bounding_box();
+
       do_add_item( item );
       break;
     case remove:
@@ -181,6 +202,8 @@ void bear::engine::layer::add_item( base_item& item )
  */
 void bear::engine::layer::remove_item( base_item& item )
 {
+  invalidate_render_cache();
+
   if ( m_currently_updating )
     m_post_update_removal.push_back( &item );
   else if ( is_currently_building( item ) )
@@ -188,6 +211,7 @@ void bear::engine::layer::remove_item( base_item& item )
   else
     {
       m_always_displayed.erase(&item);
+      m_non_fixed_items.erase(&item);
 
       do_remove_item(item);
 
@@ -209,11 +233,14 @@ void bear::engine::layer::drop_item( base_item& item )
                   &item )
                 == m_post_update_removal.end() );
 
+  invalidate_render_cache();
+
   if ( is_currently_building( item ) )
     m_post_creation_action[ &item ] = remove;
   else
     {
       m_always_displayed.erase(&item);
+      m_non_fixed_items.erase(&item);
 
       do_drop_item(item);
 
@@ -319,6 +346,111 @@ void bear::engine::layer::set_shader( visual::shader_program s )
   m_shader = s;
 } // layer::set_shader()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the rendering of the layer is kept in images.
+ *
+ * The cache is invalidated when an item is added or removed, and the layer is
+ * rendered directly when an item not fixed when it was added has moved since
+ * the previous rendering. The other changes in the visuals of the items are
+ * not displayed unless invalidate_render_cache() is called.
+ *
+ * \param c Keep the rendering or not.
+ */
+void bear::engine::layer::set_render_cached( bool c )
+{
+  if ( c == is_render_cached() )
+    return;
+
+  if ( c )
+    m_render_cache = new layer_render_cache( *this );
+  else
+    {
+      delete m_render_cache;
+      m_render_cache = NULL;
+    }
+} // layer::set_render_cached()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the rendering of the layer is kept in images.
+ */
+bool bear::engine::layer::is_render_cached() const
+{
+  return m_render_cache != NULL;
+} // layer::is_render_cached()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells if one of the items not fixed when they were added has moved
+ *        since the previous call, and records their new bounding box.
+ */
+bool bear::engine::layer::has_moving_items()
+{
+  bool result( false );
+
+  for ( std::map<const base_item*, universe::rectangle_type>::iterator it=
+          m_non_fixed_items.begin(); it!=m_non_fixed_items.end(); ++it )
+    {
+      const universe::rectangle_type box( it->first->get_bounding_box() );
+
+      if ( !(box == it->second) )
+        {
+          it->second = box;
+          result = true;
+        }
+    }
+
+  return result;
+} // layer::has_moving_items()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Forget the rendering of the layer, if it is cached, such that the
+ *        changes in the visuals of the items are displayed.
+ */
+void bear::engine::layer::invalidate_render_cache()
+{
+  if ( m_render_cache != NULL )
+    m_render_cache->invalidate();
+} // layer::invalidate_render_cache()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the visible sprites of the items of this layer, sorted by their
+ *        z-position.
+ * \param visuals (out) The sprites in the visible area, and their positions.
+ * \param visible_area The visible part of the layer.
+ */
+void bear::engine::layer::collect_visual
+( scene_visual_sink& visuals,
+  const universe::rectangle_type& visible_area ) const
+{
+  std::set<base_item*>::const_iterator it;
+
+  for ( it=m_always_displayed.begin(); it!=m_always_displayed.end(); ++it )
+    if ( !visible_area.intersects( (*it)->get_bounding_box() ) )
+      (*it)->insert_visual( visuals );
+
+  do_get_visual(visuals, visible_area);
+  visuals.sort();
+} // layer::collect_visual()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Surround the visuals with the shader of the layer, if any.
+ * \param visuals (in/out) The visuals of the layer.
+ */
+void
+bear::engine::layer::apply_shader( scene_visual_sink& visuals ) const
+{
+  if ( m_shader.is_valid() )
+    {
+      visuals.push_front( visual::scene_shader_push( m_shader ) );
+      visuals.push_back( visual::scene_shader_pop() );
+    }
+} // layer::apply_shader()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Effectively add an item in the layer.
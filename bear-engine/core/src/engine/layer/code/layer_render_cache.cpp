@@ -0,0 +1,161 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::engine::layer_render_cache class.
+ * \author Julien Jorge
+ */
+#include "engine/layer/layer_render_cache.hpp"
+
+#include "engine/layer/layer.hpp"
+#include "visual/screen.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/*----------------------------------------------------------------------------*/
+const unsigned int bear::engine::layer_render_cache::s_tile_size( 512 );
+const std::size_t bear::engine::layer_render_cache::s_max_tiles( 32 );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param the_layer The layer whose rendering is cached.
+ */
+bear::engine::layer_render_cache::layer_render_cache( const layer& the_layer )
+  : m_layer( the_layer ), m_date( 0 )
+{
+
+} // layer_render_cache::layer_render_cache()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Forget the rendered tiles. They will be rendered again when they are
+ *        visible.
+ */
+void bear::engine::layer_render_cache::invalidate()
+{
+  m_tiles.clear();
+} // layer_render_cache::invalidate()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the visuals displaying the tiles in the visible area. The tiles
+ *        not displayed for the longest time are released if there are too
+ *        many tiles.
+ * \param scr The screen used to render the missing tiles.
+ * \param visuals (out) The visuals of the tiles.
+ * \param visible_area The visible part of the layer.
+ */
+void bear::engine::layer_render_cache::get_visual
+( visual::screen& scr, scene_visual_sink& visuals,
+  const universe::rectangle_type& visible_area )
+{
+  const int min_x( std::floor( visible_area.left() / s_tile_size ) );
+  const int max_x( std::floor( visible_area.right() / s_tile_size ) );
+  const int min_y( std::floor( visible_area.bottom() / s_tile_size ) );
+  const int max_y( std::floor( visible_area.top() / s_tile_size ) );
+
+  ++m_date;
+
+  for ( int x=min_x; x<=max_x; ++x )
+    for ( int y=min_y; y<=max_y; ++y )
+      {
+        const tile_index index( x, y );
+        tile_map::iterator it( m_tiles.find(index) );
+
+        if ( it == m_tiles.end() )
+          {
+            it = m_tiles.insert( tile_map::value_type(index, tile()) ).first;
+            render_tile( scr, index, it->second );
+          }
+
+        tile& t( it->second );
+        t.last_use = m_date;
+
+        if ( t.image.is_valid() )
+          visuals.push_back
+            ( scene_visual
+              ( x * s_tile_size, y * s_tile_size,
+                visual::sprite( t.image ) ) );
+      }
+
+  release_old_tiles();
+} // layer_render_cache::get_visual()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of tiles currently rendered.
+ */
+std::size_t bear::engine::layer_render_cache::get_tiles_count() const
+{
+  return m_tiles.size();
+} // layer_render_cache::get_tiles_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Render the visuals of the layer in a tile.
+ * \param scr The screen used to render the tile.
+ * \param index The index of the tile.
+ * \param t (out) The tile.
+ */
+void bear::engine::layer_render_cache::render_tile
+( visual::screen& scr, const tile_index& index, tile& t ) const
+{
+  const universe::position_type origin
+    ( index.first * s_tile_size, index.second * s_tile_size );
+
+  scene_visual_sink visuals;
+  m_layer.collect_visual
+    ( visuals,
+      universe::rectangle_type
+      ( origin.x, origin.y, origin.x + s_tile_size, origin.y + s_tile_size ) );
+
+  if ( visuals.empty() )
+    return;
+
+  std::list<visual::scene_element> elements;
+
+  for ( scene_visual_sink::const_iterator it=visuals.begin();
+        it!=visuals.end(); ++it )
+    {
+      visual::scene_element e( it->scene_element );
+      e.set_position
+        ( e.get_position().x - origin.x, e.get_position().y - origin.y );
+      elements.push_back( e );
+    }
+
+  t.image = visual::image( s_tile_size, s_tile_size );
+  scr.render_to_image( t.image, elements );
+} // layer_render_cache::render_tile()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Release the tiles not displayed for the longest time, until there
+ *        are at most s_max_tiles tiles. The tiles of the current frame are
+ *        kept.
+ */
+void bear::engine::layer_render_cache::release_old_tiles()
+{
+  if ( m_tiles.size() <= s_max_tiles )
+    return;
+
+  std::vector< std::pair<std::size_t, tile_index> > old_tiles;
+
+  for ( tile_map::const_iterator it=m_tiles.begin(); it!=m_tiles.end(); ++it )
+    if ( it->second.last_use != m_date )
+      old_tiles.push_back( std::make_pair( it->second.last_use, it->first ) );
+
+  std::sort( old_tiles.begin(), old_tiles.end() );
+
+  for ( std::size_t i=0;
+        (i != old_tiles.size()) && (m_tiles.size() > s_max_tiles); ++i )
+    m_tiles.erase( old_tiles[i].second );
+} // layer_render_cache::release_old_tiles()
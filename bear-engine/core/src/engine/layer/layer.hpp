@@ -26,8 +26,14 @@
 
 namespace bear
 {
+  namespace visual
+  {
+    class screen;
+  } // namespace visual
+
   namespace engine
   {
+    class layer_render_cache;
     class level;
     class world;
 
@@ -38,6 +44,8 @@ namespace bear
     class ENGINE_EXPORT layer:
       virtual public level_object
     {
+      friend class layer_render_cache;
+
     private:
       /** Tells what to do with an item once it has been built. */
       enum post_create_action
@@ -70,8 +78,11 @@ namespace bear
         ( const region_type& active_area, universe::time_type elapsed_time  );
 
       void get_visual
-      ( std::list<scene_visual>& visuals,
+      ( scene_visual_sink& visuals,
         const universe::rectangle_type& visible_area ) const;
+      void get_visual
+      ( visual::screen& scr, scene_visual_sink& visuals,
+        const universe::rectangle_type& visible_area );
 
       void add_item( base_item& item );
       void remove_item( base_item& item );
@@ -92,6 +103,10 @@ namespace bear
 
       void set_shader( visual::shader_program s );
 
+      void set_render_cached( bool c );
+      bool is_render_cached() const;
+      void invalidate_render_cache();
+
     private:
       virtual void progress
       ( const region_type& active_area, universe::time_type elapsed_time  ) = 0;
@@ -101,14 +116,20 @@ namespace bear
       virtual void do_drop_item( base_item& item );
 
       virtual void do_get_visual
-      ( std::list<scene_visual>& visuals,
+      ( scene_visual_sink& visuals,
         const universe::rectangle_type& visible_area ) const = 0;
 
       virtual world* do_get_world();
       virtual const world* do_get_world() const;
 
+      void collect_visual
+      ( scene_visual_sink& visuals,
+        const universe::rectangle_type& visible_area ) const;
+      void apply_shader( scene_visual_sink& visuals ) const;
+
       post_create_action mark_as_built( base_item& item );
       bool is_currently_building( base_item& item ) const;
+      bool has_moving_items();
 
       void apply_post_update_changes();
 
@@ -132,6 +153,14 @@ namespace bear
       /** \brief The shader to apply to the items in this layer. */
       visual::shader_program m_shader;
 
+      /** \brief The rendering of the layer, if it is cached. */
+      layer_render_cache* m_render_cache;
+
+      /** \brief The items of the layer that were not fixed when they were
+          added, and their bounding box when the layer was last rendered. The
+          render cache is not used when one of them has moved. */
+      std::map<const base_item*, universe::rectangle_type> m_non_fixed_items;
+
       /** \brief The items we are currently adding in the layer. */
       std::map<base_item*, post_create_action> m_post_creation_action;
 
@@ -0,0 +1,114 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The rendering of a layer, kept in images.
+ * \author Julien Jorge
+ */
+#ifndef __ENGINE_LAYER_RENDER_CACHE_HPP__
+#define __ENGINE_LAYER_RENDER_CACHE_HPP__
+
+#include "engine/scene_visual_sink.hpp"
+#include "universe/types.hpp"
+#include "visual/image.hpp"
+
+#include <list>
+#include <map>
+
+#include "engine/class_export.hpp"
+
+namespace bear
+{
+  namespace visual
+  {
+    class screen;
+  } // namespace visual
+
+  namespace engine
+  {
+    class layer;
+
+    /**
+     * \brief The rendering of a layer, kept in images.
+     *
+     * The layer is cut in square tiles. The first time a tile is visible, the
+     * visuals of the layer in this tile are rendered in an image, then the
+     * tile is displayed with this single image until the cache is
+     * invalidated. Thus the visuals of the layer must not change between two
+     * invalidations. When there are more than s_max_tiles tiles, the tiles
+     * not displayed for the longest time are released, such that the camera
+     * can go back and forth without rendering the tiles again.
+     *
+     * The tiles are rendered with a pixel per unit of the layer.
+     *
+     * \author Julien Jorge
+     */
+    class ENGINE_EXPORT layer_render_cache
+    {
+    private:
+      /** \brief The index of a tile on each axis. */
+      typedef std::pair<int, int> tile_index;
+
+      /**
+       * \brief A part of the layer rendered in an image.
+       */
+      struct tile
+      {
+        /** \brief The rendered visuals. Invalid if there is no visual in the
+            tile. */
+        visual::image image;
+
+        /** \brief The date of the last frame in which the tile has been
+            displayed. */
+        std::size_t last_use;
+
+      }; // struct tile
+
+      /** \brief The type of the container of the tiles. */
+      typedef std::map<tile_index, tile> tile_map;
+
+    public:
+      explicit layer_render_cache( const layer& the_layer );
+
+      void invalidate();
+
+      void get_visual
+      ( visual::screen& scr, scene_visual_sink& visuals,
+        const universe::rectangle_type& visible_area );
+
+      std::size_t get_tiles_count() const;
+
+    private:
+      void render_tile
+      ( visual::screen& scr, const tile_index& index, tile& t ) const;
+      void release_old_tiles();
+
+    private:
+      /** \brief The layer whose rendering is cached. */
+      const layer& m_layer;
+
+      /** \brief The rendered tiles. */
+      tile_map m_tiles;
+
+      /** \brief The number of frames displayed with the cache, giving the
+          date of the last use of the tiles. */
+      std::size_t m_date;
+
+      /** \brief The size of the sides of the tiles. */
+      static const unsigned int s_tile_size;
+
+      /** \brief The maximum number of tiles kept when they are not
+          displayed. */
+      static const std::size_t s_max_tiles;
+
+    }; // class layer_render_cache
+  } // namespace engine
+} // namespace bear
+
+#endif // __ENGINE_LAYER_RENDER_CACHE_HPP__
@@ -142,7 +142,7 @@ namespace bear
 
       void render_gui( visual::screen& screen ) const;
       void render
-      ( const std::list<scene_visual>& visuals,
+      ( const scene_visual_sink& visuals,
         const universe::position_type& cam_pos, visual::screen& screen,
         double r_w, double r_h ) const;
       visual::scene_element element_to_screen_coordinates
@@ -207,6 +207,10 @@ namespace bear
       /** \brief The item to use to set the ears in the sound manager. */
       universe::item_handle m_ears;
 
+      /** \brief The visuals of the layer being rendered. It is kept from a
+          frame to the next one such that its memory is reused. */
+      mutable scene_visual_sink m_visuals;
+
       /** \brief The signal emitted when the level starts. */
       boost::signals2::signal<void ()> m_started_signal;
 
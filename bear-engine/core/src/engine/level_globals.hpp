@@ -20,9 +20,16 @@
 #include "visual/font/font_manager.hpp"
 #include "communication/post_office.hpp"
 #include "engine/model/model_actor.hpp"
+#include "engine/resource_cache.hpp"
+#include "engine/spritepos.hpp"
 
 #include "engine/class_export.hpp"
 
+#include <claw/non_copyable.hpp>
+
+#include <unordered_map>
+#include <unordered_set>
+
 namespace bear
 {
   namespace engine
@@ -30,9 +37,15 @@ namespace bear
     /**
      * \brief Some global classes in a level: the image_manager, the
      *        sound_manager and the post office.
+     *
+     * The resources are searched in the resource_cache before being decoded,
+     * and the decoded resources are added in the cache. The entries of the
+     * cache used by the instance are released when it is destroyed.
+     *
      * \author Julien Jorge
      */
-    class ENGINE_EXPORT level_globals
+    class ENGINE_EXPORT level_globals:
+      private claw::pattern::non_copyable
     {
     private:
       /** \brief The type of the key identifying a sprite loaded from a
@@ -43,11 +56,23 @@ namespace bear
           spritepos files. */
       typedef std::map<spritepos_entry, visual::sprite> auto_sprite_cache;
 
+      /** \brief The type of the map giving the clip of the sprites of a
+          spritepos file, by name. */
+      typedef
+      std::unordered_map<std::string, spritepos::sprite_entry::rectangle_type>
+      spritepos_index;
+
+      /** \brief The type of the map storing the parsed spritepos files, by
+          name of the image. */
+      typedef std::unordered_map<std::string, spritepos_index>
+      spritepos_index_map;
+
     public:
       level_globals();
       level_globals
         ( const level_globals* shared,
           const level_globals* temporary_resources );
+      ~level_globals();
 
       void add_image
         ( const std::string& file_name, const bear::visual::image& image );
@@ -142,9 +167,24 @@ namespace bear
     private:
       void warn_missing_ressource( std::string name ) const;
 
+      const spritepos_index*
+      get_spritepos_index( const std::string& image_name );
+      bool find_spritepos_index
+      ( const std::string& image_name, const spritepos_index*& index ) const;
+      const spritepos_index*
+      load_spritepos_index( const std::string& image_name );
+
       void restore_images();
       void restore_shader_programs();
 
+      void hold
+      ( resource_cache::resource_type type, const std::string& name );
+      void request
+      ( resource_cache::resource_type type, const std::string& name );
+      std::size_t begin_dependencies();
+      resource_cache::dependency_list end_dependencies( std::size_t first );
+      void load_dependencies( const resource_cache::dependency_list& deps );
+
       void constructor_default();
 
     private:
@@ -177,6 +217,29 @@ namespace bear
       /** \brief This map stores the sprites read from spritepos files. */
       auto_sprite_cache m_auto_sprite_cache;
 
+      /** \brief The spritepos files parsed in this instance, by name of the
+          image. */
+      spritepos_index_map m_spritepos_index;
+
+      /** \brief The images for which no spritepos file could be read. */
+      std::unordered_set<std::string> m_missing_spritepos;
+
+      /** \brief The entries of the resource_cache on which this instance
+          holds a reference. */
+      std::vector<resource_cache::key_type> m_cached_resources;
+
+      /** \brief The sounds decoded by this instance, given to the
+          resource_cache when the instance is destroyed. */
+      std::vector<std::string> m_decoded_sounds;
+
+      /** \brief The resources requested while decoding the resources added
+          in the resource_cache, from which their dependencies are taken. */
+      resource_cache::dependency_list m_requested_resources;
+
+      /** \brief How many resources added in the resource_cache are being
+          decoded. */
+      std::size_t m_decoding_depth;
+
       /** \brief Tells if no more resources are supposed to be created. */
       bool m_frozen;
 
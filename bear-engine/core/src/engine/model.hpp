@@ -60,7 +60,7 @@ namespace bear
       model<Base>& operator=( const model<Base>& that );
 
       void progress( universe::time_type elapsed_time );
-      void get_visual( std::list<scene_visual>& visuals ) const;
+      void get_visual( scene_visual_sink& visuals ) const;
 
       void set_model_actor(const model_actor& actor);
       void start_model_action(const std::string& name);
@@ -142,6 +142,10 @@ namespace bear
 
       void add_mark_item_in_layer( std::size_t i );
 
+      void get_oriented_position_and_angle
+      ( const model_mark_placement& m, universe::position_type& pos,
+        double& a ) const;
+
       void create_tweeners();
       void create_tweeners_to_snapshot( const model_snapshot& s );
       void create_tweeners_to_action( const model_action& a );
@@ -170,6 +174,9 @@ namespace bear
       /** \brief The tweeners for the current snapshot. */
       model_snapshot_tweener* m_current_snapshot;
 
+      /** \brief The tracks toward the first snapshot of the next action. */
+      model_snapshot::mark_track_list m_transition_tracks;
+
     }; // class model
   } // namespace engine
 } // namespace bear
@@ -14,6 +14,7 @@
 #include "engine/model/model_action.hpp"
 
 #include "engine/model/model_snapshot.hpp"
+#include "engine/model/model_snapshot_tweener.hpp"
 
 #include <stdexcept>
 #include <limits>
@@ -185,9 +186,35 @@ void bear::engine::model_action::add_snapshot( const model_snapshot& s )
 {
   CLAW_PRECOND( m_snapshot.find(s.get_date()) == m_snapshot.end() );
 
-  m_snapshot[s.get_date()] = new model_snapshot(s);
+  const snapshot_map::iterator it
+    ( m_snapshot.insert
+      ( snapshot_map::value_type( s.get_date(), new model_snapshot(s) ) )
+      .first );
+
+  compile_tracks(it);
+
+  if ( it != m_snapshot.begin() )
+    {
+      snapshot_map::iterator prev(it);
+      --prev;
+      compile_tracks(prev);
+    }
 } // model_action::add_snapshot()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compute the tracks interpolating the marks of each snapshot toward
+ *        the next one.
+ * \remark This method must be called after the snapshots have been modified
+ *         through a snapshot_iterator.
+ */
+void bear::engine::model_action::compile_tracks()
+{
+  for ( snapshot_map::iterator it=m_snapshot.begin(); it!=m_snapshot.end();
+        ++it )
+    compile_tracks(it);
+} // model_action::compile_tracks()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the snapshot of a given date (or the one before the date).
@@ -422,3 +449,25 @@ void std::swap
 {
   a.swap(b);
 } // std::swap()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compute the tracks interpolating the marks of a snapshot toward the
+ *        next snapshot of the action.
+ * \param it The snapshot for which the tracks are computed.
+ */
+void bear::engine::model_action::compile_tracks( snapshot_map::iterator it )
+{
+  CLAW_PRECOND( it != m_snapshot.end() );
+
+  snapshot_map::iterator next(it);
+  ++next;
+
+  model_snapshot::mark_track_list tracks;
+
+  if ( next != m_snapshot.end() )
+    model_snapshot_tweener::compute_tracks
+      ( *it->second, *next->second, *this, *this, tracks );
+
+  it->second->set_tracks(tracks);
+} // model_action::compile_tracks()
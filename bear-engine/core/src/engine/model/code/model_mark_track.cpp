@@ -0,0 +1,62 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::engine::model_mark_track class.
+ * \author Julien Jorge
+ */
+#include "engine/model/model_mark_track.hpp"
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param mark_id The index of the mark in the action.
+ * \param v The interpolated value.
+ * \param origin The value at the beginning of the track.
+ * \param target The value at the end of the track.
+ * \param easing The easing function applied to the value.
+ */
+bear::engine::model_mark_track::model_mark_track
+( std::size_t mark_id, value_type v, double origin, double target,
+  const easing_function& easing )
+  : m_mark_id(mark_id), m_value(v), m_origin(origin),
+    m_delta(target - origin), m_easing(easing)
+{
+
+} // model_mark_track::model_mark_track()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the index of the mark whose value is interpolated.
+ */
+std::size_t bear::engine::model_mark_track::get_mark_id() const
+{
+  return m_mark_id;
+} // model_mark_track::get_mark_id()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the interpolated value in a placement.
+ * \param m The placement to update.
+ * \param ratio The progression in the track, in [0, 1].
+ */
+void bear::engine::model_mark_track::apply
+( model_mark_placement& m, double ratio ) const
+{
+  const double v( m_origin + m_easing(ratio) * m_delta );
+
+  switch ( m_value )
+    {
+    case angle_value: m.set_angle(v); break;
+    case x_value: m.set_x_position(v); break;
+    case y_value: m.set_y_position(v); break;
+    case width_value: m.set_width(v); break;
+    case height_value: m.set_height(v); break;
+    }
+} // model_mark_track::apply()
@@ -115,6 +115,28 @@ std::size_t bear::engine::model_snapshot::get_mark_placements_count() const
   return m_placement.size();
 } // model_snapshot::get_mark_placements_count()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the tracks interpolating the marks up to the next snapshot of the
+ *        action.
+ */
+const bear::engine::model_snapshot::mark_track_list&
+bear::engine::model_snapshot::get_tracks() const
+{
+  return m_tracks;
+} // model_snapshot::get_tracks()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the tracks interpolating the marks up to the next snapshot of the
+ *        action.
+ * \param tracks The tracks.
+ */
+void bear::engine::model_snapshot::set_tracks( const mark_track_list& tracks )
+{
+  m_tracks = tracks;
+} // model_snapshot::set_tracks()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the function to call when passing on the snapshot.
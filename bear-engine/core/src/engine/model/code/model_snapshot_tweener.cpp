@@ -14,60 +14,51 @@
 #include "engine/model/model_snapshot_tweener.hpp"
 
 #include "engine/model/model_action.hpp"
-#include "engine/model/model_mark_placement.hpp"
-#include "engine/model/model_snapshot.hpp"
-
-#include <boost/bind/bind.hpp>
-
-using namespace boost::placeholders;
 
+#include <algorithm>
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Constructor.
- * \param init The initial positions of the marks.
- * \remark This constructor can be use when there is no target snapshot.
+ * \brief Constructor. There is no mark.
  */
-bear::engine::model_snapshot_tweener::model_snapshot_tweener
-( const model_snapshot& init )
+bear::engine::model_snapshot_tweener::model_snapshot_tweener()
+  : m_tracks(NULL), m_date(0), m_duration(0)
 {
-  m_placement.resize(init.get_mark_placements_count());
 
-  for ( std::size_t i=0; i!=m_placement.size(); ++i )
-    m_placement[i] = init.get_mark_placement(i);
 } // model_snapshot_tweener::model_snapshot_tweener()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Constructor.
+ * \brief Place the marks as in a snapshot, without interpolation.
+ * \param init The positions of the marks.
+ * \remark This method can be used when there is no target snapshot.
+ */
+void bear::engine::model_snapshot_tweener::reset( const model_snapshot& init )
+{
+  m_placement.assign( init.mark_placement_begin(), init.mark_placement_end() );
+  m_tracks = NULL;
+  m_date = 0;
+  m_duration = 0;
+} // model_snapshot_tweener::reset()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Place the marks as in a snapshot and start the interpolation toward
+ *        an other placement.
  * \param init The initial positions of the marks.
- * \param end The final positions of the marks.
- * \param start_action The action from which init was taken.
- * \param end_action The action from which end was taken.
+ * \param tracks The tracks interpolating the marks. They must remain valid
+ *        until the next reset.
  * \param d The duration of the movement.
  */
-bear::engine::model_snapshot_tweener::model_snapshot_tweener
-( const model_snapshot& init, const model_snapshot& end,
-  const model_action& init_action, const model_action& end_action,
+void bear::engine::model_snapshot_tweener::reset
+( const model_snapshot& init, const model_snapshot::mark_track_list& tracks,
   universe::time_type d )
 {
-  m_placement.resize(init.get_mark_placements_count());
-
-  for ( std::size_t i=0; i!=m_placement.size(); ++i )
-    {
-      m_placement[i] = init.get_mark_placement(i);
-
-      const std::size_t end_id
-      ( end_action.get_mark_id(init_action.get_mark(i).get_label()) );
-
-      if ( end_id != model_action::not_an_id )
-        {
-          const model_mark_placement end_mark =
-              get_mark_in_local_coordinates(init, end, end_id);
-          insert_tweener( i, end_mark, d );
-        }
-    }
-} // model_snapshot_tweener::model_snapshot_tweener()
+  m_placement.assign( init.mark_placement_begin(), init.mark_placement_end() );
+  m_tracks = &tracks;
+  m_date = 0;
+  m_duration = d;
+} // model_snapshot_tweener::reset()
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -113,15 +104,61 @@ bear::engine::model_snapshot_tweener::mark_placement_end() const
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Update the tweeners for a given amount of time.
+ * \brief Update the placements for a given amount of time.
  * \param elapsed_time The duration of the update.
  */
 void bear::engine::model_snapshot_tweener::update
 ( universe::time_type elapsed_time )
 {
-  m_tweeners.update(elapsed_time);
+  if ( m_tracks == NULL )
+    return;
+
+  m_date = std::min( m_date + elapsed_time, m_duration );
+
+  double ratio(1);
+
+  if ( m_duration > 0 )
+    ratio = m_date / m_duration;
+
+  for ( model_snapshot::mark_track_list::const_iterator it=m_tracks->begin();
+        it!=m_tracks->end(); ++it )
+    it->apply( m_placement[ it->get_mark_id() ], ratio );
+
+  // Once the tracks are done, the placements can be changed by the model
+  // without being overwritten.
+  if ( m_date == m_duration )
+    m_tracks = NULL;
 } // model_snapshot_tweener::update()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compute the tracks interpolating the marks of a snapshot toward the
+ *        marks of an other snapshot.
+ * \param init The initial positions of the marks.
+ * \param end The final positions of the marks.
+ * \param init_action The action from which init was taken.
+ * \param end_action The action from which end was taken.
+ * \param tracks (out) The tracks. The previous content is removed.
+ */
+void bear::engine::model_snapshot_tweener::compute_tracks
+( const model_snapshot& init, const model_snapshot& end,
+  const model_action& init_action, const model_action& end_action,
+  model_snapshot::mark_track_list& tracks )
+{
+  tracks.clear();
+
+  for ( std::size_t i=0; i!=init.get_mark_placements_count(); ++i )
+    {
+      const std::size_t end_id
+      ( end_action.get_mark_id(init_action.get_mark(i).get_label()) );
+
+      if ( end_id != model_action::not_an_id )
+        add_tracks
+          ( i, init.get_mark_placement(i),
+            get_mark_in_local_coordinates(init, end, end_id), tracks );
+    }
+} // model_snapshot_tweener::compute_tracks()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get a mark placement from the target snapshot in the coordinates of
@@ -133,7 +170,7 @@ void bear::engine::model_snapshot_tweener::update
 bear::engine::model_mark_placement
 bear::engine::model_snapshot_tweener::get_mark_in_local_coordinates
 ( const model_snapshot& init, const model_snapshot& end,
-    std::size_t id ) const
+    std::size_t id )
 {
   bear::universe::coordinate_type dx = end.get_x_alignment_value();
   bear::universe::coordinate_type dy = end.get_y_alignment_value();
@@ -173,51 +210,44 @@ bear::engine::model_snapshot_tweener::get_mark_in_local_coordinates
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Create a tweener to move a given mark placement to reach an other
+ * \brief Create the tracks to move a given mark placement to reach an other
  *        placement.
- * \param id The identifier of the mark to tween.
+ * \param id The identifier of the mark to interpolate.
+ * \param init The mark placement at the initial position.
  * \param end The mark placement at the final position.
- * \param d The duration of the movement.
+ * \param tracks (out) The list in which the tracks are added.
  */
-void bear::engine::model_snapshot_tweener::insert_tweener
-( std::size_t id, const model_mark_placement& end, universe::time_type d )
+void bear::engine::model_snapshot_tweener::add_tracks
+( std::size_t id, const model_mark_placement& init,
+  const model_mark_placement& end, model_snapshot::mark_track_list& tracks )
 {
-  if ( m_placement[id].get_angle() != end.get_angle() )
-    m_tweeners.insert
-      ( claw::tween::single_tweener
-        (m_placement[id].get_angle(), end.get_angle(), d,
-         boost::bind( &model_mark_placement::set_angle, &m_placement[id], _1 ),
-         m_placement[id].get_angle_easing() ) );
-
-  if ( m_placement[id].get_position().x != end.get_position().x )
-    m_tweeners.insert
-      ( claw::tween::single_tweener
-        (m_placement[id].get_position().x, end.get_position().x, d,
-         boost::bind
-         ( &model_mark_placement::set_x_position, &m_placement[id], _1 ),
-         m_placement[id].get_x_position_easing() ) );
-
-  if ( m_placement[id].get_position().y != end.get_position().y )
-    m_tweeners.insert
-      ( claw::tween::single_tweener
-        (m_placement[id].get_position().y, end.get_position().y, d,
-         boost::bind
-         ( &model_mark_placement::set_y_position, &m_placement[id], _1 ),
-         m_placement[id].get_y_position_easing() ) );
-
-  if ( m_placement[id].get_size().x != end.get_size().x )
-    m_tweeners.insert
-      ( claw::tween::single_tweener
-        (m_placement[id].get_size().x, end.get_size().x, d,
-         boost::bind
-         ( &model_mark_placement::set_width, &m_placement[id], _1 ),
-         m_placement[id].get_width_easing() ) );
-
-  if ( m_placement[id].get_size().y != end.get_size().y )
-    m_tweeners.insert
-      ( claw::tween::single_tweener
-        (m_placement[id].get_size().y, end.get_size().y, d,
-         boost::bind
-         ( &model_mark_placement::set_height, &m_placement[id], _1 ),
-         m_placement[id].get_height_easing() ) );
-} // model_snapshot_tweener::insert_tweener()
+  if ( init.get_angle() != end.get_angle() )
+    tracks.push_back
+      ( model_mark_track
+        ( id, model_mark_track::angle_value, init.get_angle(),
+          end.get_angle(), init.get_angle_easing() ) );
+
+  if ( init.get_position().x != end.get_position().x )
+    tracks.push_back
+      ( model_mark_track
+        ( id, model_mark_track::x_value, init.get_position().x,
+          end.get_position().x, init.get_x_position_easing() ) );
+
+  if ( init.get_position().y != end.get_position().y )
+    tracks.push_back
+      ( model_mark_track
+        ( id, model_mark_track::y_value, init.get_position().y,
+          end.get_position().y, init.get_y_position_easing() ) );
+
+  if ( init.get_size().x != end.get_size().x )
+    tracks.push_back
+      ( model_mark_track
+        ( id, model_mark_track::width_value, init.get_size().x,
+          end.get_size().x, init.get_width_easing() ) );
+
+  if ( init.get_size().y != end.get_size().y )
+    tracks.push_back
+      ( model_mark_track
+        ( id, model_mark_track::height_value, init.get_size().y,
+          end.get_size().y, init.get_height_easing() ) );
+} // model_snapshot_tweener::add_tracks()
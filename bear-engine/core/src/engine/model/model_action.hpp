@@ -83,6 +83,7 @@ namespace bear
 
       universe::time_type get_duration() const;
       void add_snapshot( const model_snapshot& s );
+      void compile_tracks();
 
       const_snapshot_iterator get_snapshot_at( universe::time_type t ) const;
       const_snapshot_iterator snapshot_begin() const;
@@ -107,6 +108,8 @@ namespace bear
       snapshot_map::const_iterator
         get_snapshot_const_iterator_at( universe::time_type t ) const;
 
+      void compile_tracks( snapshot_map::iterator it );
+
     public:
       /** \brief An invalid mark identifier. */
       static const std::size_t not_an_id;
@@ -0,0 +1,77 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The interpolation of a value of a mark between two snapshots.
+ * \author Julien Jorge
+ */
+#ifndef __ENGINE_MODEL_MARK_TRACK_HPP__
+#define __ENGINE_MODEL_MARK_TRACK_HPP__
+
+#include "engine/model/model_mark_placement.hpp"
+#include "engine/class_export.hpp"
+
+namespace bear
+{
+  namespace engine
+  {
+    /**
+     * \brief The interpolation of a value of a mark between two snapshots.
+     *
+     * The tracks are computed when the snapshots are added in the actions,
+     * thus the progression of a model only evaluates their easing functions.
+     *
+     * \author Julien Jorge
+     */
+    class ENGINE_EXPORT model_mark_track
+    {
+    public:
+      /** \brief The values of the placement that can be interpolated. */
+      enum value_type
+        {
+          angle_value,
+          x_value,
+          y_value,
+          width_value,
+          height_value
+        }; // enum value_type
+
+      /** \brief The type of the easing functions. */
+      typedef model_mark_placement::easing_function easing_function;
+
+    public:
+      model_mark_track
+      ( std::size_t mark_id, value_type v, double origin, double target,
+        const easing_function& easing );
+
+      std::size_t get_mark_id() const;
+      void apply( model_mark_placement& m, double ratio ) const;
+
+    private:
+      /** \brief The index of the mark in the action. */
+      std::size_t m_mark_id;
+
+      /** \brief The interpolated value. */
+      value_type m_value;
+
+      /** \brief The value at the beginning of the track. */
+      double m_origin;
+
+      /** \brief The difference between the final value and the initial
+          value. */
+      double m_delta;
+
+      /** \brief The easing function applied to the value. */
+      easing_function m_easing;
+
+    }; // class model_mark_track
+  } // namespace engine
+} // namespace bear
+
+#endif // __ENGINE_MODEL_MARK_TRACK_HPP__
@@ -15,6 +15,7 @@
 #define __ENGINE_MODEL_SNAPSHOT_HPP__
 
 #include "engine/model/model_mark_placement.hpp"
+#include "engine/model/model_mark_track.hpp"
 #include "engine/class_export.hpp"
 
 #include <vector>
@@ -34,6 +35,10 @@ namespace bear
       typedef std::vector<model_mark_placement>::const_iterator
       const_mark_placement_iterator;
 
+      /** \brief The type of the list of the tracks interpolating the marks
+          up to the next snapshot. */
+      typedef std::vector<model_mark_track> mark_track_list;
+
       /** \brief How to align the action, horizontally, with the previous
           action. */
       struct horizontal_alignment
@@ -73,6 +78,9 @@ namespace bear
       const model_mark_placement& get_mark_placement( std::size_t i ) const;
       std::size_t get_mark_placements_count() const;
 
+      const mark_track_list& get_tracks() const;
+      void set_tracks( const mark_track_list& tracks );
+
       std::string get_function() const;
       std::string get_random_sound_name() const;
       bool sound_is_global() const;
@@ -101,6 +109,10 @@ namespace bear
       /** \brief The placement of the marks in this snapshot. */
       std::vector<model_mark_placement> m_placement;
 
+      /** \brief The tracks interpolating the marks from this snapshot to the
+          next snapshot of the action. */
+      mark_track_list m_tracks;
+
       /** \brief The name of a function to call when passing on this
           snapshot. */
       std::string m_function;
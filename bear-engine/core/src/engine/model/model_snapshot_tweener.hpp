@@ -17,8 +17,7 @@
 
 #include "universe/types.hpp"
 #include "engine/class_export.hpp"
-
-#include <claw/tween/tweener_group.hpp>
+#include "engine/model/model_snapshot.hpp"
 
 #include <vector>
 
@@ -27,12 +26,15 @@ namespace bear
   namespace engine
   {
     class model_action;
-    class model_mark_placement;
-    class model_snapshot;
 
     /**
      * \brief A structure that manages all the values that can be interpolated
      *        in a snapshot.
+     *
+     * The placements of the marks are kept in a buffer reused from a snapshot
+     * to the next one, and are interpolated with the tracks precomputed in
+     * the snapshots.
+     *
      * \author Julien Jorge
      */
     class ENGINE_EXPORT model_snapshot_tweener
@@ -42,10 +44,12 @@ namespace bear
       const_mark_placement_iterator;
 
     public:
-      explicit model_snapshot_tweener( const model_snapshot& init );
-      model_snapshot_tweener
-      ( const model_snapshot& init, const model_snapshot& end,
-        const model_action& init_action, const model_action& end_action,
+      model_snapshot_tweener();
+
+      void reset( const model_snapshot& init );
+      void reset
+      ( const model_snapshot& init,
+        const model_snapshot::mark_track_list& tracks,
         universe::time_type d );
 
       model_mark_placement& get_mark_placement( std::size_t i );
@@ -56,14 +60,20 @@ namespace bear
 
       void update( universe::time_type elapsed_time );
 
+      static void compute_tracks
+      ( const model_snapshot& init, const model_snapshot& end,
+        const model_action& init_action, const model_action& end_action,
+        model_snapshot::mark_track_list& tracks );
+
     private:
-      model_mark_placement get_mark_in_local_coordinates
+      static model_mark_placement get_mark_in_local_coordinates
       ( const model_snapshot& init, const model_snapshot& end,
-          std::size_t id ) const;
+          std::size_t id );
 
-      void insert_tweener
-      ( std::size_t id, const model_mark_placement& end,
-        universe::time_type d );
+      static void add_tracks
+      ( std::size_t id, const model_mark_placement& init,
+        const model_mark_placement& end,
+        model_snapshot::mark_track_list& tracks );
 
       // not implemented
       model_snapshot_tweener( const model_snapshot_tweener& that );
@@ -73,8 +83,14 @@ namespace bear
       /** \brief The placement of the marks in this snapshot. */
       std::vector<model_mark_placement> m_placement;
 
-      /** \brief The tweeners for the values of the mark placements. */
-      claw::tween::tweener_group m_tweeners;
+      /** \brief The tracks interpolating the placements. */
+      const model_snapshot::mark_track_list* m_tracks;
+
+      /** \brief The time elapsed since the beginning of the tracks. */
+      universe::time_type m_date;
+
+      /** \brief The duration of the tracks. */
+      universe::time_type m_duration;
 
     }; // class model_snapshot_tweener
 
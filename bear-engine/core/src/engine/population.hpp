@@ -14,11 +14,11 @@
 #ifndef __ENGINE_POPULATION_HPP__
 #define __ENGINE_POPULATION_HPP__
 
-#include <map>
-#include <set>
-#include <claw/functional.hpp>
+#include <unordered_map>
+#include <vector>
 #include <claw/iterator.hpp>
 
+#include "concept/slot_map.hpp"
 #include "engine/base_item.hpp"
 #include "engine/class_export.hpp"
 
@@ -28,22 +28,66 @@ namespace bear
   {
     /**
      * \brief All the items of a level.
+     *
+     * The items are stored in a slot map, thus they are inserted, killed,
+     * dropped and found in constant time, and the handle of an item is never
+     * reused for another item. The identifiers of the items are never reused
+     * either, thus exists() returns false for the identifier of an item
+     * removed from the population even after the insertion of other items.
+     *
      * \author Julien Jorge
      */
     class ENGINE_EXPORT population
     {
     private:
-      /** brief The type of the map containing the items. */
-      typedef std::map<base_item::id_type, base_item*> item_map;
+      /** \brief The states of the items in the population. */
+      enum item_state
+        {
+          /** \brief The item is alive. */
+          state_alive,
+
+          /** \brief The item will be deleted by remove_dead_items(). */
+          state_dead,
+
+          /** \brief The item will be removed by remove_dead_items(). */
+          state_dropped
+        }; // enum item_state
+
+      /** \brief An item in the population. */
+      struct entry
+      {
+        /** \brief The item. */
+        base_item* item;
+
+        /** \brief The identifier of the item, kept since a dropped item may
+            be deleted before its removal from the population. */
+        base_item::id_type id;
+
+        /** \brief The state of the item. */
+        item_state state;
+
+      }; // struct entry
+
+      /** \brief Gets the item of an entry. */
+      struct entry_item
+      {
+        base_item& operator()( const entry& e ) const { return *e.item; }
+      }; // struct entry_item
+
+      /** \brief The type of the container of the items. */
+      typedef concept::slot_map<entry> item_map;
+
+      /** \brief The type of the handles of the items in the container. */
+      typedef item_map::handle handle_type;
+
+      /** \brief The type of the map associating the identifiers of the items
+          with their handles. */
+      typedef std::unordered_map<base_item::id_type, handle_type> handle_map;
 
     public:
       /** \brief Iterator on the living items. */
       typedef claw::wrapped_iterator
-        < base_item,
-          item_map::const_iterator,
-          claw::unary_compose
-          < claw::dereference<base_item>,
-            claw::const_pair_second<item_map::value_type> > >
+        < base_item, item_map::const_iterator, entry_item >
       ::iterator_type const_iterator;
 
     public:
@@ -61,17 +105,23 @@ namespace bear
       const_iterator begin() const;
       const_iterator end() const;
 
+    private:
+      entry* find( base_item::id_type id );
+
     private:
       /** \brief All items currently in the game. */
       item_map m_items;
 
+      /** \brief The handles of the items, by identifier. */
+      handle_map m_handles;
+
       /** \brief The items that will be deleted by calling
           remove_dead_items(). */
-      std::set<base_item::id_type> m_dead_items;
+      std::vector<handle_type> m_dead_items;
 
       /** \brief The items that will be removed by calling
           remove_dead_items(). */
-      std::set<base_item::id_type> m_dropped_items;
+      std::vector<handle_type> m_dropped_items;
 
     }; // class population
   } // namespace engine
@@ -0,0 +1,196 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The resource cache keeps the decoded resources across the levels.
+ * \author Julien Jorge
+ */
+#ifndef __ENGINE_RESOURCE_CACHE_HPP__
+#define __ENGINE_RESOURCE_CACHE_HPP__
+
+#include "audio/sound_manager.hpp"
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <claw/basic_singleton.hpp>
+
+#include "engine/class_export.hpp"
+
+namespace bear
+{
+  namespace visual
+  {
+    class animation;
+    class bitmap_charmap;
+    class font_manager;
+    class image;
+    class image_manager;
+    class true_type_memory_file;
+  } // namespace visual
+
+  namespace engine
+  {
+    class model_actor;
+
+    /**
+     * \brief The resource cache keeps the decoded resources across the
+     *        levels.
+     *
+     * The level_globals look for the resources in the cache before decoding
+     * their files, and add the resources they decode. Each level_globals
+     * holds a reference on the entries it uses and releases them when it is
+     * destroyed. The entries without reference are kept until the size of
+     * the resources in the cache exceeds the budget, then the least recently
+     * used are removed first.
+     *
+     * The models, the animations and the fonts are stored with the keys of
+     * the resources they use, like the images of their sprites or the sounds
+     * of the models. These resources are referenced by the entry while they
+     * are in the cache and must be loaded by the level_globals which takes
+     * the entry.
+     *
+     * \author Julien Jorge
+     */
+    class ENGINE_EXPORT resource_cache :
+      public claw::pattern::basic_singleton<resource_cache>
+    {
+    private:
+      /** \brief The type of the parent class. */
+      typedef claw::pattern::basic_singleton<resource_cache> super;
+
+      class entry;
+
+      template<typename T>
+      class value_entry;
+
+    public:
+      /** \brief The types of the resources stored in the cache. */
+      enum resource_type
+        {
+          image_resource,
+          sound_resource,
+          model_resource,
+          animation_resource,
+          font_resource
+        }; // enum resource_type
+
+      /** \brief The type of the key identifying an entry of the cache. */
+      typedef std::pair<resource_type, std::string> key_type;
+
+      /** \brief The type of the list of the resources used by a
+          resource. */
+      typedef std::vector<key_type> dependency_list;
+
+    private:
+      /** \brief The type of the map storing the entries. */
+      typedef std::map<key_type, entry*> entry_map;
+
+      /** \brief The type of the list of the entries without reference, from
+          the least recently used to the most recently used. */
+      typedef std::list<key_type> key_list;
+
+    public:
+      // Must be redefined to work correctly with dynamic libraries.
+      // At least under Windows with MinGW.
+      static resource_cache& get_instance();
+
+      resource_cache();
+      ~resource_cache();
+
+      void clear();
+      void clear_unused();
+
+      void set_budget( std::size_t bytes );
+      std::size_t get_budget() const;
+
+      std::size_t get_resident_size() const;
+      std::size_t get_entry_count() const;
+      std::size_t get_hit_count() const;
+      std::size_t get_miss_count() const;
+
+      bool find_image
+      ( const std::string& name, visual::image_manager& target );
+      void add_image( const std::string& name, const visual::image& img );
+
+      bool find_sound
+      ( const std::string& name, audio::sound_manager& target );
+      void keep_sound
+      ( const std::string& name, const audio::sound_manager& source );
+
+      bool find_model
+      ( const std::string& name, model_actor& m, dependency_list& deps );
+      void add_model
+      ( const std::string& name, const model_actor& m,
+        const dependency_list& deps );
+
+      bool find_animation
+      ( const std::string& name, visual::animation& anim,
+        dependency_list& deps );
+      void add_animation
+      ( const std::string& name, const visual::animation& anim,
+        const dependency_list& deps );
+
+      bool find_font
+      ( const std::string& name, visual::font_manager& target,
+        dependency_list& deps );
+      void add_font
+      ( const std::string& name, const visual::bitmap_charmap& m,
+        const dependency_list& deps );
+      void add_font
+      ( const std::string& name, const visual::true_type_memory_file& f );
+
+      void release( const key_type& key );
+
+    private:
+      const entry* find( const key_type& key );
+
+      template<typename T>
+      void insert
+      ( const key_type& key, const T& value, std::size_t size,
+        const dependency_list& deps );
+
+      void insert( const key_type& key, entry* e );
+      void acquire( const key_type& key );
+      void unreference( const key_type& key );
+      void erase( const key_type& key );
+      void trim();
+
+    private:
+      /** \brief The entries of the cache. */
+      entry_map m_entries;
+
+      /** \brief The entries without reference, from the least recently used
+          to the most recently used. */
+      key_list m_unused;
+
+      /** \brief The sounds of the cache. */
+      audio::sound_manager m_sounds;
+
+      /** \brief The size of the resources of the cache, in bytes. */
+      std::size_t m_resident_size;
+
+      /** \brief The maximum size of the resources of the cache, in bytes. The
+          entries without reference are removed to stay under this size. */
+      std::size_t m_budget;
+
+      /** \brief How many resources have been found in the cache. */
+      std::size_t m_hit_count;
+
+      /** \brief How many resources have been searched and not found in the
+          cache. */
+      std::size_t m_miss_count;
+
+    }; // class resource_cache
+  } // namespace engine
+} // namespace bear
+
+#endif // __ENGINE_RESOURCE_CACHE_HPP__
@@ -0,0 +1,195 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The container in which the visuals of the items are collected.
+ * \author Julien Jorge
+ */
+#ifndef __ENGINE_SCENE_VISUAL_SINK_HPP__
+#define __ENGINE_SCENE_VISUAL_SINK_HPP__
+
+#include "engine/scene_visual.hpp"
+
+#include "engine/class_export.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace bear
+{
+  namespace engine
+  {
+    /**
+     * \brief The container in which the visuals of the items are collected.
+     *
+     * The visuals are stored in a vector and never move until the sink is
+     * cleared. The order of the visuals is kept in a separate vector of small
+     * entries, which is the one modified by push_front() and sort(). The
+     * entries of the visuals pushed in front of the sink, out of a group, are
+     * kept aside and moved in front of the others in a single pass, when the
+     * visuals are sorted or iterated, such that a loop on push_front() is not
+     * quadratic. Clearing the sink keeps the memory of the vectors, thus a
+     * sink reused from a frame to the next one does not allocate anything
+     * once it has grown to the size of a frame.
+     *
+     * The visuals of an item are inserted in a group: they are sorted among
+     * themselves by their own z-position but they are displayed together, at
+     * the z-position of the group.
+     *
+     * \author Julien Jorge
+     */
+    class ENGINE_EXPORT scene_visual_sink
+    {
+    private:
+      /** \brief The type of the vector storing the visuals. */
+      typedef std::vector<scene_visual> visual_list;
+
+      /**
+       * \brief The position of a visual in the sink.
+       */
+      struct entry
+      {
+        /** \brief The z-position of the visual, or of its group. */
+        int z;
+
+        /** \brief The z-position of the visual in its group. */
+        int inner_z;
+
+        /** \brief The identifier of the group of the visual, zero if the
+            visual is not in a group. */
+        std::size_t group;
+
+        /** \brief The position of the first visual of the group, computed
+            when sorting. */
+        std::size_t first;
+
+        /** \brief The position of the visual, computed when sorting. */
+        std::size_t position;
+
+        /** \brief The index of the visual in m_visuals. */
+        std::size_t index;
+
+      }; // struct entry
+
+      /** \brief The type of the vector storing the order of the visuals. */
+      typedef std::vector<entry> entry_list;
+
+      /** \brief Compares the entries on the z-position of the visuals. */
+      struct z_position_compare
+      {
+        bool operator()( const entry& a, const entry& b ) const;
+      }; // struct z_position_compare
+
+    public:
+      /**
+       * \brief An iterator on the visuals, in the order of the sink.
+       *
+       * \b Template \b parameters:
+       * - \a Value The type of the visuals seen through the iterator,
+       * - \a Storage The type of the vector of the visuals.
+       */
+      template<typename Value, typename Storage>
+      class basic_iterator
+      {
+      public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Value value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value* pointer;
+        typedef Value& reference;
+
+      public:
+        basic_iterator( entry_list::const_iterator it, Storage& visuals );
+
+        reference operator*() const;
+        pointer operator->() const;
+
+        basic_iterator& operator++();
+        basic_iterator operator++(int);
+
+        bool operator==( const basic_iterator& that ) const;
+        bool operator!=( const basic_iterator& that ) const;
+
+      private:
+        /** \brief The entry of the visual. */
+        entry_list::const_iterator m_iterator;
+
+        /** \brief The visuals of the sink. */
+        Storage* m_visuals;
+
+      }; // class basic_iterator
+
+      /** \brief Iterator on the visuals. */
+      typedef basic_iterator<scene_visual, visual_list> iterator;
+
+      /** \brief Iterator on the constant visuals. */
+      typedef basic_iterator<const scene_visual, const visual_list>
+      const_iterator;
+
+    public:
+      scene_visual_sink();
+
+      void push_back( scene_visual v );
+      void push_front( scene_visual v );
+
+      void begin_group( int z );
+      void end_group();
+
+      std::size_t get_insertion_count() const;
+      scene_visual& get_inserted_visual( std::size_t i );
+
+      void sort();
+      void clear();
+
+      bool empty() const;
+      std::size_t size() const;
+
+      iterator begin();
+      iterator end();
+      const_iterator begin() const;
+      const_iterator end() const;
+
+    private:
+      entry make_entry( int z ) const;
+      void move_front_entries() const;
+
+    private:
+      /** \brief The visuals, in the order of their insertion. */
+      visual_list m_visuals;
+
+      /** \brief The order of the visuals. */
+      mutable entry_list m_entries;
+
+      /** \brief The entries of the visuals pushed in front of the sink, out of
+          a group, not moved in m_entries yet. The last one is the first
+          visual of the sink. */
+      mutable entry_list m_front_entries;
+
+      /** \brief The identifier of the group receiving the visuals, zero if
+          there is no such group. */
+      std::size_t m_group;
+
+      /** \brief The z-position of the group receiving the visuals. */
+      int m_group_z;
+
+      /** \brief The position in m_entries of the first visual of the group
+          receiving the visuals. */
+      std::size_t m_group_first;
+
+      /** \brief The identifier of the last group. */
+      std::size_t m_last_group;
+
+    }; // class scene_visual_sink
+  } // namespace engine
+} // namespace bear
+
+#include "engine/impl/scene_visual_sink.tpp"
+
+#endif // __ENGINE_SCENE_VISUAL_SINK_HPP__
@@ -0,0 +1,88 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A class that measures the duration of the iterations of the game.
+ * \author Julien Jorge
+ */
+#ifndef __ENGINE_STEP_REPORT_HPP__
+#define __ENGINE_STEP_REPORT_HPP__
+
+#include "engine/class_export.hpp"
+#include "time/time.hpp"
+
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace bear
+{
+  namespace engine
+  {
+    /**
+     * \brief A class that measures the duration of the iterations of the
+     *        game.
+     *
+     * The durations of the progresses and of the renders are kept separately,
+     * such that the report gives their distributions along with the ratio of
+     * the simulated time to the real time.
+     *
+     * \author Julien Jorge
+     */
+    class ENGINE_EXPORT step_report
+    {
+    public:
+      /** \brief The clock used to measure the durations. */
+      typedef std::chrono::steady_clock clock_type;
+
+      /** \brief The type of the list of the measured durations, in
+          milliseconds. */
+      typedef std::vector<double> duration_list;
+
+    public:
+      explicit step_report( systime::milliseconds_type time_step );
+
+      void start();
+
+      void start_progress();
+      void stop_progress();
+
+      void start_render();
+      void stop_render();
+
+      void output( std::ostream& os ) const;
+
+    private:
+      double get_elapsed_time() const;
+
+      static void output_durations
+      ( std::ostream& os, const std::string& name, duration_list d );
+
+    private:
+      /** \brief The duration of the time step of the simulation. */
+      const systime::milliseconds_type m_time_step;
+
+      /** \brief The date at which the measures started. */
+      clock_type::time_point m_start_date;
+
+      /** \brief The date at which the current measure started. */
+      clock_type::time_point m_measure_date;
+
+      /** \brief The durations of the progresses. */
+      duration_list m_progress;
+
+      /** \brief The durations of the renders. */
+      duration_list m_render;
+
+    }; // class step_report
+  } // namespace engine
+} // namespace bear
+
+#endif // __ENGINE_STEP_REPORT_HPP__
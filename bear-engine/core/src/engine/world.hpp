@@ -17,7 +17,7 @@
 #include "universe/world.hpp"
 #include "engine/class_export.hpp"
 #include "engine/population.hpp"
-#include "engine/scene_visual.hpp"
+#include "engine/scene_visual_sink.hpp"
 
 #include <list>
 
@@ -47,7 +47,7 @@ namespace bear
       ( const region_type& regions, universe::time_type elapsed_time );
 
       void get_visual
-      ( std::list<scene_visual>& visuals,
+      ( scene_visual_sink& visuals,
         const universe::rectangle_type& camera_box ) const;
 
       const_item_iterator living_items_begin() const;
@@ -15,65 +15,49 @@
 
 #include "net/message/message.hpp"
 
+#include <sstream>
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
  * \param port The port on which the server listens.
- * \param client_read_time_limit How long do we wait when asking a client for
- *        its content.
  */
-bear::net::server::server( unsigned int port, int client_read_time_limit )
-  : m_server(port), m_client_read_time_limit(client_read_time_limit)
+bear::net::server::server( unsigned int port )
+  : m_core(port)
 {
 
 } // server::server()
 
-/*----------------------------------------------------------------------------*/
-/**
- * \brief Destructor.
- */
-bear::net::server::~server()
-{
-  for ( client_list::const_iterator it=m_clients.begin(); it!=m_clients.end();
-        ++it )
-    delete *it;
-} // server::~server()
-
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the number of connections to which this server sends the messages.
  */
 std::size_t bear::net::server::get_connection_count() const
 {
-  return m_clients.size();
+  return m_core.get_client_count();
 } // server::get_connection_count()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Dispatch a message to the clients.
+ * \brief Dispatch a message to the clients. The message is serialized once for
+ *        all the clients.
  * \param m The message to dispatch.
  */
 void bear::net::server::dispatch_message( const message& m )
 {
-  for ( std::size_t i=0; i!=get_connection_count(); ++i )
-    send_message( i, m );
+  m_core.broadcast( serialize(m) );
 } // server::dispatch_message()
       
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Send a message to one client.
+ * \brief Send a message to one client. Nothing is sent if the client has
+ *        closed its connection.
  * \param client_id The identifier of the client to which the message is sent.
  * \param m The message to send.
  */
 void bear::net::server::send_message( std::size_t client_id, const message& m )
 {
-  CLAW_PRECOND( client_id < m_clients.size() );
-
-  client_list::const_iterator it=m_clients.begin();
-  std::advance(it, client_id);
-
-  client_type& client = **it;
-  client << m.get_name() << '\n' << m << std::endl;
+  m_core.send( client_id, serialize(m) );
 } // server::send_message()
       
 /*----------------------------------------------------------------------------*/
@@ -82,21 +66,24 @@ void bear::net::server::send_message( std::size_t client_id, const message& m )
  */
 void bear::net::server::check_for_new_clients()
 {
-  bool check_client = true;
-  while (check_client)
-    {
-      client_pointer c = new client_type(m_client_read_time_limit);
-      m_server.accept( *c, 0 );
+  std::vector<std::size_t> ids;
+  m_core.accept_clients( ids );
 
-      if ( c->is_open() )
-        {
-          m_clients.push_back(c);
-          on_new_client(m_clients.size() - 1);
-        }
-      else
-        {
-          delete c;
-          check_client = false;
-        }
-    }
+  for ( std::size_t i=0; i!=ids.size(); ++i )
+    on_new_client( ids[i] );
 } // server::check_for_new_clients()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Builds the data sent to the clients for a message: its name on a
+ *        line followed by its formatted content and a new line.
+ * \param m The message.
+ */
+bear::net::server_core::buffer_type
+bear::net::server::serialize( const message& m )
+{
+  std::ostringstream oss;
+  oss << m.get_name() << '\n' << m << '\n';
+
+  return std::make_shared<const std::string>( oss.str() );
+} // server::serialize()
@@ -0,0 +1,180 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::net::server_core class with the sockets
+ *        of libclaw, for the systems without POSIX sockets.
+ * \author Julien Jorge
+ */
+#include "net/server_core.hpp"
+
+#include <claw/socket_server.hpp>
+#include <claw/socket_stream.hpp>
+
+/**
+ * \brief A connection to a client.
+ */
+class bear::net::server_core::connection
+{
+public:
+  /** \brief The stream in which the data is written. Reading from the stream
+      never waits. */
+  claw::net::socket_stream stream;
+
+public:
+  /**
+   * \brief Constructor.
+   */
+  connection()
+    : stream(0)
+  {
+
+  }
+
+}; // class server_core::connection
+
+
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param port The port on which the clients connect.
+ */
+bear::net::server_core::server_core( unsigned int port )
+  : m_server( new claw::net::socket_server(port) ), m_next_client_id(0)
+{
+
+} // server_core::server_core()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor.
+ */
+bear::net::server_core::~server_core()
+{
+  for ( connection_map::const_iterator it=m_clients.begin();
+        it!=m_clients.end(); ++it )
+    delete it->second;
+
+  delete m_server;
+} // server_core::~server_core()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells if the server is listening for the clients.
+ */
+bool bear::net::server_core::is_open() const
+{
+  return m_server->is_open();
+} // server_core::is_open()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Accepts the pending connections. Their identifiers are greater than
+ *        the ones of the previous clients and follow the order of their
+ *        connection.
+ * \param ids (out) The identifiers of the new clients are appended to this
+ *        vector.
+ */
+void bear::net::server_core::accept_clients( std::vector<std::size_t>& ids )
+{
+  bool check_client = true;
+
+  while (check_client)
+    {
+      connection* const c = new connection;
+      m_server->accept( c->stream, 0 );
+
+      if ( c->stream.is_open() )
+        {
+          m_clients[m_next_client_id] = c;
+          ids.push_back(m_next_client_id);
+          ++m_next_client_id;
+        }
+      else
+        {
+          delete c;
+          check_client = false;
+        }
+    }
+} // server_core::accept_clients()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the count of clients whose connection is still open.
+ */
+std::size_t bear::net::server_core::get_client_count() const
+{
+  return m_clients.size();
+} // server_core::get_client_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the size of the data queued for the clients and not written in
+ *        their sockets yet. The data is written immediately by this
+ *        implementation, thus the result is always zero.
+ */
+std::size_t bear::net::server_core::get_queued_size() const
+{
+  return 0;
+} // server_core::get_queued_size()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Writes some data for a client. Nothing is sent if the connection of
+ *        the client has been closed.
+ * \param client_id The identifier of the client.
+ * \param data The data to send.
+ */
+void bear::net::server_core::send
+( std::size_t client_id, const buffer_type& data )
+{
+  const connection_map::iterator it( m_clients.find(client_id) );
+
+  if ( (it != m_clients.end()) && !write( *it->second, data ) )
+    {
+      delete it->second;
+      m_clients.erase( it );
+    }
+} // server_core::send()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Writes some data for all the clients.
+ * \param data The data to send.
+ */
+void bear::net::server_core::broadcast( const buffer_type& data )
+{
+  connection_map::iterator it( m_clients.begin() );
+
+  while ( it != m_clients.end() )
+    if ( write( *it->second, data ) )
+      ++it;
+    else
+      {
+        delete it->second;
+        m_clients.erase( it++ );
+      }
+} // server_core::broadcast()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Writes some data in the stream of a connection.
+ * \param c The connection.
+ * \param data The data to write.
+ * \return false if the connection has failed.
+ */
+bool bear::net::server_core::write( connection& c, const buffer_type& data )
+{
+  c.stream.write( data->data(), data->size() );
+  c.stream.flush();
+
+  return c.stream.good() && c.stream.is_open();
+} // server_core::write()
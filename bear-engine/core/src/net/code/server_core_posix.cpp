@@ -0,0 +1,858 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::net::server_core class with POSIX
+ *        sockets.
+ * \author Julien Jorge
+ */
+#include "net/server_core.hpp"
+
+#include <claw/assert.hpp>
+#include <claw/logger.hpp>
+
+#include <boost/bind.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+namespace bear
+{
+  namespace net
+  {
+    namespace detail
+    {
+      /** \brief The key of the events of the listening socket. */
+      static const std::size_t listener_key = 0;
+
+      /** \brief The key of the events of the pipe waking up the thread. */
+      static const std::size_t wake_key = 1;
+
+      /** \brief The key of the events of the first connection. */
+      static const std::size_t first_connection_key = 2;
+
+      /** \brief The maximum count of buffers written in a single call. */
+      static const std::size_t max_buffers_per_write = 64;
+
+      /** \brief The maximum size of the data queued for a client. A client
+          which does not read its data fast enough is disconnected when its
+          queue gets larger. */
+      static const std::size_t max_queued_size_per_client = 4 * 1024 * 1024;
+
+#ifdef MSG_NOSIGNAL
+      /** \brief The flags passed to sendmsg(). A closed connection must not
+          raise SIGPIPE. */
+      static const int send_flags = MSG_NOSIGNAL;
+#else
+      /** \brief The flags passed to sendmsg(). SIGPIPE is disabled on the
+          sockets instead. */
+      static const int send_flags = 0;
+#endif
+
+      /**
+       * \brief Makes the operations on a descriptor non blocking.
+       * \param descriptor The descriptor.
+       */
+      static bool set_non_blocking( int descriptor )
+      {
+        const int flags( fcntl( descriptor, F_GETFL, 0 ) );
+
+        return (flags != -1)
+          && (fcntl( descriptor, F_SETFL, flags | O_NONBLOCK ) != -1);
+      } // set_non_blocking()
+
+      /**
+       * \brief Tells if the last error of a non blocking operation only means
+       *        that the operation would have blocked.
+       */
+      static bool would_block()
+      {
+        return (errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR);
+      } // would_block()
+    }
+  }
+}
+
+/**
+ * \brief A connection to a client.
+ */
+class bear::net::server_core::connection
+{
+public:
+  /**
+   * \brief Constructor.
+   * \param d The socket of the connection.
+   * \param k The key of the events of the socket.
+   * \param i The identifier of the client.
+   */
+  connection( int d, std::size_t k, std::size_t i )
+    : descriptor(d), key(k), id(i), dirty(false), closed(false),
+      queued_size(0), offset(0), writable(true), sending(false)
+  {
+
+  }
+
+public:
+  /** \brief The socket of the connection. */
+  const int descriptor;
+
+  /** \brief The key of the events of the socket in
+      server_core::m_connections. */
+  const std::size_t key;
+
+  /** \brief The identifier of the client in server_core::m_clients. */
+  const std::size_t id;
+
+  /** \brief The data queued by the server, not seen by the I/O thread
+      yet. Protected by server_core::m_mutex. */
+  std::deque<buffer_type> incoming;
+
+  /** \brief Tells if the connection is in server_core::m_dirty. Protected
+      by server_core::m_mutex. */
+  bool dirty;
+
+  /** \brief Tells if the connection has been closed. Changed by the I/O
+      thread only, with server_core::m_mutex locked. */
+  bool closed;
+
+  /** \brief The data to write in the socket. */
+  std::deque<buffer_type> outgoing;
+
+  /** \brief The size of the data of outgoing not written yet. */
+  std::size_t queued_size;
+
+  /** \brief The size of the part of outgoing.front() already written. */
+  std::size_t offset;
+
+  /** \brief Tells if the socket may accept some data without blocking. */
+  bool writable;
+
+  /** \brief Tells if the connection is in server_core::m_sending. */
+  bool sending;
+
+}; // class server_core::connection
+
+
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param port The port on which the clients connect.
+ */
+bear::net::server_core::server_core( unsigned int port )
+  : m_listener(-1), m_epoll(-1), m_next_key(detail::first_connection_key),
+    m_next_client_id(0), m_queued_size(0), m_released_size(0),
+    m_quit(false), m_thread(NULL)
+{
+  m_wake_pipe[0] = -1;
+  m_wake_pipe[1] = -1;
+
+  open( port );
+
+  if ( m_listener == -1 )
+    return;
+
+  if ( (pipe( m_wake_pipe ) != 0)
+       || !detail::set_non_blocking( m_wake_pipe[0] )
+       || !detail::set_non_blocking( m_wake_pipe[1] ) )
+    {
+      claw::logger << claw::log_error << "server_core: pipe: "
+                   << std::strerror(errno) << std::endl;
+      close_descriptors();
+      return;
+    }
+
+#ifdef __linux__
+  m_epoll = epoll_create1( EPOLL_CLOEXEC );
+
+  if ( m_epoll == -1 )
+    claw::logger << claw::log_warning << "server_core: epoll: "
+                 << std::strerror(errno) << ". Falling back to poll."
+                 << std::endl;
+  else
+    {
+      epoll_event e;
+      e.events = EPOLLIN;
+
+      e.data.u64 = detail::listener_key;
+      epoll_ctl( m_epoll, EPOLL_CTL_ADD, m_listener, &e );
+
+      e.data.u64 = detail::wake_key;
+      epoll_ctl( m_epoll, EPOLL_CTL_ADD, m_wake_pipe[0], &e );
+    }
+#endif
+
+  m_thread = new boost::thread( boost::bind( &server_core::run, this ) );
+} // server_core::server_core()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor. The data not written yet is lost.
+ */
+bear::net::server_core::~server_core()
+{
+  if ( m_thread != NULL )
+    {
+      {
+        boost::mutex::scoped_lock lock( m_mutex );
+        m_quit = true;
+      }
+
+      wake_up();
+      m_thread->join();
+      delete m_thread;
+    }
+
+  for ( connection_map::const_iterator it=m_connections.begin();
+        it!=m_connections.end(); ++it )
+    {
+      close( it->second->descriptor );
+      delete it->second;
+    }
+
+  for ( std::size_t i=0; i!=m_closed.size(); ++i )
+    delete m_closed[i];
+
+  close_descriptors();
+} // server_core::~server_core()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells if the server is listening for the clients.
+ */
+bool bear::net::server_core::is_open() const
+{
+  return m_thread != NULL;
+} // server_core::is_open()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gives to the server the connections accepted since the last call.
+ *        Their identifiers are greater than the ones of the previous clients
+ *        and follow the order of their connection.
+ * \param ids (out) The identifiers of the new clients are appended to this
+ *        vector.
+ */
+void bear::net::server_core::accept_clients( std::vector<std::size_t>& ids )
+{
+  boost::mutex::scoped_lock lock( m_mutex );
+
+  for ( std::size_t i=0; i!=m_accepted.size(); ++i )
+    {
+      m_clients[ m_accepted[i]->id ] = m_accepted[i];
+      ids.push_back( m_accepted[i]->id );
+    }
+
+  m_accepted.clear();
+} // server_core::accept_clients()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the count of clients given to the server whose connection is
+ *        still open.
+ */
+std::size_t bear::net::server_core::get_client_count() const
+{
+  boost::mutex::scoped_lock lock( m_mutex );
+  return m_clients.size();
+} // server_core::get_client_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the size of the data queued for the clients and not written in
+ *        their sockets yet.
+ */
+std::size_t bear::net::server_core::get_queued_size() const
+{
+  boost::mutex::scoped_lock lock( m_mutex );
+  return m_queued_size;
+} // server_core::get_queued_size()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Queues some data for a client. The function returns immediately,
+ *        the data is written by the I/O thread. Nothing is sent if the
+ *        connection of the client has been closed.
+ * \param client_id The identifier of the client.
+ * \param data The data to send.
+ */
+void bear::net::server_core::send
+( std::size_t client_id, const buffer_type& data )
+{
+  bool wake;
+
+  {
+    boost::mutex::scoped_lock lock( m_mutex );
+
+    const connection_map::const_iterator it( m_clients.find(client_id) );
+
+    if ( it == m_clients.end() )
+      return;
+
+    wake = m_dirty.empty();
+    enqueue( *it->second, data );
+    wake = wake && !m_dirty.empty();
+  }
+
+  if ( wake )
+    wake_up();
+} // server_core::send()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Queues some data for all the clients. The data is shared among the
+ *        queues of the clients.
+ * \param data The data to send.
+ */
+void bear::net::server_core::broadcast( const buffer_type& data )
+{
+  bool wake;
+
+  {
+    boost::mutex::scoped_lock lock( m_mutex );
+
+    wake = m_dirty.empty();
+
+    for ( connection_map::const_iterator it=m_clients.begin();
+          it!=m_clients.end(); ++it )
+      enqueue( *it->second, data );
+
+    wake = wake && !m_dirty.empty();
+  }
+
+  if ( wake )
+    wake_up();
+} // server_core::broadcast()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Creates the socket on which the clients connect.
+ * \param port The port on which the clients connect.
+ */
+void bear::net::server_core::open( unsigned int port )
+{
+  m_listener = socket( AF_INET, SOCK_STREAM, 0 );
+
+  if ( m_listener == -1 )
+    {
+      claw::logger << claw::log_error << "server_core: socket: "
+                   << std::strerror(errno) << std::endl;
+      return;
+    }
+
+  const int yes(1);
+  setsockopt( m_listener, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes) );
+
+  sockaddr_in address;
+  std::memset( &address, 0, sizeof(address) );
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl( INADDR_ANY );
+  address.sin_port = htons( port );
+
+  if ( (bind( m_listener, reinterpret_cast<sockaddr*>(&address),
+              sizeof(address) ) != 0)
+       || (listen( m_listener, SOMAXCONN ) != 0)
+       || !detail::set_non_blocking( m_listener ) )
+    {
+      claw::logger << claw::log_error << "server_core: port " << port << ": "
+                   << std::strerror(errno) << std::endl;
+      close( m_listener );
+      m_listener = -1;
+    }
+} // server_core::open()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Closes the descriptors of the listening socket, of the pipe and of
+ *        the epoll instance.
+ */
+void bear::net::server_core::close_descriptors()
+{
+  const int descriptors[] =
+    { m_listener, m_wake_pipe[0], m_wake_pipe[1], m_epoll };
+
+  for ( std::size_t i=0; i!=sizeof(descriptors)/sizeof(descriptors[0]); ++i )
+    if ( descriptors[i] != -1 )
+      close( descriptors[i] );
+
+  m_listener = -1;
+  m_wake_pipe[0] = -1;
+  m_wake_pipe[1] = -1;
+  m_epoll = -1;
+} // server_core::close_descriptors()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief The loop of the I/O thread.
+ */
+void bear::net::server_core::run()
+{
+  bool quit(false);
+
+  while ( !quit )
+    {
+      wait_for_events();
+      collect_data();
+
+      std::size_t kept(0);
+
+      for ( std::size_t i=0; i!=m_sending.size(); ++i )
+        {
+          connection* const c( m_sending[i] );
+
+          if ( c->writable && !c->closed )
+            flush( *c );
+
+          if ( !c->closed && !c->outgoing.empty() )
+            {
+              m_sending[kept] = c;
+              ++kept;
+            }
+          else
+            c->sending = false;
+        }
+
+      m_sending.resize( kept );
+
+      boost::mutex::scoped_lock lock( m_mutex );
+
+      m_queued_size -= m_released_size;
+      m_released_size = 0;
+      quit = m_quit;
+
+      release_closed_connections();
+    }
+} // server_core::run()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Waits for an event on the sockets or on the pipe and processes it.
+ */
+void bear::net::server_core::wait_for_events()
+{
+#ifdef __linux__
+  if ( m_epoll != -1 )
+    {
+      epoll_event events[64];
+      const int n( epoll_wait( m_epoll, events, 64, -1 ) );
+
+      for ( int i=0; i<n; ++i )
+        process_event
+          ( events[i].data.u64, events[i].events & EPOLLIN,
+            events[i].events & EPOLLOUT,
+            events[i].events & (EPOLLERR | EPOLLHUP) );
+
+      return;
+    }
+#endif
+
+  // The sockets are watched for writing only when they are known to be full.
+  // Otherwise poll() would return immediately.
+  std::vector<pollfd> descriptors;
+  std::vector<std::size_t> keys;
+
+  descriptors.reserve( m_connections.size() + detail::first_connection_key );
+  keys.reserve( descriptors.capacity() );
+
+  pollfd p;
+  p.events = POLLIN;
+  p.revents = 0;
+
+  p.fd = m_listener;
+  descriptors.push_back( p );
+  keys.push_back( detail::listener_key );
+
+  p.fd = m_wake_pipe[0];
+  descriptors.push_back( p );
+  keys.push_back( detail::wake_key );
+
+  for ( connection_map::const_iterator it=m_connections.begin();
+        it!=m_connections.end(); ++it )
+    {
+      const connection& c( *it->second );
+
+      p.fd = c.descriptor;
+      p.events = POLLIN;
+
+      if ( c.sending && !c.writable )
+        p.events |= POLLOUT;
+
+      descriptors.push_back( p );
+      keys.push_back( c.key );
+    }
+
+  if ( poll( &descriptors[0], descriptors.size(), -1 ) > 0 )
+    for ( std::size_t i=0; i!=descriptors.size(); ++i )
+      if ( descriptors[i].revents != 0 )
+        process_event
+          ( keys[i], descriptors[i].revents & POLLIN,
+            descriptors[i].revents & POLLOUT,
+            descriptors[i].revents & (POLLERR | POLLHUP | POLLNVAL) );
+} // server_core::wait_for_events()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Processes an event received on a descriptor.
+ * \param key The key of the descriptor.
+ * \param readable Tells if there is something to read.
+ * \param writable Tells if some data can be written.
+ * \param error Tells if an error occurred or if the connection has been
+ *        closed.
+ */
+void bear::net::server_core::process_event
+( std::size_t key, bool readable, bool writable, bool error )
+{
+  if ( key == detail::listener_key )
+    accept_connections();
+  else if ( key == detail::wake_key )
+    {
+      char buffer[64];
+
+      while ( read( m_wake_pipe[0], buffer, sizeof(buffer) ) > 0 )
+        ;
+    }
+  else
+    {
+      // The connection may have been closed by a previous event.
+      const connection_map::const_iterator it( m_connections.find(key) );
+
+      if ( it == m_connections.end() )
+        return;
+
+      connection& c( *it->second );
+
+      if ( error )
+        close_connection( c );
+      else
+        {
+          if ( readable )
+            read_and_discard( c );
+
+          if ( writable )
+            c.writable = true;
+        }
+    }
+} // server_core::process_event()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Accepts the pending connections on the listening socket. They are
+ *        given to the server by the next call to accept_clients().
+ */
+void bear::net::server_core::accept_connections()
+{
+  while ( true )
+    {
+      const int descriptor( accept( m_listener, NULL, NULL ) );
+
+      if ( descriptor == -1 )
+        {
+          if ( !detail::would_block() )
+            claw::logger << claw::log_warning << "server_core: accept: "
+                         << std::strerror(errno) << std::endl;
+          return;
+        }
+
+      if ( !detail::set_non_blocking( descriptor ) )
+        {
+          close( descriptor );
+          continue;
+        }
+
+      // The messages are small and must be received as soon as possible.
+      const int yes(1);
+      setsockopt( descriptor, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes) );
+
+#ifdef SO_NOSIGPIPE
+      setsockopt( descriptor, SOL_SOCKET, SO_NOSIGPIPE, &yes, sizeof(yes) );
+#endif
+
+      connection* c;
+
+      {
+        boost::mutex::scoped_lock lock( m_mutex );
+
+        c = new connection( descriptor, m_next_key, m_next_client_id );
+        ++m_next_client_id;
+        m_accepted.push_back( c );
+      }
+
+      ++m_next_key;
+      m_connections[ c->key ] = c;
+
+#ifdef __linux__
+      if ( m_epoll != -1 )
+        {
+          // Edge-triggered: a new event comes only when a full socket can
+          // accept some data again.
+          epoll_event e;
+          e.events = EPOLLIN | EPOLLOUT | EPOLLET;
+          e.data.u64 = c->key;
+          epoll_ctl( m_epoll, EPOLL_CTL_ADD, descriptor, &e );
+        }
+#endif
+    }
+} // server_core::accept_connections()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Queues some data for a connection.
+ * \param c The connection.
+ * \param data The data to send.
+ * \pre m_mutex is locked.
+ */
+void bear::net::server_core::enqueue( connection& c, const buffer_type& data )
+{
+  if ( c.closed )
+    return;
+
+  c.incoming.push_back( data );
+  m_queued_size += data->size();
+
+  if ( !c.dirty )
+    {
+      c.dirty = true;
+      m_dirty.push_back( &c );
+    }
+} // server_core::enqueue()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Moves the data queued by the server into the write queues of the
+ *        I/O thread. The clients whose queue gets too large are disconnected.
+ */
+void bear::net::server_core::collect_data()
+{
+  connection_list overflowed;
+
+  {
+    boost::mutex::scoped_lock lock( m_mutex );
+
+    for ( std::size_t i=0; i!=m_dirty.size(); ++i )
+      {
+        connection& c( *m_dirty[i] );
+        c.dirty = false;
+
+        if ( c.closed )
+          for ( std::size_t j=0; j!=c.incoming.size(); ++j )
+            m_queued_size -= c.incoming[j]->size();
+        else
+          {
+            for ( std::size_t j=0; j!=c.incoming.size(); ++j )
+              c.queued_size += c.incoming[j]->size();
+
+            c.outgoing.insert
+              ( c.outgoing.end(), c.incoming.begin(), c.incoming.end() );
+
+            if ( c.queued_size > detail::max_queued_size_per_client )
+              overflowed.push_back( &c );
+            else if ( !c.sending )
+              {
+                c.sending = true;
+                m_sending.push_back( &c );
+              }
+          }
+
+        c.incoming.clear();
+      }
+
+    m_dirty.clear();
+  }
+
+  for ( std::size_t i=0; i!=overflowed.size(); ++i )
+    {
+      claw::logger << claw::log_warning << "server_core: client "
+                   << overflowed[i]->id << " disconnected, "
+                   << overflowed[i]->queued_size << " bytes queued."
+                   << std::endl;
+      close_connection( *overflowed[i] );
+    }
+} // server_core::collect_data()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Writes the queued data of a connection until its socket is full.
+ * \param c The connection.
+ */
+void bear::net::server_core::flush( connection& c )
+{
+  while ( !c.outgoing.empty() )
+    {
+      iovec buffers[ detail::max_buffers_per_write ];
+      std::size_t n(0);
+
+      for ( std::deque<buffer_type>::const_iterator it=c.outgoing.begin();
+            (it != c.outgoing.end())
+              && (n != detail::max_buffers_per_write);
+            ++it, ++n )
+        {
+          buffers[n].iov_base = const_cast<char*>( (*it)->data() );
+          buffers[n].iov_len = (*it)->size();
+        }
+
+      buffers[0].iov_base = static_cast<char*>(buffers[0].iov_base) + c.offset;
+      buffers[0].iov_len -= c.offset;
+
+      msghdr header;
+      std::memset( &header, 0, sizeof(header) );
+      header.msg_iov = buffers;
+      header.msg_iovlen = n;
+
+      const ssize_t written
+        ( sendmsg( c.descriptor, &header, detail::send_flags ) );
+
+      if ( written == -1 )
+        {
+          if ( errno == EINTR )
+            continue;
+
+          if ( detail::would_block() )
+            c.writable = false;
+          else
+            close_connection( c );
+
+          return;
+        }
+
+      m_released_size += written;
+      c.queued_size -= written;
+
+      std::size_t remaining( written );
+
+      while ( !c.outgoing.empty()
+              && ( (remaining != 0)
+                   || (c.outgoing.front()->size() == c.offset) ) )
+        {
+          const std::size_t left( c.outgoing.front()->size() - c.offset );
+
+          if ( remaining >= left )
+            {
+              remaining -= left;
+              c.offset = 0;
+              c.outgoing.pop_front();
+            }
+          else
+            {
+              c.offset += remaining;
+              remaining = 0;
+            }
+        }
+    }
+} // server_core::flush()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Reads and ignores the data sent by a client, and closes the
+ *        connection if the client has closed it.
+ * \param c The connection.
+ */
+void bear::net::server_core::read_and_discard( connection& c )
+{
+  char buffer[256];
+  ssize_t length;
+
+  do
+    length = recv( c.descriptor, buffer, sizeof(buffer), 0 );
+  while ( length > 0 );
+
+  if ( (length == 0) || !detail::would_block() )
+    close_connection( c );
+} // server_core::read_and_discard()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Closes a connection. Its data is lost. The connection is released by
+ *        release_closed_connections().
+ * \param c The connection.
+ * \pre m_mutex is not locked.
+ */
+void bear::net::server_core::close_connection( connection& c )
+{
+  CLAW_PRECOND( !c.closed );
+
+  m_released_size += c.queued_size;
+  c.queued_size = 0;
+  c.outgoing.clear();
+  c.offset = 0;
+
+  {
+    boost::mutex::scoped_lock lock( m_mutex );
+    c.closed = true;
+  }
+
+  close( c.descriptor );
+
+  m_connections.erase( c.key );
+  m_closed.push_back( &c );
+} // server_core::close_connection()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Removes the closed connections from the clients of the server and
+ *        deletes them. The connections whose data has not been collected yet
+ *        are kept until the next call.
+ * \pre m_mutex is locked, none of the connections in m_closed is in
+ *      m_sending.
+ */
+void bear::net::server_core::release_closed_connections()
+{
+  std::size_t kept(0);
+
+  for ( std::size_t i=0; i!=m_closed.size(); ++i )
+    {
+      connection* const c( m_closed[i] );
+
+      if ( c->dirty )
+        {
+          m_closed[kept] = c;
+          ++kept;
+        }
+      else
+        {
+          m_clients.erase( c->id );
+          m_accepted.erase
+            ( std::remove( m_accepted.begin(), m_accepted.end(), c ),
+              m_accepted.end() );
+          delete c;
+        }
+    }
+
+  m_closed.resize( kept );
+} // server_core::release_closed_connections()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Wakes the I/O thread up, for example to tell it that some data has
+ *        been queued.
+ */
+void bear::net::server_core::wake_up()
+{
+  const char c(0);
+
+  // If the pipe is full then the thread has not read it yet and will wake up
+  // anyway.
+  if ( write( m_wake_pipe[1], &c, 1 ) != 1 )
+    return;
+} // server_core::wake_up()
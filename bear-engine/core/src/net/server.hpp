@@ -15,10 +15,9 @@
 #define __NET_SERVER_HPP__
 
 #include "net/class_export.hpp"
+#include "net/server_core.hpp"
 
-#include <list>
 #include <claw/non_copyable.hpp>
-#include <claw/socket_server.hpp>
 #include <boost/signals2.hpp>
 
 namespace bear
@@ -29,24 +28,17 @@ namespace bear
 
     /**
      * \brief A server is an object that can dispatch messages to clients.
+     *
+     * The messages are serialized once and the resulting data is written in
+     * the sockets of the clients by a server_core, in its own thread.
+     *
      * \author Julien Jorge
      */
     class NET_EXPORT server:
       private claw::pattern::non_copyable
     {
-    private:
-      /** \brief The type of a clients connected to this server. */
-      typedef claw::net::socket_stream client_type;
-
-      /** \brief The type of a pointer on a client connected to this server. */
-      typedef client_type* client_pointer;
-
-      /** \brief The list of clients connected to this server. */
-      typedef std::list<client_pointer> client_list;
-
     public:
-      server( unsigned int port, int client_read_time_limit = 0 );
-      ~server();
+      explicit server( unsigned int port );
 
       std::size_t get_connection_count() const;
 
@@ -58,15 +50,12 @@ namespace bear
       void check_for_new_clients();
 
     private:
-      /** \brief This is the socket in which the messages are dispatched and
-          from which the new clients are taken. */
-      claw::net::socket_server m_server;
-
-      /** \brief Those are the clients to which the messages are dispatched. */
-      client_list m_clients;
+      static server_core::buffer_type serialize( const message& m );
 
-      /** \brief How long do we wait when asking a client for its content. */
-      int m_client_read_time_limit;
+    private:
+      /** \brief The connections to the clients, in which the messages are
+          written. */
+      server_core m_core;
 
     }; // class server
 
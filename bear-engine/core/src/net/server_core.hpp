@@ -0,0 +1,188 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The part of the server which writes the data in the sockets of the
+ *        clients.
+ * \author Julien Jorge
+ */
+#ifndef __NET_SERVER_CORE_HPP__
+#define __NET_SERVER_CORE_HPP__
+
+#include "net/class_export.hpp"
+
+#include <claw/non_copyable.hpp>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+namespace claw
+{
+  namespace net
+  {
+    class socket_server;
+  }
+}
+#endif
+
+namespace bear
+{
+  namespace net
+  {
+    /**
+     * \brief The part of the server which writes the data in the sockets of
+     *        the clients.
+     *
+     * With POSIX sockets, the sockets are non blocking and are handled in a
+     * dedicated thread, which waits for them to be ready with epoll, or with
+     * poll where epoll is not available. The data sent to several clients is
+     * shared among their write queues. A client whose queue exceeds a given
+     * size is disconnected.
+     *
+     * On Windows, the data is written in the sockets of libclaw, in the thread
+     * of the caller.
+     *
+     * The connections closed by the clients are released, thus the
+     * identifiers of the clients are not contiguous.
+     *
+     * \author Julien Jorge
+     */
+    class NET_EXPORT server_core:
+      private claw::pattern::non_copyable
+    {
+    public:
+      /** \brief The type of the data sent to the clients. */
+      typedef std::shared_ptr<const std::string> buffer_type;
+
+    private:
+      class connection;
+
+      /** \brief The type of the list of the connections to the clients. */
+      typedef std::vector<connection*> connection_list;
+
+      /** \brief The type of the map associating the connections with their
+          identifiers. */
+      typedef std::map<std::size_t, connection*> connection_map;
+
+    public:
+      explicit server_core( unsigned int port );
+      ~server_core();
+
+      bool is_open() const;
+
+      void accept_clients( std::vector<std::size_t>& ids );
+      std::size_t get_client_count() const;
+      std::size_t get_queued_size() const;
+
+      void send( std::size_t client_id, const buffer_type& data );
+      void broadcast( const buffer_type& data );
+
+    private:
+#ifdef _WIN32
+      static bool write( connection& c, const buffer_type& data );
+
+    private:
+      /** \brief The socket on which the clients connect. */
+      claw::net::socket_server* m_server;
+
+      /** \brief The connections to the clients, by identifier. */
+      connection_map m_clients;
+
+      /** \brief The identifier of the next client. */
+      std::size_t m_next_client_id;
+#else
+      void open( unsigned int port );
+      void close_descriptors();
+
+      void run();
+      void wait_for_events();
+      void process_event
+      ( std::size_t key, bool readable, bool writable, bool error );
+
+      void accept_connections();
+      void enqueue( connection& c, const buffer_type& data );
+      void collect_data();
+      void flush( connection& c );
+      void read_and_discard( connection& c );
+      void close_connection( connection& c );
+      void release_closed_connections();
+
+      void wake_up();
+
+    private:
+      /** \brief The socket on which the clients connect. */
+      int m_listener;
+
+      /** \brief The descriptor of the epoll instance, or -1 if the sockets
+          are watched with poll. */
+      int m_epoll;
+
+      /** \brief The pipe written to wake up the I/O thread. */
+      int m_wake_pipe[2];
+
+      /** \brief The open connections, by key of their events. Only the I/O
+          thread uses this map. */
+      connection_map m_connections;
+
+      /** \brief The key of the events of the next connection. Only the I/O
+          thread uses this value. */
+      std::size_t m_next_key;
+
+      /** \brief The connections closed by the I/O thread and not released
+          yet. Only the I/O thread uses this list. */
+      connection_list m_closed;
+
+      /** \brief The connections accepted by the I/O thread but not given to
+          the server yet. */
+      connection_list m_accepted;
+
+      /** \brief The open connections given to the server, by identifier of
+          the client. */
+      connection_map m_clients;
+
+      /** \brief The identifier of the next client. */
+      std::size_t m_next_client_id;
+
+      /** \brief The connections whose data has not been seen by the I/O
+          thread yet. */
+      connection_list m_dirty;
+
+      /** \brief The connections having some data to write. Only the I/O
+          thread uses this list. */
+      connection_list m_sending;
+
+      /** \brief The size of the data queued and not written yet. */
+      std::size_t m_queued_size;
+
+      /** \brief The size of the data written or discarded by the I/O thread
+          and not removed from m_queued_size yet. */
+      std::size_t m_released_size;
+
+      /** \brief Tells the I/O thread to stop. */
+      bool m_quit;
+
+      /** \brief The mutex protecting the data shared with the I/O thread. */
+      mutable boost::mutex m_mutex;
+
+      /** \brief The thread waiting for the sockets to be ready. */
+      boost::thread* m_thread;
+#endif
+
+    }; // class server_core
+
+  } // namespace net
+} // namespace bear
+
+#endif // __NET_SERVER_CORE_HPP__
@@ -19,6 +19,8 @@
 
 #include "universe/class_export.hpp"
 
+#include <cstddef>
+
 namespace bear
 {
   namespace universe
@@ -39,6 +41,8 @@ namespace bear
       virtual ~base_forced_movement();
 
       virtual base_forced_movement* clone() const = 0;
+      virtual base_forced_movement*
+      clone_in( void* buffer, std::size_t size ) const;
 
       void init();
 
@@ -19,6 +19,8 @@
 
 #include "universe/class_export.hpp"
 
+#include <cstddef>
+
 namespace bear
 {
   namespace universe
@@ -40,6 +42,18 @@ namespace bear
       /** \brief Create a copy of this instance using the operator new. */
       virtual base_reference_point* clone() const = 0;
 
+      /**
+       * \brief Create a copy of this instance in a given buffer, if it fits,
+       *        or using the operator new.
+       * \param buffer The memory where the copy is built.
+       * \param size The size of the buffer.
+       */
+      virtual base_reference_point*
+      clone_in( void* buffer, std::size_t size ) const
+      {
+        return clone();
+      }
+
       /** \brief Tell if get_point() can be safely called. */
       virtual bool is_valid() const = 0;
 
@@ -38,6 +38,8 @@ namespace bear
       explicit center_of_mass_reference_point( physical_item& item );
 
       virtual base_reference_point* clone() const;
+      virtual base_reference_point*
+      clone_in( void* buffer, std::size_t size ) const;
 
       virtual bool is_valid() const;
       virtual position_type get_point() const;
@@ -40,6 +40,23 @@ bear::universe::base_forced_movement::~base_forced_movement()
   // nothing to do.
 } // base_forced_movement::~base_forced_movement()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Instanciate a copy of this movement in a given buffer, if it fits.
+ * \param buffer The memory where the copy is built.
+ * \param size The size of the buffer.
+ *
+ * The default implementation ignores the buffer and uses clone(). The common
+ * movements override this method such that they are copied without any
+ * allocation.
+ */
+bear::universe::base_forced_movement*
+bear::universe::base_forced_movement::clone_in
+( void* buffer, std::size_t size ) const
+{
+  return clone();
+} // base_forced_movement::clone_in()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Initialise the item.
@@ -15,6 +15,8 @@
 
 #include "universe/physical_item.hpp"
 
+#include <new>
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
@@ -37,6 +39,22 @@ bear::universe::center_of_mass_reference_point::clone() const
   return new center_of_mass_reference_point(*this);
 } // center_of_mass_reference_point::clone()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Duplicate this instance in a given buffer, if it fits.
+ * \param buffer The memory where the copy is built.
+ * \param size The size of the buffer.
+ */
+bear::universe::base_reference_point*
+bear::universe::center_of_mass_reference_point::clone_in
+( void* buffer, std::size_t size ) const
+{
+  if ( size < sizeof(center_of_mass_reference_point) )
+    return clone();
+
+  return new (buffer) center_of_mass_reference_point(*this);
+} // center_of_mass_reference_point::clone_in()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Tell if this reference is usable.
@@ -17,6 +17,9 @@
 
 #include <claw/assert.hpp>
 
+/*----------------------------------------------------------------------------*/
+const std::size_t bear::universe::forced_movement::s_storage_size;
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
@@ -33,11 +36,10 @@ bear::universe::forced_movement::forced_movement()
  * \param that The instance to copy from.
  */
 bear::universe::forced_movement::forced_movement( const forced_movement& that )
+  : m_movement(NULL)
 {
-  if ( that.is_null() )
-    m_movement = NULL;
-  else
-    m_movement = that.m_movement->clone();
+  if ( !that.is_null() )
+    copy( *that.m_movement );
 } // forced_movement::forced_movement()
 
 /*----------------------------------------------------------------------------*/
@@ -47,9 +49,9 @@ bear::universe::forced_movement::forced_movement( const forced_movement& that )
  */
 bear::universe::forced_movement::forced_movement
 ( const base_forced_movement& m )
-  : m_movement( m.clone() )
+  : m_movement(NULL)
 {
-
+  copy(m);
 } // forced_movement::forced_movement()
 
 /*----------------------------------------------------------------------------*/
@@ -67,9 +69,16 @@ bear::universe::forced_movement::~forced_movement()
  * \param that The instance to copy from.
  */
 bear::universe::forced_movement&
-bear::universe::forced_movement::operator=( forced_movement that )
+bear::universe::forced_movement::operator=( const forced_movement& that )
 {
-  std::swap(m_movement, that.m_movement);
+  if ( &that != this )
+    {
+      clear();
+
+      if ( !that.is_null() )
+        copy( *that.m_movement );
+    }
+
   return *this;
 } // forced_movement::operator=()
 
@@ -88,7 +97,11 @@ bool bear::universe::forced_movement::is_null() const
  */
 void bear::universe::forced_movement::clear()
 {
-  delete m_movement;
+  if ( dynamic_cast<void*>(m_movement) == &m_storage )
+    m_movement->~base_forced_movement();
+  else
+    delete m_movement;
+
   m_movement = NULL;
 } // forced_movement::clear()
 
@@ -281,3 +294,15 @@ bool bear::universe::forced_movement::is_finished() const
   CLAW_PRECOND( !is_null() );
   return m_movement->is_finished();
 } // forced_movement::is_finished()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Copy an effective movement in this instance.
+ * \param m The movement to copy.
+ * \pre is_null()
+ */
+void bear::universe::forced_movement::copy( const base_forced_movement& m )
+{
+  CLAW_PRECOND( is_null() );
+  m_movement = m.clone_in( &m_storage, s_storage_size );
+} // forced_movement::copy()
@@ -16,6 +16,7 @@
 #include "universe/physical_item.hpp"
 
 #include <cmath>
+#include <new>
 #include <limits>
 
 /*----------------------------------------------------------------------------*/
@@ -42,6 +43,22 @@ bear::universe::forced_rotation::clone() const
   return new forced_rotation(*this);
 } // forced_rotation::clone()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Instanciate a copy of this movement in a given buffer, if it fits.
+ * \param buffer The memory where the copy is built.
+ * \param size The size of the buffer.
+ */
+bear::universe::base_forced_movement*
+bear::universe::forced_rotation::clone_in
+( void* buffer, std::size_t size ) const
+{
+  if ( size < sizeof(forced_rotation) )
+    return clone();
+
+  return new (buffer) forced_rotation(*this);
+} // forced_rotation::clone_in()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Set the radius of the rotation.
@@ -15,6 +15,8 @@
 
 #include "universe/physical_item.hpp"
 
+#include <new>
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
@@ -51,6 +53,22 @@ bear::universe::forced_translation::clone() const
   return new forced_translation(*this);
 } // forced_translation::clone()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Instanciate a copy of this movement in a given buffer, if it fits.
+ * \param buffer The memory where the copy is built.
+ * \param size The size of the buffer.
+ */
+bear::universe::base_forced_movement*
+bear::universe::forced_translation::clone_in
+( void* buffer, std::size_t size ) const
+{
+  if ( size < sizeof(forced_translation) )
+    return clone();
+
+  return new (buffer) forced_translation(*this);
+} // forced_translation::clone_in()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Set the angle applied to the item.
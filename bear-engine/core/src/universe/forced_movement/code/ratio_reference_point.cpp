@@ -15,6 +15,8 @@
 
 #include "universe/physical_item.hpp"
 
+#include <new>
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
@@ -38,6 +40,22 @@ bear::universe::ratio_reference_point::clone() const
   return new ratio_reference_point(*this);
 } // ratio_reference_point::clone()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Duplicate this instance in a given buffer, if it fits.
+ * \param buffer The memory where the copy is built.
+ * \param size The size of the buffer.
+ */
+bear::universe::base_reference_point*
+bear::universe::ratio_reference_point::clone_in
+( void* buffer, std::size_t size ) const
+{
+  if ( size < sizeof(ratio_reference_point) )
+    return clone();
+
+  return new (buffer) ratio_reference_point(*this);
+} // ratio_reference_point::clone_in()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Tell if this reference is usable.
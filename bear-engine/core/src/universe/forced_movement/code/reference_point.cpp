@@ -17,6 +17,9 @@
 
 #include <claw/assert.hpp>
 
+/*----------------------------------------------------------------------------*/
+const std::size_t bear::universe::reference_point::s_storage_size;
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
@@ -33,11 +36,9 @@ bear::universe::reference_point::reference_point()
  * \param that The instance to copy from.
  */
 bear::universe::reference_point::reference_point( const reference_point& that )
+  : m_reference(NULL)
 {
-  if ( that.m_reference == NULL )
-    m_reference = NULL;
-  else
-    m_reference = that.m_reference->clone();
+  copy(that);
 } // reference_point::reference_point()
 
 /*----------------------------------------------------------------------------*/
@@ -47,7 +48,7 @@ bear::universe::reference_point::reference_point( const reference_point& that )
  */
 bear::universe::reference_point::reference_point
 ( const base_reference_point& p )
-  : m_reference( p.clone() )
+  : m_reference( p.clone_in( &m_storage, s_storage_size ) )
 {
 
 } // reference_point::reference_point()
@@ -58,7 +59,7 @@ bear::universe::reference_point::reference_point
  */
 bear::universe::reference_point::~reference_point()
 {
-  delete m_reference;
+  clear();
 } // reference_point::~reference_point()
 
 /*----------------------------------------------------------------------------*/
@@ -69,8 +70,12 @@ bear::universe::reference_point::~reference_point()
 bear::universe::reference_point&
 bear::universe::reference_point::operator=( const reference_point& that )
 {
-  reference_point tmp(that);
-  std::swap(m_reference, tmp.m_reference);
+  if ( &that != this )
+    {
+      clear();
+      copy(that);
+    }
+
   return *this;
 } // reference_point::operator=()
 
@@ -114,3 +119,31 @@ bear::universe::physical_item& bear::universe::reference_point::get_item() const
   CLAW_PRECOND( has_item() );
   return m_reference->get_item();
 } // reference_point::get_item()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Copy the effective reference point of an other instance.
+ * \param that The instance to copy from.
+ * \pre m_reference == NULL
+ */
+void bear::universe::reference_point::copy( const reference_point& that )
+{
+  CLAW_PRECOND( m_reference == NULL );
+
+  if ( that.m_reference != NULL )
+    m_reference = that.m_reference->clone_in( &m_storage, s_storage_size );
+} // reference_point::copy()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destroy the effective reference point.
+ */
+void bear::universe::reference_point::clear()
+{
+  if ( dynamic_cast<void*>(m_reference) == &m_storage )
+    m_reference->~base_reference_point();
+  else
+    delete m_reference;
+
+  m_reference = NULL;
+} // reference_point::clear()
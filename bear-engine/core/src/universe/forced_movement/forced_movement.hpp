@@ -19,6 +19,9 @@
 
 #include "universe/class_export.hpp"
 
+#include <cstddef>
+#include <type_traits>
+
 namespace bear
 {
   namespace universe
@@ -31,6 +34,13 @@ namespace bear
      *
      * If an item has a forced movement, the physical rules won't apply to him.
      *
+     * The effective movement is built in a buffer of the instance when it
+     * fits, which is the case of the common movements (translations,
+     * rotations and trackings). Thus these movements are copied, assigned to
+     * the items and looped in the sequences without any allocation, and the
+     * sub movements of a sequence are stored contiguously. The other
+     * movements are allocated with the operator new.
+     *
      * \author Julien Jorge
      */
     class UNIVERSE_EXPORT forced_movement
@@ -41,7 +51,7 @@ namespace bear
       forced_movement( const base_forced_movement& m );
       ~forced_movement();
 
-      forced_movement& operator=( forced_movement that );
+      forced_movement& operator=( const forced_movement& that );
 
       bool is_null() const;
       void clear();
@@ -72,9 +82,20 @@ namespace bear
       bool is_finished() const;
 
     private:
+      void copy( const base_forced_movement& m );
+
+    private:
+      /** \brief The size of the buffer in which the effective movement is
+          built. */
+      static const std::size_t s_storage_size = 256;
+
       /** \brief The effective movement. */
       base_forced_movement* m_movement;
 
+      /** \brief The memory where the effective movement is built, if it
+          fits. */
+      std::aligned_storage<s_storage_size>::type m_storage;
+
     }; // class forced_movement
   } // namespace universe
 } // namespace bear
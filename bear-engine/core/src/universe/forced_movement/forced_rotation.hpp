@@ -63,6 +63,7 @@ namespace bear
       forced_rotation();
 
       base_forced_movement* clone() const;
+      base_forced_movement* clone_in( void* buffer, std::size_t size ) const;
 
       void set_radius( double radius );
       void set_start_angle( double start_angle );
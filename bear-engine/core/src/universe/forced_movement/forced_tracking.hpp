@@ -41,6 +41,7 @@ namespace bear
         time_type length = std::numeric_limits<time_type>::infinity() );
 
       base_forced_movement* clone() const;
+      base_forced_movement* clone_in( void* buffer, std::size_t size ) const;
 
       void set_distance( const position_type& distance );
       void set_total_time( time_type length );
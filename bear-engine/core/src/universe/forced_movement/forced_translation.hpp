@@ -43,6 +43,7 @@ namespace bear
         time_type length = std::numeric_limits<time_type>::infinity() );
 
       base_forced_movement* clone() const;
+      base_forced_movement* clone_in( void* buffer, std::size_t size ) const;
 
       void set_angle( double angle );
       void set_force_angle( bool f );
@@ -42,6 +42,8 @@ namespace bear
         const position_type& gap = position_type(0, 0) );
 
       virtual base_reference_point* clone() const;
+      virtual base_reference_point*
+      clone_in( void* buffer, std::size_t size ) const;
 
       virtual bool is_valid() const;
       virtual position_type get_point() const;
@@ -19,6 +19,9 @@
 
 #include "universe/class_export.hpp"
 
+#include <cstddef>
+#include <type_traits>
+
 namespace bear
 {
   namespace universe
@@ -30,6 +33,10 @@ namespace bear
      * \brief Instances of reference_point compute the reference
      *        point used in forced movements.
      *
+     * The effective reference point is built in a buffer of the instance when
+     * it fits, thus the common reference points are copied without any
+     * allocation.
+     *
      * \author Julien Jorge
      */
     class UNIVERSE_EXPORT reference_point
@@ -48,9 +55,21 @@ namespace bear
       physical_item& get_item() const;
 
     private:
+      void copy( const reference_point& that );
+      void clear();
+
+    private:
+      /** \brief The size of the buffer in which the effective reference point
+          is built. */
+      static const std::size_t s_storage_size = 64;
+
       /** \brief The effective reference point. */
       base_reference_point* m_reference;
 
+      /** \brief The memory where the effective reference point is built, if
+          it fits. */
+      std::aligned_storage<s_storage_size>::type m_storage;
+
     }; // class reference_point
   } // namespace universe
 } // namespace bear
@@ -66,24 +66,98 @@ void bear::universe::static_map<ItemType>::insert( const item_type& item )
                  << box.left() << ' ' << box.bottom() << ' ' << box.right()
                  << ' ' << box.top() << ")." << std::endl;
 
-  if ( top >= (int)m_size.y )
-    top = m_size.y - 1;
-  if ( bottom < 0 )
-    bottom = 0;
-  if ( right >= (int)m_size.x )
-    right = m_size.x - 1;
-  if ( left < 0 )
-    left = 0;
+  clamp_cells( left, bottom, right, top );
 
-  const std::size_t id( m_items.size() );
-  m_items.push_back( item );
-  m_bounding_boxes.push_back( box );
+  std::size_t id;
+
+  if ( m_free_ids.empty() )
+    {
+      id = m_items.size();
+      m_items.push_back( item );
+      m_bounding_boxes.push_back( box );
+    }
+  else
+    {
+      id = m_free_ids.back();
+      m_free_ids.pop_back();
+      m_items[ id ] = item;
+      m_bounding_boxes[ id ] = box;
+    }
 
   for ( int col = left; col <= right; ++col )
     for ( int line = bottom; line <= top; ++line )
       m_map[ col * m_size.y + line ].push_back( id );
 } // static_map::insert()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove an item from the map.
+ * \param item The item to remove.
+ * \pre The item is in the map.
+ *
+ * The item is searched in the cells covered by its bounding box. If the item
+ * has moved since its insertion, all the cells are searched.
+ */
+template<class ItemType>
+void bear::universe::static_map<ItemType>::erase( const item_type& item )
+{
+  const area_type box = item->get_bounding_box();
+  int top = (int)box.top() / (int)m_box_size;
+  int left = (int)box.left() / (int)m_box_size;
+  int bottom = (int)box.bottom() / (int)m_box_size;
+  int right = (int)box.right() / (int)m_box_size;
+
+  clamp_cells( left, bottom, right, top );
+
+  const std::size_t none( std::numeric_limits<std::size_t>::max() );
+  std::size_t id( erase_from_cells( item, left, bottom, right, top ) );
+
+  if ( id == none )
+    id = erase_from_cells( item, 0, 0, m_size.x - 1, m_size.y - 1 );
+
+  CLAW_POSTCOND( id != none );
+
+  m_items[ id ] = item_type();
+  m_free_ids.push_back( id );
+} // static_map::erase()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove the references to an item from a range of cells.
+ * \param item The item to remove.
+ * \param left The first column of the range.
+ * \param bottom The first line of the range.
+ * \param right The last column of the range.
+ * \param top The last line of the range.
+ * \return The index of the item in m_items, or the maximum value of
+ *         std::size_t if the item was not found in the range.
+ */
+template<class ItemType>
+std::size_t bear::universe::static_map<ItemType>::erase_from_cells
+( const item_type& item, int left, int bottom, int right, int top )
+{
+  std::size_t result( std::numeric_limits<std::size_t>::max() );
+
+  for ( int col = left; col <= right; ++col )
+    for ( int line = bottom; line <= top; ++line )
+      {
+        item_box& cell( m_map[ col * m_size.y + line ] );
+        std::size_t i(0);
+
+        while ( i != cell.size() )
+          if ( m_items[ cell[i] ] == item )
+            {
+              result = cell[i];
+              cell[i] = cell.back();
+              cell.pop_back();
+            }
+          else
+            ++i;
+      }
+
+  return result;
+} // static_map::erase_from_cells()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get all items inside rectangular regions of the map, without
@@ -264,3 +338,25 @@ void bear::universe::static_map<ItemType>::make_set
   
   items.swap(result);
 } // static_map::make_set()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Restrict a range of cells to the cells of the map.
+ * \param left (in/out) The first column of the range.
+ * \param bottom (in/out) The first line of the range.
+ * \param right (in/out) The last column of the range.
+ * \param top (in/out) The last line of the range.
+ */
+template<class ItemType>
+void bear::universe::static_map<ItemType>::clamp_cells
+( int& left, int& bottom, int& right, int& top ) const
+{
+  if ( top >= (int)m_size.y )
+    top = m_size.y - 1;
+  if ( bottom < 0 )
+    bottom = 0;
+  if ( right >= (int)m_size.x )
+    right = m_size.x - 1;
+  if ( left < 0 )
+    left = 0;
+} // static_map::clamp_cells()
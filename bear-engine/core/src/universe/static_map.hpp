@@ -67,6 +67,7 @@ namespace bear
       ( unsigned int width, unsigned int height, unsigned int box_size );
 
       void insert( const item_type& item );
+      void erase( const item_type& item );
 
       template<typename AreaIterator>
       void get_areas
@@ -87,6 +88,9 @@ namespace bear
 
     private:
       void make_set( item_list& items ) const;
+      void clamp_cells( int& left, int& bottom, int& right, int& top ) const;
+      std::size_t erase_from_cells
+      ( const item_type& item, int left, int bottom, int right, int top );
 
     private:
       /** \brief The size of the boxes. */
@@ -101,6 +105,10 @@ namespace bear
       item_list m_items;
       std::vector<rectangle_type> m_bounding_boxes;
 
+      /** \brief The indices in m_items of the erased items, reused by the
+          next insertions. */
+      std::vector<std::size_t> m_free_ids;
+
     }; // class static_map
 
   } // namespace universe
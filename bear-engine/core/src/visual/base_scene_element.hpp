@@ -53,6 +53,8 @@ namespace bear
       ( const rectangle_list& boxes, scene_element_list& output ) const;
 
       virtual void render( base_screen& scr ) const;
+      virtual void render_repeated
+      ( base_screen& scr, unsigned int x_count, unsigned int y_count ) const;
 
       const position_type& get_position() const;
       void set_position( coordinate_type x, coordinate_type y );
@@ -26,6 +26,7 @@ namespace bear
 {
   namespace visual
   {
+    class image;
     class sprite;
     class shader_program;
 
@@ -52,8 +53,14 @@ namespace bear
 
       virtual void begin_render() {}
       virtual void render( const position_type& pos, const sprite& s ) = 0;
+      virtual void render_repeated
+      ( const position_type& pos, const sprite& s, unsigned int x_count,
+        unsigned int y_count ) = 0;
       virtual void end_render() { }
 
+      virtual void begin_image_render( const image& target ) = 0;
+      virtual void end_image_render() = 0;
+
       virtual void draw_line
       ( const color_type& color,
         const std::vector<position_type>& p, double w, bool close = false ) = 0;
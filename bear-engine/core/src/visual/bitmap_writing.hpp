@@ -83,9 +83,14 @@ namespace bear
       typedef sprite_list::const_iterator const_iterator;
 
     public:
+      bitmap_writing();
+
       std::size_t get_sprites_count() const;
       placed_sprite get_sprite( std::size_t i ) const;
 
+      std::size_t get_visible_sprites_count() const;
+      void set_visible_sprites_count( std::size_t n );
+
       void set_effect( sequence_effect e );
       void update( double t );
 
@@ -106,6 +111,10 @@ namespace bear
       /** \brief The effect to apply to the sprites. */
       sequence_effect m_effect;
 
+      /** \brief The number of sprites rendered, taken from the beginning of
+          m_sprites. */
+      std::size_t m_visible_count;
+
     }; // class bitmap_writing
   } // namespace visual
 } // namespace bear
@@ -93,6 +93,31 @@ void bear::visual::base_scene_element::render( base_screen& scr ) const
   // nothing to do
 } // base_scene_element::render()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Render the element several times on a screen, side by side, starting
+ *        from its position and stepping by the size of its bounding box.
+ * \param scr The screen on which we render the element.
+ * \param x_count The number of repetitions on the x-axis.
+ * \param y_count The number of repetitions on the y-axis.
+ */
+void bear::visual::base_scene_element::render_repeated
+( base_screen& scr, unsigned int x_count, unsigned int y_count ) const
+{
+  const rectangle_type box( get_bounding_box() );
+  base_scene_element* const e( clone() );
+
+  for ( unsigned int x=0; x!=x_count; ++x )
+    for ( unsigned int y=0; y!=y_count; ++y )
+      {
+        e->set_position
+          ( m_position.x + x * box.width(), m_position.y + y * box.height() );
+        e->render( scr );
+      }
+
+  delete e;
+} // base_scene_element::render_repeated()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the position on the element on the screen.
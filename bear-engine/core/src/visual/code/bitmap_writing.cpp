@@ -12,6 +12,8 @@
 #include "visual/font/font.hpp"
 #include "visual/text_layout.hpp"
 
+#include <claw/assert.hpp>
+
 #include <limits>
 #include <algorithm>
 
@@ -72,6 +74,16 @@ bear::visual::bitmap_writing::arrange_sprite_list::get_bottom() const
 
 
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+bear::visual::bitmap_writing::bitmap_writing()
+  : m_visible_count(0)
+{
+
+} // bitmap_writing::bitmap_writing()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the number of sprites in the writing.
@@ -100,6 +112,30 @@ bear::visual::bitmap_writing::get_sprite( std::size_t i ) const
   return result;
 } // bitmap_writing::get_sprite()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of sprites rendered with the writing.
+ */
+std::size_t bear::visual::bitmap_writing::get_visible_sprites_count() const
+{
+  return m_visible_count;
+} // bitmap_writing::get_visible_sprites_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the number of sprites rendered with the writing. Only the first
+ *        \a n sprites are rendered, thus the text can be revealed
+ *        progressively without being arranged again.
+ * \param n The number of sprites to render.
+ * \pre n <= get_sprites_count()
+ */
+void bear::visual::bitmap_writing::set_visible_sprites_count( std::size_t n )
+{
+  CLAW_PRECOND( n <= m_sprites.size() );
+
+  m_visible_count = n;
+} // bitmap_writing::set_visible_sprites_count()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Set the effect to apply to the sprites of the text.
@@ -141,6 +177,7 @@ void bear::visual::bitmap_writing::create
   text_layout layout(f, str, s, h );
 
   layout.arrange_text<arrange_sprite_list&>( func );
+  m_visible_count = m_sprites.size();
 
   if ( v == text_align::align_bottom )
     shift_vertically( - func.get_bottom() );
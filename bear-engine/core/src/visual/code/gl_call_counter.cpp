@@ -0,0 +1,93 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::visual::gl_call_counter class.
+ * \author Julien Jorge
+ */
+#include "visual/gl_call_counter.hpp"
+
+#include <claw/assert.hpp>
+#include <claw/logger.hpp>
+
+/*----------------------------------------------------------------------------*/
+const std::size_t bear::visual::gl_call_counter::s_log_period( 600 );
+std::size_t
+bear::visual::gl_call_counter::s_current[ call_type_count ] = { 0 };
+std::size_t bear::visual::gl_call_counter::s_last[ call_type_count ] = { 0 };
+std::size_t bear::visual::gl_call_counter::s_total[ call_type_count ] = { 0 };
+std::size_t bear::visual::gl_call_counter::s_frames( 0 );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Counts a call made for the frame in progress.
+ * \param c The kind of the call.
+ */
+void bear::visual::gl_call_counter::count( call_type c )
+{
+  CLAW_PRECOND( c < call_type_count );
+  ++s_current[ c ];
+} // gl_call_counter::count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the number of calls of a given kind made for the last frame.
+ * \param c The kind of the calls.
+ */
+std::size_t bear::visual::gl_call_counter::get( call_type c )
+{
+  CLAW_PRECOND( c < call_type_count );
+  return s_last[ c ];
+} // gl_call_counter::get()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells that the frame in progress is done.
+ */
+void bear::visual::gl_call_counter::end_frame()
+{
+  for ( std::size_t i(0); i != call_type_count; ++i )
+    {
+      s_last[i] = s_current[i];
+      s_total[i] += s_current[i];
+      s_current[i] = 0;
+    }
+
+  ++s_frames;
+
+  if ( s_frames == s_log_period )
+    {
+      log_averages();
+
+      for ( std::size_t i(0); i != call_type_count; ++i )
+        s_total[i] = 0;
+
+      s_frames = 0;
+    }
+} // gl_call_counter::end_frame()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Writes the average number of calls per frame in the log.
+ */
+void bear::visual::gl_call_counter::log_averages()
+{
+  claw::logger << claw::log_verbose << "OpenGL calls per frame over "
+               << s_frames << " frames: programs "
+               << (double)s_total[ use_program_call ] / s_frames
+               << ", uniform locations "
+               << (double)s_total[ uniform_location_call ] / s_frames
+               << ", uniforms "
+               << (double)s_total[ uniform_call ] / s_frames
+               << ", textures "
+               << (double)s_total[ texture_call ] / s_frames
+               << ", draws "
+               << (double)s_total[ draw_call ] / s_frames
+               << std::endl;
+} // gl_call_counter::log_averages()
@@ -1,5 +1,7 @@
 #include "visual/gl_draw.hpp"
 
+#include "visual/gl_call_counter.hpp"
+
 #include "visual/gl_error.hpp"
 #include "visual/gl_state.hpp"
 #include "visual/detail/gl_vertex_attribute_index.hpp"
@@ -33,6 +35,8 @@ bear::visual::gl_draw::gl_draw
   const claw::math::coordinate_2d< unsigned int >& size )
   : m_white( white ),
     m_shader( shader ),
+    m_size( size ),
+    m_program( 0 ),
     m_background_color{ 0, 0, 0, 0 },
     m_vertex_count( 0 ),
     m_color_count( 0 ),
@@ -65,17 +69,48 @@ void bear::visual::gl_draw::draw( const std::vector< gl_state >& states )
   glClear( GL_COLOR_BUFFER_BIT );
   VISUAL_GL_ERROR_THROW();
 
-  for ( const gl_state& state : states )
-    {
-      prepare();
-      glUseProgram( m_shader );
-      VISUAL_GL_ERROR_THROW();
-  
-      state.draw( *this );
-      VISUAL_GL_ERROR_THROW();
+  // The program may have been changed since the last frame.
+  m_program = 0;
 
-      finalize();
-    }
+  draw_states( states );
+}
+
+void bear::visual::gl_draw::draw_offscreen
+( const std::vector< gl_state >& states,
+  const claw::math::coordinate_2d< unsigned int >& size )
+{
+  // The frame buffer currently bound is expected to be a texture of the given
+  // size. The y-axis is flipped such that the first line of the texture is the
+  // top of the rendered area, as in the images loaded from the files.
+  glClearColor( 0, 0, 0, 0 );
+  VISUAL_GL_ERROR_THROW();
+
+  glClear( GL_COLOR_BUFFER_BIT );
+  VISUAL_GL_ERROR_THROW();
+
+  m_program = 0;
+  set_viewport( size, true );
+
+  draw_states( states );
+
+  set_viewport( m_size );
+}
+
+void bear::visual::gl_draw::use_program( GLuint program )
+{
+  if ( program == m_program )
+    return;
+
+  glUseProgram( program );
+  VISUAL_GL_ERROR_THROW();
+  gl_call_counter::count( gl_call_counter::use_program_call );
+
+  m_program = program;
+}
+
+void bear::visual::gl_draw::use_default_program()
+{
+  use_program( m_shader );
 }
 
 void bear::visual::gl_draw::set_vertices
@@ -158,7 +193,10 @@ void bear::visual::gl_draw::draw( GLenum mode, GLuint first, GLuint count )
   assert( m_vertex_count != 0 );
   
   if ( m_texture_coordinate_count == 0 )
-    glBindTexture( GL_TEXTURE_2D, m_white );
+    {
+      glBindTexture( GL_TEXTURE_2D, m_white );
+      gl_call_counter::count( gl_call_counter::texture_call );
+    }
   
   generate_indices();
 
@@ -166,24 +204,25 @@ void bear::visual::gl_draw::draw( GLenum mode, GLuint first, GLuint count )
     ( mode, count, GL_UNSIGNED_SHORT,
       reinterpret_cast< GLvoid* >( first * sizeof( GLushort ) ) );
   VISUAL_GL_ERROR_THROW();
+  gl_call_counter::count( gl_call_counter::draw_call );
 }
 
 void bear::visual::gl_draw::set_viewport
-( const claw::math::coordinate_2d< unsigned int >& size )
+( const claw::math::coordinate_2d< unsigned int >& size, bool flip )
 {
   const GLfloat m00( GLfloat( 2 ) / size.x );
-  const GLfloat m11( GLfloat( 2 ) / size.y );
+  const GLfloat m11( GLfloat( flip ? -2 : 2 ) / size.y );
+  const GLfloat m31( flip ? 1 : -1 );
 
   const std::array< float, 16 > transform =
     {
       m00,   0,  0,  0,
         0, m11,  0,  0,
         0,   0, -2,  0,
-       -1,  -1,  1,  1
+       -1, m31,  1,  1
     };
 
-  glUseProgram( m_shader );
-  VISUAL_GL_ERROR_THROW();
+  use_program( m_shader );
   
   glUniformMatrix4fv
     ( glGetUniformLocation( m_shader, "transform" ), 1, GL_FALSE,
@@ -191,6 +230,20 @@ void bear::visual::gl_draw::set_viewport
   VISUAL_GL_ERROR_THROW();
 }
 
+void bear::visual::gl_draw::draw_states
+( const std::vector< gl_state >& states )
+{
+  for ( const gl_state& state : states )
+    {
+      prepare();
+  
+      state.draw( *this );
+      VISUAL_GL_ERROR_THROW();
+
+      finalize();
+    }
+}
+
 void bear::visual::gl_draw::prepare()
 {
   m_vertex_count = 0;
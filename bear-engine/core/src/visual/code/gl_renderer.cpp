@@ -13,9 +13,11 @@
  */
 #include "visual/gl_renderer.hpp"
 
+#include "visual/gl_call_counter.hpp"
 #include "visual/gl_capture_queue.hpp"
 #include "visual/gl_draw.hpp"
 #include "visual/gl_fragment_shader.hpp"
+#include "visual/gl_image.hpp"
 #include "visual/gl_error.hpp"
 #include "visual/gl_vertex_shader.hpp"
 #include "visual/sdl_error.hpp"
@@ -95,6 +97,11 @@ GLuint bear::visual::gl_renderer::create_texture( screen_size_type& size )
                GL_UNSIGNED_BYTE, nullptr );
   VISUAL_GL_ERROR_THROW();
 
+  // The repeated sprites wrap their texture coordinates around the texture.
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  VISUAL_GL_ERROR_THROW();
+
   release_context();
 
   return texture_id;
@@ -479,6 +486,25 @@ void bear::visual::gl_renderer::set_gl_states( state_list& states )
     m_render_condition.notify_one();
 } // gl_renderer::set_gl_states()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Sets some elements to render in an image. They are rendered before
+ *        the next frame, thus the image can be displayed in this frame.
+ * \param target The image in which the states are rendered. Its previous
+ *        content is lost.
+ * \param states States to render. The function steals the states and leaves
+ *        this parameter empty when returning.
+ */
+void bear::visual::gl_renderer::render_to_image
+( const image& target, state_list& states )
+{
+  boost::mutex::scoped_lock lock( m_mutex.gl_set_states );
+
+  m_image_renderings.push_back( image_rendering() );
+  m_image_renderings.back().target = target;
+  m_image_renderings.back().states.swap( states );
+} // gl_renderer::render_to_image()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Gets the color of the background.
@@ -633,6 +659,7 @@ void bear::visual::gl_renderer::render_states()
   // the gl_access mutex. Thus we have to ensure it is unlocked here.
   m_previous_states.swap( m_states );
   m_states.clear();
+  m_image_renderings.clear();
 } // gl_renderer::render_states()
 
 /*----------------------------------------------------------------------------*/
@@ -644,8 +671,10 @@ void bear::visual::gl_renderer::draw_scene()
   boost::mutex::scoped_lock gl_lock( m_mutex.gl_access );
   make_current();
 
+  draw_images();
   m_draw->draw( m_states );
   m_capture_queue->draw( *m_draw );
+  gl_call_counter::end_frame();
   
   SDL_GL_SwapWindow( m_window );
   VISUAL_GL_ERROR_THROW();
@@ -653,6 +682,55 @@ void bear::visual::gl_renderer::draw_scene()
   release_context();
 }
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Renders the states of m_image_renderings in their target images.
+ */
+void bear::visual::gl_renderer::draw_images()
+{
+  if ( m_image_renderings.empty() )
+    return;
+
+  if ( m_image_frame_buffer == 0 )
+    {
+      glGenFramebuffers( 1, &m_image_frame_buffer );
+      VISUAL_GL_ERROR_THROW();
+    }
+
+  glBindFramebuffer( GL_FRAMEBUFFER, m_image_frame_buffer );
+  VISUAL_GL_ERROR_THROW();
+
+  // The alpha of the images must be the coverage of the rendered pixels, such
+  // that they blend correctly once drawn on the screen.
+  glBlendFuncSeparate
+    ( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA );
+  VISUAL_GL_ERROR_THROW();
+
+  for ( const image_rendering& r : m_image_renderings )
+    {
+      const gl_image* impl
+        ( static_cast<const gl_image*>( r.target.get_impl() ) );
+
+      glFramebufferTexture2D
+        ( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+          impl->texture_id(), 0 );
+      VISUAL_GL_ERROR_THROW();
+
+      glViewport( 0, 0, r.target.width(), r.target.height() );
+      VISUAL_GL_ERROR_THROW();
+
+      m_draw->draw_offscreen( r.states, r.target.size() );
+    }
+
+  glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+  VISUAL_GL_ERROR_THROW();
+
+  glBindFramebuffer( GL_FRAMEBUFFER, 0 );
+  VISUAL_GL_ERROR_THROW();
+
+  resize_view();
+} // gl_renderer::draw_images()
+
 void bear::visual::gl_renderer::update_screenshot
 ( systime::milliseconds_type render_time )
 {
@@ -985,6 +1063,7 @@ bear::visual::gl_renderer::gl_renderer()
     m_fullscreen( false ),
     m_video_mode_is_set( false ),
     m_paused( false ),
+    m_image_frame_buffer( 0 ),
     m_render_ready( false ),
     m_draw( nullptr ),
     m_capture_queue( nullptr )
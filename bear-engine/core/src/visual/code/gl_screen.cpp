@@ -170,6 +170,58 @@ void bear::visual::gl_screen::render
   render_sprite( pos, s );
 } // gl_screen::render()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Draw a sprite several times on the gl_screen, side by side.
+ *
+ * When the sprite covers its whole texture, the repeated area is drawn as a
+ * single quad whose texture coordinates wrap around the texture. Otherwise the
+ * sprite comes from an atlas, wrapping would show its neighbours, and a quad
+ * is pushed for each repetition.
+ *
+ * \param pos On gl_screen position of the bottom left repetition.
+ * \param s The sprite to draw.
+ * \param x_count The number of repetitions on the x-axis.
+ * \param y_count The number of repetitions on the y-axis.
+ */
+void bear::visual::gl_screen::render_repeated
+( const position_type& pos, const sprite& s, unsigned int x_count,
+  unsigned int y_count )
+{
+  if ( (s.clip_rectangle().width == 0) || (s.clip_rectangle().height == 0 )
+       || (x_count == 0) || (y_count == 0) )
+    return;
+
+  if ( !is_wrappable(s) )
+    {
+      for ( unsigned int x=0; x!=x_count; ++x )
+        for ( unsigned int y=0; y!=y_count; ++y )
+          render_sprite
+            ( position_type
+              ( pos.x + x * s.width(), pos.y + y * s.height() ), s );
+
+      return;
+    }
+
+  const claw::math::box_2d<GLfloat> clip_vertices( 0, 0, x_count, y_count );
+
+  sprite area(s);
+  area.set_size( s.width() * x_count, s.height() * y_count );
+
+  std::vector<position_type> render_coord(4);
+  get_render_coord( pos, area, render_coord );
+
+  color_type color;
+  color.set
+    ( s.get_red_intensity(), s.get_green_intensity(),
+      s.get_blue_intensity(), s.get_opacity() );
+
+  const gl_image* impl = static_cast<const gl_image*>(s.get_image().get_impl());
+  GLuint texture_id( impl->texture_id() );
+
+  render_image( texture_id, render_coord, clip_vertices, color );
+} // gl_screen::render_repeated()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Stop the rendering process.
@@ -180,6 +232,40 @@ void bear::visual::gl_screen::end_render()
   gl_renderer::get_instance().set_gl_states( m_gl_state );
 } // gl_screen::end_render()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Starts rendering in an image. The next rendering commands are
+ *        rendered in this image until end_image_render() is called, without
+ *        altering the rendering of the frame.
+ * \param target The image in which the commands are rendered.
+ */
+void bear::visual::gl_screen::begin_image_render( const image& target )
+{
+  CLAW_PRECOND( m_frame_gl_state.empty() );
+  CLAW_PRECOND( m_frame_shader.empty() );
+
+  m_image_target = target;
+  m_frame_gl_state.swap( m_gl_state );
+  m_frame_shader.swap( m_shader );
+} // gl_screen::begin_image_render()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Ends the rendering in the image passed to begin_image_render(). The
+ *        image receives its content before the next frame is displayed.
+ */
+void bear::visual::gl_screen::end_image_render()
+{
+  m_frame_gl_state.swap( m_gl_state );
+  m_frame_shader.swap( m_shader );
+  m_frame_shader.clear();
+
+  gl_renderer::get_instance().render_to_image
+    ( m_image_target, m_frame_gl_state );
+
+  m_image_target = image();
+} // gl_screen::end_image_render()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Draw a line.
@@ -285,6 +371,22 @@ void bear::visual::gl_screen::render_sprite
   render_image( texture_id, render_coord, clip_vertices, color );
 } // gl_screen::render_sprite()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells if a sprite can be repeated by wrapping the texture coordinates
+ *        around its texture.
+ * \param s The sprite to check.
+ */
+bool bear::visual::gl_screen::is_wrappable( const sprite& s ) const
+{
+  const sprite::clip_rectangle_type& clip( s.clip_rectangle() );
+
+  return (s.get_angle() == 0)
+    && (clip.position.x == 0) && (clip.position.y == 0)
+    && (clip.width == s.get_image().width())
+    && (clip.height == s.get_image().height());
+} // gl_screen::is_wrappable()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the coordinates of the corners of a sprite after transformation
@@ -13,8 +13,23 @@
  */
 #include "visual/gl_shader_program.hpp"
 
+#include "visual/gl_call_counter.hpp"
+#include "visual/gl_error.hpp"
 #include "visual/gl_renderer.hpp"
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructs the state of a uniform whose location is not known yet.
+ */
+bear::visual::gl_shader_program::uniform_state::uniform_state()
+  : location( -1 ), uploaded( false )
+{
+
+} // gl_shader_program::uniform_state::uniform_state()
+
+
+
+
 bear::visual::gl_shader_program::gl_shader_program
 ( const std::string& fragment_code, const std::string& vertex_code )
   : m_fragment_shader( fragment_code ),
@@ -42,3 +57,40 @@ GLuint bear::visual::gl_shader_program::program_id() const
 {
   return m_program_id;
 } // gl_shader_program::program_id()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Records the value of a uniform about to be applied to the program.
+ * \param v The variable to apply.
+ * \return The location where the value must be uploaded, or -1 if the
+ *         program already has this value or has no such uniform.
+ *
+ * The location of the uniform is queried from OpenGL only the first time the
+ * uniform is applied.
+ */
+GLint bear::visual::gl_shader_program::update_uniform
+( const shader_variable_map::variable& v ) const
+{
+  uniform_map::iterator it( m_uniforms.find( v.get_name() ) );
+
+  if ( it == m_uniforms.end() )
+    {
+      it = m_uniforms.insert
+        ( uniform_map::value_type( v.get_name(), uniform_state() ) ).first;
+
+      it->second.location =
+        glGetUniformLocation( m_program_id, v.get_name().c_str() );
+      VISUAL_GL_ERROR_THROW();
+      gl_call_counter::count( gl_call_counter::uniform_location_call );
+    }
+
+  uniform_state& state( it->second );
+
+  if ( (state.location == -1) || (state.uploaded && (state.value == v)) )
+    return -1;
+
+  state.value = v;
+  state.uploaded = true;
+
+  return state.location;
+} // gl_shader_program::update_uniform()
@@ -13,51 +13,17 @@
  */
 #include "visual/gl_state.hpp"
 
+#include "visual/gl_call_counter.hpp"
 #include "visual/gl_draw.hpp"
 #include "visual/gl_error.hpp"
 #include "visual/gl_shader_program.hpp"
 #include "visual/detail/apply_shader.hpp"
 
+#include <claw/assert.hpp>
 #include <claw/exception.hpp>
 
 #include <limits>
 
-/*----------------------------------------------------------------------------*/
-/**
- * \brief Tests if the visited variables exists with the same value in a given
- *        var map.
- * \param result The result of the visit.
- * \param vars The variable_map to compare to.
- */
-bear::visual::gl_state::variables_are_included::variables_are_included
-( bool& result, const shader_program::input_variable_map& vars )
-  : m_result( result ), m_variables( vars )
-{
-
-} // gl_state::variables_are_included::variables_are_included()
-
-/*----------------------------------------------------------------------------*/
-/**
- * \brief Sets the value of an integer uniform.
- * \param name The name of the uniform.
- * \param value The value to assign to the uniform.
- */
-template<typename T>
-void bear::visual::gl_state::variables_are_included::operator()
-( const std::string& name, const T& value ) const
-{
-  if ( !m_result )
-    return;
-
-  if ( !m_variables.exists<T>( name ) )
-    m_result = false;
-  else
-    m_result = ( value == m_variables.get<T>( name ) );
-} // gl_state::variables_are_included::operator()()
-
-
-
-
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructs the range of elements for a given texture.
@@ -165,21 +131,15 @@ bool bear::visual::gl_state::is_compatible_with( const gl_state& state ) const
       if ( this_shader->program_id() != that_shader->program_id() )
         return false;
 
-      shader_program::variable_visitor_type visitor;
-      shader_program::input_variable_map this_shader_vars
+      const shader_program::input_variable_map& this_shader_vars
         ( m_shader.get_variables() );
-      shader_program::input_variable_map that_shader_vars
+      const shader_program::input_variable_map& that_shader_vars
         ( state.m_shader.get_variables() );
-      bool equal_variables( true );
-
-      visitor.run
-        ( this_shader_vars,
-          variables_are_included( equal_variables, that_shader_vars ) );
-      visitor.run
-        ( that_shader_vars,
-          variables_are_included( equal_variables, this_shader_vars ) );
 
-      return equal_variables;
+      // The copies of a program share their variables, and the variables of
+      // different programs are compared by their hashes first.
+      return ( &this_shader_vars == &that_shader_vars )
+        || ( this_shader_vars == that_shader_vars );
     }
 
   return false;
@@ -230,6 +190,19 @@ void bear::visual::gl_state::draw( gl_draw& output ) const
     draw_textured( output );
 } // gl_state::draw()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Selects the program with which the vertices are drawn.
+ * \param output The target of the draw.
+ */
+void bear::visual::gl_state::use_program( gl_draw& output ) const
+{
+  if ( m_shader.is_valid() )
+    detail::apply_shader( m_shader, output );
+  else
+    output.use_default_program();
+} // gl_state::use_program()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Draws the vertices in the case where there is no texture.
@@ -239,8 +212,7 @@ void bear::visual::gl_state::draw_shape( gl_draw& output ) const
   if ( m_vertices.empty() )
     return;
 
-  if ( m_shader.is_valid() )
-    detail::apply_shader( m_shader );
+  use_program( output );
 
   if ( m_line_width > 0 )
     {
@@ -263,8 +235,7 @@ void bear::visual::gl_state::draw_textured( gl_draw& output ) const
   if ( m_vertices.empty() )
     return;
 
-  if ( m_shader.is_valid() )
-    detail::apply_shader( m_shader );
+  use_program( output );
 
   set_colors( output );
   set_vertices( output );
@@ -277,6 +248,7 @@ void bear::visual::gl_state::draw_textured( gl_draw& output ) const
     {
       glBindTexture( GL_TEXTURE_2D, it->texture_id );
       VISUAL_GL_ERROR_THROW();
+      gl_call_counter::count( gl_call_counter::texture_call );
 
       glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
       VISUAL_GL_ERROR_THROW();
@@ -15,6 +15,7 @@
 
 #include "visual/screen.hpp"
 #include "visual/gl_image.hpp"
+#include "visual/null_image.hpp"
 
 #include <claw/exception.hpp>
 
@@ -42,6 +43,9 @@ bear::visual::image::image( unsigned int width, unsigned int height )
     case screen::screen_gl:
       *m_impl = new gl_image( width, height );
       break;
+    case screen::screen_null:
+      *m_impl = new null_image( width, height );
+      break;
     case screen::screen_undef:
       claw::exception("screen sub system has not been set.");
     }
@@ -88,6 +92,9 @@ void bear::visual::image::restore( const claw::graphic::image& data )
     case screen::screen_gl:
       *m_impl = new gl_image(data);
       break;
+    case screen::screen_null:
+      *m_impl = new null_image(data);
+      break;
     case screen::screen_undef:
       claw::exception("screen sub system has not been set.");
     }
@@ -0,0 +1,33 @@
+#include "visual/null_capture.hpp"
+
+#include <algorithm>
+
+bear::visual::null_capture::null_capture
+( const claw::math::coordinate_2d< unsigned int >& size,
+  const color& background )
+  : m_size( size ), m_background( background )
+{
+
+}
+
+bear::visual::null_capture* bear::visual::null_capture::clone() const
+{
+  return new null_capture( *this );
+}
+
+boost::signals2::connection
+bear::visual::null_capture::render
+( const capture_ready& ready, const capture_progress& progress )
+{
+  claw::graphic::image result( m_size.x, m_size.y );
+
+  for ( unsigned int y( 0 ); y != m_size.y; ++y )
+    std::fill( result[ y ].begin(), result[ y ].end(), m_background );
+
+  if ( progress )
+    progress( 1 );
+
+  ready( result );
+
+  return boost::signals2::connection();
+}
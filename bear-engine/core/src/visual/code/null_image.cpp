@@ -0,0 +1,92 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::visual::null_image class.
+ * \author Julien Jorge
+ */
+#include "visual/null_image.hpp"
+
+#include <algorithm>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructs an image of a given size.
+ * \param width The width of the image.
+ * \param height The height of the image.
+ */
+bear::visual::null_image::null_image( unsigned int width, unsigned int height )
+  : m_size(width, height), m_has_transparency(false)
+{
+
+} // null_image::null_image()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor with a claw::graphic::image object.
+ * \param data The image whose size and transparency are kept.
+ */
+bear::visual::null_image::null_image( const claw::graphic::image& data )
+  : m_size(data.width(), data.height()), m_has_transparency(false)
+{
+  draw( data, claw::math::coordinate_2d<unsigned int>( 0, 0 ) );
+} // null_image::null_image() [claw::graphic::image]
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get image's size.
+ */
+claw::math::coordinate_2d<unsigned int>
+bear::visual::null_image::size() const
+{
+  return m_size;
+} // null_image::size()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the image has transparent pixels.
+ */
+bool bear::visual::null_image::has_transparency() const
+{
+  return m_has_transparency;
+} // null_image::has_transparency()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Replaces a portion of this image with a given data. Only the
+ *        transparency of the data is kept, as gl_image does.
+ * \param data The pixels to copy in the image.
+ * \param pos The position in the image where data must be copied.
+ */
+void bear::visual::null_image::draw
+( const claw::graphic::image& data,
+  claw::math::coordinate_2d<unsigned int> pos )
+{
+  m_has_transparency = false;
+
+  for ( claw::graphic::image::const_iterator it( data.begin() );
+        !m_has_transparency && (it != data.end()); ++it )
+    m_has_transparency = ( it->components.alpha != 255 );
+} // null_image::draw()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Reads the pixel colors of the image. Since the pixels are not kept,
+ *        the result is fully transparent.
+ */
+claw::graphic::image bear::visual::null_image::read() const
+{
+  claw::graphic::image result( m_size.x, m_size.y );
+  claw::graphic::rgba_pixel transparent( 0, 0, 0, 0 );
+
+  for ( unsigned int y( 0 ); y != m_size.y; ++y )
+    std::fill( result[ y ].begin(), result[ y ].end(), transparent );
+
+  return result;
+} // null_image::read()
@@ -0,0 +1,229 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::visual::null_screen class.
+ * \author Julien Jorge
+ */
+#include "visual/null_screen.hpp"
+
+#include "visual/null_capture.hpp"
+
+#include <algorithm>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param size Size of the screen.
+ * \param title The title of the window, ignored.
+ * \param full Tell if the window is full screen or not, ignored.
+ */
+bear::visual::null_screen::null_screen
+( const claw::math::coordinate_2d<unsigned int>& size,
+  const std::string& title, bool full )
+  : m_size( size ), m_background_color( 0, 0, 0 )
+{
+
+} // null_screen::null_screen()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Suspends the display. Does nothing.
+ */
+void bear::visual::null_screen::pause()
+{
+
+} // null_screen::pause()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Resumes the display. Does nothing.
+ */
+void bear::visual::null_screen::unpause()
+{
+
+} // null_screen::unpause()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Turn fullscreen mode on/off. Does nothing.
+ * \param b Tell if we want a fullscreen mode.
+ */
+void bear::visual::null_screen::fullscreen( bool b )
+{
+
+} // null_screen::fullscreen()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the size of the screen.
+ */
+claw::math::coordinate_2d<unsigned int>
+bear::visual::null_screen::get_size() const
+{
+  return m_size;
+} // null_screen::get_size()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the size of the area where the scene is displayed, which is the
+ *        size of the screen.
+ */
+claw::math::coordinate_2d<unsigned int>
+bear::visual::null_screen::get_viewport_size() const
+{
+  return m_size;
+} // null_screen::get_viewport_size()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the size of the container of the screen, which is the size of
+ *        the screen.
+ */
+claw::math::coordinate_2d<unsigned int>
+bear::visual::null_screen::get_container_size() const
+{
+  return m_size;
+} // null_screen::get_container_size()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the color of the background.
+ * \param c The color.
+ */
+void bear::visual::null_screen::set_background_color( const color_type& c )
+{
+  m_background_color = c;
+} // null_screen::set_background_color()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the color of the background.
+ */
+bear::visual::color_type
+bear::visual::null_screen::get_background_color() const
+{
+  return m_background_color;
+} // null_screen::get_background_color()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Draw a sprite on the screen. Does nothing.
+ * \param pos On screen position of the sprite.
+ * \param s The sprite to draw.
+ */
+void bear::visual::null_screen::render
+( const position_type& pos, const sprite& s )
+{
+
+} // null_screen::render()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Draw a sprite several times on the screen. Does nothing.
+ * \param pos On screen position of the first sprite.
+ * \param s The sprite to draw.
+ * \param x_count How many times the sprite is repeated horizontally.
+ * \param y_count How many times the sprite is repeated vertically.
+ */
+void bear::visual::null_screen::render_repeated
+( const position_type& pos, const sprite& s, unsigned int x_count,
+  unsigned int y_count )
+{
+
+} // null_screen::render_repeated()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Start to draw in an image. Does nothing.
+ * \param target The image in which the next elements would be drawn.
+ */
+void bear::visual::null_screen::begin_image_render( const image& target )
+{
+
+} // null_screen::begin_image_render()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Stop to draw in an image. Does nothing.
+ */
+void bear::visual::null_screen::end_image_render()
+{
+
+} // null_screen::end_image_render()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Draw a line. Does nothing.
+ * \param color The color of the line.
+ * \param p The points of the line.
+ * \param w The width of the line.
+ * \param close Tell if the line loops.
+ */
+void bear::visual::null_screen::draw_line
+( const color_type& color, const std::vector<position_type>& p, double w,
+  bool close )
+{
+
+} // null_screen::draw_line()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Draw a filled polygon. Does nothing.
+ * \param color The color of the polygon.
+ * \param p The points of the polygon.
+ */
+void bear::visual::null_screen::draw_polygon
+( const color_type& color, const std::vector<position_type>& p )
+{
+
+} // null_screen::draw_polygon()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Use a shader for the next rendering commands. Does nothing.
+ * \param p The shader.
+ */
+void bear::visual::null_screen::push_shader( const shader_program& p )
+{
+
+} // null_screen::push_shader()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Stop using the last shader passed to push_shader(). Does nothing.
+ */
+void bear::visual::null_screen::pop_shader()
+{
+
+} // null_screen::pop_shader()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Do a screen shot. The image is filled with the color of the
+ *        background.
+ * \param img The image in which we save the content of the screen.
+ */
+void bear::visual::null_screen::shot( claw::graphic::image& img ) const
+{
+  img.set_size( m_size.x, m_size.y );
+
+  for ( unsigned int y( 0 ); y != m_size.y; ++y )
+    std::fill( img[ y ].begin(), img[ y ].end(), m_background_color );
+} // null_screen::shot()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Capture the content of the screen. The captured image is filled with
+ *        the color of the background.
+ */
+bear::visual::capture bear::visual::null_screen::capture_scene() const
+{
+  return null_capture( m_size, m_background_color );
+} // null_screen::capture_scene()
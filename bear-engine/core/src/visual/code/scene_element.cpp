@@ -13,6 +13,8 @@
  */
 #include "visual/scene_element.hpp"
 
+#include <utility>
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
@@ -35,6 +37,18 @@ bear::visual::scene_element::scene_element( const scene_element& that )
 
 } // scene_element::scene_element()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Move constructor. The effective element is taken from \a that, which
+ *        can only be destroyed or assigned afterwards.
+ * \param that The instance to move from.
+ */
+bear::visual::scene_element::scene_element( scene_element&& that ) noexcept
+  : m_elem(that.m_elem)
+{
+  that.m_elem = NULL;
+} // scene_element::scene_element()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Destructor.
@@ -60,6 +74,19 @@ bear::visual::scene_element::operator=( const scene_element& that )
   return *this;
 } // scene_element::operator=()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Move assignment. The effective elements of the two instances are
+ *        exchanged.
+ * \param that The instance to move from.
+ */
+bear::visual::scene_element&
+bear::visual::scene_element::operator=( scene_element&& that ) noexcept
+{
+  std::swap( m_elem, that.m_elem );
+  return *this;
+} // scene_element::operator=()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get a rectangle where the element is fully opaque.
@@ -101,6 +128,19 @@ void bear::visual::scene_element::render( base_screen& scr ) const
   m_elem->render(scr);
 } // scene_element::render()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Render the element several times on a screen, side by side.
+ * \param scr The screen on which we render the element.
+ * \param x_count The number of repetitions on the x-axis.
+ * \param y_count The number of repetitions on the y-axis.
+ */
+void bear::visual::scene_element::render_repeated
+( base_screen& scr, unsigned int x_count, unsigned int y_count ) const
+{
+  m_elem->render_repeated(scr, x_count, y_count);
+} // scene_element::render_repeated()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the position on the element on the screen.
@@ -0,0 +1,90 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the visual::scene_pattern.
+ * \author Julien Jorge
+ */
+#include "visual/scene_pattern.hpp"
+
+#include "visual/base_screen.hpp"
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param x X-position of the bottom left repetition on the screen.
+ * \param y Y-position of the bottom left repetition on the screen.
+ * \param e The element to repeat.
+ * \param x_count The number of repetitions on the x-axis.
+ * \param y_count The number of repetitions on the y-axis.
+ */
+bear::visual::scene_pattern::scene_pattern
+( coordinate_type x, coordinate_type y, const scene_element& e,
+  unsigned int x_count, unsigned int y_count )
+  : base_scene_element(x, y), m_element(e), m_x_count(x_count),
+    m_y_count(y_count)
+{
+  m_element.set_position(x, y);
+} // scene_pattern::scene_pattern()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Allocate a copy of this instance.
+ */
+bear::visual::base_scene_element* bear::visual::scene_pattern::clone() const
+{
+  return new scene_pattern(*this);
+} // scene_pattern::clone()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get a rectangle where the pattern is completely opaque. The pattern
+ *        is opaque only if its element is opaque everywhere.
+ */
+bear::visual::rectangle_type
+bear::visual::scene_pattern::get_opaque_box() const
+{
+  const rectangle_type box( m_element.get_bounding_box() );
+
+  if ( (get_rendering_attributes().get_opacity() != 1)
+       || (m_element.get_opaque_box() != box) )
+    return rectangle_type(0, 0, 0, 0);
+  else
+    return get_bounding_box();
+} // scene_pattern::get_opaque_box()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get a rectangle bounding all the repetitions.
+ */
+bear::visual::rectangle_type
+bear::visual::scene_pattern::get_bounding_box() const
+{
+  const rectangle_type box( m_element.get_bounding_box() );
+
+  return rectangle_type
+    ( get_position().x, get_position().y,
+      get_position().x + box.width() * m_x_count,
+      get_position().y + box.height() * m_y_count );
+} // scene_pattern::get_bounding_box()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Render the pattern on a screen.
+ * \param scr The screen on which we render the pattern.
+ */
+void bear::visual::scene_pattern::render( base_screen& scr ) const
+{
+  scene_element e(m_element);
+
+  e.get_rendering_attributes().combine(get_rendering_attributes());
+  e.set_position( get_position() );
+
+  e.render_repeated( scr, m_x_count, m_y_count );
+} // scene_pattern::render()
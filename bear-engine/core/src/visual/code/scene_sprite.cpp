@@ -159,6 +159,36 @@ void bear::visual::scene_sprite::render( base_screen& scr ) const
   scr.render(get_position(), s);
 } // scene_sprite::render()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Render the sprite several times on a screen, side by side. The screen
+ *        receives the whole repeated area in a single command, unless the
+ *        sprite is rotated.
+ * \param scr The screen on which we render the sprite.
+ * \param x_count The number of repetitions on the x-axis.
+ * \param y_count The number of repetitions on the y-axis.
+ */
+void bear::visual::scene_sprite::render_repeated
+( base_screen& scr, unsigned int x_count, unsigned int y_count ) const
+{
+  if ( !m_sprite.is_valid() )
+    return;
+
+  sprite s(m_sprite);
+  s.combine( get_rendering_attributes() );
+
+  if ( s.get_angle() != 0 )
+    base_scene_element::render_repeated( scr, x_count, y_count );
+  else
+    {
+      s.set_size
+        ( s.width() * get_scale_factor_x(),
+          s.height() * get_scale_factor_y() );
+
+      scr.render_repeated(get_position(), s, x_count, y_count);
+    }
+} // scene_sprite::render_repeated()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Change the sprite of the visual.
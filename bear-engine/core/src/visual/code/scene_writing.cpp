@@ -100,7 +100,7 @@ void bear::visual::scene_writing::render
   const double r_y
     ( get_scale_factor_y() * get_rendering_attributes().height() / w.height() );
 
-  for ( std::size_t i=0; i!=w.get_sprites_count(); ++i )
+  for ( std::size_t i=0; i!=w.get_visible_sprites_count(); ++i )
     {
       placed_sprite s( w.get_sprite(i) );
       position_type p(get_position());
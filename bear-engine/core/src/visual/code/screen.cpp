@@ -14,6 +14,7 @@
 #include "visual/screen.hpp"
 
 #include "visual/gl_screen.hpp"
+#include "visual/null_screen.hpp"
 
 #include <claw/exception.hpp>
 #include <claw/bitmap.hpp>
@@ -42,6 +43,7 @@ void bear::visual::screen::initialize( sub_system sub_sys )
     case screen_gl:
       gl_screen::initialize();
       break;
+    case screen_null:
     case screen_undef:
       {
         // nothing to do
@@ -61,6 +63,7 @@ void bear::visual::screen::release()
     case screen_gl:
       gl_screen::release();
       break;
+    case screen_null:
     case screen_undef:
       {
         // nothing to do
@@ -96,6 +99,9 @@ bear::visual::screen::screen
     case screen_gl:
       m_impl = new gl_screen(size, title, full);
       break;
+    case screen_null:
+      m_impl = new null_screen(size, title, full);
+      break;
     case screen_undef:
       claw::exception("screen sub system has not been set.");
     }
@@ -228,19 +234,7 @@ void bear::visual::screen::render( const scene_element& e )
     return;
 
   if ( e.has_shadow() )
-    {
-      scene_element shadow( e );
-      shadow.set_shadow( 0, 0 );
-      shadow.set_shadow_opacity( 0 );
-
-      shadow.get_rendering_attributes().set_intensity(0, 0, 0);
-      shadow.get_rendering_attributes().set_opacity
-        ( e.get_rendering_attributes().get_opacity() * e.get_shadow_opacity() );
-
-      shadow.set_position( e.get_position() + e.get_shadow() );
-
-      m_scene_element.push_back( shadow );
-    }
+    m_scene_element.push_back( make_shadow(e) );
 
   m_scene_element.push_back(e);
 } // screen::render()
@@ -261,6 +255,35 @@ void bear::visual::screen::end_render()
   m_mode = SCREEN_IDLE;
 } // screen::end_render()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Draw some elements in an image instead of the screen. The elements
+ *        are drawn in the given order, without searching the hidden parts,
+ *        and the image receives its content before the next frame is
+ *        displayed. This method can be called during the rendering of a
+ *        frame, it does not alter it.
+ * \param target The image in which the elements are drawn. The coordinates of
+ *        the elements are relative to its bottom left corner.
+ * \param elements The elements to draw.
+ */
+void bear::visual::screen::render_to_image
+( const image& target, const std::list<scene_element>& elements )
+{
+  m_impl->begin_image_render( target );
+
+  for ( std::list<scene_element>::const_iterator it=elements.begin();
+        it!=elements.end(); ++it )
+    if ( it->always_displayed() || !it->get_bounding_box().empty() )
+      {
+        if ( it->has_shadow() )
+          make_shadow(*it).render(*m_impl);
+
+        it->render(*m_impl);
+      }
+
+  m_impl->end_image_render();
+} // screen::render_to_image()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Do a screen shot.
@@ -298,6 +321,27 @@ bear::visual::capture bear::visual::screen::capture_scene() const
   return m_impl->capture_scene();
 }
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Create the element rendering the shadow of a given element.
+ * \param e The element whose shadow is created.
+ */
+bear::visual::scene_element
+bear::visual::screen::make_shadow( const scene_element& e ) const
+{
+  scene_element shadow( e );
+  shadow.set_shadow( 0, 0 );
+  shadow.set_shadow_opacity( 0 );
+
+  shadow.get_rendering_attributes().set_intensity(0, 0, 0);
+  shadow.get_rendering_attributes().set_opacity
+    ( e.get_rendering_attributes().get_opacity() * e.get_shadow_opacity() );
+
+  shadow.set_position( e.get_position() + e.get_shadow() );
+
+  return shadow;
+} // screen::make_shadow()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Render the opaque box of an element.
@@ -15,11 +15,27 @@
 
 #include "visual/screen.hpp"
 #include "visual/gl_shader_program.hpp"
+#include "visual/null_shader_program.hpp"
 #include "visual/detail/get_default_fragment_shader_code.hpp"
 #include "visual/detail/get_default_vertex_shader_code.hpp"
 
+#include <claw/assert.hpp>
 #include <claw/exception.hpp>
 
+#include <sstream>
+
+namespace bear
+{
+  namespace visual
+  {
+    namespace detail
+    {
+      /** \brief The variables of the programs having no variable. */
+      static const shader_program::input_variable_map g_no_variables;
+    }
+  }
+}
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
@@ -76,6 +92,9 @@ void bear::visual::shader_program::restore
     case screen::screen_gl:
       *m_impl = new gl_shader_program( fragment, vertex );
       break;
+    case screen::screen_null:
+      *m_impl = new null_shader_program;
+      break;
     case screen::screen_undef:
       claw::exception("screen sub system has not been set.");
     }
@@ -110,9 +129,16 @@ bear::visual::shader_program::get_impl() const
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Gets the values of th variables of the program.
+ *
+ * The copies of a program share the same variables until one of them sets a
+ * variable, thus comparing the addresses of the results is enough to detect
+ * the common case of two programs with the same variables.
  */
 const bear::visual::shader_program::input_variable_map&
 bear::visual::shader_program::get_variables() const
 {
-  return m_input_variable;
+  if ( m_input_variable == NULL )
+    return detail::g_no_variables;
+  else
+    return *m_input_variable;
 } // shader_program::get_variables()
@@ -0,0 +1,424 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::visual::shader_variable_map class.
+ * \author Julien Jorge
+ */
+#include "visual/shader_variable_map.hpp"
+
+#include <claw/assert.hpp>
+
+#include <algorithm>
+#include <functional>
+
+namespace bear
+{
+  namespace visual
+  {
+    namespace detail
+    {
+      /**
+       * \brief Orders the variables by name.
+       */
+      struct variable_name_less
+      {
+        bool operator()
+        ( const shader_variable_map::variable& v,
+          const std::string& name ) const
+        {
+          return v.get_name() < name;
+        }
+      }; // struct variable_name_less
+
+      /**
+       * \brief Combines a hash with the hash of a value.
+       * \param seed The hash to update.
+       * \param h The hash of the value.
+       */
+      static void hash_combine( std::size_t& seed, std::size_t h )
+      {
+        seed ^= h + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      } // hash_combine()
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Default constructor. The variable is the integer zero with an empty
+ *        name.
+ */
+bear::visual::shader_variable_map::variable::variable()
+  : m_type( int_value )
+{
+  m_value.int_value = 0;
+  compute_hash();
+} // shader_variable_map::variable::variable()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructs an integer variable.
+ * \param name The name of the variable.
+ * \param value The value of the variable.
+ */
+bear::visual::shader_variable_map::variable::variable
+( const std::string& name, int value )
+  : m_name( name ), m_type( int_value )
+{
+  m_value.int_value = value;
+  compute_hash();
+} // shader_variable_map::variable::variable()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructs a boolean variable.
+ * \param name The name of the variable.
+ * \param value The value of the variable.
+ */
+bear::visual::shader_variable_map::variable::variable
+( const std::string& name, bool value )
+  : m_name( name ), m_type( bool_value )
+{
+  m_value.bool_value = value;
+  compute_hash();
+} // shader_variable_map::variable::variable()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructs a real variable.
+ * \param name The name of the variable.
+ * \param value The value of the variable.
+ */
+bear::visual::shader_variable_map::variable::variable
+( const std::string& name, float value )
+  : m_name( name ), m_type( float_value )
+{
+  m_value.float_value = value;
+  compute_hash();
+} // shader_variable_map::variable::variable()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructs a matrix variable.
+ * \param name The name of the variable.
+ * \param value The value of the variable.
+ */
+bear::visual::shader_variable_map::variable::variable
+( const std::string& name, const matrix_type& value )
+  : m_name( name ), m_type( matrix_value ), m_matrix( value )
+{
+  m_value.int_value = 0;
+  compute_hash();
+} // shader_variable_map::variable::variable()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the name of the variable.
+ */
+const std::string&
+bear::visual::shader_variable_map::variable::get_name() const
+{
+  return m_name;
+} // shader_variable_map::variable::get_name()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the type of the value of the variable.
+ */
+bear::visual::shader_variable_map::value_type
+bear::visual::shader_variable_map::variable::get_type() const
+{
+  return m_type;
+} // shader_variable_map::variable::get_type()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the hash of the name, the type and the value of the variable.
+ */
+std::size_t bear::visual::shader_variable_map::variable::get_hash() const
+{
+  return m_hash;
+} // shader_variable_map::variable::get_hash()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the value of an integer variable.
+ */
+int bear::visual::shader_variable_map::variable::get_int() const
+{
+  CLAW_PRECOND( m_type == int_value );
+  return m_value.int_value;
+} // shader_variable_map::variable::get_int()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the value of a boolean variable.
+ */
+bool bear::visual::shader_variable_map::variable::get_bool() const
+{
+  CLAW_PRECOND( m_type == bool_value );
+  return m_value.bool_value;
+} // shader_variable_map::variable::get_bool()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the value of a real variable.
+ */
+float bear::visual::shader_variable_map::variable::get_float() const
+{
+  CLAW_PRECOND( m_type == float_value );
+  return m_value.float_value;
+} // shader_variable_map::variable::get_float()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the value of a matrix variable.
+ */
+const bear::visual::shader_variable_map::matrix_type&
+bear::visual::shader_variable_map::variable::get_matrix() const
+{
+  CLAW_PRECOND( m_type == matrix_value );
+  return m_matrix;
+} // shader_variable_map::variable::get_matrix()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells if two variables have the same name and the same value.
+ * \param that The variable to compare to.
+ */
+bool bear::visual::shader_variable_map::variable::operator==
+( const variable& that ) const
+{
+  if ( (m_hash != that.m_hash) || (m_type != that.m_type)
+       || (m_name != that.m_name) )
+    return false;
+
+  switch ( m_type )
+    {
+    case int_value: return m_value.int_value == that.m_value.int_value;
+    case bool_value: return m_value.bool_value == that.m_value.bool_value;
+    case float_value: return m_value.float_value == that.m_value.float_value;
+    case matrix_value: return m_matrix == that.m_matrix;
+    }
+
+  return false;
+} // shader_variable_map::variable::operator==()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells if two variables have a different name or a different value.
+ * \param that The variable to compare to.
+ */
+bool bear::visual::shader_variable_map::variable::operator!=
+( const variable& that ) const
+{
+  return !(*this == that);
+} // shader_variable_map::variable::operator!=()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Computes the hash of the name, the type and the value.
+ */
+void bear::visual::shader_variable_map::variable::compute_hash()
+{
+  m_hash = std::hash<std::string>()( m_name );
+  detail::hash_combine( m_hash, m_type );
+
+  switch ( m_type )
+    {
+    case int_value:
+      detail::hash_combine( m_hash, std::hash<int>()( m_value.int_value ) );
+      break;
+    case bool_value:
+      detail::hash_combine( m_hash, std::hash<bool>()( m_value.bool_value ) );
+      break;
+    case float_value:
+      detail::hash_combine
+        ( m_hash, std::hash<float>()( m_value.float_value ) );
+      break;
+    case matrix_value:
+      for ( std::size_t i(0); i != m_matrix.size(); ++i )
+        detail::hash_combine( m_hash, std::hash<float>()( m_matrix[i] ) );
+      break;
+    }
+} // shader_variable_map::variable::compute_hash()
+
+
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructs an empty map.
+ */
+bear::visual::shader_variable_map::shader_variable_map()
+  : m_hash( 0 )
+{
+
+} // shader_variable_map::shader_variable_map()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Sets the value of an integer variable.
+ * \param name The name of the variable.
+ * \param value The value of the variable.
+ */
+void bear::visual::shader_variable_map::set
+( const std::string& name, int value )
+{
+  set( variable( name, value ) );
+} // shader_variable_map::set()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Sets the value of a boolean variable.
+ * \param name The name of the variable.
+ * \param value The value of the variable.
+ */
+void bear::visual::shader_variable_map::set
+( const std::string& name, bool value )
+{
+  set( variable( name, value ) );
+} // shader_variable_map::set()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Sets the value of a real variable.
+ * \param name The name of the variable.
+ * \param value The value of the variable.
+ */
+void bear::visual::shader_variable_map::set
+( const std::string& name, float value )
+{
+  set( variable( name, value ) );
+} // shader_variable_map::set()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Sets the value of a matrix variable.
+ * \param name The name of the variable.
+ * \param value The value of the variable.
+ */
+void bear::visual::shader_variable_map::set
+( const std::string& name, const matrix_type& value )
+{
+  set( variable( name, value ) );
+} // shader_variable_map::set()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Finds a variable with a given name.
+ * \param name The name of the variable.
+ * \return end() if there is no such variable.
+ */
+bear::visual::shader_variable_map::const_iterator
+bear::visual::shader_variable_map::find( const std::string& name ) const
+{
+  const const_iterator result
+    ( std::lower_bound
+      ( m_variables.begin(), m_variables.end(), name,
+        detail::variable_name_less() ) );
+
+  if ( (result != m_variables.end()) && (result->get_name() == name) )
+    return result;
+  else
+    return m_variables.end();
+} // shader_variable_map::find()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells if there is no variable in the map.
+ */
+bool bear::visual::shader_variable_map::empty() const
+{
+  return m_variables.empty();
+} // shader_variable_map::empty()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the number of variables in the map.
+ */
+std::size_t bear::visual::shader_variable_map::size() const
+{
+  return m_variables.size();
+} // shader_variable_map::size()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the hash of the variables.
+ */
+std::size_t bear::visual::shader_variable_map::get_hash() const
+{
+  return m_hash;
+} // shader_variable_map::get_hash()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets an iterator on the first variable, in the order of their names.
+ */
+bear::visual::shader_variable_map::const_iterator
+bear::visual::shader_variable_map::begin() const
+{
+  return m_variables.begin();
+} // shader_variable_map::begin()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets an iterator just past the last variable.
+ */
+bear::visual::shader_variable_map::const_iterator
+bear::visual::shader_variable_map::end() const
+{
+  return m_variables.end();
+} // shader_variable_map::end()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells if two maps contain the same variables with the same values.
+ * \param that The map to compare to.
+ */
+bool bear::visual::shader_variable_map::operator==
+( const shader_variable_map& that ) const
+{
+  return (m_hash == that.m_hash) && (m_variables == that.m_variables);
+} // shader_variable_map::operator==()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells if two maps differ in their variables or their values.
+ * \param that The map to compare to.
+ */
+bool bear::visual::shader_variable_map::operator!=
+( const shader_variable_map& that ) const
+{
+  return !(*this == that);
+} // shader_variable_map::operator!=()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Inserts a variable or replaces the variable with the same name.
+ * \param v The variable to set.
+ */
+void bear::visual::shader_variable_map::set( const variable& v )
+{
+  const variable_list::iterator it
+    ( std::lower_bound
+      ( m_variables.begin(), m_variables.end(), v.get_name(),
+        detail::variable_name_less() ) );
+
+  if ( (it != m_variables.end()) && (it->get_name() == v.get_name()) )
+    {
+      m_hash -= it->get_hash();
+      *it = v;
+    }
+  else
+    m_variables.insert( it, v );
+
+  m_hash += v.get_hash();
+} // shader_variable_map::set()
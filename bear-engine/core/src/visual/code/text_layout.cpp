@@ -15,6 +15,8 @@
 
 #include <claw/assert.hpp>
 
+#include <utility>
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
@@ -34,6 +36,235 @@ bear::visual::text_layout::text_layout
 
 } // text_layout::text_layout()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the arrangement of the text, from the cache of the font if
+ *        possible.
+ * \param storage An arrangement in which the text is arranged if the font has
+ *        no cache.
+ * \return The arrangement in the cache of the font, or \a storage.
+ */
+const bear::visual::text_layout::layout_type&
+bear::visual::text_layout::get_layout( layout_type& storage ) const
+{
+  text_layout_cache* const cache( m_font.get_layout_cache() );
+
+  if ( cache == NULL )
+    {
+      compute_layout( storage );
+      return storage;
+    }
+
+  const layout_type* const cached
+    ( cache->find( m_text, m_size, m_horizontal_align ) );
+
+  if ( cached != NULL )
+    return *cached;
+
+  const layout_type* const previous
+    ( cache->find_prefix( m_text, m_size, m_horizontal_align ) );
+
+  if ( (previous == NULL) || !resume_layout( storage, *previous ) )
+    compute_layout( storage );
+
+  return cache->insert
+    ( m_text, m_size, m_horizontal_align, std::move( storage ) );
+} // text_layout::get_layout()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Arranges the whole text.
+ * \param result (out) The arrangement of the text.
+ */
+void bear::visual::text_layout::compute_layout( layout_type& result ) const
+{
+  // The position on the Y-axis is computed such that the text starts on the
+  // top of the box.
+  result.top = m_size.y - compute_line_height_above_baseline(0);
+  result.words.clear();
+  result.last_line_first = 0;
+  result.last_line_word = 0;
+  result.last_line_y = result.top;
+
+  arrange_lines( result, cursor_type( compute_line_left(0), result.top ), 0 );
+} // text_layout::compute_layout()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Arranges the text from the last line of the arrangement of a text of
+ *        which m_text is an extension.
+ *
+ * When the lines are aligned on the left, the lines preceding the last line
+ * of \a previous do not depend on the characters appended to the text, except
+ * for the height of the first line, which is checked. With the other
+ * alignments, the position of a line depends on its width, which may change
+ * with the appended characters, thus the text is arranged again.
+ *
+ * \param result (out) The arrangement of the text.
+ * \param previous The arrangement of the beginning of the text.
+ * \return false if the arrangement cannot be resumed from \a previous.
+ */
+bool bear::visual::text_layout::resume_layout
+( layout_type& result, const layout_type& previous ) const
+{
+  if ( (m_horizontal_align != text_align::align_left)
+       || (previous.last_line_first == 0) )
+    return false;
+
+  const coordinate_type top
+    ( m_size.y - compute_line_height_above_baseline(0) );
+
+  if ( top != previous.top )
+    return false;
+
+  result.top = top;
+  result.words.assign
+    ( previous.words.begin(),
+      previous.words.begin() + previous.last_line_word );
+  result.last_line_first = previous.last_line_first;
+  result.last_line_word = previous.last_line_word;
+  result.last_line_y = previous.last_line_y;
+
+  arrange_lines
+    ( result,
+      cursor_type
+      ( compute_line_left( previous.last_line_first ), previous.last_line_y ),
+      previous.last_line_first );
+
+  return true;
+} // text_layout::resume_layout()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Arranges the lines of text, starting from a given character.
+ * \param result (in/out) The arrangement in which the words are added.
+ * \param cursor The position of the character in the box.
+ * \param i The index of the character from which the text is arranged.
+ */
+void bear::visual::text_layout::arrange_lines
+( layout_type& result, cursor_type cursor, std::size_t i ) const
+{
+  const std::size_t text_size( m_text.size() );
+
+  // We allow to write outside the box if it is on less than one screen unit.
+  while ( (cursor.y > -1) && (i != text_size) )
+    if ( m_text[i] == '\n' )
+      {
+        ++i;
+        start_line( result, cursor, i );
+      }
+    else
+      arrange_next_word( result, cursor, i );
+} // text_layout::arrange_lines()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Find the next word and arrange it.
+ * \param result (in/out) The arrangement in which the words are added.
+ * \param cursor (in/out) The position of the cursor in the component.
+ * \param i (in/out) Index of the first character of the word. (out) Index of
+ *        the next character to print.
+ */
+void bear::visual::text_layout::arrange_next_word
+( layout_type& result, cursor_type& cursor, std::size_t& i ) const
+{
+  // find the first word
+  std::size_t word = m_text.find_first_not_of(' ', i);
+
+  if (word == std::string::npos)
+    i = m_text.size();
+  else if (m_text[word] == '\n')
+    i = word;
+  else
+    {
+      // the end of the word
+      std::size_t space = m_text.find_first_of( " \n", word );
+
+      if (space == std::string::npos)
+        space = m_text.size();
+
+      coordinate_type p( cursor.x );
+      std::size_t j( i );
+      bool fit_on_line(true);
+
+      while ( fit_on_line && (j != space) )
+        {
+          const size_type w( m_font.get_advance( m_text[ j ] ) );
+
+          if ( p + w <= m_size.x )
+            {
+              p += w;
+              ++j;
+            }
+          else
+            fit_on_line = false;
+        }
+
+      // the word fits on the line
+      if ( fit_on_line )
+        {
+          const std::size_t word_length = space - i;
+          arrange_word( result, cursor, i, word_length );
+          cursor.x = p;
+        }
+      else
+        {
+          if ( cursor.x == 0 )
+            {
+              // the word doesn't fit on the full line
+              const std::size_t line_length( j - word );
+              arrange_word( result, cursor, i, line_length );
+            }
+          else
+            {
+              // We will retry at the begining of the line in the next
+              // loop. We remove the spaces at the begining of the line.
+              i = word;
+            }
+
+          start_line( result, cursor, i );
+        }
+    }
+} // text_layout::arrange_next_word()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Adds a word in the arrangement.
+ * \param result (in/out) The arrangement in which the word is added.
+ * \param cursor The position of the cursor in the component.
+ * \param i (in/out) Index of the first character of the word. (out) Index of
+ *        the next character to print.
+ * \param n Number of characters to print.
+ */
+void bear::visual::text_layout::arrange_word
+( layout_type& result, const cursor_type& cursor, std::size_t& i,
+  const std::size_t n ) const
+{
+  const text_layout_cache::word w = { cursor, i, i + n };
+
+  result.words.push_back( w );
+  i += n;
+} // text_layout::arrange_word()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Moves the cursor to the beginning of the next line and keeps the
+ *        state of the arrangement at this point.
+ * \param result (in/out) The arrangement of the text.
+ * \param cursor (in/out) The position of the cursor in the component.
+ * \param i The index of the first character of the line.
+ */
+void bear::visual::text_layout::start_line
+( layout_type& result, cursor_type& cursor, std::size_t i ) const
+{
+  cursor.y -= m_font.get_line_spacing();
+  cursor.x = compute_line_left(i);
+
+  result.last_line_first = i;
+  result.last_line_word = result.words.size();
+  result.last_line_y = cursor.y;
+} // text_layout::start_line()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Compute the left origin of a line of text.
@@ -101,7 +332,7 @@ bear::visual::text_layout::compute_line_width( std::size_t first ) const
       else
         last_space_sequence = std::string::npos;
 
-      width = m_font.get_metrics( m_text[last] ).get_advance().x;
+      width = m_font.get_advance( m_text[last] );
       if ( (candidate_length + width) > m_size.x )
         break;
 
@@ -0,0 +1,163 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::visual::text_layout_cache class.
+ * \author Julien Jorge
+ */
+#include "visual/text_layout_cache.hpp"
+
+#include <claw/assert.hpp>
+
+#include <functional>
+#include <utility>
+
+namespace bear
+{
+  namespace visual
+  {
+    namespace detail
+    {
+      /**
+       * \brief Combines a hash with the hash of a value.
+       * \param seed The hash to update.
+       * \param h The hash of the value.
+       */
+      static void combine_layout_hash( std::size_t& seed, std::size_t h )
+      {
+        seed ^= h + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      } // combine_layout_hash()
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param capacity The maximum number of arrangements kept in the cache.
+ */
+bear::visual::text_layout_cache::text_layout_cache( std::size_t capacity )
+  : m_capacity( capacity )
+{
+  CLAW_PRECOND( capacity > 0 );
+} // text_layout_cache::text_layout_cache()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the arrangement of a text, if it is in the cache.
+ * \param text The arranged text.
+ * \param size The size of the box around the text.
+ * \param align How the lines of text are aligned.
+ * \return NULL if the arrangement is not in the cache.
+ */
+const bear::visual::text_layout_cache::layout*
+bear::visual::text_layout_cache::find
+( const std::string& text, const size_box_type& size,
+  text_align::horizontal_align align )
+{
+  const std::size_t h( hash( text, size, align ) );
+
+  for ( entry_list::iterator it=m_entries.begin(); it!=m_entries.end(); ++it )
+    if ( (it->hash == h) && (it->align == align) && (it->size == size)
+         && (it->text == text) )
+      {
+        m_entries.splice( m_entries.begin(), m_entries, it );
+        return &m_entries.front().value;
+      }
+
+  return NULL;
+} // text_layout_cache::find()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the arrangement of the longest text in the cache, arranged in
+ *        the same box, of which a given text is an extension.
+ * \param text The text that extends the cached text.
+ * \param size The size of the box around the text.
+ * \param align How the lines of text are aligned.
+ * \return NULL if there is no such arrangement in the cache.
+ */
+const bear::visual::text_layout_cache::layout*
+bear::visual::text_layout_cache::find_prefix
+( const std::string& text, const size_box_type& size,
+  text_align::horizontal_align align ) const
+{
+  const layout* result( NULL );
+  std::size_t length(0);
+
+  for ( entry_list::const_iterator it=m_entries.begin(); it!=m_entries.end();
+        ++it )
+    if ( (it->align == align) && (it->size == size)
+         && (it->text.size() > length) && (it->text.size() < text.size())
+         && (text.compare( 0, it->text.size(), it->text ) == 0) )
+      {
+        result = &it->value;
+        length = it->text.size();
+      }
+
+  return result;
+} // text_layout_cache::find_prefix()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Adds the arrangement of a text in the cache.
+ * \param text The arranged text.
+ * \param size The size of the box around the text.
+ * \param align How the lines of text are aligned.
+ * \param value The arrangement of the text.
+ * \return The arrangement stored in the cache.
+ */
+const bear::visual::text_layout_cache::layout&
+bear::visual::text_layout_cache::insert
+( const std::string& text, const size_box_type& size,
+  text_align::horizontal_align align, layout value )
+{
+  if ( m_entries.size() == m_capacity )
+    m_entries.pop_back();
+
+  m_entries.push_front( entry() );
+
+  entry& e( m_entries.front() );
+  e.text = text;
+  e.size = size;
+  e.align = align;
+  e.hash = hash( text, size, align );
+  e.value = std::move( value );
+
+  return e.value;
+} // text_layout_cache::insert()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Removes all the arrangements from the cache.
+ */
+void bear::visual::text_layout_cache::clear()
+{
+  m_entries.clear();
+} // text_layout_cache::clear()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Computes the hash of the parameters of an arrangement.
+ * \param text The arranged text.
+ * \param size The size of the box around the text.
+ * \param align How the lines of text are aligned.
+ */
+std::size_t bear::visual::text_layout_cache::hash
+( const std::string& text, const size_box_type& size,
+  text_align::horizontal_align align )
+{
+  std::size_t result( std::hash<std::string>()( text ) );
+
+  detail::combine_layout_hash( result, std::hash<double>()( size.x ) );
+  detail::combine_layout_hash( result, std::hash<double>()( size.y ) );
+  detail::combine_layout_hash( result, align );
+
+  return result;
+} // text_layout_cache::hash()
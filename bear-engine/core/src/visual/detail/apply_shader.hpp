@@ -4,11 +4,12 @@ namespace bear
 {
   namespace visual
   {
+    class gl_draw;
     class shader_program;
     
     namespace detail
     {
-      void apply_shader( const shader_program& shader );
+      void apply_shader( const shader_program& shader, gl_draw& output );
     }
   }
 }
@@ -1,74 +1,50 @@
 #include "visual/detail/apply_shader.hpp"
 
+#include "visual/gl_call_counter.hpp"
+#include "visual/gl_draw.hpp"
 #include "visual/gl_error.hpp"
 #include "visual/gl_shader_program.hpp"
 #include "visual/shader_program.hpp"
 
+#include <cassert>
+
 namespace bear
 {
   namespace visual
   {
     namespace detail
     {
-      class uniform_setter
-      {
-      public:
-        explicit uniform_setter( GLuint program );
-
-        void operator()( const std::string& name, int value ) const;
-        void operator()( const std::string& name, float value ) const;
-        void operator()( const std::string& name, bool value ) const;
-        void operator()
-        ( const std::string& name, const std::array< float, 16 >& value ) const;
-
-      private:
-        const GLuint m_program;
-      };
+      static void set_uniform
+      ( GLint location, const shader_variable_map::variable& v );
     }
   }
 }
-  
-bear::visual::detail::uniform_setter::uniform_setter( GLuint program )
-  : m_program( program )
-{
-
-}
-
-void bear::visual::detail::uniform_setter::operator()
-( const std::string& name, int value ) const
-{
-  glUniform1i( glGetUniformLocation( m_program, name.c_str() ), value);
-  VISUAL_GL_ERROR_THROW();
-}
-
-void bear::visual::detail::uniform_setter::operator()
-( const std::string& name, float value ) const
-{
-  glUniform1f( glGetUniformLocation( m_program, name.c_str() ), value);
-  VISUAL_GL_ERROR_THROW();
-}
 
-void bear::visual::detail::uniform_setter::operator()
-( const std::string& name, bool value ) const
+void bear::visual::detail::set_uniform
+( GLint location, const shader_variable_map::variable& v )
 {
-  glUniform1i( glGetUniformLocation( m_program, name.c_str() ), value);
-  VISUAL_GL_ERROR_THROW();
-}
+  switch ( v.get_type() )
+    {
+    case shader_variable_map::int_value:
+      glUniform1i( location, v.get_int() );
+      break;
+    case shader_variable_map::bool_value:
+      glUniform1i( location, v.get_bool() );
+      break;
+    case shader_variable_map::float_value:
+      glUniform1f( location, v.get_float() );
+      break;
+    case shader_variable_map::matrix_value:
+      glUniformMatrix4fv( location, 1, GL_FALSE, v.get_matrix().data() );
+      break;
+    }
 
-void bear::visual::detail::uniform_setter::operator()
-  ( const std::string& name, const std::array< float, 16 >& value ) const
-{
-  glUniformMatrix4fv
-    ( glGetUniformLocation( m_program, name.c_str() ),
-      1, GL_FALSE, value.data() );
   VISUAL_GL_ERROR_THROW();
+  gl_call_counter::count( gl_call_counter::uniform_call );
 }
 
-
-
-
-
-void bear::visual::detail::apply_shader( const shader_program& shader )
+void bear::visual::detail::apply_shader
+( const shader_program& shader, gl_draw& output )
 {
   assert ( shader.is_valid() );
 
@@ -77,11 +53,18 @@ void bear::visual::detail::apply_shader( const shader_program& shader )
 
   assert( s->program_id() != 0 );
   
-  glUseProgram( s->program_id() );
-  VISUAL_GL_ERROR_THROW();
+  output.use_program( s->program_id() );
 
-  shader_program::variable_visitor_type visitor;
-  shader_program::input_variable_map vars( shader.get_variables() );
-  visitor.run( vars, uniform_setter( s->program_id() ) );
-}
+  const shader_program::input_variable_map& vars( shader.get_variables() );
 
+  // The program keeps the values of its uniforms, thus only the values that
+  // changed since the last draw with this program are uploaded.
+  for ( shader_program::input_variable_map::const_iterator it( vars.begin() );
+        it != vars.end(); ++it )
+    {
+      const GLint location( s->update_uniform( *it ) );
+
+      if ( location != -1 )
+        set_uniform( location, *it );
+    }
+}
@@ -17,20 +17,29 @@
 #include "charset/def.hpp"
 #include "visual/sprite.hpp"
 #include "visual/font/glyph_metrics.hpp"
+#include "visual/text_layout_cache.hpp"
 
 #include "visual/class_export.hpp"
 
+#include <vector>
+
 namespace bear
 {
   namespace visual
   {
     /**
      * \brief The common interface to the classes representing the fonts.
+     *
+     * The font keeps the advance of the characters it has been asked for in
+     * a table indexed by the code of the characters, and the last
+     * arrangements of the texts displayed with it.
+     *
      * \author Julien Jorge
      */
     class VISUAL_EXPORT base_font
     {
     public:
+      base_font();
       virtual ~base_font();
 
       virtual size_type get_size() const = 0;
@@ -38,9 +47,36 @@ namespace bear
       virtual glyph_metrics get_metrics( charset::char_type c ) = 0;
       virtual sprite get_sprite( charset::char_type character ) = 0;
 
+      size_type get_advance( charset::char_type c );
+      text_layout_cache& get_layout_cache();
+
       virtual void clear();
       virtual void restore();
 
+    private:
+      /** \brief The advance of the characters on the x-axis, indexed by their
+          code minus s_first_advance. A negative value means that the advance
+          has not been computed yet. */
+      std::vector<size_type> m_advance;
+
+      /** \brief The last arrangements of the texts displayed with this
+          font. */
+      text_layout_cache m_layout_cache;
+
+      /** \brief The code of the first character in m_advance. The characters
+          of an std::string are signed on some platforms, thus the table
+          begins with the negative codes. */
+      static const charset::char_type s_first_advance;
+
+      /** \brief The code just past the last character that can be stored in
+          m_advance. The advance of the characters out of the table is
+          computed on each call. */
+      static const charset::char_type s_end_advance;
+
+      /** \brief The maximum number of arrangements kept in
+          m_layout_cache. */
+      static const std::size_t s_layout_cache_capacity;
+
     }; // class base_font
   } // namespace visual
 } // namespace bear
@@ -13,6 +13,23 @@
  */
 #include "visual/font/base_font.hpp"
 
+/*----------------------------------------------------------------------------*/
+const bear::charset::char_type bear::visual::base_font::s_first_advance
+( -128 );
+const bear::charset::char_type bear::visual::base_font::s_end_advance
+( 0x10000 );
+const std::size_t bear::visual::base_font::s_layout_cache_capacity( 32 );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+bear::visual::base_font::base_font()
+  : m_layout_cache( s_layout_cache_capacity )
+{
+
+} // base_font::base_font()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Destructor.
@@ -22,6 +39,37 @@ bear::visual::base_font::~base_font()
   // nothing to do
 } // base_font::~base_font()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Returns the advance on the x-axis of a glyph.
+ * \param c The character of the glyph.
+ */
+bear::visual::size_type
+bear::visual::base_font::get_advance( charset::char_type c )
+{
+  if ( (c < s_first_advance) || (c >= s_end_advance) )
+    return get_metrics( c ).get_advance().x;
+
+  const std::size_t i( c - s_first_advance );
+
+  if ( i >= m_advance.size() )
+    m_advance.resize( i + 1, -1 );
+
+  if ( m_advance[ i ] < 0 )
+    m_advance[ i ] = get_metrics( c ).get_advance().x;
+
+  return m_advance[ i ];
+} // base_font::get_advance()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the last arrangements of the texts displayed with this font.
+ */
+bear::visual::text_layout_cache& bear::visual::base_font::get_layout_cache()
+{
+  return m_layout_cache;
+} // base_font::get_layout_cache()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Removes the data of the font for future restoration.
@@ -56,6 +56,20 @@ bear::visual::font::get_metrics( charset::char_type c ) const
   return result;
 } // font::get_metrics()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Returns the advance on the x-axis of a glyph.
+ * \param c The character of the glyph.
+ */
+bear::visual::size_type
+bear::visual::font::get_advance( charset::char_type c ) const
+{
+  if ( m_impl == NULL )
+    return 0;
+  else
+    return m_impl->get_advance( c );
+} // font::get_advance()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Returns the spacing between two lines of text displayed with this
@@ -93,3 +107,16 @@ bear::visual::font::get_sprite( charset::char_type character ) const
 
   return result;
 } // font::get_sprite()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the last arrangements of the texts displayed with this font.
+ * \return NULL if this font has no implementation.
+ */
+bear::visual::text_layout_cache* bear::visual::font::get_layout_cache() const
+{
+  if ( m_impl == NULL )
+    return NULL;
+  else
+    return &m_impl->get_layout_cache();
+} // font::get_layout_cache()
@@ -67,10 +67,23 @@ void bear::visual::font_manager::load_font
  */
 void bear::visual::font_manager::load_font
 ( std::string name, std::istream& file )
+{
+  load_font( name, true_type_memory_file( file ) );
+} // font_manager::load_font()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Adds the data of a true type font file already read.
+ * \param name The identifier of the font.
+ * \param f The content of the file, shared with the manager.
+ * \pre !exists( name )
+ */
+void bear::visual::font_manager::load_font
+( std::string name, const true_type_memory_file& f )
 {
   CLAW_PRECOND( !exists(name) );
 
-  m_memory_file.insert( std::make_pair( name, true_type_memory_file( file ) ) );
+  m_memory_file.insert( std::make_pair( name, f ) );
 } // font_manager::load_font()
 
 /*----------------------------------------------------------------------------*/
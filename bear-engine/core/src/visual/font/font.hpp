@@ -25,6 +25,7 @@ namespace bear
   namespace visual
   {
     class base_font;
+    class text_layout_cache;
 
     /**
      * \brief An interface to the instances of base_font.
@@ -46,12 +47,15 @@ namespace bear
       explicit font( base_font_pointer f, size_type size );
 
       glyph_metrics get_metrics( charset::char_type c ) const;
+      size_type get_advance( charset::char_type c ) const;
 
       size_type get_line_spacing() const;
       size_type get_size() const;
 
       sprite get_sprite( charset::char_type character ) const;
 
+      text_layout_cache* get_layout_cache() const;
+
     private:
       /** \brief The base_font from which we take the glyphs. */
       base_font_pointer m_impl;
@@ -60,6 +60,7 @@ namespace bear
 
       void load_font( std::string name, const bitmap_charmap& m );
       void load_font( std::string name, std::istream& file );
+      void load_font( std::string name, const true_type_memory_file& f );
 
       void clear_fonts();
       void restore_fonts();
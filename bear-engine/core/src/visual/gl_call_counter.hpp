@@ -0,0 +1,76 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Counts the calls to OpenGL made to render the frames.
+ * \author Julien Jorge
+ */
+#ifndef __VISUAL_GL_CALL_COUNTER_HPP__
+#define __VISUAL_GL_CALL_COUNTER_HPP__
+
+#include "visual/class_export.hpp"
+
+#include <cstddef>
+
+namespace bear
+{
+  namespace visual
+  {
+    /**
+     * \brief Counts the calls to OpenGL made to render the frames.
+     *
+     * The counts of the last frame are available with get(), and the average
+     * counts per frame are written in the verbose log periodically. The
+     * methods must be called from the thread rendering the frames.
+     *
+     * \author Julien Jorge
+     */
+    class VISUAL_EXPORT gl_call_counter
+    {
+    public:
+      /** \brief The kinds of calls counted. */
+      enum call_type
+      {
+        use_program_call,
+        uniform_location_call,
+        uniform_call,
+        texture_call,
+        draw_call,
+        call_type_count
+      }; // enum call_type
+
+    public:
+      static void count( call_type c );
+      static std::size_t get( call_type c );
+      static void end_frame();
+
+    private:
+      static void log_averages();
+
+    private:
+      /** \brief The number of frames between two outputs in the log. */
+      static const std::size_t s_log_period;
+
+      /** \brief The calls made for the frame in progress. */
+      static std::size_t s_current[ call_type_count ];
+
+      /** \brief The calls made for the last frame. */
+      static std::size_t s_last[ call_type_count ];
+
+      /** \brief The calls made since the last output in the log. */
+      static std::size_t s_total[ call_type_count ];
+
+      /** \brief The number of frames since the last output in the log. */
+      static std::size_t s_frames;
+
+    }; // class gl_call_counter
+  } // namespace visual
+} // namespace bear
+
+#endif // __VISUAL_GL_CALL_COUNTER_HPP__
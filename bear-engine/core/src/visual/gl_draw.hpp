@@ -22,6 +22,12 @@ namespace bear
       void set_background_color( const color_type& c );
 
       void draw( const std::vector< gl_state >& states );
+      void draw_offscreen
+      ( const std::vector< gl_state >& states,
+        const claw::math::coordinate_2d< unsigned int >& size );
+
+      void use_program( GLuint program );
+      void use_default_program();
       
       void set_vertices( const std::vector< GLfloat >& vertices );
       void set_colors( const std::vector< GLfloat >& colors );
@@ -41,6 +47,8 @@ namespace bear
     private:
       const GLuint m_white;
       const GLuint m_shader;
+      const claw::math::coordinate_2d< unsigned int > m_size;
+      GLuint m_program;
       
       GLfloat m_background_color[ 4 ];
       GLuint m_buffers[ 4 ];
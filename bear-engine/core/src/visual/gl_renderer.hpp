@@ -16,6 +16,7 @@
 
 #include "visual/gl_capture.hpp"
 #include "visual/gl_state.hpp"
+#include "visual/image.hpp"
 #include "visual/types.hpp"
 
 #include "time/time.hpp"
@@ -59,6 +60,19 @@ namespace bear
     private:
       typedef gl_renderer* renderer_pointer;
 
+      /**
+       * \brief Some states to render in an image rather than on the screen.
+       */
+      struct image_rendering
+      {
+        /** \brief The image receiving the rendering. */
+        image target;
+
+        /** \brief The states to render. */
+        state_list states;
+
+      }; // struct image_rendering
+
     public:
       static gl_renderer& get_instance();
       static void terminate();
@@ -98,6 +112,7 @@ namespace bear
       void set_fullscreen( bool f );
 
       void set_gl_states( state_list& states );
+      void render_to_image( const image& target, state_list& states );
 
       color_type get_background_color();
       void set_background_color( const color_type& c );
@@ -114,6 +129,7 @@ namespace bear
 
       void render_states();
       void draw_scene();
+      void draw_images();
       void update_screenshot( systime::milliseconds_type render_time );
 
       void resize_view();
@@ -182,6 +198,12 @@ namespace bear
       state_list m_states;
       state_list m_previous_states;
 
+      /** \brief The states to render in images before the next frame. */
+      std::vector<image_rendering> m_image_renderings;
+
+      /** \brief The frame buffer used to render in the images. */
+      GLuint m_image_frame_buffer;
+
       bool m_render_ready;
       boost::condition_variable m_render_condition;
 
@@ -17,6 +17,7 @@
 #include "visual/base_screen.hpp"
 #include "visual/gl.hpp"
 #include "visual/gl_state.hpp"
+#include "visual/image.hpp"
 #include "visual/shader_program.hpp"
 
 #include <SDL2/SDL.h>
@@ -58,8 +59,14 @@ namespace bear
 
       void begin_render() override;
       void render( const position_type& pos, const sprite& s ) override;
+      void render_repeated
+      ( const position_type& pos, const sprite& s, unsigned int x_count,
+        unsigned int y_count ) override;
       void end_render() override;
 
+      void begin_image_render( const image& target ) override;
+      void end_image_render() override;
+
       void draw_line
       ( const color_type& color,
         const std::vector<position_type>& p, double w = 1.0,
@@ -76,6 +83,7 @@ namespace bear
 
     private:
       void render_sprite( const position_type& pos, const sprite& s );
+      bool is_wrappable( const sprite& s ) const;
       
       void get_render_coord
         ( const position_type& pos, const sprite& s,
@@ -105,6 +113,18 @@ namespace bear
       /** \brief The OpenGL drawing commands. */
       std::vector<gl_state> m_gl_state;
 
+      /** \brief The image in which the commands are rendered, between
+          begin_image_render() and end_image_render(). */
+      image m_image_target;
+
+      /** \brief The shaders of the frame, kept aside while rendering in an
+          image. */
+      std::vector<shader_program> m_frame_shader;
+
+      /** \brief The drawing commands of the frame, kept aside while rendering
+          in an image. */
+      std::vector<gl_state> m_frame_gl_state;
+
     }; // class gl_screen
   } // namespace visual
 } // namespace bear
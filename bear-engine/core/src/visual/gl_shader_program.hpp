@@ -17,7 +17,9 @@
 #include "visual/base_shader_program.hpp"
 #include "visual/gl_fragment_shader.hpp"
 #include "visual/gl_vertex_shader.hpp"
+#include "visual/shader_variable_map.hpp"
 
+#include <unordered_map>
 #include <vector>
 
 namespace bear
@@ -32,6 +34,30 @@ namespace bear
     class VISUAL_EXPORT gl_shader_program:
       public base_shader_program
     {
+    private:
+      /**
+       * \brief The state of a uniform variable of the program, as known by
+       *        OpenGL.
+       */
+      struct uniform_state
+      {
+        uniform_state();
+
+        /** \brief The location of the uniform in the program. */
+        GLint location;
+
+        /** \brief Tells if a value has been uploaded for this uniform. */
+        bool uploaded;
+
+        /** \brief The last value uploaded for this uniform. */
+        shader_variable_map::variable value;
+
+      }; // struct uniform_state
+
+      /** \brief The type of the map associating the uniforms with their
+          names. */
+      typedef std::unordered_map<std::string, uniform_state> uniform_map;
+
     public:
       gl_shader_program
         ( const std::string& fragment_code, const std::string& vertex_code );
@@ -40,6 +66,8 @@ namespace bear
     
       GLuint program_id() const;
 
+      GLint update_uniform( const shader_variable_map::variable& v ) const;
+
     private:
       void log_errors( std::string step ) const;
 
@@ -52,6 +80,10 @@ namespace bear
 
       gl_vertex_shader m_vertex_shader;
 
+      /** \brief The locations and the last values of the uniforms, filled
+          when the variables are applied. */
+      mutable uniform_map m_uniforms;
+
     }; // gl_shader_program
 
   } // namespace visual
@@ -43,29 +43,6 @@ namespace bear
         render_triangles
       }; // enum render_mode
 
-      /**
-       * \brief The visitor that checks if a variable exists in another
-       *        variable_map with the same value.
-       */
-      class variables_are_included
-      {
-      public:
-        variables_are_included
-        ( bool& result, const shader_program::input_variable_map& vars );
-
-        template<typename T>
-        void operator()( const std::string& name, const T& value ) const;
-
-      private:
-        /** \brief The updated result of the tests. */
-        bool& m_result;
-
-        /** \brief The variable_map to which the visited variabled are
-            compared. */
-        const shader_program::input_variable_map& m_variables;
-
-      }; // class variables_are_included
-
       /**
        * \brief The element_range class describes how to render a given range
        *        of vertices from the state.
@@ -109,6 +86,7 @@ namespace bear
       void draw( gl_draw& output ) const;
 
     private:
+      void use_program( gl_draw& output ) const;
       void draw_shape( gl_draw& output ) const;
       void draw_textured( gl_draw& output ) const;
 
@@ -23,5 +23,9 @@ template<typename T>
 void bear::visual::shader_program::set_variable
 ( const std::string& name, const T& value )
 {
-  m_input_variable.set<T>( name, value );
+  // the variables may be shared with the copies of this program.
+  if ( m_input_variable.use_count() != 1 )
+    m_input_variable.reset( new input_variable_map( get_variables() ) );
+
+  m_input_variable->set( name, value );
 } // shader_program::set_variable()
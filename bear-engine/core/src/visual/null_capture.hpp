@@ -0,0 +1,30 @@
+#pragma once
+
+#include "visual/base_capture.hpp"
+#include "visual/color.hpp"
+
+#include <claw/coordinate_2d.hpp>
+
+namespace bear
+{
+  namespace visual
+  {
+    class VISUAL_EXPORT null_capture:
+      public base_capture
+    {
+    public:
+      null_capture
+      ( const claw::math::coordinate_2d< unsigned int >& size,
+        const color& background );
+
+      null_capture* clone() const override;
+      boost::signals2::connection render
+        ( const capture_ready& ready, const capture_progress& progress )
+          override;
+
+    private:
+      const claw::math::coordinate_2d< unsigned int > m_size;
+      const color m_background;
+    };
+  }
+}
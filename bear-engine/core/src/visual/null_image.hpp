@@ -0,0 +1,54 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief An image which does not keep its pixels.
+ * \author Julien Jorge
+ */
+#ifndef __VISUAL_NULL_IMAGE_HPP__
+#define __VISUAL_NULL_IMAGE_HPP__
+
+#include "visual/base_image.hpp"
+
+namespace bear
+{
+  namespace visual
+  {
+    /**
+     * \brief An image which does not keep its pixels, used with the
+     *        null_screen.
+     * \author Julien Jorge
+     */
+    class VISUAL_EXPORT null_image:
+      public base_image
+    {
+    public:
+      null_image( unsigned int width, unsigned int height );
+      explicit null_image( const claw::graphic::image& data );
+
+      claw::math::coordinate_2d<unsigned int> size() const override;
+      bool has_transparency() const override;
+
+      void draw
+        ( const claw::graphic::image& data,
+          claw::math::coordinate_2d<unsigned int> pos ) override;
+      claw::graphic::image read() const override;
+
+    private:
+      /** \brief Image's size. */
+      const claw::math::coordinate_2d<unsigned int> m_size;
+
+      /** \brief Is there any transparent pixel in the image ? */
+      bool m_has_transparency;
+
+    }; // class null_image
+  } // namespace visual
+} // namespace bear
+
+#endif // __VISUAL_NULL_IMAGE_HPP__
@@ -0,0 +1,89 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A screen which displays nothing.
+ * \author Julien Jorge
+ */
+#ifndef __VISUAL_NULL_SCREEN_HPP__
+#define __VISUAL_NULL_SCREEN_HPP__
+
+#include "visual/base_screen.hpp"
+
+#include <string>
+
+namespace bear
+{
+  namespace visual
+  {
+    /**
+     * \brief A screen which displays nothing.
+     *
+     * This screen accepts all the rendering commands and ignores them. It
+     * neither opens a window nor needs an OpenGL context, thus the game can
+     * run on a machine without a display, for example to simulate the levels
+     * faster than the real time.
+     *
+     * \author Julien Jorge
+     */
+    class VISUAL_EXPORT null_screen:
+      public base_screen
+    {
+    public:
+      explicit null_screen
+      ( const claw::math::coordinate_2d<unsigned int>& size,
+        const std::string& title="", bool full=false );
+
+      void pause() override;
+      void unpause() override;
+
+      void fullscreen( bool b ) override;
+      claw::math::coordinate_2d<unsigned int> get_size() const override;
+      claw::math::coordinate_2d<unsigned int>
+        get_viewport_size() const override;
+      claw::math::coordinate_2d<unsigned int>
+        get_container_size() const override;
+
+      void set_background_color( const color_type& c ) override;
+      color_type get_background_color() const override;
+
+      void render( const position_type& pos, const sprite& s ) override;
+      void render_repeated
+      ( const position_type& pos, const sprite& s, unsigned int x_count,
+        unsigned int y_count ) override;
+
+      void begin_image_render( const image& target ) override;
+      void end_image_render() override;
+
+      void draw_line
+      ( const color_type& color,
+        const std::vector<position_type>& p, double w = 1.0,
+        bool close=false ) override;
+
+      void draw_polygon
+      ( const color_type& color, const std::vector<position_type>& p ) override;
+
+      void push_shader( const shader_program& p ) override;
+      void pop_shader() override;
+
+      void shot( claw::graphic::image& img ) const override;
+      capture capture_scene() const override;
+
+    private:
+      /** \brief The size of the screen. */
+      const claw::math::coordinate_2d<unsigned int> m_size;
+
+      /** \brief The color of the background. */
+      color_type m_background_color;
+
+    }; // class null_screen
+  } // namespace visual
+} // namespace bear
+
+#endif // __VISUAL_NULL_SCREEN_HPP__
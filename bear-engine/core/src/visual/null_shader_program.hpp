@@ -0,0 +1,36 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A shader program which is never compiled.
+ * \author Julien Jorge
+ */
+#ifndef __VISUAL_NULL_SHADER_PROGRAM_HPP__
+#define __VISUAL_NULL_SHADER_PROGRAM_HPP__
+
+#include "visual/base_shader_program.hpp"
+
+namespace bear
+{
+  namespace visual
+  {
+    /**
+     * \brief A shader program which is never compiled, used with the
+     *        null_screen.
+     * \author Julien Jorge
+     */
+    class VISUAL_EXPORT null_shader_program:
+      public base_shader_program
+    {
+
+    }; // class null_shader_program
+  } // namespace visual
+} // namespace bear
+
+#endif // __VISUAL_NULL_SHADER_PROGRAM_HPP__
@@ -40,9 +40,11 @@ namespace bear
     public:
       scene_element( const base_scene_element& e = base_scene_element() );
       scene_element( const scene_element& that );
+      scene_element( scene_element&& that ) noexcept;
       ~scene_element();
 
       scene_element& operator=( const scene_element& that );
+      scene_element& operator=( scene_element&& that ) noexcept;
 
       rectangle_type get_opaque_box() const;
       rectangle_type get_bounding_box() const;
@@ -51,6 +53,8 @@ namespace bear
       burst( const rectangle_list& boxes, scene_element_list& output ) const;
 
       void render( base_screen& scr ) const;
+      void render_repeated
+      ( base_screen& scr, unsigned int x_count, unsigned int y_count ) const;
 
       const position_type& get_position() const;
       void set_position( const position_type& p );
@@ -0,0 +1,66 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A scene element repeated side by side on the screen.
+ * \author Julien Jorge
+ */
+#ifndef __VISUAL_SCENE_PATTERN_HPP__
+#define __VISUAL_SCENE_PATTERN_HPP__
+
+#include "visual/base_scene_element.hpp"
+#include "visual/scene_element.hpp"
+
+#include "visual/class_export.hpp"
+
+namespace bear
+{
+  namespace visual
+  {
+    /**
+     * \brief A scene element repeated side by side on the screen.
+     *
+     * The position of the pattern is the position of its bottom left
+     * repetition and the repetitions are spaced by the size of the bounding
+     * box of the element. The pattern goes through the scene as a single
+     * element and the sprites are passed to the screen as a single repeated
+     * area, which lets the screen draw them with a single quad.
+     *
+     * \author Julien Jorge
+     */
+    class VISUAL_EXPORT scene_pattern:
+      public base_scene_element
+    {
+    public:
+      scene_pattern
+      ( coordinate_type x, coordinate_type y, const scene_element& e,
+        unsigned int x_count, unsigned int y_count );
+
+      base_scene_element* clone() const;
+
+      rectangle_type get_opaque_box() const;
+      rectangle_type get_bounding_box() const;
+
+      void render( base_screen& scr ) const;
+
+    private:
+      /** \brief The repeated element. */
+      scene_element m_element;
+
+      /** \brief The number of repetitions on the x-axis. */
+      unsigned int m_x_count;
+
+      /** \brief The number of repetitions on the y-axis. */
+      unsigned int m_y_count;
+
+    }; // class scene_pattern
+  } // namespace visual
+} // namespace bear
+
+#endif // __VISUAL_SCENE_PATTERN_HPP__
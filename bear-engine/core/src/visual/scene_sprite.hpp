@@ -42,6 +42,8 @@ namespace bear
       ( const rectangle_list& boxes, scene_element_list& output ) const;
 
       void render( base_screen& scr ) const;
+      void render_repeated
+      ( base_screen& scr, unsigned int x_count, unsigned int y_count ) const;
 
     private:
       void set_sprite( const sprite& spr );
@@ -15,6 +15,7 @@
 #define __VISUAL_SCREEN_HPP__
 
 #include "visual/capture.hpp"
+#include "visual/image.hpp"
 #include "visual/scene_element.hpp"
 
 #include "visual/class_export.hpp"
@@ -36,6 +37,7 @@ namespace bear
       enum sub_system
         {
           screen_gl,
+          screen_null,
           screen_undef
         }; // enum_sub_system
 
@@ -81,11 +83,15 @@ namespace bear
       void render( const scene_element& e );
       void end_render();
 
+      void render_to_image
+      ( const image& target, const std::list<scene_element>& elements );
+
       void shot( const std::string& bitmap_name ) const;
       void shot( claw::graphic::image& img ) const;
       capture capture_scene() const;
 
     private:
+      scene_element make_shadow( const scene_element& e ) const;
       void render_opaque_box( const scene_element& e ) const;
       void render_element( const scene_element& e ) const;
 
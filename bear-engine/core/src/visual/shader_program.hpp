@@ -14,16 +14,14 @@
 #ifndef __VISUAL_SHADER_PROGRAM_HPP__
 #define __VISUAL_SHADER_PROGRAM_HPP__
 
-#include <array>
+#include <memory>
 #include <string>
 
+#include <claw/assert.hpp>
 #include <claw/smart_ptr.hpp>
 
 #include "visual/base_shader_program.hpp"
-
-#include <claw/multi_type_map.hpp>
-#include <claw/multi_type_map_visitor.hpp>
-#include <claw/meta/type_list.hpp>
+#include "visual/shader_variable_map.hpp"
 
 namespace bear
 {
@@ -39,30 +37,18 @@ namespace bear
       typedef
         claw::memory::smart_ptr<base_shader_program> base_shader_program_ptr;
 
-    public:
       /**
-       * \brief The types of the variables that can be passed to the program.
+       * \brief The type of the pointer to the variables, shared among the
+       *        copies of the program until one of them changes a variable.
        */
-      typedef
-        claw::meta::type_list_maker
-        <
-          int,
-          bool,
-          float,
-          std::array< float, 16 >
-        >::result var_types;
+      typedef std::shared_ptr<shader_variable_map> variable_map_ptr;
 
+    public:
       /**
        * \brief The type of the map storing the values of the inputs of the
        *       program.
        */
-      typedef claw::multi_type_map<std::string, var_types> input_variable_map;
-
-      /**
-       * \brief The type of the visitor to use to access the variables of the
-       *        program.
-       */
-      typedef claw::multi_type_map_visitor variable_visitor_type;
+      typedef shader_variable_map input_variable_map;
 
     public:
       shader_program();
@@ -93,7 +79,7 @@ namespace bear
       claw::memory::smart_ptr<base_shader_program_ptr> m_impl;
 
       /** The values of the variables passed to the program. */
-      input_variable_map m_input_variable;
+      variable_map_ptr m_input_variable;
 
     }; // class shader_program
   } // namespace visual
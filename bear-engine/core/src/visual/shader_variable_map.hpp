@@ -0,0 +1,145 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The values of the variables passed to a shader program.
+ * \author Julien Jorge
+ */
+#ifndef __VISUAL_SHADER_VARIABLE_MAP_HPP__
+#define __VISUAL_SHADER_VARIABLE_MAP_HPP__
+
+#include "visual/class_export.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace bear
+{
+  namespace visual
+  {
+    /**
+     * \brief The values of the variables passed to a shader program.
+     *
+     * The variables are stored in a vector sorted by name, each of them
+     * carrying a hash of its name and of its value. The hash of the map is
+     * the sum of the hashes of its variables, thus it is updated in constant
+     * time when a variable is set and two maps with different hashes are
+     * known to be different without visiting their variables.
+     *
+     * \author Julien Jorge
+     */
+    class VISUAL_EXPORT shader_variable_map
+    {
+    public:
+      /** \brief The type of the matrices passed to the program. */
+      typedef std::array<float, 16> matrix_type;
+
+      /** \brief The types of the values of the variables. */
+      enum value_type
+      {
+        int_value,
+        bool_value,
+        float_value,
+        matrix_value
+      }; // enum value_type
+
+      /**
+       * \brief A variable passed to the program.
+       */
+      class VISUAL_EXPORT variable
+      {
+      public:
+        variable();
+        variable( const std::string& name, int value );
+        variable( const std::string& name, bool value );
+        variable( const std::string& name, float value );
+        variable( const std::string& name, const matrix_type& value );
+
+        const std::string& get_name() const;
+        value_type get_type() const;
+        std::size_t get_hash() const;
+
+        int get_int() const;
+        bool get_bool() const;
+        float get_float() const;
+        const matrix_type& get_matrix() const;
+
+        bool operator==( const variable& that ) const;
+        bool operator!=( const variable& that ) const;
+
+      private:
+        void compute_hash();
+
+      private:
+        /** \brief The name of the variable in the program. */
+        std::string m_name;
+
+        /** \brief The type of the value. */
+        value_type m_type;
+
+        /** \brief The hash of the name, the type and the value. */
+        std::size_t m_hash;
+
+        /** \brief The value of the variable, if it is not a matrix. */
+        union
+        {
+          int int_value;
+          bool bool_value;
+          float float_value;
+        } m_value;
+
+        /** \brief The value of the variable, if it is a matrix. */
+        matrix_type m_matrix;
+
+      }; // class variable
+
+    private:
+      /** \brief The type of the container storing the variables. */
+      typedef std::vector<variable> variable_list;
+
+    public:
+      /** \brief The type of the iterators on the variables. */
+      typedef variable_list::const_iterator const_iterator;
+
+    public:
+      shader_variable_map();
+
+      void set( const std::string& name, int value );
+      void set( const std::string& name, bool value );
+      void set( const std::string& name, float value );
+      void set( const std::string& name, const matrix_type& value );
+
+      const_iterator find( const std::string& name ) const;
+
+      bool empty() const;
+      std::size_t size() const;
+      std::size_t get_hash() const;
+
+      const_iterator begin() const;
+      const_iterator end() const;
+
+      bool operator==( const shader_variable_map& that ) const;
+      bool operator!=( const shader_variable_map& that ) const;
+
+    private:
+      void set( const variable& v );
+
+    private:
+      /** \brief The variables, sorted by name. */
+      variable_list m_variables;
+
+      /** \brief The sum of the hashes of the variables. */
+      std::size_t m_hash;
+
+    }; // class shader_variable_map
+  } // namespace visual
+} // namespace bear
+
+#endif // __VISUAL_SHADER_VARIABLE_MAP_HPP__
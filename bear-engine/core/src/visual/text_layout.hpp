@@ -16,6 +16,7 @@
 
 #include "visual/font/font.hpp"
 #include "visual/text_align.hpp"
+#include "visual/text_layout_cache.hpp"
 
 #include "visual/class_export.hpp"
 
@@ -29,6 +30,12 @@ namespace bear
      * \brief A class that arrange a text in a box (like it should be
      *        displayed).
      *
+     * The arrangements are kept in the cache of the font, thus arranging the
+     * same text in the same box again only replays the placement of the
+     * words. When the lines are aligned on the left and the text extends a
+     * text previously arranged in the same box, the arrangement resumes from
+     * the beginning of the last line of the previous text.
+     *
      * \sa writing
      *
      * \author Julien Jorge
@@ -40,6 +47,9 @@ namespace bear
           character. */
       typedef position_type cursor_type;
 
+      /** \brief The type of the arrangement of the text. */
+      typedef text_layout_cache::layout layout_type;
+
     public:
       VISUAL_EXPORT text_layout
       ( const font& f, const std::string& str, const size_box_type& s,
@@ -49,20 +59,26 @@ namespace bear
       void arrange_text( Func func ) const;
 
     private:
-      template<typename Func>
-      void arrange_next_word
-      ( Func func, cursor_type& cursor, std::size_t& i ) const;
+      VISUAL_EXPORT const layout_type& get_layout
+      ( layout_type& storage ) const;
 
-      template<typename Func>
+      void compute_layout( layout_type& result ) const;
+      bool resume_layout
+      ( layout_type& result, const layout_type& previous ) const;
+
+      void arrange_lines
+      ( layout_type& result, cursor_type cursor, std::size_t i ) const;
+      void arrange_next_word
+      ( layout_type& result, cursor_type& cursor, std::size_t& i ) const;
       void arrange_word
-      ( Func func, cursor_type& cursor, std::size_t& i,
+      ( layout_type& result, const cursor_type& cursor, std::size_t& i,
         const std::size_t n ) const;
+      void start_line
+      ( layout_type& result, cursor_type& cursor, std::size_t i ) const;
 
-      VISUAL_EXPORT coordinate_type compute_line_left
-      ( std::size_t first ) const;
-      VISUAL_EXPORT size_type compute_line_width( std::size_t first ) const;
-      VISUAL_EXPORT size_type
-      compute_line_height_above_baseline( std::size_t first ) const;
+      coordinate_type compute_line_left( std::size_t first ) const;
+      size_type compute_line_width( std::size_t first ) const;
+      size_type compute_line_height_above_baseline( std::size_t first ) const;
 
     private:
       /** \brief The size of the box around the text. */
@@ -0,0 +1,151 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The last arrangements of the texts displayed with a font.
+ * \author Julien Jorge
+ */
+#ifndef __VISUAL_TEXT_LAYOUT_CACHE_HPP__
+#define __VISUAL_TEXT_LAYOUT_CACHE_HPP__
+
+#include "visual/text_align.hpp"
+#include "visual/types.hpp"
+
+#include "visual/class_export.hpp"
+
+#include <list>
+#include <string>
+#include <vector>
+
+namespace bear
+{
+  namespace visual
+  {
+    /**
+     * \brief The last arrangements of the texts displayed with a font.
+     *
+     * The arrangements are identified by the text, the size of the box and
+     * the alignment of the lines. The font is implicit since each font owns
+     * its cache. When the cache is full, the arrangement used the least
+     * recently is removed.
+     *
+     * \sa text_layout
+     *
+     * \author Julien Jorge
+     */
+    class VISUAL_EXPORT text_layout_cache
+    {
+    public:
+      /**
+       * \brief A word placed in the box.
+       */
+      struct word
+      {
+        /** \brief The position in the box where the word starts. */
+        position_type position;
+
+        /** \brief The first character of the word in the text. */
+        std::size_t first;
+
+        /** \brief The character just past the last character of the word. */
+        std::size_t last;
+
+      }; // struct word
+
+      /** \brief The type of the list of the words of a text. */
+      typedef std::vector<word> word_list;
+
+      /**
+       * \brief The arrangement of a text.
+       *
+       * When the lines are aligned on the left, the arrangement of the lines
+       * preceding the last line of a text does not change when characters are
+       * appended to the text. Thus we keep the state of the layout at the
+       * beginning of the last line in order to resume it from there.
+       */
+      struct layout
+      {
+        /** \brief The placed words, in the order of the text. */
+        word_list words;
+
+        /** \brief The y-coordinate of the baseline of the first line. */
+        coordinate_type top;
+
+        /** \brief The index in the text of the first character of the last
+            line. */
+        std::size_t last_line_first;
+
+        /** \brief The number of words placed before the last line. */
+        std::size_t last_line_word;
+
+        /** \brief The y-coordinate of the baseline of the last line. */
+        coordinate_type last_line_y;
+
+      }; // struct layout
+
+    private:
+      /**
+       * \brief An arrangement and the parameters from which it was computed.
+       */
+      struct entry
+      {
+        /** \brief The arranged text. */
+        std::string text;
+
+        /** \brief The size of the box around the text. */
+        size_box_type size;
+
+        /** \brief How the lines of text are aligned. */
+        text_align::horizontal_align align;
+
+        /** \brief The hash of the text, the size and the alignment. */
+        std::size_t hash;
+
+        /** \brief The arrangement of the text. */
+        layout value;
+
+      }; // struct entry
+
+      /** \brief The type of the list of the arrangements, the most recently
+          used first. */
+      typedef std::list<entry> entry_list;
+
+    public:
+      explicit text_layout_cache( std::size_t capacity );
+
+      const layout* find
+      ( const std::string& text, const size_box_type& size,
+        text_align::horizontal_align align );
+      const layout* find_prefix
+      ( const std::string& text, const size_box_type& size,
+        text_align::horizontal_align align ) const;
+
+      const layout& insert
+      ( const std::string& text, const size_box_type& size,
+        text_align::horizontal_align align, layout value );
+
+      void clear();
+
+    private:
+      static std::size_t hash
+      ( const std::string& text, const size_box_type& size,
+        text_align::horizontal_align align );
+
+    private:
+      /** \brief The maximum number of arrangements in the cache. */
+      const std::size_t m_capacity;
+
+      /** \brief The arrangements, the most recently used first. */
+      entry_list m_entries;
+
+    }; // class text_layout_cache
+  } // namespace visual
+} // namespace bear
+
+#endif // __VISUAL_TEXT_LAYOUT_CACHE_HPP__
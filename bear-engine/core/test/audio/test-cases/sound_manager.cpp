@@ -0,0 +1,296 @@
+#include "audio/sample.hpp"
+#include "audio/sound_effect.hpp"
+#include "audio/sound_manager.hpp"
+
+#include <SDL2/SDL.h>
+
+#include <cstdlib>
+#include <sstream>
+
+#define BOOST_TEST_MODULE bear::audio::sound_manager
+#include <boost/test/included/unit_test.hpp>
+
+namespace test
+{
+  namespace audio
+  {
+    void write_16( std::ostream& os, unsigned int v )
+    {
+      os.put( v & 0xFF );
+      os.put( (v >> 8) & 0xFF );
+    }
+
+    void write_32( std::ostream& os, unsigned int v )
+    {
+      write_16( os, v & 0xFFFF );
+      write_16( os, v >> 16 );
+    }
+
+    /**
+     * Loads a sound made of a square wave in the format of the output stream:
+     * 16 bits stereo at 44100 Hz.
+     */
+    void load_sound
+    ( bear::audio::sound_manager& manager, const std::string& name,
+      unsigned int duration )
+    {
+      const unsigned int rate( 44100 );
+      const unsigned int frame_size( 4 );
+      const unsigned int frames( rate * duration / 1000 );
+
+      std::stringstream wav;
+      wav << "RIFF";
+      write_32( wav, 36 + frames * frame_size );
+      wav << "WAVEfmt ";
+      write_32( wav, 16 );
+      write_16( wav, 1 );
+      write_16( wav, 2 );
+      write_32( wav, rate );
+      write_32( wav, rate * frame_size );
+      write_16( wav, frame_size );
+      write_16( wav, 16 );
+      wav << "data";
+      write_32( wav, frames * frame_size );
+
+      for ( unsigned int i( 0 ); i != frames * 2; ++i )
+        write_16( wav, ( (i / 100) % 2 == 0 ) ? 0x2000 : 0xE000 );
+
+      manager.load_sound( name, wav );
+    }
+
+    bear::audio::sample* play_at
+    ( bear::audio::sound_manager& manager, double x, unsigned int loops = 0,
+      int priority = 0 )
+    {
+      bear::audio::sound_effect effect
+        ( claw::math::coordinate_2d< double >( x, 0 ) );
+      effect.set_loops( loops );
+      effect.set_priority( priority );
+
+      bear::audio::sample* const result( manager.new_sample( "sound" ) );
+      result->play( effect );
+
+      return result;
+    }
+  }
+}
+
+/**
+ * Opens the audio output with the dummy driver of the SDL, which consumes the
+ * mixed stream without any audio device.
+ */
+struct dummy_audio_driver
+{
+  dummy_audio_driver()
+  {
+    setenv( "SDL_AUDIODRIVER", "dummy", 1 );
+    bear::audio::sound_manager::initialize();
+  }
+
+  ~dummy_audio_driver()
+  {
+    bear::audio::sound_manager::release();
+  }
+};
+
+BOOST_GLOBAL_FIXTURE( dummy_audio_driver );
+
+BOOST_AUTO_TEST_CASE( closest_voices_are_real )
+{
+  bear::audio::sound_manager manager;
+  test::audio::load_sound( manager, "sound", 500 );
+  manager.set_max_voices( 2 );
+
+  bear::audio::sample* const far( test::audio::play_at( manager, 600 ) );
+  bear::audio::sample* const near( test::audio::play_at( manager, 100 ) );
+  bear::audio::sample* const closest( test::audio::play_at( manager, 0 ) );
+  bear::audio::sample* const middle( test::audio::play_at( manager, 300 ) );
+
+  manager.update_voices();
+
+  BOOST_CHECK( !closest->is_virtual() );
+  BOOST_CHECK( !near->is_virtual() );
+  BOOST_CHECK( middle->is_virtual() );
+  BOOST_CHECK( far->is_virtual() );
+
+  BOOST_CHECK( closest->is_playing() );
+  BOOST_CHECK( near->is_playing() );
+  BOOST_CHECK( middle->is_playing() );
+  BOOST_CHECK( far->is_playing() );
+
+  delete far;
+  delete near;
+  delete closest;
+  delete middle;
+}
+
+BOOST_AUTO_TEST_CASE( priority_beats_distance )
+{
+  bear::audio::sound_manager manager;
+  test::audio::load_sound( manager, "sound", 500 );
+  manager.set_max_voices( 1 );
+
+  bear::audio::sample* const near( test::audio::play_at( manager, 0 ) );
+  bear::audio::sample* const important
+    ( test::audio::play_at( manager, 800, 0, 1 ) );
+
+  manager.update_voices();
+
+  BOOST_CHECK( near->is_virtual() );
+  BOOST_CHECK( !important->is_virtual() );
+
+  delete near;
+  delete important;
+}
+
+BOOST_AUTO_TEST_CASE( inaudible_voice_is_virtual )
+{
+  bear::audio::sound_manager manager;
+  test::audio::load_sound( manager, "sound", 500 );
+  manager.set_max_voices( 10 );
+
+  bear::audio::sample* const s( test::audio::play_at( manager, 5000 ) );
+
+  manager.update_voices();
+  BOOST_CHECK( s->is_virtual() );
+  BOOST_CHECK( s->is_playing() );
+
+  SDL_Delay( 50 );
+
+  manager.set_ears_position( claw::math::coordinate_2d< double >( 5000, 0 ) );
+  BOOST_CHECK( !s->is_virtual() );
+  BOOST_CHECK( s->is_playing() );
+
+  manager.set_ears_position( claw::math::coordinate_2d< double >( 0, 0 ) );
+  BOOST_CHECK( s->is_virtual() );
+
+  delete s;
+}
+
+BOOST_AUTO_TEST_CASE( real_voice_keeps_its_channel_near_silence )
+{
+  bear::audio::sound_manager manager;
+  test::audio::load_sound( manager, "sound", 500 );
+  manager.set_max_voices( 10 );
+
+  bear::audio::sample* const s( test::audio::play_at( manager, 5000 ) );
+
+  manager.update_voices();
+  BOOST_CHECK( s->is_virtual() );
+
+  // Just behind the silence distance, the virtual voice stays virtual.
+  manager.set_ears_position( claw::math::coordinate_2d< double >( 3750, 0 ) );
+  BOOST_CHECK( s->is_virtual() );
+
+  manager.set_ears_position( claw::math::coordinate_2d< double >( 3900, 0 ) );
+  BOOST_CHECK( !s->is_virtual() );
+
+  // Back to the same place, the real voice keeps its channel.
+  manager.set_ears_position( claw::math::coordinate_2d< double >( 3750, 0 ) );
+  BOOST_CHECK( !s->is_virtual() );
+
+  manager.set_ears_position( claw::math::coordinate_2d< double >( 3600, 0 ) );
+  BOOST_CHECK( s->is_virtual() );
+
+  delete s;
+}
+
+BOOST_AUTO_TEST_CASE( real_voice_keeps_its_channel_against_close_voice )
+{
+  bear::audio::sound_manager manager;
+  test::audio::load_sound( manager, "sound", 500 );
+  manager.set_max_voices( 1 );
+
+  bear::audio::sample* const first( test::audio::play_at( manager, 500 ) );
+  bear::audio::sample* const second( test::audio::play_at( manager, 1000 ) );
+
+  manager.update_voices();
+  BOOST_CHECK( !first->is_virtual() );
+  BOOST_CHECK( second->is_virtual() );
+
+  // The second voice is a bit closer but not enough to take the channel.
+  manager.set_ears_position( claw::math::coordinate_2d< double >( 760, 0 ) );
+  BOOST_CHECK( !first->is_virtual() );
+  BOOST_CHECK( second->is_virtual() );
+
+  manager.set_ears_position( claw::math::coordinate_2d< double >( 1000, 0 ) );
+  BOOST_CHECK( first->is_virtual() );
+  BOOST_CHECK( !second->is_virtual() );
+
+  delete first;
+  delete second;
+}
+
+BOOST_AUTO_TEST_CASE( virtual_voice_finishes )
+{
+  bear::audio::sound_manager manager;
+  test::audio::load_sound( manager, "sound", 50 );
+
+  bear::audio::sample* const s( test::audio::play_at( manager, 5000, 1 ) );
+
+  manager.update_voices();
+  BOOST_CHECK( s->is_virtual() );
+  BOOST_CHECK( s->is_playing() );
+
+  SDL_Delay( 100 );
+
+  manager.update_voices();
+  BOOST_CHECK( !s->is_virtual() );
+  BOOST_CHECK( !s->is_playing() );
+
+  delete s;
+}
+
+BOOST_AUTO_TEST_CASE( remaining_loops_resume_after_tail )
+{
+  bear::audio::sound_manager manager;
+  test::audio::load_sound( manager, "sound", 300 );
+
+  bear::audio::sample* const s( test::audio::play_at( manager, 5000, 3 ) );
+
+  manager.update_voices();
+  BOOST_CHECK( s->is_virtual() );
+
+  SDL_Delay( 100 );
+
+  // The sample is played from the tail of its first loop.
+  manager.set_ears_position( claw::math::coordinate_2d< double >( 5000, 0 ) );
+  BOOST_CHECK( !s->is_virtual() );
+
+  SDL_Delay( 350 );
+
+  // The tail is over, the two loops left wait for the next update.
+  BOOST_CHECK( s->is_virtual() );
+  BOOST_CHECK( s->is_playing() );
+
+  manager.update_voices();
+  BOOST_CHECK( !s->is_virtual() );
+  BOOST_CHECK( s->is_playing() );
+
+  SDL_Delay( 800 );
+
+  BOOST_CHECK( !s->is_virtual() );
+  BOOST_CHECK( !s->is_playing() );
+
+  delete s;
+}
+
+BOOST_AUTO_TEST_CASE( stop_virtual_voice )
+{
+  bear::audio::sound_manager manager;
+  test::audio::load_sound( manager, "sound", 500 );
+
+  bear::audio::sample* const s( test::audio::play_at( manager, 5000 ) );
+
+  manager.update_voices();
+  BOOST_CHECK( s->is_virtual() );
+
+  s->stop();
+  BOOST_CHECK( !s->is_virtual() );
+  BOOST_CHECK( !s->is_playing() );
+
+  manager.set_ears_position( claw::math::coordinate_2d< double >( 5000, 0 ) );
+  BOOST_CHECK( !s->is_playing() );
+
+  delete s;
+}
@@ -0,0 +1,167 @@
+#include "net/server_core.hpp"
+
+#include <boost/thread/thread.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#define BOOST_TEST_MODULE bear::net::server_core
+#include <boost/test/included/unit_test.hpp>
+
+namespace test
+{
+  namespace net
+  {
+    const unsigned int port( 34567 );
+
+    void sleep( unsigned int ms )
+    {
+      boost::this_thread::sleep( boost::posix_time::milliseconds( ms ) );
+    }
+
+    /**
+     * Opens a connection to the server on the loopback interface.
+     */
+    int connect_to_server()
+    {
+      sockaddr_in address;
+      std::memset( &address, 0, sizeof(address) );
+      address.sin_family = AF_INET;
+      address.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+      address.sin_port = htons( port );
+
+      const int result( socket( AF_INET, SOCK_STREAM, 0 ) );
+      connect( result, (sockaddr*)&address, sizeof(address) );
+
+      return result;
+    }
+
+    /**
+     * Accepts the pending connections until count clients are connected.
+     */
+    void accept_clients
+    ( bear::net::server_core& core, std::vector<std::size_t>& ids,
+      std::size_t count )
+    {
+      for ( unsigned int i( 0 ); (i != 200) && (ids.size() != count); ++i )
+        {
+          core.accept_clients( ids );
+          sleep( 5 );
+        }
+    }
+
+    /**
+     * Sends some data to all the clients until the count of clients of the
+     * server is the expected one.
+     */
+    void broadcast_until
+    ( bear::net::server_core& core, const bear::net::server_core::buffer_type&
+      data, std::size_t count )
+    {
+      for ( unsigned int i( 0 );
+            (i != 200) && (core.get_client_count() != count); ++i )
+        {
+          core.broadcast( data );
+          sleep( 10 );
+        }
+    }
+
+    /**
+     * Reads and discards the data received from the server until the
+     * connection is closed.
+     */
+    void read_all( int descriptor )
+    {
+      char buffer[65536];
+
+      while ( read( descriptor, buffer, sizeof(buffer) ) > 0 );
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( closed_peer_is_released )
+{
+  bear::net::server_core core( test::net::port );
+  BOOST_REQUIRE( core.is_open() );
+
+  const int a( test::net::connect_to_server() );
+  const int b( test::net::connect_to_server() );
+  const int c( test::net::connect_to_server() );
+
+  std::vector<std::size_t> ids;
+  test::net::accept_clients( core, ids, 3 );
+
+  BOOST_REQUIRE_EQUAL( ids.size(), 3 );
+  BOOST_CHECK( ids[0] < ids[1] );
+  BOOST_CHECK( ids[1] < ids[2] );
+  BOOST_CHECK_EQUAL( core.get_client_count(), 3 );
+
+  close( b );
+
+  test::net::broadcast_until
+    ( core, std::make_shared<const std::string>( "x\n" ), 2 );
+  BOOST_CHECK_EQUAL( core.get_client_count(), 2 );
+
+  // The identifiers of the remaining clients are kept.
+  const int d( test::net::connect_to_server() );
+
+  std::vector<std::size_t> more;
+  test::net::accept_clients( core, more, 1 );
+
+  BOOST_REQUIRE_EQUAL( more.size(), 1 );
+  BOOST_CHECK( more[0] > ids[2] );
+  BOOST_CHECK_EQUAL( core.get_client_count(), 3 );
+
+  // Sending to the closed client does nothing.
+  core.send( ids[1], std::make_shared<const std::string>( "x\n" ) );
+
+  close( a );
+  close( c );
+  close( d );
+}
+
+BOOST_AUTO_TEST_CASE( slow_client_is_disconnected )
+{
+  bear::net::server_core core( test::net::port );
+  BOOST_REQUIRE( core.is_open() );
+
+  const int slow( test::net::connect_to_server() );
+  const int fast( test::net::connect_to_server() );
+
+  std::vector<std::size_t> ids;
+  test::net::accept_clients( core, ids, 2 );
+  BOOST_REQUIRE_EQUAL( ids.size(), 2 );
+
+  boost::thread reader( &test::net::read_all, fast );
+
+  // The slow client never reads, thus its queue exceeds the 4 MiB cap.
+  const bear::net::server_core::buffer_type data
+    ( new std::string( 64 * 1024, 'y' ) );
+
+  for ( unsigned int i( 0 ); i != 400; ++i )
+    {
+      core.broadcast( data );
+
+      if ( i % 20 == 0 )
+        test::net::sleep( 5 );
+    }
+
+  test::net::broadcast_until( core, data, 1 );
+  BOOST_CHECK_EQUAL( core.get_client_count(), 1 );
+
+  // The data of the disconnected client is not counted anymore.
+  for ( unsigned int i( 0 ); (i != 200) && (core.get_queued_size() != 0); ++i )
+    test::net::sleep( 10 );
+
+  BOOST_CHECK_EQUAL( core.get_queued_size(), 0 );
+
+  shutdown( fast, SHUT_RDWR );
+  reader.join();
+
+  close( slow );
+  close( fast );
+}
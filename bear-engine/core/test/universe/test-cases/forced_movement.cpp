@@ -0,0 +1,177 @@
+#include "universe/forced_movement/forced_movement.hpp"
+#include "universe/forced_movement/base_forced_movement.hpp"
+#include "universe/forced_movement/forced_rotation.hpp"
+#include "universe/forced_movement/forced_sequence.hpp"
+#include "universe/forced_movement/forced_tracking.hpp"
+#include "universe/forced_movement/forced_translation.hpp"
+#include "universe/physical_item.hpp"
+
+#define BOOST_TEST_MODULE bear::universe::forced_movement
+#include <boost/test/included/unit_test.hpp>
+
+namespace test
+{
+  namespace universe
+  {
+    class custom_movement:
+      public bear::universe::base_forced_movement
+    {
+    public:
+      bear::universe::base_forced_movement* clone() const override
+      {
+        return new custom_movement( *this );
+      }
+
+      bool is_finished() const override
+      {
+        return false;
+      }
+
+    private:
+      void do_init() override
+      {
+
+      }
+
+      bear::universe::time_type
+      do_next_position( bear::universe::time_type elapsed_time ) override
+      {
+        set_moving_item_position
+          ( get_moving_item_position()
+            + bear::universe::position_type( 0, elapsed_time ) );
+        return 0;
+      }
+    };
+  }
+}
+
+BOOST_AUTO_TEST_CASE( copy_translation )
+{
+  bear::universe::physical_item item;
+  item.set_size( 10, 10 );
+  item.set_center_of_mass( 0, 0 );
+
+  bear::universe::forced_movement movement
+    ( bear::universe::forced_translation
+      ( bear::universe::speed_type( 10, 0 ) ) );
+  movement.set_item( item );
+  movement.init();
+
+  bear::universe::forced_movement copy( movement );
+  copy.next_position( 1 );
+  BOOST_CHECK_EQUAL( item.get_center_of_mass().x, 10 );
+
+  movement = copy;
+  movement = movement;
+  copy.clear();
+  movement.next_position( 1 );
+  BOOST_CHECK_EQUAL( item.get_center_of_mass().x, 20 );
+  BOOST_CHECK_EQUAL( item.get_center_of_mass().y, 0 );
+}
+
+BOOST_AUTO_TEST_CASE( copy_tracking )
+{
+  bear::universe::physical_item item1;
+  item1.set_size( 10, 10 );
+  item1.set_center_of_mass( 0, 0 );
+
+  bear::universe::physical_item item2;
+  item2.set_size( 10, 10 );
+  item2.set_center_of_mass( 20, 30 );
+
+  bear::universe::forced_tracking tracking;
+  tracking.set_reference_point_on_center( item2 );
+
+  bear::universe::forced_movement movement( tracking );
+  movement.set_item( item1 );
+  movement.init();
+
+  const bear::universe::forced_movement copy( movement );
+  movement.clear();
+
+  bear::universe::forced_movement assigned;
+  assigned = copy;
+  BOOST_CHECK( assigned.has_reference_item() );
+  BOOST_CHECK_EQUAL( &assigned.get_reference_item(), &item2 );
+
+  item2.set_center_of_mass( 40, 50 );
+  assigned.next_position( 1 );
+  BOOST_CHECK_EQUAL( item1.get_center_of_mass().x, 20 );
+  BOOST_CHECK_EQUAL( item1.get_center_of_mass().y, 20 );
+}
+
+BOOST_AUTO_TEST_CASE( assign_to_item )
+{
+  bear::universe::physical_item item;
+  bear::universe::physical_item center;
+
+  bear::universe::forced_rotation rotation;
+  rotation.set_reference_point_on_center( center );
+
+  for ( std::size_t i( 0 ); i != 10; ++i )
+    {
+      item.set_forced_movement( rotation );
+      BOOST_CHECK( item.has_forced_movement() );
+      BOOST_CHECK_EQUAL( item.get_movement_reference(), &center );
+
+      item.set_forced_movement
+        ( bear::universe::forced_translation
+          ( bear::universe::speed_type( 1, 0 ) ) );
+      BOOST_CHECK( item.has_forced_movement() );
+      BOOST_CHECK( item.get_movement_reference() == nullptr );
+    }
+
+  item.clear_forced_movement();
+  BOOST_CHECK( !item.has_forced_movement() );
+}
+
+BOOST_AUTO_TEST_CASE( sequence_loop )
+{
+  bear::universe::physical_item item;
+  item.set_size( 10, 10 );
+  item.set_center_of_mass( 0, 0 );
+
+  bear::universe::forced_sequence sequence;
+  sequence.push_back
+    ( bear::universe::forced_translation
+      ( bear::universe::speed_type( 10, 0 ), 1 ) );
+  sequence.push_back
+    ( bear::universe::forced_translation
+      ( bear::universe::speed_type( -10, 0 ), 1 ) );
+
+  bear::universe::forced_movement movement( sequence );
+  movement.set_item( item );
+  movement.init();
+
+  for ( std::size_t i( 0 ); i != 4; ++i )
+    {
+      movement.next_position( 0.5 );
+      movement.next_position( 0.5 );
+      BOOST_CHECK_CLOSE( item.get_center_of_mass().x, 10, 0.001 );
+
+      movement.next_position( 1 );
+      BOOST_CHECK_SMALL( item.get_center_of_mass().x, 0.001 );
+    }
+
+  BOOST_CHECK( !movement.is_finished() );
+}
+
+BOOST_AUTO_TEST_CASE( custom_movement )
+{
+  bear::universe::physical_item item;
+  item.set_size( 10, 10 );
+  item.set_center_of_mass( 0, 0 );
+
+  bear::universe::forced_movement movement
+    ( ( test::universe::custom_movement() ) );
+  movement.set_item( item );
+  movement.init();
+
+  bear::universe::forced_movement copy;
+  copy = movement;
+  movement.clear();
+
+  copy.next_position( 2 );
+  BOOST_CHECK_EQUAL( item.get_center_of_mass().x, 0 );
+  BOOST_CHECK_EQUAL( item.get_center_of_mass().y, 2 );
+}
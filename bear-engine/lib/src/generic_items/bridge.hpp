@@ -97,7 +97,7 @@ namespace bear
     bool set_real_field( const std::string& name, double value );
     void progress( bear::universe::time_type elapsed_time );
     void on_enters_layer();
-    void get_visual( std::list<engine::scene_visual>& visuals ) const;
+    void get_visual( engine::scene_visual_sink& visuals ) const;
     bool is_valid() const;
     
   protected:
@@ -105,13 +105,13 @@ namespace bear
 
   private:
     void add_bridge_visuals
-    ( std::list<engine::scene_visual>& visuals,
+    ( engine::scene_visual_sink& visuals,
       const base_item* start, const base_item* end,
       const universe::coordinate_type& unity,
       universe::coordinate_type& length, 
       universe::position_type& previous_pos ) const;
     void add_bridge_visual
-    ( std::list<engine::scene_visual>& visuals,
+    ( engine::scene_visual_sink& visuals,
       const universe::position_type& left_pos,
       const universe::position_type& right_pos ) const;
     
@@ -210,7 +210,7 @@ void bear::bridge::on_enters_layer()
  * \param visuals (out) The visuals.
  */
 void bear::bridge::get_visual
-( std::list<engine::scene_visual>& visuals ) const
+( engine::scene_visual_sink& visuals ) const
 {
   universe::coordinate_type length = 0;
   const visual::sprite s(get_sprite());
@@ -272,7 +272,7 @@ void bear::bridge::populate_loader_map( engine::item_loader_map& m )
  * \param previous_pos Th position of the last visual.
  */
 void bear::bridge::add_bridge_visuals
-( std::list<engine::scene_visual>& visuals,
+( engine::scene_visual_sink& visuals,
   const base_item* start, const base_item* end,
   const universe::coordinate_type& unity,
   universe::coordinate_type& length, 
@@ -309,7 +309,7 @@ void bear::bridge::add_bridge_visuals
  * \param right_pos Right position.
  */
 void bear::bridge::add_bridge_visual
-( std::list<engine::scene_visual>& visuals,
+( engine::scene_visual_sink& visuals,
   const universe::position_type& left_pos,
   const universe::position_type& right_pos ) const
 {
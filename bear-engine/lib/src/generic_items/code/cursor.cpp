@@ -73,7 +73,7 @@ bool bear::cursor::set_real_field( const std::string& name, double value )
  * \brief Get the sprite representing the item.
  * \param visuals (out) The sprites of the item, and their positions.
  */
-void bear::cursor::get_visual( std::list<engine::scene_visual>& visuals ) const
+void bear::cursor::get_visual( engine::scene_visual_sink& visuals ) const
 {
   if ( m_inactive_duration < m_visibility_duration )
     super::get_visual( visuals );
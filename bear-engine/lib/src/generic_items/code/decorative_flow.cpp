@@ -95,7 +95,7 @@ bear::decorative_flow::set_real_field( const std::string& name, double value )
  * \param visuals (out) The sprites of the item, and their positions.
  */
 void bear::decorative_flow::get_visual
-( std::list<engine::scene_visual>& visuals ) const
+( engine::scene_visual_sink& visuals ) const
 {
   visual::sprite spr( get_sprite() );
 
@@ -77,6 +77,8 @@ bool bear::decorative_item::loader::set_field
     m_item.set_kill_on_contact( value );
   else if (name == "kill_when_leaving")
     m_item.set_kill_when_leaving( value );
+  else if (name == "passive")
+    m_item.set_passive( value );
   else
     result = super::set_field(name, value);
 
@@ -96,7 +98,7 @@ BASE_ITEM_EXPORT( decorative_item, bear )
 bear::decorative_item::decorative_item()
   : m_kill_when_finished(false),  m_kill_on_contact(false),
   m_stop_on_bottom_contact(false), m_kill_when_leaving(false),
-  m_shadow_x(0), m_shadow_y(0)
+  m_shadow_x(0), m_shadow_y(0), m_passive(false), m_animation_date(0)
 {
   set_phantom(true);
   set_can_move_items(false);
@@ -121,28 +123,29 @@ void bear::decorative_item::progress( universe::time_type elapsed_time )
 /**
  * \brief Gets the scene elements to use to render this item.
  * \param visuals (out) The scene elements.
+ *
+ * When the item has a shadow, the elements of the parent class are grouped in
+ * a sequence such that a single shadow is cast by the whole item.
  */
 void bear::decorative_item::get_visual
-( std::list<engine::scene_visual>& visuals ) const
+( engine::scene_visual_sink& visuals ) const
 {
   if ( (m_shadow_x == 0) || (m_shadow_y == 0) )
     super::get_visual( visuals );
   else
     {
-      typedef std::list<engine::scene_visual> visual_list;
-
-      visual_list parent_visuals;
-
-      super::get_visual( parent_visuals );
-      parent_visuals.sort( engine::scene_visual::z_position_compare() );
+      super::get_visual( m_shadow_visuals );
+      m_shadow_visuals.sort();
 
       visual::scene_element_sequence result;
       result.set_shadow( m_shadow_x, m_shadow_y );
 
-      for ( visual_list::iterator it=parent_visuals.begin();
-            it!=parent_visuals.end(); ++it )
+      for ( engine::scene_visual_sink::iterator it=m_shadow_visuals.begin();
+            it!=m_shadow_visuals.end(); ++it )
         result.push_back( it->scene_element );
 
+      m_shadow_visuals.clear();
+
       visuals.push_back( engine::scene_visual( result, get_z_position() ) );
     }
 } // decorative_item::get_visual()
@@ -157,6 +160,15 @@ void bear::decorative_item::set_kill_when_finished(bool value)
   m_kill_when_finished = value;
 } // decorative_item::set_kill_when_finished()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the item kills himself when the animation is finished.
+ */
+bool bear::decorative_item::get_kill_when_finished() const
+{
+  return m_kill_when_finished;
+} // decorative_item::get_kill_when_finished()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Set if the item kills himself when he has a contact.
@@ -206,6 +218,53 @@ void bear::decorative_item::set_shadow_y( double v )
   m_shadow_y = v;
 } // decorative_item::set_shadow_y()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set if the item only plays its animation.
+ * \param value The new value.
+ *
+ * A passive item is not progressed by a decoration_layer: its animation is
+ * moved forward with the clock of the layer when the item is displayed.
+ */
+void bear::decorative_item::set_passive( bool value )
+{
+  m_passive = value;
+} // decorative_item::set_passive()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the item only plays its animation. An item killed on contact
+ *        is never passive since the contacts are checked in progress().
+ */
+bool bear::decorative_item::is_passive() const
+{
+  return m_passive && !m_kill_on_contact;
+} // decorative_item::is_passive()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the date of the clock at which the animation currently is.
+ * \param date The date of the clock.
+ */
+void bear::decorative_item::set_animation_date( universe::time_type date )
+{
+  m_animation_date = date;
+} // decorative_item::set_animation_date()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Move the animation forward until a given date of the clock.
+ * \param date The date of the clock.
+ */
+void bear::decorative_item::advance_animation_to( universe::time_type date )
+{
+  if ( date > m_animation_date )
+    {
+      progress_animation( date - m_animation_date );
+      m_animation_date = date;
+    }
+} // decorative_item::advance_animation_to()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Adds the loaders of this item class into a given loader map.
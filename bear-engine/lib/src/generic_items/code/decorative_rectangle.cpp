@@ -39,7 +39,7 @@ bear::decorative_rectangle::decorative_rectangle()
  * \param visuals (out) The sprites of the item, and their positions.
  */
 void bear::decorative_rectangle::get_visual
-( std::list<engine::scene_visual>& visuals ) const
+( engine::scene_visual_sink& visuals ) const
 {
   super::get_visual(visuals);
 
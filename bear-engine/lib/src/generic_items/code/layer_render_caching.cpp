@@ -0,0 +1,75 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::layer_render_caching class.
+ * \author Julien Jorge
+ */
+#include "generic_items/layer_render_caching.hpp"
+
+#include "engine/layer/layer.hpp"
+#include "engine/level.hpp"
+
+#include <algorithm>
+
+BASE_ITEM_EXPORT( layer_render_caching, bear )
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+bear::layer_render_caching::layer_render_caching()
+{
+  set_phantom(true);
+  set_can_move_items(false);
+  set_artificial(true);
+  set_global(true);
+} // layer_render_caching::layer_render_caching()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set a field of type list of string.
+ * \param name The name of the field.
+ * \param value The new value of the field.
+ * \return false if the field "name" is unknow, true otherwise.
+ */
+bool bear::layer_render_caching::set_string_list_field
+( const std::string& name, const std::vector<std::string>& value )
+{
+  bool result = true;
+
+  if ( name == "layer_render_caching.layer_tags" )
+    m_layer_tags = value;
+  else
+    result = super::set_string_list_field(name, value);
+
+  return result;
+} // layer_render_caching::set_string_list_field()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Does one iteration in the progression of the item. The layers are
+ *        set when all of them are loaded, then the item kills itself.
+ * \param elapsed_time The elapsed time since the last call.
+ */
+void bear::layer_render_caching::progress( universe::time_type elapsed_time )
+{
+  super::progress(elapsed_time);
+
+  if ( m_layer_tags.empty() )
+    get_layer().set_render_cached( true );
+  else
+    for ( engine::level::layer_iterator it( get_level().layer_begin() );
+          it != get_level().layer_end(); ++it )
+      if ( std::find( m_layer_tags.begin(), m_layer_tags.end(), it->get_tag() )
+           != m_layer_tags.end() )
+        it->set_render_cached( true );
+
+  kill();
+} // layer_render_caching::progress()
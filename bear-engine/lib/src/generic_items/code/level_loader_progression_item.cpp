@@ -39,7 +39,7 @@ void bear::level_loader_progression_item::progress
  * \param visuals (out) The sprites of the item, and their positions.
  */
 void bear::level_loader_progression_item::get_visual
-( std::list<engine::scene_visual>& visuals ) const
+( engine::scene_visual_sink& visuals ) const
 {
   add_visual( m_item_bar, visuals );
 } // level_loader_progression_item::get_visual()
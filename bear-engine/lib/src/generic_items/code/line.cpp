@@ -109,7 +109,7 @@ void bear::line::progress( universe::time_type elapsed_time )
  * \brief Get the visual of the item.
  * \param visual (out) The visual representation of the item.
  */
-void bear::line::get_visual( std::list<engine::scene_visual>& visuals ) const
+void bear::line::get_visual( engine::scene_visual_sink& visuals ) const
 {
   super::get_visual(visuals);
 
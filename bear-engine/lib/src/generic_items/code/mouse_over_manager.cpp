@@ -122,7 +122,7 @@ bool bear::mouse_over_manager::set_sample_field
  * \param visuals (out) The sprites of the item, and their positions.
  */
 void bear::mouse_over_manager::get_visual
-( std::list<bear::engine::scene_visual>& visuals ) const
+( bear::engine::scene_visual_sink& visuals ) const
 {
   super::get_visual(visuals); 
   
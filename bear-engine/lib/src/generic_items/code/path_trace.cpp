@@ -153,7 +153,7 @@ void bear::path_trace::progress( universe::time_type elapsed_time )
  * \param visuals (out) The visuals.
  */
 void
-bear::path_trace::get_visual( std::list<engine::scene_visual>& visuals ) const
+bear::path_trace::get_visual( engine::scene_visual_sink& visuals ) const
 {
   CLAW_PRECOND( m_previous_bottom.size() == m_previous_top.size() );
 
@@ -12,7 +12,6 @@
  * \author Sebastie Angibaud
  */
 #include "generic_items/reflecting_decoration.hpp"
-#include "visual/scene_element_sequence.hpp"
 
 #include "engine/layer/layer.hpp"
 #include "engine/world.hpp"
@@ -72,40 +71,30 @@ void bear::reflecting_decoration::progress( universe::time_type elapsed_time )
 /**
  * \brief Get the sprites representing the item.
  * \param visuals (out) The sprites of the item, and their positions.
+ *
+ * The visuals of the reflected items are inserted directly in \a visuals, then
+ * moved by the gap of the item and combined with its rendering attributes.
+ * They are displayed in the group of this item, sorted by their z-position.
  */
 void bear::reflecting_decoration::get_visual
-( std::list<engine::scene_visual>& visuals ) const
+( engine::scene_visual_sink& visuals ) const
 {
   items_list::const_iterator it;
   items_list item_list(m_items_list);
 
   item_list.sort( reflecting_decoration::z_item_position_compare() );
 
+  const std::size_t first( visuals.get_insertion_count() );
+
   for ( it = item_list.begin(); it != item_list.end(); ++it )
     if ( it->get_item() != NULL )
-      {
-        std::list<engine::scene_visual> scenes;
-        (*it)->get_visual(scenes);
-
-        scenes.sort(engine::scene_visual::z_position_compare());
-
-        if ( !scenes.empty() )
-          {
-            visual::scene_element_sequence e;
-            visual::position_type origin
-              ( scenes.front().scene_element.get_position() );
-            e.set_position( origin + get_gap() );
-
-            for ( ; !scenes.empty() ; scenes.pop_front() )
-              {
-                visual::scene_element elem( scenes.front().scene_element );
-                elem.set_position( elem.get_position() - origin );
-                e.push_back( elem );
-              }
-
-            e.get_rendering_attributes().combine( get_rendering_attributes() );
-
-            visuals.push_back( engine::scene_visual(e, get_z_position()) );
-          }
-      }
+      (*it)->get_visual(visuals);
+
+  for ( std::size_t i=first; i!=visuals.get_insertion_count(); ++i )
+    {
+      visual::scene_element& e( visuals.get_inserted_visual(i).scene_element );
+
+      e.set_position( e.get_position() + get_gap() );
+      e.get_rendering_attributes().combine( get_rendering_attributes() );
+    }
 } // reflecting_decoration::get_visual()
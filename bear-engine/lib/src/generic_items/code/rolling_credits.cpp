@@ -256,7 +256,7 @@ void bear::rolling_credits::progress( universe::time_type elapsed_time )
  * \param visuals (out) The sprites of the item, and their positions.
  */
 void bear::rolling_credits::get_visual
-( std::list<engine::scene_visual>& visuals ) const
+( engine::scene_visual_sink& visuals ) const
 {
   bool stop(false);
   std::list<credit_line>::const_iterator it;
@@ -126,7 +126,7 @@ bool bear::star::set_real_field( const std::string& name, double value )
  * \brief Get the visual of the item.
  * \param visual (out) The visual representation of the item.
  */
-void bear::star::get_visual( std::list<engine::scene_visual>& visuals ) const
+void bear::star::get_visual( engine::scene_visual_sink& visuals ) const
 {
   super::get_visual(visuals);
 
@@ -92,7 +92,7 @@ bool bear::trigger::set_item_list_field
  */
 void
 bear::trigger::get_visual
-( std::list<bear::engine::scene_visual>& visuals ) const
+( bear::engine::scene_visual_sink& visuals ) const
 {
 #ifndef NDEBUG
   if ( ( get_height() == 0 ) &&  ( get_width() == 0 ) )
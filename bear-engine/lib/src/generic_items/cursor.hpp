@@ -40,7 +40,7 @@ namespace bear
 
     void progress( universe::time_type elapsed_time );
     bool set_real_field( const std::string& name, double value );
-    void get_visual( std::list<bear::engine::scene_visual>& visuals ) const;
+    void get_visual( bear::engine::scene_visual_sink& visuals ) const;
 
   private:
     bool mouse_move( const claw::math::coordinate_2d<unsigned int>& pos );
@@ -19,7 +19,7 @@
 #include "engine/item_brick/item_with_decoration.hpp"
 #include "engine/item_brick/activable_sides.hpp"
 #include "generic_items/class_export.hpp"
-#include "engine/scene_visual.hpp"
+#include "engine/scene_visual_sink.hpp"
 
 #include "engine/export.hpp"
 
@@ -57,7 +57,7 @@ namespace bear
     void build();
     virtual bool set_real_field( const std::string& name, double value );
 
-    virtual void get_visual( std::list<engine::scene_visual>& visuals ) const;
+    virtual void get_visual( engine::scene_visual_sink& visuals ) const;
 
   protected:
     void populate_loader_map( engine::item_loader_map& m );
@@ -35,6 +35,8 @@ namespace bear
    * he leaves the active region (default = false).
    *  - \a kill_when finished: (bool) \c Indicates if the item kills himself
    * when the animation is finished (default = false).
+   *  - \a passive: (bool) \c Indicates if the item only plays its animation,
+   * in which case a decoration_layer does not progress it (default = false).
    *
    */
   class GENERIC_ITEMS_EXPORT decorative_item:
@@ -78,9 +80,10 @@ namespace bear
     decorative_item();
 
     void progress( universe::time_type elapsed_time );
-    void get_visual( std::list<engine::scene_visual>& visuals ) const;
+    void get_visual( engine::scene_visual_sink& visuals ) const;
 
     void set_kill_when_finished(bool value);
+    bool get_kill_when_finished() const;
     void set_kill_on_contact(bool value);
 
     bool get_kill_when_leaving() const;
@@ -89,6 +92,11 @@ namespace bear
     void set_shadow_x( double v );
     void set_shadow_y( double v );
 
+    void set_passive( bool value );
+    bool is_passive() const;
+    void set_animation_date( universe::time_type date );
+    void advance_animation_to( universe::time_type date );
+
   protected:
     void populate_loader_map( engine::item_loader_map& m );
 
@@ -117,6 +125,17 @@ namespace bear
     /** \brief The offset of the shadow of the visuals on the y-axis. */
     visual::coordinate_type m_shadow_y;
 
+    /** \brief Tell if the item only plays its animation. */
+    bool m_passive;
+
+    /** \brief The date of the clock of the layer at which the animation is,
+        when the item is passive. */
+    universe::time_type m_animation_date;
+
+    /** \brief The visuals of the parent class, grouped under the shadow, kept
+        from a frame to the next one such that its memory is reused. */
+    mutable engine::scene_visual_sink m_shadow_visuals;
+
   }; // class decorative_item
 } // namespace bear
 
@@ -16,7 +16,7 @@
 
 #include "engine/base_item.hpp"
 #include "engine/item_brick/basic_renderable_item.hpp"
-#include "engine/scene_visual.hpp"
+#include "engine/scene_visual_sink.hpp"
 
 #include "generic_items/class_export.hpp"
 
@@ -49,7 +49,7 @@ namespace bear
 
   public:
     decorative_rectangle();
-    void get_visual( std::list<engine::scene_visual>& visuals ) const;
+    void get_visual( engine::scene_visual_sink& visuals ) const;
     bool set_real_field( const std::string& name, double value );
     bool set_color_field( const std::string& name, visual::color value );
     void set_fill_color( const visual::color& c );
@@ -37,7 +37,7 @@ namespace bear
     ( const region_type& active_area, universe::time_type elapsed_time  );
 
   private:
-    void do_get_visual( std::list<engine::scene_visual>& visuals,
+    void do_get_visual( engine::scene_visual_sink& visuals,
                         const universe::rectangle_type& visible_area ) const;
 
     void do_add_item( engine::base_item& that );
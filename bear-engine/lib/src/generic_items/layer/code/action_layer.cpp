@@ -57,7 +57,7 @@ void bear::action_layer::progress
  * \param visible_area The visible part of the layer.
  */
 void bear::action_layer::do_get_visual
-( std::list<engine::scene_visual>& visuals,
+( engine::scene_visual_sink& visuals,
   const universe::rectangle_type& visible_area ) const
 {
   m_world.get_visual( visuals, visible_area );
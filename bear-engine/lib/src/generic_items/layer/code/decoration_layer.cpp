@@ -16,6 +16,7 @@
 #include "engine/layer/export.hpp"
 
 #include <claw/logger.hpp>
+#include <algorithm>
 #include <set>
 
 LAYER_EXPORT( decoration_layer, bear )
@@ -28,7 +29,10 @@ LAYER_EXPORT( decoration_layer, bear )
 bear::decoration_layer::decoration_layer
 ( const universe::size_box_type& size )
   : layer( size ),
-    m_items( (unsigned int)m_size.x + 1, (unsigned int)m_size.y + 1, 256 )
+    m_items( (unsigned int)m_size.x + 1, (unsigned int)m_size.y + 1, 256 ),
+    m_passive_items
+    ( (unsigned int)m_size.x + 1, (unsigned int)m_size.y + 1, 256 ),
+    m_date(0)
 {
 
 } // decoration_layer::decoration_layer()
@@ -51,6 +55,20 @@ bear::decoration_layer::~decoration_layer()
 
   for(it_g=m_global_items.begin(); it_g!=m_global_items.end(); ++it_g)
     delete *it_g;
+
+  passive_item_map::item_list passive_items;
+  m_passive_items.get_all_unique(passive_items);
+
+  passive_item_list::const_iterator it_p;
+
+  for (it_p=passive_items.begin(); it_p!=passive_items.end(); ++it_p)
+    delete *it_p;
+
+  for (it_p=m_global_passive_items.begin();
+       it_p!=m_global_passive_items.end(); ++it_p)
+    delete *it_p;
+
+  delete_dead_items();
 } // decoration_layer::~decoration_layer()
 
 /*----------------------------------------------------------------------------*/
@@ -71,6 +89,8 @@ void bear::decoration_layer::start()
 void bear::decoration_layer::progress
 ( const region_type& active_area, universe::time_type elapsed_time  )
 {
+  delete_dead_items();
+
   item_map::item_list items;
 
   m_items.get_areas_unique( active_area.begin(), active_area.end(), items );
@@ -82,6 +102,25 @@ void bear::decoration_layer::progress
 
   for(it=m_global_items.begin(); it!=m_global_items.end(); ++it)
     (*it)->progress(elapsed_time);
+
+  m_date += elapsed_time;
+
+  std::size_t i(0);
+
+  while ( i != m_finite_passive_items.size() )
+    {
+      decorative_item* const item( m_finite_passive_items[i] );
+      item->advance_animation_to( m_date );
+
+      if ( item->get_animation().is_finished() )
+        {
+          m_finite_passive_items[i] = m_finite_passive_items.back();
+          m_finite_passive_items.pop_back();
+          item->kill();
+        }
+      else
+        ++i;
+    }
 } // decoration_layer::progress()
 
 /*----------------------------------------------------------------------------*/
@@ -99,8 +138,28 @@ void bear::decoration_layer::log_statistics() const
   claw::logger << claw::log_verbose << "layer[" << m_size.x << ":" << m_size.y
                << "]:items:empty=" << empty_cells << " min=" << min
                << " max=" << max << " avg=" << avg << std::endl;
+
+  empty_cells = m_passive_items.empty_cells();
+  m_passive_items.cells_load(min, max, avg);
+
+  claw::logger << claw::log_verbose << "layer[" << m_size.x << ":" << m_size.y
+               << "]:passive items:empty=" << empty_cells << " min=" << min
+               << " max=" << max << " avg=" << avg << std::endl;
 } // decoration_layer::log_statistics()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Delete the items removed from the layer.
+ */
+void bear::decoration_layer::delete_dead_items()
+{
+  for ( std::vector<engine::base_item*>::const_iterator it=
+          m_dead_items.begin(); it!=m_dead_items.end(); ++it )
+    delete *it;
+
+  m_dead_items.clear();
+} // decoration_layer::delete_dead_items()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the visible sprites of this layer.
@@ -108,7 +167,7 @@ void bear::decoration_layer::log_statistics() const
  * \param visible_area The visible part of the layer.
  */
 void bear::decoration_layer::do_get_visual
-( std::list<engine::scene_visual>& visuals,
+( engine::scene_visual_sink& visuals,
   const universe::rectangle_type& visible_area ) const
 {
   item_map::item_list items;
@@ -118,7 +177,7 @@ void bear::decoration_layer::do_get_visual
   item_map::item_list::const_iterator it;
 
   for (it=items.begin(); it!=items.end(); ++it)
-    visuals.push_back( (*it)->get_visual() );
+    (*it)->insert_visual( visuals );
 
   for(it=m_global_items.begin(); it!=m_global_items.end(); ++it)
     if ( visible_area.intersects( (*it)->get_bounding_box() ) )
@@ -127,10 +186,45 @@ void bear::decoration_layer::do_get_visual
           ( visible_area.intersection( (*it)->get_bounding_box() ) );
 
         if( (r.width() > 0) && (r.height() > 0) )
-          visuals.push_back( (*it)->get_visual() );
+          (*it)->insert_visual( visuals );
+      }
+
+  passive_item_map::item_list passive_items;
+  m_passive_items.get_area_unique( visible_area, passive_items );
+
+  passive_item_list::const_iterator it_p;
+
+  for (it_p=passive_items.begin(); it_p!=passive_items.end(); ++it_p)
+    add_passive_visual( visuals, **it_p );
+
+  for (it_p=m_global_passive_items.begin();
+       it_p!=m_global_passive_items.end(); ++it_p)
+    if ( visible_area.intersects( (*it_p)->get_bounding_box() ) )
+      {
+        const universe::rectangle_type r
+          ( visible_area.intersection( (*it_p)->get_bounding_box() ) );
+
+        if( (r.width() > 0) && (r.height() > 0) )
+          add_passive_visual( visuals, **it_p );
       }
 } // decoration_layer::do_get_visual()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Move the animation of a passive item to the date of the layer and
+ *        add the item in the visible sprites.
+ * \param visuals (out) The sprites in the visible area, and their positions.
+ * \param item The item to display.
+ */
+void bear::decoration_layer::add_passive_visual
+( engine::scene_visual_sink& visuals, decorative_item& item ) const
+{
+  item.advance_animation_to( m_date );
+
+  const engine::base_item& base( item );
+  base.insert_visual( visuals );
+} // decoration_layer::add_passive_visual()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Add an item in the layer.
@@ -138,7 +232,21 @@ void bear::decoration_layer::do_get_visual
  */
 void bear::decoration_layer::do_add_item( engine::base_item& item )
 {
-  if ( item.is_global() )
+  decorative_item* const passive( dynamic_cast<decorative_item*>(&item) );
+
+  if ( (passive != NULL) && passive->is_passive() )
+    {
+      passive->set_animation_date( m_date );
+
+      if ( passive->get_kill_when_finished() )
+        m_finite_passive_items.push_back( passive );
+
+      if ( item.is_global() )
+        m_global_passive_items.push_back( passive );
+      else
+        m_passive_items.insert( passive );
+    }
+  else if ( item.is_global() )
     m_global_items.push_back(&item);
   else
     m_items.insert( &item );
@@ -149,11 +257,41 @@ void bear::decoration_layer::do_add_item( engine::base_item& item )
  * \brief Remove an item from the layer.
  * \param that The item to remove.
  *
- * This method should never be called.
+ * The item is still used by the caller after this call, thus it is deleted at
+ * the next progression.
  */
 void bear::decoration_layer::do_remove_item( engine::base_item& that )
 {
-  CLAW_PRECOND( false );
+  decorative_item* const passive( dynamic_cast<decorative_item*>(&that) );
+
+  if ( (passive != NULL) && passive->is_passive() )
+    {
+      if ( that.is_global() )
+        m_global_passive_items.erase
+          ( std::find
+            ( m_global_passive_items.begin(), m_global_passive_items.end(),
+              passive ) );
+      else
+        m_passive_items.erase( passive );
+
+      const passive_item_list::iterator it
+        ( std::find
+          ( m_finite_passive_items.begin(), m_finite_passive_items.end(),
+            passive ) );
+
+      if ( it != m_finite_passive_items.end() )
+        {
+          *it = m_finite_passive_items.back();
+          m_finite_passive_items.pop_back();
+        }
+    }
+  else if ( that.is_global() )
+    m_global_items.erase
+      ( std::find( m_global_items.begin(), m_global_items.end(), &that ) );
+  else
+    m_items.erase( &that );
+
+  m_dead_items.push_back( &that );
 } // decoration_layer::do_remove_item()
 
 /*----------------------------------------------------------------------------*/
@@ -16,6 +16,7 @@
 #include "generic_items/layer/pattern_layer.hpp"
 
 #include "engine/layer/export.hpp"
+#include "visual/scene_pattern.hpp"
 
 #include <claw/assert.hpp>
 
@@ -55,14 +56,15 @@ void bear::pattern_layer::progress
  * \param visible_area The visible part of the layer.
  */
 void bear::pattern_layer::do_get_visual
-( std::list<engine::scene_visual>& visuals,
+( engine::scene_visual_sink& visuals,
   const universe::rectangle_type& visible_area ) const
 {
   engine::population::const_iterator it;
+  engine::scene_visual_sink local_visuals;
 
   for ( it=m_items.begin(); it!=m_items.end(); ++it )
     {
-      std::list<engine::scene_visual> local_visuals;
+      local_visuals.clear();
       it->get_visual( local_visuals );
 
       repeat_visual( visuals, local_visuals, visible_area );
@@ -107,11 +109,11 @@ void bear::pattern_layer::do_drop_item( engine::base_item& that )
  * \param visible_area The visible part of the layer.
  */
 void bear::pattern_layer::repeat_visual
-( std::list<engine::scene_visual>& visuals,
-  const std::list<engine::scene_visual>& local_visuals,
+( engine::scene_visual_sink& visuals,
+  const engine::scene_visual_sink& local_visuals,
   const universe::rectangle_type& visible_area ) const
 {
-  std::list<engine::scene_visual>::const_iterator it;
+  engine::scene_visual_sink::const_iterator it;
 
   for ( it=local_visuals.begin(); it!=local_visuals.end(); ++it )
     repeat_sprite( visuals, *it, visible_area );
@@ -119,36 +121,35 @@ void bear::pattern_layer::repeat_visual
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Repeat the sprite of a visual on the screen.
+ * \brief Repeat the sprite of a visual on the screen. The repetitions are
+ *        grouped in a single visual.
  * \param visuals (out) The sprites in the visible area, and their positions.
  * \param v The visual to repeat.
  * \param visible_area The visible part of the layer.
  */
 void bear::pattern_layer::repeat_sprite
-( std::list<engine::scene_visual>& visuals, const engine::scene_visual& v,
+( engine::scene_visual_sink& visuals, const engine::scene_visual& v,
   const universe::rectangle_type& visible_area ) const
 {
   claw::math::coordinate_2d<int> v_pos;
   const claw::math::coordinate_2d<unsigned int> v_size =
     v.scene_element.get_bounding_box().size();
+
+  if ( (v_size.x == 0) || (v_size.y == 0) )
+    return;
+
   const unsigned int x_count = visible_area.width()  / v_size.x + 2;
   const unsigned int y_count = visible_area.height() / v_size.y + 2;
 
   v_pos.x = visible_area.left() - (int)visible_area.left() % v_size.x;
+  v_pos.y = visible_area.bottom() - (int)visible_area.bottom() % v_size.y;
 
-  for (unsigned int x=0; x!=x_count; ++x)
-    {
-      v_pos.y = visible_area.bottom() - (int)visible_area.bottom() % v_size.y;
+  visual::scene_element e( v.scene_element );
+  e.set_shadow( 0, 0 );
 
-      for (unsigned int y=0; y!=y_count; ++y)
-        {
-          engine::scene_visual new_v(v);
-          new_v.scene_element.set_position(v_pos);
-          visuals.push_front(new_v);
+  visual::scene_pattern pattern( v_pos.x, v_pos.y, e, x_count, y_count );
+  pattern.set_shadow( v.scene_element.get_shadow() );
+  pattern.set_shadow_opacity( v.scene_element.get_shadow_opacity() );
 
-          v_pos.y += v_size.y;
-        }
-
-      v_pos.x += v_size.x;
-    }
+  visuals.push_front( engine::scene_visual( pattern, v.z_position ) );
 } // pattern_layer::repeat_sprite()
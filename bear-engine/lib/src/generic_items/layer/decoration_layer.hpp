@@ -19,6 +19,7 @@
 #include "universe/static_map.hpp"
 #include "engine/layer/layer.hpp"
 #include "engine/base_item.hpp"
+#include "generic_items/decorative_item.hpp"
 
 #include <claw/math.hpp>
 
@@ -29,6 +30,13 @@ namespace bear
   /**
    * \brief A decoration layer contains animation and sprites positioned in
    *        the world.
+   *
+   * The passive decorative items are not progressed. The layer has a clock
+   * and the animation of such an item is moved forward to the date of the
+   * clock when the item is displayed. Only the passive items killed at the
+   * end of their animation are checked at each progression. The killed
+   * passive items are removed from the layer and deleted at the next
+   * progression.
    */
   class GENERIC_ITEMS_EXPORT decoration_layer:
     public engine::layer
@@ -37,6 +45,12 @@ namespace bear
     /** \brief The type of the structure containing the items. */
     typedef universe::static_map<engine::base_item*> item_map;
 
+    /** \brief The type of the structure containing the passive items. */
+    typedef universe::static_map<decorative_item*> passive_item_map;
+
+    /** \brief The type of the lists of passive items. */
+    typedef std::vector<decorative_item*> passive_item_list;
+
   public:
     decoration_layer( const universe::size_box_type& size );
     virtual ~decoration_layer();
@@ -49,9 +63,14 @@ namespace bear
     void log_statistics() const;
 
   private:
-    void do_get_visual( std::list<engine::scene_visual>& visuals,
+    void delete_dead_items();
+
+    void do_get_visual( engine::scene_visual_sink& visuals,
                         const universe::rectangle_type& visible_area ) const;
 
+    void add_passive_visual
+    ( engine::scene_visual_sink& visuals, decorative_item& item ) const;
+
     void do_add_item( engine::base_item& item );
     void do_remove_item( engine::base_item& item );
     void do_drop_item( engine::base_item& item );
@@ -63,6 +82,24 @@ namespace bear
     /** \brief All global items. */
     std::vector<engine::base_item*> m_global_items;
 
+    /** \brief The passive decorations. */
+    passive_item_map m_passive_items;
+
+    /** \brief The global passive decorations. */
+    passive_item_list m_global_passive_items;
+
+    /** \brief The passive decorations killed at the end of their animation,
+        while they are alive. */
+    passive_item_list m_finite_passive_items;
+
+    /** \brief The items removed from the layer, deleted at the next
+        progression. */
+    std::vector<engine::base_item*> m_dead_items;
+
+    /** \brief The clock of the layer, giving the date of the animations of
+        the passive decorations. */
+    universe::time_type m_date;
+
   }; // class decoration_layer
 } // namespace bear
 
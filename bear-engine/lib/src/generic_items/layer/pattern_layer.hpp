@@ -35,7 +35,7 @@ namespace bear
     ( const region_type& active_area, universe::time_type elapsed_time  );
 
   private:
-    void do_get_visual( std::list<engine::scene_visual>& visuals,
+    void do_get_visual( engine::scene_visual_sink& visuals,
                         const universe::rectangle_type& visible_area ) const;
 
     void do_add_item( engine::base_item& that );
@@ -43,12 +43,12 @@ namespace bear
     void do_drop_item( engine::base_item& item );
 
     void repeat_visual
-    ( std::list<engine::scene_visual>& visuals,
-      const std::list<engine::scene_visual>& local_visuals,
+    ( engine::scene_visual_sink& visuals,
+      const engine::scene_visual_sink& local_visuals,
       const universe::rectangle_type& visible_area ) const;
 
     void repeat_sprite
-    ( std::list<engine::scene_visual>& visuals, const engine::scene_visual& v,
+    ( engine::scene_visual_sink& visuals, const engine::scene_visual& v,
       const universe::rectangle_type& visible_area ) const;
 
     void add( engine::base_item* const& who );
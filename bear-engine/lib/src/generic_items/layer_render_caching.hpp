@@ -0,0 +1,63 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief An item that keeps the rendering of some layers in images.
+ * \author Julien Jorge
+ */
+#ifndef __BEAR_LAYER_RENDER_CACHING_HPP__
+#define __BEAR_LAYER_RENDER_CACHING_HPP__
+
+#include "engine/base_item.hpp"
+#include "engine/export.hpp"
+
+#include "generic_items/class_export.hpp"
+
+namespace bear
+{
+  /**
+   * \brief An item that keeps the rendering of some layers in images, then
+   *        kills itself.
+   *
+   * The layers are rendered once in offscreen tiles, then only the tiles are
+   * displayed. Thus this item must be used only on the layers whose items
+   * never change, like static decorations and patterns.
+   *
+   * The fields of this item are
+   *  - \a layer_tags: (list of string) \c The tags of the layers whose
+   *    rendering is kept (default is the layer containing the item),
+   *  - any field supported by the parent class.
+   *
+   * \author Julien Jorge
+   */
+  class GENERIC_ITEMS_EXPORT layer_render_caching:
+    public engine::base_item
+  {
+    DECLARE_BASE_ITEM(layer_render_caching);
+
+  public:
+    /** \brief The type of the parent class. */
+    typedef engine::base_item super;
+
+  public:
+    layer_render_caching();
+
+    bool set_string_list_field
+    ( const std::string& name, const std::vector<std::string>& value );
+
+    void progress( universe::time_type elapsed_time );
+
+  private:
+    /** \brief The tags of the layers whose rendering is kept. */
+    std::vector<std::string> m_layer_tags;
+
+  }; // class layer_render_caching
+} // namespace bear
+
+#endif // __BEAR_LAYER_RENDER_CACHING_HPP__
@@ -43,7 +43,7 @@ namespace bear
 
   public:
     void progress( universe::time_type elapsed_time );
-    void get_visual( std::list<engine::scene_visual>& visuals ) const;
+    void get_visual( engine::scene_visual_sink& visuals ) const;
 
     bool set_sprite_field
     ( const std::string& name, const visual::sprite& value );
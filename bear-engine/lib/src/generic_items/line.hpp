@@ -57,7 +57,7 @@ namespace bear
       ( const std::string& name, const std::vector<engine::base_item*>& value );
 
     void progress( universe::time_type elapsed_time );
-    void get_visual( std::list<engine::scene_visual>& visuals ) const;
+    void get_visual( engine::scene_visual_sink& visuals ) const;
 
     void push_back( engine::base_item* item );
     void set_line_width( visual::size_type w );
@@ -43,7 +43,7 @@ namespace bear
     bool set_u_integer_field( const std::string& name, unsigned int value );
     bool set_bool_field( const std::string& name, bool value );
 
-    void get_visual( std::list<engine::scene_visual>& visuals ) const;
+    void get_visual( engine::scene_visual_sink& visuals ) const;
     
     void set_link_count(std::size_t link_count);
     void set_max_fall(universe::coordinate_type max_fall);
@@ -89,7 +89,7 @@ bool bear::chain_link_visual::set_bool_field
  * \param visuals (out) The visuals.
  */
 void bear::chain_link_visual::get_visual
-( std::list<engine::scene_visual>& visuals ) const
+( engine::scene_visual_sink& visuals ) const
 {
   const std::size_t n(get_link_count());
   universe::vector_type dir = get_end_position() - get_start_position();
@@ -78,7 +78,7 @@ bear::continuous_link_visual::continuous_link_visual()
  * \param visuals (out) The visuals.
  */
 void bear::continuous_link_visual::get_visual
-( std::list<engine::scene_visual>& visuals ) const
+( engine::scene_visual_sink& visuals ) const
 {
   visual::sprite s(get_sprite());
 
@@ -63,7 +63,7 @@ namespace bear
   public:
     continuous_link_visual();
 
-    void get_visual( std::list<engine::scene_visual>& visuals ) const;
+    void get_visual( engine::scene_visual_sink& visuals ) const;
 
     void set_line_width( double w );
 
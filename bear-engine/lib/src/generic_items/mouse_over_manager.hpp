@@ -61,7 +61,7 @@ namespace bear
     bool set_sample_field( const std::string& name, audio::sample* value );
 
   private:
-    void get_visual( std::list<bear::engine::scene_visual>& visuals ) const;
+    void get_visual( bear::engine::scene_visual_sink& visuals ) const;
     bool mouse_move( const claw::math::coordinate_2d<unsigned int>& pos );
     void get_dependent_items
       ( universe::physical_item::item_list& d ) const;
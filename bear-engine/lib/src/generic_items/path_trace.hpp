@@ -66,7 +66,7 @@ namespace bear
     void set_length( universe::time_type length );
 
     void progress( universe::time_type elapsed_time );
-    void get_visual( std::list<engine::scene_visual>& visuals ) const;
+    void get_visual( engine::scene_visual_sink& visuals ) const;
 
     virtual void move( universe::time_type elapsed_time );
 
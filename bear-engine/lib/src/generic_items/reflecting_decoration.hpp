@@ -56,7 +56,7 @@ namespace bear
 
   public:
     void progress( bear::universe::time_type elapsed_time );
-    virtual void get_visual( std::list<engine::scene_visual>& visuals ) const;
+    virtual void get_visual( engine::scene_visual_sink& visuals ) const;
 
   private:
     /** \brief The list of collised items. */
@@ -86,7 +86,7 @@ namespace bear
 
     void build();
     void progress( universe::time_type elapsed_time );
-    void get_visual( std::list<engine::scene_visual>& visuals ) const;
+    void get_visual( engine::scene_visual_sink& visuals ) const;
 
     bool set_string_field
       ( const std::string& name, const std::string& value );
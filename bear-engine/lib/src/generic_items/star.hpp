@@ -70,7 +70,7 @@ namespace bear
     bool set_u_integer_field( const std::string& name, unsigned int value );
     bool set_real_field( const std::string& name, double value );
 
-    void get_visual( std::list<engine::scene_visual>& visuals ) const;
+    void get_visual( engine::scene_visual_sink& visuals ) const;
     void set_ratio( double r );
 
   private:
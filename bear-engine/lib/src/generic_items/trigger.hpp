@@ -71,7 +71,7 @@ namespace bear
     bool set_item_list_field
       ( const std::string& name, const std::vector<engine::base_item*>& value );
 
-    void get_visual( std::list<bear::engine::scene_visual>& visuals ) const;
+    void get_visual( bear::engine::scene_visual_sink& visuals ) const;
 
     void activate();
     void deactivate();
@@ -0,0 +1,94 @@
+#include "generic_items/layer/decoration_layer.hpp"
+#include "generic_items/layer_render_caching.hpp"
+
+#include "engine/level.hpp"
+
+#define BOOST_TEST_MODULE bear::decoration_layer
+#include <boost/test/included/unit_test.hpp>
+
+namespace test
+{
+  namespace generic_items
+  {
+    /**
+     * A level containing a single decoration layer, in which the items are
+     * progressed.
+     */
+    class decoration_level
+    {
+    public:
+      decoration_level()
+        : m_level
+          ( "test", "", bear::universe::size_box_type( 1024, 1024 ), "",
+            NULL, NULL ),
+          m_layer
+          ( new bear::decoration_layer
+            ( bear::universe::size_box_type( 1024, 1024 ) ) )
+      {
+        m_level.push_layer( m_layer );
+      }
+
+      bear::decoration_layer& get_layer()
+      {
+        return *m_layer;
+      }
+
+      void update()
+      {
+        bear::engine::layer::region_type active_area;
+        active_area.push_back
+          ( bear::universe::rectangle_type( 0, 0, 1024, 1024 ) );
+
+        m_layer->update( active_area, 0.1 );
+      }
+
+    private:
+      bear::engine::level m_level;
+      bear::decoration_layer* const m_layer;
+    };
+  }
+}
+
+/**
+ * The layer_render_caching item is global and kills itself at its first
+ * progression. It must leave the decoration layer, which keeps the render
+ * cache enabled.
+ */
+BOOST_AUTO_TEST_CASE( global_item_killed_during_progress )
+{
+  test::generic_items::decoration_level level;
+  bear::decoration_layer& layer( level.get_layer() );
+
+  layer.add_item( *new bear::layer_render_caching );
+  BOOST_CHECK( !layer.is_render_cached() );
+
+  level.update();
+  BOOST_CHECK( layer.is_render_cached() );
+
+  // The killed item is deleted here.
+  level.update();
+  BOOST_CHECK( layer.is_render_cached() );
+}
+
+/**
+ * A non global item is stored in the cells of the layer. It must be removed
+ * from them when it is killed.
+ */
+BOOST_AUTO_TEST_CASE( local_item_killed_during_progress )
+{
+  test::generic_items::decoration_level level;
+  bear::decoration_layer& layer( level.get_layer() );
+
+  bear::layer_render_caching* const item( new bear::layer_render_caching );
+  item->set_global( false );
+  item->set_bottom_left( bear::universe::position_type( 100, 200 ) );
+  item->set_size( bear::universe::size_box_type( 50, 50 ) );
+
+  layer.add_item( *item );
+
+  level.update();
+  BOOST_CHECK( layer.is_render_cached() );
+
+  level.update();
+  BOOST_CHECK( layer.is_render_cached() );
+}
@@ -0,0 +1,217 @@
+/**
+ * \file
+ *
+ * Performance test of the balloons of the speakers. Many speakers say long
+ * dialogues at the same time in a level; at each frame the speakers are
+ * progressed, then the balloon layer of the level places their balloons and
+ * renders them.
+ *
+ * The speakers do not move, thus the balloons are placed again only when a
+ * balloon opens or closes.
+ *
+ * The font returns fixed metrics but the balloon layer needs the game, which
+ * opens a window. The test can run on a machine without a GPU with a software
+ * OpenGL, e.g. LIBGL_ALWAYS_SOFTWARE=1 with Mesa.
+ *
+ * Usage: comic-balloon [speaker_count]
+ */
+
+#include "fixed_metrics_font.hpp"
+
+#include "engine/comic/item/item_that_speaks.hpp"
+#include "engine/comic/layer/balloon_layer.hpp"
+#include "engine/base_item.hpp"
+#include "engine/export.hpp"
+#include "engine/game.hpp"
+#include "engine/game_description.hpp"
+#include "engine/level.hpp"
+#include "generic_items/layer/decoration_layer.hpp"
+#include "time/time.hpp"
+#include "visual/font/font.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * An item whose balloon is displayed in the layer named "balloons".
+ */
+class speaker:
+  public bear::engine::item_that_speaks<bear::engine::base_item>
+{
+  DECLARE_BASE_ITEM( speaker );
+
+public:
+  typedef bear::engine::item_that_speaks<bear::engine::base_item> super;
+
+public:
+  speaker()
+    : super( "balloons" )
+  {
+
+  }
+};
+
+BASE_ITEM_IMPLEMENT_NO_NAMESPACE( speaker )
+
+/**
+ * Builds a sentence made of words taken in a pangram.
+ */
+std::string create_sentence( std::size_t word_count )
+{
+  static const char* const words[] =
+    { "The", "quick", "brown", "fox", "jumps", "over", "the", "lazy",
+      "dog." };
+  static const std::size_t count( sizeof(words) / sizeof(words[0]) );
+
+  std::string result;
+
+  for ( std::size_t i( 0 ); i != word_count; ++i )
+    {
+      if ( !result.empty() )
+        result += ' ';
+
+      result += words[ std::rand() % count ];
+    }
+
+  return result;
+}
+
+/**
+ * A level made of a layer of speakers, whose size is the one of the screen,
+ * and of the balloon layer displaying their balloons.
+ */
+class speaking_level
+{
+private:
+  const bear::universe::size_box_type m_size;
+  bear::engine::level m_level;
+  bear::decoration_layer* const m_layer;
+  bear::engine::balloon_layer* const m_balloons;
+  std::vector< speaker* > m_speakers;
+
+public:
+  speaking_level( const bear::universe::size_box_type& size )
+    : m_size( size ),
+      m_level( "comic-balloon", "", size, "", NULL, NULL ),
+      m_layer( new bear::decoration_layer( size ) ),
+      m_balloons( new bear::engine::balloon_layer( "balloons" ) )
+  {
+    m_level.push_layer( m_layer );
+    m_level.push_layer( m_balloons );
+
+    bear::engine::base_item* const camera( new bear::engine::base_item );
+    camera->set_size( size );
+    m_layer->add_item( *camera );
+    m_level.set_camera( *camera );
+
+    m_level.unset_pause();
+  }
+
+  void add_speaker( const bear::visual::font& f )
+  {
+    const std::size_t i( m_speakers.size() );
+    speaker* const s( new speaker );
+
+    s->set_bottom_left
+      ( bear::universe::position_type
+        ( (i * 97) % (std::size_t)(m_size.x - 30),
+          (i * 61) % (std::size_t)(m_size.y - 50) ) );
+    s->set_size( 30, 50 );
+    s->get_balloon().set_font( f );
+
+    std::vector< std::string > speech;
+
+    for ( std::size_t j( 0 ); j != 3; ++j )
+      speech.push_back( create_sentence( 10 + std::rand() % 30 ) );
+
+    s->speak( speech );
+
+    m_layer->add_item( *s );
+    m_speakers.push_back( s );
+  }
+
+  /**
+   * Runs the dialogues of the speakers until they have all finished to speak.
+   */
+  void run_dialogues()
+  {
+    const bear::universe::time_type elapsed_time( 1.0 / 60 );
+
+    std::size_t frames( 0 );
+    std::size_t elements( 0 );
+
+    const bear::systime::milliseconds_type start
+      ( bear::systime::get_date_ms() );
+
+    while ( is_speaking() )
+      {
+        bear::engine::layer::region_type active_area;
+        active_area.push_back
+          ( bear::universe::rectangle_type( 0, 0, m_size.x, m_size.y ) );
+
+        m_layer->update( active_area, elapsed_time );
+        m_balloons->progress( elapsed_time );
+
+        bear::engine::balloon_layer::scene_element_list e;
+        m_balloons->render( e );
+
+        elements += e.size();
+        ++frames;
+      }
+
+    const bear::systime::milliseconds_type duration
+      ( bear::systime::get_date_ms() - start );
+
+    std::cout << "frames: " << frames << '\n'
+              << "elements: " << elements << '\n'
+              << "total: " << duration << " ms\n"
+              << "per frame: " << (double)duration / frames << " ms\n";
+  }
+
+private:
+  bool is_speaking() const
+  {
+    for ( std::size_t i( 0 ); i != m_speakers.size(); ++i )
+      if ( !m_speakers[ i ]->has_finished_to_speak()
+           || m_speakers[ i ]->has_more_things_to_say() )
+        return true;
+
+    return false;
+  }
+};
+
+/**
+ * Creates the game, which opens the screen used by the balloon layer, then
+ * runs the benchmark.
+ */
+int main( int argc, char* argv[] )
+{
+  std::size_t speaker_count( 40 );
+
+  if ( argc > 1 )
+    std::istringstream( argv[ 1 ] ) >> speaker_count;
+
+  bear::engine::game_description description;
+  description.set_game_name( "comic-balloon" );
+  description.set_screen_width( 1280 );
+  description.set_screen_height( 720 );
+
+  bear::engine::game game( description );
+
+  fixed_metrics_font impl;
+  const bear::visual::font f( &impl, impl.get_size() );
+
+  speaking_level level
+    ( bear::universe::size_box_type
+      ( description.screen_size().x, description.screen_size().y ) );
+
+  for ( std::size_t i( 0 ); i != speaker_count; ++i )
+    level.add_speaker( f );
+
+  level.run_dialogues();
+
+  return 0;
+}
@@ -0,0 +1,40 @@
+/**
+ * \file
+ *
+ * A font returning fixed metrics, for the performance tests of the texts
+ * which do not need any display.
+ */
+#ifndef __TEST_FIXED_METRICS_FONT_HPP__
+#define __TEST_FIXED_METRICS_FONT_HPP__
+
+#include "visual/font/base_font.hpp"
+
+#include <cstdlib>
+
+/**
+ * A font whose glyphs have no sprite and an advance depending on the
+ * character.
+ */
+class fixed_metrics_font:
+  public bear::visual::base_font
+{
+public:
+  bear::visual::size_type get_size() const
+  {
+    return 20;
+  }
+
+  bear::visual::glyph_metrics get_metrics( bear::charset::char_type c )
+  {
+    return bear::visual::glyph_metrics
+      ( bear::visual::size_box_type( 6 + std::abs( c ) % 9, 0 ),
+        bear::visual::size_box_type( 0, -4 ) );
+  }
+
+  bear::visual::sprite get_sprite( bear::charset::char_type )
+  {
+    return bear::visual::sprite();
+  }
+};
+
+#endif // __TEST_FIXED_METRICS_FONT_HPP__
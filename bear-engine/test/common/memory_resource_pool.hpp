@@ -0,0 +1,59 @@
+/**
+ * \file
+ *
+ * A resource pool serving files stored in memory, for the performance tests
+ * which do not read the files of a game.
+ */
+#ifndef __TEST_MEMORY_RESOURCE_POOL_HPP__
+#define __TEST_MEMORY_RESOURCE_POOL_HPP__
+
+#include "engine/resource_pool/base_resource_pool.hpp"
+
+#include <map>
+#include <string>
+
+/**
+ * A resource pool serving files stored in memory, which counts the accesses to
+ * the files.
+ */
+class memory_resource_pool:
+  public bear::engine::base_resource_pool
+{
+public:
+  memory_resource_pool()
+    : get_file_count( 0 ), exists_count( 0 )
+  {
+
+  }
+
+  void add_file( const std::string& name, const std::string& content )
+  {
+    m_files[ name ] = content;
+  }
+
+  void get_file( const std::string& name, std::ostream& os )
+  {
+    ++get_file_count;
+
+    const std::map< std::string, std::string >::const_iterator it
+      ( m_files.find( name ) );
+
+    if ( it != m_files.end() )
+      os << it->second;
+  }
+
+  bool exists( const std::string& name ) const
+  {
+    ++exists_count;
+    return m_files.find( name ) != m_files.end();
+  }
+
+public:
+  std::size_t get_file_count;
+  mutable std::size_t exists_count;
+
+private:
+  std::map< std::string, std::string > m_files;
+};
+
+#endif // __TEST_MEMORY_RESOURCE_POOL_HPP__
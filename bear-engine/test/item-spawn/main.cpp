@@ -0,0 +1,119 @@
+/**
+ * \file
+ *
+ * Performance test of the spawning and the killing of short-lived items.
+ */
+
+#include "engine/base_item.hpp"
+#include "engine/export.hpp"
+#include "engine/population.hpp"
+#include "time/time.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/**
+ * An item allocated in its own pool.
+ */
+class pooled_item:
+  public bear::engine::base_item
+{
+  DECLARE_BASE_ITEM( pooled_item );
+};
+
+BASE_ITEM_IMPLEMENT_NO_NAMESPACE( pooled_item )
+
+/**
+ * An item allocated with the global allocator, since it does not declare its
+ * own pool.
+ */
+class global_item:
+  public pooled_item
+{
+  double m_padding;
+};
+
+/**
+ * Spawns and kills the items in a population as a game would do with
+ * explosions and projectiles, and checks that the identifiers of the killed
+ * items are never found again.
+ */
+template<typename Item>
+double run
+( std::size_t step_count, std::size_t spawn_per_step, std::size_t lifetime )
+{
+  bear::engine::population population;
+  std::vector< std::vector<bear::engine::base_item*> > generations
+    ( lifetime );
+  std::vector<bear::engine::base_item::id_type> killed;
+
+  const bear::systime::milliseconds_type start
+    ( bear::systime::get_date_ms() );
+
+  for ( std::size_t step=0; step!=step_count; ++step )
+    {
+      std::vector<bear::engine::base_item*>& g
+        ( generations[ step % lifetime ] );
+
+      killed.clear();
+
+      for ( bear::engine::base_item* item : g )
+        {
+          killed.push_back( item->get_id() );
+          population.kill( item );
+        }
+
+      g.clear();
+
+      for ( std::size_t i=0; i!=spawn_per_step; ++i )
+        {
+          Item* const item( new Item );
+          population.insert( item );
+          g.push_back( item );
+        }
+
+      population.remove_dead_items();
+
+      for ( bear::engine::base_item::id_type id : killed )
+        if ( population.exists( id ) )
+          {
+            std::cerr << "Item #" << id << " is still in the population."
+                      << std::endl;
+            std::exit( 1 );
+          }
+    }
+
+  const bear::systime::milliseconds_type end( bear::systime::get_date_ms() );
+
+  return (double)(end - start) / step_count;
+}
+
+int main( int argc, char* argv[] )
+{
+  std::size_t step_count( 2000 );
+  std::size_t spawn_per_step( 200 );
+
+  if ( argc > 1 )
+    step_count = std::atoi( argv[1] );
+
+  if ( argc > 2 )
+    spawn_per_step = std::atoi( argv[2] );
+
+  const std::size_t lifetime( 30 );
+
+  std::cout << spawn_per_step << " items spawned per step, living "
+            << lifetime << " steps." << std::endl;
+
+  std::cout << "global allocator: "
+            << run<global_item>( step_count, spawn_per_step, lifetime )
+            << " ms/step" << std::endl;
+
+  std::cout << "item pool: "
+            << run<pooled_item>( step_count, spawn_per_step, lifetime )
+            << " ms/step ("
+            << pooled_item::get_item_pool().get_blocks_count()
+            << " blocks allocated)" << std::endl;
+
+  return 0;
+}
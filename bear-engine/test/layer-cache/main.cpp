@@ -0,0 +1,206 @@
+/**
+ * \file
+ *
+ * Performance test of the rendering of a static layer kept in images. Many
+ * sprites are spread in a layer larger than the screen and the camera moves
+ * across this layer. The sprites are rendered either directly at each frame
+ * or, with --cached, through the engine::layer_render_cache of the layer,
+ * which renders them once in tiles then displays the visible tiles.
+ *
+ * The time spent to build each frame and the draw calls of the last frame are
+ * written on the standard output. The test can run on a machine without a GPU
+ * with a software OpenGL, e.g. LIBGL_ALWAYS_SOFTWARE=1 with Mesa.
+ *
+ * Usage: layer-cache [--cached] [sprite_count]
+ */
+
+#include "engine/layer/layer.hpp"
+#include "engine/scene_visual_sink.hpp"
+#include "time/time.hpp"
+#include "visual/gl_call_counter.hpp"
+#include "visual/scene_sprite.hpp"
+#include "visual/screen.hpp"
+
+#include <claw/image.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <sstream>
+
+double random_number()
+{
+  return (double)std::rand() / RAND_MAX;
+}
+
+bear::visual::sprite create_sprite()
+{
+  claw::graphic::image image( 32, 32 );
+
+  for ( unsigned int y( 0 ); y != image.height(); ++y )
+    for ( unsigned int x( 0 ); x != image.width(); ++x )
+      image[ y ][ x ] =
+        claw::graphic::rgba_pixel_8( x * 8, y * 8, 128, ( x + y ) * 4 );
+
+  return bear::visual::sprite( bear::visual::image( image ) );
+}
+
+/**
+ * A layer displaying some sprites which never move.
+ */
+class sprite_layer:
+  public bear::engine::layer
+{
+public:
+  explicit sprite_layer( const bear::universe::size_box_type& size )
+    : bear::engine::layer( size )
+  {
+
+  }
+
+  void add_sprite( const bear::visual::scene_sprite& s )
+  {
+    m_elements.push_back( s );
+  }
+
+private:
+  void progress
+  ( const region_type& active_area, bear::universe::time_type elapsed_time )
+  {
+
+  }
+
+  void do_get_visual
+  ( bear::engine::scene_visual_sink& visuals,
+    const bear::universe::rectangle_type& visible_area ) const
+  {
+    for ( const bear::visual::scene_element& e : m_elements )
+      if ( visible_area.intersects( e.get_bounding_box() ) )
+        visuals.push_back( bear::engine::scene_visual( e ) );
+  }
+
+private:
+  std::list< bear::visual::scene_element > m_elements;
+};
+
+/**
+ * Moves a camera across a layer and displays the visible visuals, collected
+ * from the render cache of the layer when it is enabled.
+ */
+class benchmark
+{
+private:
+  const claw::math::coordinate_2d< unsigned int > m_screen_size;
+  const bear::universe::size_box_type m_area_size;
+  bear::visual::screen m_screen;
+  sprite_layer m_layer;
+  bear::engine::scene_visual_sink m_visuals;
+
+public:
+  explicit benchmark( std::size_t sprite_count )
+    : m_screen_size( 1024, 576 ),
+      m_area_size( 4096, 2048 ),
+      m_screen( m_screen_size ),
+      m_layer( m_area_size )
+  {
+    const bear::visual::sprite sprite( create_sprite() );
+
+    for ( std::size_t i( 0 ); i != sprite_count; ++i )
+      {
+        bear::visual::sprite s( sprite );
+        s.set_angle( random_number() * 6.28 );
+        s.set_intensity( random_number(), random_number(), random_number() );
+
+        m_layer.add_sprite
+          ( bear::visual::scene_sprite
+            ( random_number() * ( m_area_size.x - s.width() ),
+              random_number() * ( m_area_size.y - s.height() ), s ) );
+      }
+  }
+
+  void run( bool cached )
+  {
+    const std::size_t frame_count( 300 );
+    bear::systime::milliseconds_type total( 0 );
+
+    m_layer.set_render_cached( cached );
+
+    for ( std::size_t frame( 0 ); frame != frame_count; ++frame )
+      {
+        const double t( double( frame ) / frame_count );
+        const bear::universe::position_type camera
+          ( t * ( m_area_size.x - m_screen_size.x ),
+            ( 0.5 + std::sin( t * 6.28 ) / 2 )
+            * ( m_area_size.y - m_screen_size.y ) );
+
+        const bear::systime::milliseconds_type start
+          ( bear::systime::get_date_ms() );
+
+        m_screen.begin_render();
+        render( camera );
+        m_screen.end_render();
+
+        const bear::systime::milliseconds_type end
+          ( bear::systime::get_date_ms() );
+
+        total += end - start;
+
+        if ( frame % 30 == 0 )
+          std::cout << frame << '\t' << end - start << " ms\t"
+                    << bear::visual::gl_call_counter::get
+            ( bear::visual::gl_call_counter::draw_call )
+                    << " draw calls\n";
+      }
+
+    std::cout << ( cached ? "cached" : "direct" ) << ": "
+              << double( total ) / frame_count << " ms per frame.\n";
+  }
+
+private:
+  void render( const bear::universe::position_type& camera )
+  {
+    const bear::universe::rectangle_type visible_area
+      ( camera.x, camera.y, camera.x + m_screen_size.x,
+        camera.y + m_screen_size.y );
+
+    m_visuals.clear();
+    m_layer.get_visual( m_screen, m_visuals, visible_area );
+
+    for ( bear::engine::scene_visual_sink::const_iterator it
+            ( m_visuals.begin() );
+          it != m_visuals.end(); ++it )
+      {
+        bear::visual::scene_element e( it->scene_element );
+        e.set_position( e.get_position() - camera );
+        m_screen.render( e );
+      }
+  }
+};
+
+/**
+ * Initializes the visual module of the engine then runs the benchmark. The
+ * module is released before leaving.
+ */
+int main( int argc, char* argv[] )
+{
+  bool cached( false );
+  std::size_t sprite_count( 20000 );
+
+  for ( int i( 1 ); i < argc; ++i )
+    if ( std::string( argv[ i ] ) == "--cached" )
+      cached = true;
+    else
+      std::istringstream( argv[ i ] ) >> sprite_count;
+
+  bear::visual::screen::initialize( bear::visual::screen::screen_gl );
+
+  {
+    benchmark b( sprite_count );
+    b.run( cached );
+  }
+
+  bear::visual::screen::release();
+
+  return 0;
+}
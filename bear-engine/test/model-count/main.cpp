@@ -0,0 +1,180 @@
+/**
+ * \file
+ *
+ * Performance test of the interpolation of the marks of the models. Many
+ * bear::decorative_model items play the same looping action in a decoration
+ * layer, which is progressed as in a level.
+ */
+
+#include "engine/easing.hpp"
+#include "engine/level.hpp"
+#include "engine/model/model_action.hpp"
+#include "engine/model/model_actor.hpp"
+#include "engine/model/model_mark.hpp"
+#include "engine/model/model_snapshot.hpp"
+#include "engine/resource_cache.hpp"
+#include "generic_items/decorative_model.hpp"
+#include "generic_items/layer/decoration_layer.hpp"
+#include "time/time.hpp"
+
+#include <claw/tween/easing/easing_back.hpp>
+#include <claw/tween/easing/easing_none.hpp>
+#include <claw/tween/easing/easing_quad.hpp>
+#include <claw/tween/easing/easing_sine.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+double random_number()
+{
+  return (double)std::rand() / RAND_MAX;
+}
+
+bear::engine::easing_function random_easing()
+{
+  switch( std::rand() % 4 )
+    {
+    case 0: return &claw::tween::easing_none::ease_in_out;
+    case 1: return &claw::tween::easing_sine::ease_in_out;
+    case 2: return &claw::tween::easing_quad::ease_out;
+    default: return &claw::tween::easing_back::ease_in;
+    }
+}
+
+/**
+ * Builds an action looping on itself, whose marks move, rotate and change
+ * their size in every snapshot.
+ */
+bear::engine::model_action
+create_action( std::size_t mark_count, std::size_t snapshot_count )
+{
+  const bear::universe::time_type snapshot_duration( 0.25 );
+
+  bear::engine::model_action result
+    ( mark_count, snapshot_count * snapshot_duration, "idle", "", false );
+
+  for ( std::size_t i=0; i!=mark_count; ++i )
+    {
+      std::ostringstream label;
+      label << "mark_" << i;
+
+      result.get_mark(i) =
+        bear::engine::model_mark
+        ( label.str(), bear::engine::model_animation(), true, false, true );
+    }
+
+  for ( std::size_t s=0; s!=snapshot_count; ++s )
+    {
+      bear::engine::model_snapshot snapshot
+        ( s * snapshot_duration, mark_count, "", std::vector<std::string>(),
+          false );
+      snapshot.set_size( 100, 100 );
+
+      for ( std::size_t i=0; i!=mark_count; ++i )
+        {
+          bear::engine::model_mark_placement m
+            ( i, 100 * random_number(), 100 * random_number(),
+              10 + 20 * random_number(), 10 + 20 * random_number(), i,
+              6.28 * random_number(), true, "" );
+
+          m.set_angle_easing( random_easing() );
+          m.set_x_position_easing( random_easing() );
+          m.set_y_position_easing( random_easing() );
+          m.set_width_easing( random_easing() );
+          m.set_height_easing( random_easing() );
+
+          snapshot.set_mark_placement( m );
+        }
+
+      result.add_snapshot( snapshot );
+    }
+
+  return result;
+}
+
+/**
+ * Creates a level with a decoration layer in which the models are added. The
+ * model played by the items is put in the resource cache, from which the
+ * items take it when they are built.
+ */
+class model_level
+{
+private:
+  bear::engine::level m_level;
+  bear::decoration_layer* const m_layer;
+
+public:
+  explicit model_level( const bear::universe::size_box_type& size )
+    : m_level( "model-count", "", size, "", NULL, NULL ),
+      m_layer( new bear::decoration_layer( size ) )
+  {
+    m_level.push_layer( m_layer );
+  }
+
+  void add_model
+  ( const bear::universe::position_type& position,
+    bear::universe::time_type date )
+  {
+    bear::decorative_model* const item( new bear::decorative_model );
+    item->set_string_field( "decorative_model.model_file", "bench.cm" );
+    item->set_string_field( "decorative_model.initial_action", "idle" );
+    item->set_center_of_mass( position );
+
+    m_layer->add_item( *item );
+    item->progress( date );
+  }
+
+  void progress( bear::universe::time_type elapsed_time )
+  {
+    bear::engine::layer::region_type active_area;
+    active_area.push_back
+      ( bear::universe::rectangle_type
+        ( 0, 0, m_layer->get_size().x, m_layer->get_size().y ) );
+
+    m_layer->update( active_area, elapsed_time );
+  }
+};
+
+int main( int argc, char* argv[] )
+{
+  std::size_t model_count( 1000 );
+  std::size_t frame_count( 3000 );
+
+  if ( argc > 1 )
+    model_count = std::atoi( argv[1] );
+
+  if ( argc > 2 )
+    frame_count = std::atoi( argv[2] );
+
+  bear::engine::model_actor actor;
+  actor.add_action( "idle", create_action( 8, 6 ) );
+  bear::engine::resource_cache::get_instance().add_model
+    ( "bench.cm", actor, bear::engine::resource_cache::dependency_list() );
+
+  const bear::universe::size_box_type size( 4096, 4096 );
+  model_level level( size );
+
+  // The models are spread in the action.
+  for ( std::size_t i=0; i!=model_count; ++i )
+    level.add_model
+      ( bear::universe::position_type
+        ( size.x * random_number(), size.y * random_number() ),
+        actor.get_action( "idle" )->get_duration() * random_number() );
+
+  const bear::universe::time_type time_step( 1.0 / 60 );
+
+  const bear::systime::milliseconds_type start
+    ( bear::systime::get_date_ms() );
+
+  for ( std::size_t f=0; f!=frame_count; ++f )
+    level.progress( time_step );
+
+  const bear::systime::milliseconds_type end( bear::systime::get_date_ms() );
+
+  std::cout << model_count << " models, " << frame_count << " frames: "
+            << (double)(end - start) / frame_count << " ms/frame"
+            << std::endl;
+
+  return 0;
+}
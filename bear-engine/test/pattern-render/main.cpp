@@ -0,0 +1,145 @@
+/**
+ * \file
+ *
+ * Rendering test of the repeated sprites. A tiled area is rendered once with a
+ * scene sprite per tile and once with a single scene pattern, then the two
+ * frames are compared pixel by pixel.
+ *
+ * The test needs an OpenGL context. It can run on a machine without a GPU with
+ * a software implementation, e.g. LIBGL_ALWAYS_SOFTWARE=1 with Mesa.
+ */
+
+#include "visual/scene_pattern.hpp"
+#include "visual/scene_sprite.hpp"
+#include "visual/screen.hpp"
+
+#include <claw/image.hpp>
+
+#include <iostream>
+
+/**
+ * Builds an image with a different color on each pixel, such that a sampling
+ * error shows up in the comparison.
+ */
+claw::graphic::image create_image( unsigned int width, unsigned int height )
+{
+  claw::graphic::image result( width, height );
+
+  for ( unsigned int y( 0 ); y != height; ++y )
+    for ( unsigned int x( 0 ); x != width; ++x )
+      result[ y ][ x ] =
+        claw::graphic::rgba_pixel_8
+        ( x * 255 / width, y * 255 / height, ( x + y ) % 2 * 255, 255 );
+
+  return result;
+}
+
+/**
+ * Counts the pixels that differ in two images of the same size.
+ */
+std::size_t count_differences
+( const claw::graphic::image& a, const claw::graphic::image& b )
+{
+  std::size_t result( 0 );
+  claw::graphic::image::const_iterator it_b( b.begin() );
+
+  for ( claw::graphic::image::const_iterator it_a( a.begin() );
+        it_a != a.end(); ++it_a, ++it_b )
+    if ( ( it_a->components.red != it_b->components.red )
+         || ( it_a->components.green != it_b->components.green )
+         || ( it_a->components.blue != it_b->components.blue )
+         || ( it_a->components.alpha != it_b->components.alpha ) )
+      ++result;
+
+  return result;
+}
+
+/**
+ * Renders an element alone on the screen and takes a shot of the frame.
+ */
+claw::graphic::image render
+( bear::visual::screen& s, const bear::visual::scene_element& e )
+{
+  s.begin_render();
+  s.render( e );
+  s.end_render();
+
+  claw::graphic::image result;
+  s.shot( result );
+
+  return result;
+}
+
+/**
+ * Renders a sprite repeated on the screen with the two methods and compares
+ * the results.
+ * \return true if the frames are identical.
+ */
+bool check_sprite
+( bear::visual::screen& s, const std::string& name,
+  const bear::visual::sprite& spr )
+{
+  const bear::visual::position_type origin( -7, -3 );
+  const unsigned int x_count( s.get_size().x / spr.width() + 2 );
+  const unsigned int y_count( s.get_size().y / spr.height() + 2 );
+
+  s.begin_render();
+
+  for ( unsigned int x( 0 ); x != x_count; ++x )
+    for ( unsigned int y( 0 ); y != y_count; ++y )
+      s.render
+        ( bear::visual::scene_sprite
+          ( origin.x + x * spr.width(), origin.y + y * spr.height(), spr ) );
+
+  s.end_render();
+
+  claw::graphic::image tiles;
+  s.shot( tiles );
+
+  const claw::graphic::image pattern
+    ( render
+      ( s,
+        bear::visual::scene_pattern
+        ( origin.x, origin.y, bear::visual::scene_sprite( 0, 0, spr ),
+          x_count, y_count ) ) );
+
+  const std::size_t differences( count_differences( tiles, pattern ) );
+
+  std::cout << name << ": " << differences << " different pixels.\n";
+
+  return differences == 0;
+}
+
+/**
+ * Initializes the engine then runs the comparisons. The engine's modules will
+ * be released before leaving.
+ */
+int main( int argc, char* argv[] )
+{
+  bear::visual::screen::initialize( bear::visual::screen::screen_gl );
+
+  bool result( true );
+
+  {
+    bear::visual::screen s
+      ( claw::math::coordinate_2d<unsigned int>( 320, 200 ) );
+    s.set_background_color( bear::visual::color_type( "#000000" ) );
+
+    const bear::visual::image texture( create_image( 32, 16 ) );
+
+    bear::visual::sprite whole( texture );
+    result = check_sprite( s, "whole texture", whole ) && result;
+
+    whole.mirror( true );
+    result = check_sprite( s, "mirrored texture", whole ) && result;
+
+    const bear::visual::sprite atlas
+      ( texture,
+        bear::visual::sprite::clip_rectangle_type( 8, 4, 16, 8 ) );
+    result = check_sprite( s, "atlas sprite", atlas ) && result;
+  }
+
+  bear::visual::screen::release();
+
+  return result ? 0 : 1;
+}
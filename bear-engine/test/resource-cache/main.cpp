@@ -0,0 +1,147 @@
+/**
+ * \file
+ *
+ * Performance test of the loading of the levels with the resource cache. Two
+ * sets of images are generated in memory, then the levels alternate between
+ * the two sets, like a game going back and forth between a map and the
+ * levels. Since a level only takes the resources of the previous level, each
+ * level decodes its images again unless they are kept in the resource cache.
+ *
+ * The time spent to load each level and the counters of the cache are written
+ * on the standard output. Run the test with a budget of zero to measure the
+ * loading without cache. The screen displays nothing, thus the test does not
+ * need an OpenGL context.
+ *
+ * Usage: resource-cache [--budget=mebibytes] [level_count]
+ */
+
+#include "memory_resource_pool.hpp"
+
+#include "engine/level_globals.hpp"
+#include "engine/resource_cache.hpp"
+#include "engine/resource_pool.hpp"
+#include "time/time.hpp"
+#include "visual/screen.hpp"
+
+#include <claw/image.hpp>
+#include <claw/png.hpp>
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Builds the content of a PNG file of 256×256 pixels.
+ */
+std::string create_png( unsigned int seed )
+{
+  claw::graphic::image image( 256, 256 );
+
+  for ( unsigned int y( 0 ); y != image.height(); ++y )
+    for ( unsigned int x( 0 ); x != image.width(); ++x )
+      image[ y ][ x ] =
+        claw::graphic::rgba_pixel_8( x + seed, y * seed, x ^ y, 255 );
+
+  std::ostringstream result;
+  claw::graphic::png::writer writer( image, result );
+
+  return result.str();
+}
+
+/**
+ * Loads all the images of a set in a new level_globals, which stays alive
+ * until the next level is loaded.
+ */
+bear::engine::level_globals*
+load_level( const std::vector< std::string >& images )
+{
+  bear::engine::level_globals* const result
+    ( new bear::engine::level_globals );
+
+  for ( std::size_t i( 0 ); i != images.size(); ++i )
+    result->load_image( images[ i ] );
+
+  return result;
+}
+
+/**
+ * Initializes the visual module of the engine then runs the benchmark. The
+ * module is released before leaving.
+ */
+int main( int argc, char* argv[] )
+{
+  std::size_t budget( 64 );
+  std::size_t level_count( 10 );
+  const std::size_t image_count( 40 );
+
+  for ( int i( 1 ); i < argc; ++i )
+    {
+      const std::string arg( argv[ i ] );
+
+      if ( arg.find( "--budget=" ) == 0 )
+        std::istringstream( arg.substr( 9 ) ) >> budget;
+      else
+        std::istringstream( arg ) >> level_count;
+    }
+
+  memory_resource_pool* const pool( new memory_resource_pool );
+  std::vector< std::string > images[ 2 ];
+
+  for ( std::size_t i( 0 ); i != 2 * image_count; ++i )
+    {
+      std::ostringstream oss;
+      oss << "gfx/image-" << i << ".png";
+
+      images[ i % 2 ].push_back( oss.str() );
+      pool->add_file( oss.str(), create_png( i ) );
+    }
+
+  bear::engine::resource_pool::get_instance().add_pool( pool );
+
+  bear::engine::resource_cache& cache
+    ( bear::engine::resource_cache::get_instance() );
+  cache.set_budget( budget * 1024 * 1024 );
+
+  bear::visual::screen::initialize( bear::visual::screen::screen_null );
+
+  {
+    const bear::visual::screen s
+      ( claw::math::coordinate_2d< unsigned int >( 640, 480 ) );
+
+    bear::engine::level_globals* level( NULL );
+    bear::systime::milliseconds_type total( 0 );
+
+    for ( std::size_t i( 0 ); i != level_count; ++i )
+      {
+        const bear::systime::milliseconds_type start
+          ( bear::systime::get_date_ms() );
+
+        bear::engine::level_globals* const next
+          ( load_level( images[ i % 2 ] ) );
+
+        const bear::systime::milliseconds_type duration
+          ( bear::systime::get_date_ms() - start );
+
+        delete level;
+        level = next;
+        total += duration;
+
+        std::cout << "level " << i << ": " << duration << " ms\n";
+      }
+
+    delete level;
+
+    std::cout << "total: " << total << " ms\n"
+              << "hits: " << cache.get_hit_count() << '\n'
+              << "misses: " << cache.get_miss_count() << '\n'
+              << "entries: " << cache.get_entry_count() << '\n'
+              << "resident bytes: " << cache.get_resident_size() << '\n';
+
+    cache.clear();
+  }
+
+  bear::visual::screen::release();
+
+  return 0;
+}
@@ -0,0 +1,217 @@
+/**
+ * \file
+ *
+ * Performance test of the dispatch of the messages of a server to many
+ * clients. The clients are sockets connected to the server on the loopback
+ * interface and read by a separate thread. The test measures the time spent in
+ * net::server::dispatch_message(), which is taken from the game loop, and the
+ * time needed for all the clients to receive all the messages.
+ *
+ * With --per-client the messages are sent to each client with
+ * net::server::send_message(), thus serialized once per client, as
+ * dispatch_message() did before the data was shared among the clients.
+ *
+ * Usage: server-fanout [--per-client] [client_count] [message_count]
+ */
+
+#include "net/message/message.hpp"
+#include "net/server.hpp"
+#include "time/time.hpp"
+
+#include <boost/thread/thread.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/**
+ * A message carrying a state of a given size, like the messages sent to the
+ * clients at each synchronization.
+ */
+class state_message:
+  public bear::net::message
+{
+public:
+  explicit state_message( std::size_t size )
+    : m_payload( size, 'x' )
+  {
+
+  }
+
+private:
+  std::ostream& formatted_output( std::ostream& os ) const
+  {
+    return os << m_payload;
+  }
+
+  std::string do_get_name() const
+  {
+    return "state";
+  }
+
+private:
+  const std::string m_payload;
+};
+
+/**
+ * Reads the sockets of the clients until they have received a given amount of
+ * data, or until nothing comes for a second.
+ */
+class reader
+{
+public:
+  reader( const std::vector< int >& sockets, std::size_t expected )
+    : received( 0 ), m_sockets( sockets ), m_expected( expected )
+  {
+
+  }
+
+  void operator()()
+  {
+    std::vector< pollfd > descriptors( m_sockets.size() );
+
+    for ( std::size_t i( 0 ); i != m_sockets.size(); ++i )
+      {
+        descriptors[ i ].fd = m_sockets[ i ];
+        descriptors[ i ].events = POLLIN;
+      }
+
+    char buffer[ 65536 ];
+
+    while ( received < m_expected )
+      {
+        if ( poll( &descriptors[ 0 ], descriptors.size(), 1000 ) <= 0 )
+          return;
+
+        for ( std::size_t i( 0 ); i != descriptors.size(); ++i )
+          if ( descriptors[ i ].revents & POLLIN )
+            {
+              const ssize_t length
+                ( read( descriptors[ i ].fd, buffer, sizeof( buffer ) ) );
+
+              if ( length > 0 )
+                received += length;
+            }
+      }
+  }
+
+public:
+  std::size_t received;
+
+private:
+  const std::vector< int >& m_sockets;
+  const std::size_t m_expected;
+};
+
+/**
+ * Opens the connections of the clients to the server on the loopback
+ * interface.
+ */
+std::vector< int > connect_clients( std::size_t count, unsigned int port )
+{
+  sockaddr_in address;
+  std::memset( &address, 0, sizeof( address ) );
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+  address.sin_port = htons( port );
+
+  std::vector< int > result;
+
+  for ( std::size_t i( 0 ); i != count; ++i )
+    {
+      const int s( socket( AF_INET, SOCK_STREAM, 0 ) );
+
+      if ( connect( s, reinterpret_cast< sockaddr* >( &address ),
+                    sizeof( address ) ) != 0 )
+        {
+          std::cerr << "connect: " << std::strerror( errno ) << '\n';
+          close( s );
+          break;
+        }
+
+      result.push_back( s );
+    }
+
+  return result;
+}
+
+int main( int argc, char* argv[] )
+{
+  const unsigned int port( 24812 );
+  bool per_client( false );
+  std::size_t client_count( 300 );
+  std::size_t message_count( 1000 );
+  std::size_t arg_index( 0 );
+
+  for ( int i( 1 ); i < argc; ++i )
+    if ( std::string( argv[ i ] ) == "--per-client" )
+      per_client = true;
+    else
+      {
+        std::istringstream iss( argv[ i ] );
+
+        if ( arg_index == 0 )
+          iss >> client_count;
+        else
+          iss >> message_count;
+
+        ++arg_index;
+      }
+
+  bear::net::server server( port );
+  std::vector< int > clients( connect_clients( client_count, port ) );
+
+  while ( server.get_connection_count() != clients.size() )
+    {
+      server.check_for_new_clients();
+      boost::this_thread::yield();
+    }
+
+  const state_message m( 200 );
+
+  std::ostringstream oss;
+  oss << m.get_name() << '\n' << m << '\n';
+  const std::size_t expected
+    ( clients.size() * message_count * oss.str().size() );
+
+  reader r( clients, expected );
+  boost::thread reading( boost::ref( r ) );
+
+  const bear::systime::milliseconds_type start
+    ( bear::systime::get_date_ms() );
+
+  for ( std::size_t i( 0 ); i != message_count; ++i )
+    if ( per_client )
+      for ( std::size_t c( 0 ); c != server.get_connection_count(); ++c )
+        server.send_message( c, m );
+    else
+      server.dispatch_message( m );
+
+  const bear::systime::milliseconds_type dispatch
+    ( bear::systime::get_date_ms() - start );
+
+  reading.join();
+
+  const bear::systime::milliseconds_type delivery
+    ( bear::systime::get_date_ms() - start );
+
+  std::cout << "clients: " << clients.size() << '\n'
+            << "messages: " << message_count << '\n'
+            << "dispatch: " << dispatch << " ms\n"
+            << "delivery: " << delivery << " ms\n"
+            << "received: " << r.received << '/' << expected << " bytes\n";
+
+  for ( std::size_t i( 0 ); i != clients.size(); ++i )
+    close( clients[ i ] );
+
+  return 0;
+}
@@ -0,0 +1,158 @@
+/**
+ * \file
+ *
+ * Performance test of the loading of the sprites described in a spritepos
+ * file. A sheet with thousands of entries is generated in memory, then a
+ * sprite is created for each entry with level_globals::auto_sprite(), as the
+ * loading of a level referencing all of them would do. Some sprites are also
+ * requested from an image without spritepos file.
+ *
+ * With --reparse the test also measures the former way to find an entry, where
+ * the spritepos file was read and parsed for each sprite.
+ *
+ * The images are created in video memory, thus the test needs an OpenGL
+ * context. It can run on a machine without a GPU with a software
+ * implementation, e.g. LIBGL_ALWAYS_SOFTWARE=1 with Mesa.
+ *
+ * Usage: spritepos-index [--reparse] [entry_count]
+ */
+
+#include "memory_resource_pool.hpp"
+
+#include "engine/level_globals.hpp"
+#include "engine/resource_pool.hpp"
+#include "engine/spritepos.hpp"
+#include "time/time.hpp"
+#include "visual/screen.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Builds the content of a spritepos file with entries of 16×16 pixels spread
+ * on a sheet of 1024 pixels wide.
+ */
+std::string create_spritepos( const std::vector< std::string >& names )
+{
+  std::ostringstream result;
+  result << "# generated sheet\n";
+
+  for ( std::size_t i( 0 ); i != names.size(); ++i )
+    result << names[ i ] << ": " << ( i % 64 ) * 16 << ' ' << ( i / 64 ) * 16
+           << " 16 16\n";
+
+  return result.str();
+}
+
+/**
+ * Creates the sprites of all the entries with level_globals::auto_sprite().
+ */
+void load_sprites
+( const std::vector< std::string >& names, memory_resource_pool& pool )
+{
+  bear::engine::level_globals globals;
+  globals.add_image( "gfx/sheet.png", bear::visual::image( 1024, 1024 ) );
+  globals.add_image( "gfx/plain.png", bear::visual::image( 16, 16 ) );
+
+  std::size_t valid( 0 );
+
+  const bear::systime::milliseconds_type start
+    ( bear::systime::get_date_ms() );
+
+  for ( std::size_t i( 0 ); i != names.size(); ++i )
+    {
+      if ( globals.auto_sprite( "gfx/sheet.png", names[ i ] ).is_valid() )
+        ++valid;
+
+      if ( i % 10 == 0 )
+        globals.auto_sprite( "gfx/plain.png", names[ i ] );
+    }
+
+  const bear::systime::milliseconds_type duration
+    ( bear::systime::get_date_ms() - start );
+
+  std::cout << "auto_sprite: " << duration << " ms\n"
+            << "valid sprites: " << valid << '\n'
+            << "files read: " << pool.get_file_count << '\n'
+            << "existence checks: " << pool.exists_count << '\n';
+}
+
+/**
+ * Finds all the entries by parsing the spritepos file for each of them, as
+ * level_globals::auto_sprite() did before it kept an index of the entries.
+ */
+void reparse_sprites
+( const std::vector< std::string >& names, const std::string& content )
+{
+  std::size_t found( 0 );
+
+  const bear::systime::milliseconds_type start
+    ( bear::systime::get_date_ms() );
+
+  for ( std::size_t i( 0 ); i != names.size(); ++i )
+    {
+      std::stringstream f( content );
+      const bear::engine::spritepos s( f );
+
+      if ( s.find( names[ i ] ) != s.end() )
+        ++found;
+    }
+
+  const bear::systime::milliseconds_type duration
+    ( bear::systime::get_date_ms() - start );
+
+  std::cout << "reparse: " << duration << " ms\n"
+            << "found entries: " << found << '\n';
+}
+
+/**
+ * Initializes the visual module of the engine then runs the benchmark. The
+ * module is released before leaving.
+ */
+int main( int argc, char* argv[] )
+{
+  bool reparse( false );
+  std::size_t entry_count( 4000 );
+
+  for ( int i( 1 ); i < argc; ++i )
+    if ( std::string( argv[ i ] ) == "--reparse" )
+      reparse = true;
+    else
+      std::istringstream( argv[ i ] ) >> entry_count;
+
+  std::vector< std::string > names( entry_count );
+
+  for ( std::size_t i( 0 ); i != names.size(); ++i )
+    {
+      std::ostringstream oss;
+      oss << "sprite " << i;
+      names[ i ] = oss.str();
+    }
+
+  const std::string content( create_spritepos( names ) );
+  std::random_shuffle( names.begin(), names.end() );
+
+  memory_resource_pool* const pool( new memory_resource_pool );
+  pool->add_file( "gfx/sheet.spritepos", content );
+  bear::engine::resource_pool::get_instance().add_pool( pool );
+
+  bear::visual::screen::initialize( bear::visual::screen::screen_gl );
+
+  {
+    const bear::visual::screen s
+      ( claw::math::coordinate_2d< unsigned int >( 640, 480 ) );
+
+    load_sprites( names, *pool );
+
+    if ( reparse )
+      reparse_sprites( names, content );
+  }
+
+  bear::visual::screen::release();
+
+  return 0;
+}
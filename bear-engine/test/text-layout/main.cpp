@@ -0,0 +1,153 @@
+/**
+ * \file
+ *
+ * Performance test of the arrangement of long texts. The texts are arranged in
+ * a box as done by the static texts of the interface and by the credits, then
+ * they are displayed progressively, one character more at each step, as a
+ * typewriter effect would do.
+ *
+ * The font returns fixed metrics, thus the test does not need any display.
+ *
+ * Usage: text-layout [--no-cache] [text_count]
+ */
+
+#include "fixed_metrics_font.hpp"
+
+#include "time/time.hpp"
+#include "visual/font/font.hpp"
+#include "visual/text_layout.hpp"
+#include "visual/text_layout_display_size.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+/**
+ * Builds a text made of words taken in sentences in various languages.
+ */
+std::string create_text( std::size_t word_count )
+{
+  static const char* const words[] =
+    { "The", "quick", "brown", "fox", "jumps", "over", "the", "lazy", "dog.",
+      "Portez", "ce", "vieux", "whisky", "au", "juge", "blond", "qui", "fume",
+      "sur", "son", "île", "intérieure,", "à", "côté", "de", "l'alcôve.",
+      "Victor", "jagt", "zwölf", "Boxkämpfer", "quer", "über", "den",
+      "großen", "Sylter", "Deich.", "El", "veloz", "murciélago", "hindú",
+      "comía", "feliz", "cardillo", "y", "kiwi.", "\n" };
+  static const std::size_t count( sizeof(words) / sizeof(words[0]) );
+
+  std::string result;
+
+  for ( std::size_t i( 0 ); i != word_count; ++i )
+    {
+      if ( !result.empty() && ( result[ result.size() - 1 ] != '\n' ) )
+        result += ' ';
+
+      result += words[ std::rand() % count ];
+    }
+
+  return result;
+}
+
+/**
+ * Arranges a text in a box and returns the height of the arranged text.
+ */
+bear::visual::size_type
+arrange( const bear::visual::font& f, const std::string& text,
+         const bear::visual::size_box_type& box,
+         bear::visual::text_align::horizontal_align a )
+{
+  bear::visual::text_layout_display_size func( text, f, box.y );
+  bear::visual::text_layout layout( f, text, box, a );
+
+  layout.arrange_text< bear::visual::text_layout_display_size& >( func );
+
+  return func.get_bounding_box().height();
+}
+
+/**
+ * Arranges the texts several times, as the components of the interface do
+ * when they are resized or refreshed.
+ */
+void
+arrange_repeatedly
+( fixed_metrics_font& impl, const std::vector< std::string >& texts,
+  bool cache )
+{
+  const bear::visual::font f( &impl, impl.get_size() );
+  const bear::visual::size_box_type box( 600, 10000 );
+  bear::visual::size_type height( 0 );
+
+  const bear::systime::milliseconds_type start
+    ( bear::systime::get_date_ms() );
+
+  for ( std::size_t i( 0 ); i != 100; ++i )
+    for ( std::size_t j( 0 ); j != texts.size(); ++j )
+      {
+        if ( !cache )
+          impl.get_layout_cache().clear();
+
+        height += arrange( f, texts[ j ], box,
+                           bear::visual::text_align::align_center );
+      }
+
+  std::cout << "repeated: "
+            << bear::systime::get_date_ms() - start << " ms ("
+            << height << ")\n";
+}
+
+/**
+ * Arranges the prefixes of the texts of increasing length, as a typewriter
+ * effect does.
+ */
+void
+arrange_progressively
+( fixed_metrics_font& impl, const std::vector< std::string >& texts,
+  bool cache )
+{
+  const bear::visual::font f( &impl, impl.get_size() );
+  const bear::visual::size_box_type box( 600, 10000 );
+  bear::visual::size_type height( 0 );
+
+  const bear::systime::milliseconds_type start
+    ( bear::systime::get_date_ms() );
+
+  for ( std::size_t j( 0 ); j != texts.size(); ++j )
+    for ( std::size_t n( 1 ); n <= texts[ j ].size(); ++n )
+      {
+        if ( !cache )
+          impl.get_layout_cache().clear();
+
+        height += arrange( f, texts[ j ].substr( 0, n ), box,
+                           bear::visual::text_align::align_left );
+      }
+
+  std::cout << "progressive: "
+            << bear::systime::get_date_ms() - start << " ms ("
+            << height << ")\n";
+}
+
+int main( int argc, char* argv[] )
+{
+  bool cache( true );
+  std::size_t text_count( 20 );
+
+  for ( int i( 1 ); i < argc; ++i )
+    if ( std::string( argv[ i ] ) == "--no-cache" )
+      cache = false;
+    else
+      std::istringstream( argv[ i ] ) >> text_count;
+
+  std::vector< std::string > texts;
+
+  for ( std::size_t i( 0 ); i != text_count; ++i )
+    texts.push_back( create_text( 400 ) );
+
+  fixed_metrics_font impl;
+
+  arrange_repeatedly( impl, texts, cache );
+  arrange_progressively( impl, texts, cache );
+
+  return 0;
+}
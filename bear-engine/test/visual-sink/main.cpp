@@ -0,0 +1,162 @@
+/**
+ * \file
+ *
+ * Performance test of the collection of the visuals of a frame. Each frame
+ * inserts the visuals of many items with a shadow, like the decorative items,
+ * then repeats some visuals in front of the sink, like the pattern layer, and
+ * sorts the sink.
+ *
+ * The shadow is either set on the visuals inserted in the sink of the frame,
+ * or, with --sequence, set on a scene_element_sequence built from a temporary
+ * sink per item, as the decorative items did before. The number of memory
+ * allocations and the time per frame are written on the standard output.
+ *
+ * Usage: visual-sink [--sequence] [item_count]
+ */
+
+#include "engine/scene_visual_sink.hpp"
+#include "time/time.hpp"
+#include "visual/scene_element_sequence.hpp"
+#include "visual/scene_sprite.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+
+/** The number of calls to operator new since the start of the program. */
+static std::size_t g_allocation_count( 0 );
+
+void* operator new( std::size_t size )
+{
+  ++g_allocation_count;
+
+  void* const result( std::malloc( size == 0 ? 1 : size ) );
+
+  if ( result == NULL )
+    throw std::bad_alloc();
+
+  return result;
+}
+
+void operator delete( void* p ) noexcept
+{
+  std::free( p );
+}
+
+/**
+ * Inserts the visuals of an item and sets their shadow in the sink.
+ */
+void insert_in_sink
+( bear::engine::scene_visual_sink& visuals,
+  const bear::visual::sprite& sprite, int z )
+{
+  visuals.begin_group( z );
+
+  const std::size_t first( visuals.get_insertion_count() );
+
+  visuals.push_back
+    ( bear::engine::scene_visual
+      ( bear::visual::scene_sprite( z, z, sprite ), z ) );
+  visuals.push_front
+    ( bear::engine::scene_visual
+      ( bear::visual::scene_sprite( z, 0, sprite ), z ) );
+
+  for ( std::size_t i( first ); i != visuals.get_insertion_count(); ++i )
+    visuals.get_inserted_visual( i ).scene_element.set_shadow( 3, -3 );
+
+  visuals.end_group();
+}
+
+/**
+ * Inserts the visuals of an item in a sequence with a shadow, collected in a
+ * temporary sink.
+ */
+void insert_in_sequence
+( bear::engine::scene_visual_sink& visuals,
+  const bear::visual::sprite& sprite, int z )
+{
+  bear::engine::scene_visual_sink item_visuals;
+
+  item_visuals.push_back
+    ( bear::engine::scene_visual
+      ( bear::visual::scene_sprite( z, z, sprite ), z ) );
+  item_visuals.push_front
+    ( bear::engine::scene_visual
+      ( bear::visual::scene_sprite( z, 0, sprite ), z ) );
+  item_visuals.sort();
+
+  bear::visual::scene_element_sequence sequence;
+  sequence.set_shadow( 3, -3 );
+
+  for ( bear::engine::scene_visual_sink::const_iterator it
+          ( item_visuals.begin() );
+        it != item_visuals.end(); ++it )
+    sequence.push_back( it->scene_element );
+
+  visuals.begin_group( z );
+  visuals.push_back( bear::engine::scene_visual( sequence, z ) );
+  visuals.end_group();
+}
+
+/**
+ * Collects the visuals of the frames in a single sink and measures the
+ * allocations of the last frames, once the sink has reached its size.
+ */
+int main( int argc, char* argv[] )
+{
+  bool sequence( false );
+  std::size_t item_count( 2000 );
+
+  for ( int i( 1 ); i < argc; ++i )
+    {
+      const std::string arg( argv[ i ] );
+
+      if ( arg == "--sequence" )
+        sequence = true;
+      else
+        std::istringstream( arg ) >> item_count;
+    }
+
+  const std::size_t frame_count( 100 );
+  const std::size_t pattern_count( item_count );
+  const bear::visual::sprite sprite;
+
+  bear::engine::scene_visual_sink visuals;
+  std::size_t allocations( 0 );
+  bear::systime::milliseconds_type total( 0 );
+
+  for ( std::size_t frame( 0 ); frame != frame_count; ++frame )
+    {
+      const std::size_t allocations_start( g_allocation_count );
+      const bear::systime::milliseconds_type start
+        ( bear::systime::get_date_ms() );
+
+      for ( std::size_t i( 0 ); i != item_count; ++i )
+        if ( sequence )
+          insert_in_sequence( visuals, sprite, i % 16 );
+        else
+          insert_in_sink( visuals, sprite, i % 16 );
+
+      for ( std::size_t i( 0 ); i != pattern_count; ++i )
+        visuals.push_front
+          ( bear::engine::scene_visual
+            ( bear::visual::scene_sprite( i, i, sprite ), -1 ) );
+
+      visuals.sort();
+      visuals.clear();
+
+      total += bear::systime::get_date_ms() - start;
+
+      if ( frame != 0 )
+        allocations += g_allocation_count - allocations_start;
+    }
+
+  std::cout << ( sequence ? "sequence" : "sink" ) << ": "
+            << double( total ) / frame_count << " ms per frame, "
+            << double( allocations ) / ( frame_count - 1 )
+            << " allocations per frame.\n";
+
+  return 0;
+}
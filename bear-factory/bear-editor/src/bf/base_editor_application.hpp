@@ -16,6 +16,8 @@
 
 #include <wx/wx.h>
 
+#include <vector>
+
 namespace bf
 {
   class workspace_environment;
@@ -32,6 +34,10 @@ namespace bf
     ~base_editor_application();
 
   protected:
+    unsigned int get_jobs() const;
+    bool is_forced() const;
+
+    virtual bool compile_files( const std::vector<wxString>& paths ) const;
     virtual void compile( const wxString& path ) const;
     virtual void update( const wxString& path ) const;
     virtual bool do_init_app(const workspace_environment& env);
@@ -48,6 +54,8 @@ namespace bf
     bool update_arguments() const;
     bool show_help();
     bool show_version();
+    bool read_jobs();
+    bool read_opaque_rectangle_algorithm();
     bool find_and_erase_option
     ( const wxString& long_name, const wxString& short_name );
     bool find_and_erase_option_value
@@ -62,6 +70,14 @@ namespace bf
     /** \brief The locale, for internationalization. */
     wxLocale m_locale;
 
+    /** \brief The number of threads to use for the command line
+        compilation. */
+    unsigned int m_jobs;
+
+    /** \brief Tell if the command line compilation must build the files even
+        if they are up to date. */
+    bool m_force;
+
   }; // class base_editor_application
 } // namespace bf
 
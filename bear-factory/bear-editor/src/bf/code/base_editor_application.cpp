@@ -13,6 +13,7 @@
  */
 #include "bf/base_editor_application.hpp"
 
+#include "bf/compilation_context.hpp"
 #include "bf/path_configuration.hpp"
 #include "bf/version.hpp"
 #include "bf/workspace_environment.hpp"
@@ -20,6 +21,7 @@
 
 #include <wx/tooltip.h>
 #include <iostream>
+#include <sstream>
 
 #include <claw/exception.hpp>
 #include <claw/logger.hpp>
@@ -30,7 +32,7 @@
  * \brief Constructor.
  */
 bf::base_editor_application::base_editor_application()
-  : m_locale( wxLocale::GetSystemLanguage() )
+  : m_locale( wxLocale::GetSystemLanguage() ), m_jobs(1), m_force(false)
 {
   claw::logger.set( new claw::console_logger() );
   claw::logger.set_level( claw::log_verbose );
@@ -54,6 +56,54 @@ bf::base_editor_application::~base_editor_application()
   claw::logger.clear();
 } // base_editor_application::~base_editor_application()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of threads to use for the command line compilation.
+ */
+unsigned int bf::base_editor_application::get_jobs() const
+{
+  return m_jobs;
+} // base_editor_application::get_jobs()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the command line compilation must build the files even if
+ *        nothing they depend on has changed since their last compilation.
+ */
+bool bf::base_editor_application::is_forced() const
+{
+  return m_force;
+} // base_editor_application::is_forced()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compile some files. The default implementation calls compile() on
+ *        each file.
+ * \param paths The paths to the files.
+ * \return true if all the files have been compiled.
+ */
+bool bf::base_editor_application::compile_files
+( const std::vector<wxString>& paths ) const
+{
+  bool result(true);
+
+  for ( std::size_t i=0; i!=paths.size(); ++i )
+    try
+      {
+        claw::logger << claw::log_verbose << "Compiling "
+                     << wx_to_std_string(paths[i]) << std::endl;
+        compile(paths[i]);
+      }
+    catch(std::exception& e)
+      {
+        std::cerr << "Error when processing '" << wx_to_std_string(paths[i])
+                  << "': " << e.what() << std::endl;
+        result = false;
+      }
+
+  return result;
+} // base_editor_application::compile_files()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Compile a file.
@@ -106,6 +156,14 @@ bool bf::base_editor_application::OnInit()
   if ( show_version() )
     return result;
 
+  if ( !read_jobs() )
+    return result;
+
+  if ( !read_opaque_rectangle_algorithm() )
+    return result;
+
+  m_force = find_and_erase_option( wxT("--force"), wxT("-f") );
+
   const bool compile_f
     ( find_and_erase_option( wxT("--compile"), wxT("-c") ) );
   const bool update_f
@@ -185,24 +243,13 @@ bool bf::base_editor_application::command_line_init()
  */
 bool bf::base_editor_application::compile_arguments() const
 {
-  bool result(true);
+  std::vector<wxString> paths;
 
   for (int i=1; i<argc; ++i)
     if ( wxString(argv[i]) != wxT("--") )
-      try
-        {
-          claw::logger << claw::log_verbose << "Compiling "
-                       << wx_to_std_string(argv[i]) << std::endl;
-          compile(argv[i]);
-        }
-      catch(std::exception& e)
-        {
-          std::cerr << "Error when processing '" << argv[i] << "': "
-                    << e.what() << std::endl;
-          result = false;
-        }
+      paths.push_back( argv[i] );
 
-  return result;
+  return compile_files( paths );
 } // base_editor_application::compile_arguments()
 
 /*----------------------------------------------------------------------------*/
@@ -245,6 +292,14 @@ bool bf::base_editor_application::show_help()
         "Where the options are:\n\n"
         "\t--compile, -c\n\t\tCompile the files and exit, \n"
         "\t--update, -u\n\t\tUpdate the files and exit, \n"
+        "\t--force, -f\n\t\tCompile the files even if they are up to "
+        "date, \n"
+        "\t--jobs, -j integer\n\t\tUse this number of threads to compute "
+        "the opaque rectangles of the sprites when compiling the files, \n"
+        "\t--opaque-rectangles, -r branch-and-bound|histogram\n\t\t"
+        "Search the opaque rectangles of the sprites with this algorithm. "
+        "The histogram search is faster but its results differ from those "
+        "of the default branch and bound search, \n"
         "\t--workspace, -w string\n\t\tWhen no file is provided, "
         "create a new editor in this workspace, \n"
         "\t--help, -h\n\t\tDisplay this help and exit, \n"
@@ -272,6 +327,62 @@ bool bf::base_editor_application::show_version()
     return false;
 } // base_editor_application::show_version()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the number of threads to use for the compilation, if given on
+ *        the command line.
+ * \return false if the value of the option is invalid.
+ */
+bool bf::base_editor_application::read_jobs()
+{
+  std::string value;
+
+  if ( !find_and_erase_option_value( wxT("--jobs"), wxT("-j"), value ) )
+    return true;
+
+  std::istringstream iss(value);
+  unsigned int jobs;
+
+  if ( (iss >> jobs) && iss.eof() && (jobs != 0) )
+    {
+      m_jobs = jobs;
+      return true;
+    }
+
+  std::cerr << "Invalid number of jobs: '" << value << "'." << std::endl;
+  return false;
+} // base_editor_application::read_jobs()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the algorithm used to compute the opaque rectangles of the
+ *        sprites, if given on the command line.
+ * \return false if the value of the option is invalid.
+ */
+bool bf::base_editor_application::read_opaque_rectangle_algorithm()
+{
+  std::string value;
+
+  if ( !find_and_erase_option_value
+       ( wxT("--opaque-rectangles"), wxT("-r"), value ) )
+    return true;
+
+  if ( value == "branch-and-bound" )
+    compilation_context::set_default_opaque_rectangle_algorithm
+      ( compilation_context::branch_and_bound_algorithm );
+  else if ( value == "histogram" )
+    compilation_context::set_default_opaque_rectangle_algorithm
+      ( compilation_context::histogram_algorithm );
+  else
+    {
+      std::cerr << "Invalid opaque rectangle algorithm: '" << value << "'."
+                << std::endl;
+      return false;
+    }
+
+  return true;
+} // base_editor_application::read_opaque_rectangle_algorithm()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Check if an option is present on the command line and remove it.
@@ -15,24 +15,111 @@
 
 #include <wx/image.h>
 
+#include "bf/item_class_pool.hpp"
+#include "bf/path_configuration.hpp"
+#include "bf/task_pool.hpp"
+#include "bf/opaque_rectangle/ler_histogram_solver.hpp"
 #include "bf/opaque_rectangle/ler_problem.hpp"
 #include "bf/opaque_rectangle/ler_solver.hpp"
 #include "bf/workspace_environment.hpp"
 
+#include <boost/bind.hpp>
+
+/*----------------------------------------------------------------------------*/
+bf::compilation_context::opaque_rectangle_algorithm
+bf::compilation_context::s_default_opaque_rectangle_algorithm
+( bf::compilation_context::branch_and_bound_algorithm );
+
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Constructor.
+ * \brief Constructor. The opaque rectangles are computed with the algorithm
+ *        given to set_default_opaque_rectangle_algorithm().
  * \param optimization_level The optimisation level during the compilation. If
  *        the value is less than 1 then the opaque boxes are not computed.
  * \param env The compilation environemtn to use.
  */
  bf::compilation_context::compilation_context
  ( unsigned int optimization_level, workspace_environment& env )
-   : m_image_cache(env), m_optimization_level(optimization_level), 
+   : m_image_cache(env), m_opaque_rectangle_cache(env.get_name()),
+     m_defer_opaque_rectangles(false),
+     m_optimization_level(optimization_level), 
+     m_opaque_rectangle_algorithm(s_default_opaque_rectangle_algorithm),
      m_workspace(env)
 {
+  if ( m_optimization_level >= 1 )
+    m_opaque_rectangle_cache.load();
+} // compilation_context::compilation_context()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param optimization_level The optimisation level during the compilation. If
+ *        the value is less than 1 then the opaque boxes are not computed.
+ * \param env The compilation environemtn to use.
+ * \param algorithm The algorithm used to compute the opaque rectangles.
+ */
+ bf::compilation_context::compilation_context
+ ( unsigned int optimization_level, workspace_environment& env,
+   opaque_rectangle_algorithm algorithm )
+   : m_image_cache(env), m_opaque_rectangle_cache(env.get_name()),
+     m_defer_opaque_rectangles(false),
+     m_optimization_level(optimization_level), 
+     m_opaque_rectangle_algorithm(algorithm), m_workspace(env)
+{
+  if ( m_optimization_level >= 1 )
+    m_opaque_rectangle_cache.load();
 } // compilation_context::compilation_context()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor. The opaque rectangles computed during the compilation are
+ *        saved for the next compilations.
+ */
+bf::compilation_context::~compilation_context()
+{
+  m_opaque_rectangle_cache.save();
+} // compilation_context::~compilation_context()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the algorithm used to compute the opaque rectangles by the
+ *        contexts constructed without an algorithm. The default is the branch
+ *        and bound search, such that the compiled files do not change.
+ * \param algorithm The algorithm.
+ */
+void bf::compilation_context::set_default_opaque_rectangle_algorithm
+( opaque_rectangle_algorithm algorithm )
+{
+  s_default_opaque_rectangle_algorithm = algorithm;
+} // compilation_context::set_default_opaque_rectangle_algorithm()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the algorithm used to compute the opaque rectangles by the
+ *        contexts constructed without an algorithm.
+ */
+bf::compilation_context::opaque_rectangle_algorithm
+bf::compilation_context::get_default_opaque_rectangle_algorithm()
+{
+  return s_default_opaque_rectangle_algorithm;
+} // compilation_context::get_default_opaque_rectangle_algorithm()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get a string identifying an algorithm used to compute the opaque
+ *        rectangles, and its version. The version must be changed each time the
+ *        algorithm changes its results.
+ * \param algorithm The algorithm.
+ */
+std::string bf::compilation_context::get_algorithm_signature
+( opaque_rectangle_algorithm algorithm )
+{
+  if ( algorithm == branch_and_bound_algorithm )
+    return "branch-and-bound-1";
+  else
+    return "histogram-1";
+} // compilation_context::get_algorithm_signature()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the opaque rectangle of a given sprite.
@@ -49,14 +136,112 @@ bf::compilation_context::get_opaque_rectangle
 
   opaque_rectangle_map::iterator it = m_opaque_rectangle.find(key);
 
-  if ( it == m_opaque_rectangle.end() )
-    it =
-      m_opaque_rectangle.insert
-      ( std::make_pair( key, compute_opaque_rectangle(key) ) ).first;
+  if ( it != m_opaque_rectangle.end() )
+    return it->second;
+
+  if ( m_defer_opaque_rectangles )
+    {
+      m_deferred_opaque_rectangles.insert(key);
+      return rectangle(0, 0, 0, 0);
+    }
 
-  return it->second;
+  return
+    m_opaque_rectangle.insert
+    ( std::make_pair( key, load_or_compute_opaque_rectangle(key) ) )
+    .first->second;
 } // compilation_context::get_opaque_rectangle()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Defer the computation of the opaque rectangles to the next call to
+ *        compute_deferred_opaque_rectangles().
+ *
+ * Until then, get_opaque_rectangle() records the sprites for which it is
+ * called and returns an empty rectangle for those whose rectangle is not known
+ * yet. This is used to collect the sprites of several resources with a first
+ * compilation whose output is discarded, then to compute their rectangles in
+ * parallel before the actual compilation.
+ */
+void bf::compilation_context::defer_opaque_rectangles()
+{
+  m_defer_opaque_rectangles = true;
+} // compilation_context::defer_opaque_rectangles()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compute the opaque rectangles of the sprites recorded since the call
+ *        to defer_opaque_rectangles(), and stop deferring the computation.
+ * \param jobs The number of threads computing the rectangles.
+ *
+ * The images are decoded in the calling thread, which is the only one to
+ * access the image pool of the workspace. The threads only run the solvers on
+ * copies of the alpha channels, thus the images of the next sprites are
+ * decoded while the rectangles of the previous ones are computed.
+ */
+void bf::compilation_context::compute_deferred_opaque_rectangles
+( unsigned int jobs )
+{
+  m_defer_opaque_rectangles = false;
+
+  std::vector<sprite> sprites;
+  std::vector<std::string> paths;
+  std::vector<rectangle> results( m_deferred_opaque_rectangles.size() );
+
+  sprites.reserve( m_deferred_opaque_rectangles.size() );
+  paths.reserve( m_deferred_opaque_rectangles.size() );
+
+  {
+    task_pool pool( jobs, 2 * jobs );
+
+    for ( std::set<sprite>::const_iterator it =
+            m_deferred_opaque_rectangles.begin();
+          it != m_deferred_opaque_rectangles.end(); ++it )
+      if ( !is_opaque_rectangle_needed(*it) )
+        m_opaque_rectangle[*it] = rectangle(0, 0, 0, 0);
+      else if ( !is_opaque_rectangle_computed(*it) )
+        {
+          const std::string path( get_image_full_path(*it) );
+          rectangle r;
+
+          if ( !path.empty()
+               && m_opaque_rectangle_cache.find
+               ( path, it->get_clip_rectangle(), get_algorithm_signature(),
+                 r ) )
+            m_opaque_rectangle[*it] = r;
+          else
+            {
+              unsigned int width;
+              unsigned int height;
+              const alpha_channel alpha
+                ( get_alpha_channel( *it, width, height ) );
+
+              pool.push
+                ( boost::bind
+                  ( &compilation_context::compute_opaque_rectangle_task,
+                    alpha, width, height, m_opaque_rectangle_algorithm,
+                    &results[ sprites.size() ] ) );
+
+              sprites.push_back( *it );
+              paths.push_back( path );
+            }
+        }
+
+    pool.wait();
+  }
+
+  for ( std::size_t i=0; i!=sprites.size(); ++i )
+    {
+      m_opaque_rectangle[ sprites[i] ] = results[i];
+
+      if ( !paths[i].empty() )
+        m_opaque_rectangle_cache.insert
+          ( paths[i], sprites[i].get_clip_rectangle(),
+            get_algorithm_signature(), results[i] );
+    }
+
+  m_deferred_opaque_rectangles.clear();
+} // compilation_context::compute_deferred_opaque_rectangles()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the identifier associated to a given item_instance in the compiled
@@ -108,6 +293,133 @@ std::string bf::compilation_context::get_workspace_name() const
   return m_workspace.get_name();
 } // compilation_context::get_workspace_name()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Record a file used by the compiled resources.
+ * \param path The full path to the file.
+ */
+void bf::compilation_context::add_dependency( const std::string& path )
+{
+  m_dependencies.insert(path);
+} // compilation_context::add_dependency()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Record the files describing an item class and its super classes as
+ *        used by the compiled resources.
+ * \param c The item class.
+ */
+void bf::compilation_context::add_item_class_dependency( const item_class& c )
+{
+  std::list<item_class const*> hierarchy;
+  c.find_hierarchy( hierarchy );
+
+  for ( std::list<item_class const*>::const_iterator it=hierarchy.begin();
+        it!=hierarchy.end(); ++it )
+    {
+      const std::string path
+        ( m_workspace.get_item_class_pool().get_item_class_file
+          ( (*it)->get_class_name() ) );
+
+      if ( !path.empty() )
+        m_dependencies.insert(path);
+    }
+} // compilation_context::add_item_class_dependency()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the paths of the files used by the resources compiled since the
+ *        last call to clear_dependencies().
+ */
+const std::set<std::string>&
+bf::compilation_context::get_dependencies() const
+{
+  return m_dependencies;
+} // compilation_context::get_dependencies()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Forget the files used by the resources compiled until now.
+ */
+void bf::compilation_context::clear_dependencies()
+{
+  m_dependencies.clear();
+} // compilation_context::clear_dependencies()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the opaque rectangle of a sprite has to be computed, according
+ *        to the optimization level and to the size of the sprite.
+ * \param s The sprite to check.
+ */
+bool
+bf::compilation_context::is_opaque_rectangle_needed( const sprite& s ) const
+{
+  return (m_optimization_level >= 1)
+    && (s.get_clip_width() != 0) && (s.get_clip_height() != 0);
+} // compilation_context::is_opaque_rectangle_needed()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the opaque rectangle of a sprite has already been computed.
+ * \param s The sprite to check.
+ */
+bool
+bf::compilation_context::is_opaque_rectangle_computed( const sprite& s ) const
+{
+  return m_opaque_rectangle.find(s) != m_opaque_rectangle.end();
+} // compilation_context::is_opaque_rectangle_computed()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the full path to the image of a sprite.
+ * \param s The sprite whose image is searched.
+ * \return The full path or an empty string if the image has not been found.
+ */
+std::string
+bf::compilation_context::get_image_full_path( const sprite& s ) const
+{
+  std::string result( s.get_image_name() );
+
+  if ( !path_configuration::get_instance().get_full_path
+       ( result, m_workspace.get_name() ) )
+    result.clear();
+
+  return result;
+} // compilation_context::get_image_full_path()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the opaque rectangle of a given sprite from the rectangles
+ *        computed during the previous compilations, or compute it if it is
+ *        not available.
+ * \param s The sprite for which we want the opaque rectangle.
+ */
+bf::compilation_context::rectangle
+bf::compilation_context::load_or_compute_opaque_rectangle( const sprite& s )
+{
+  if ( !is_opaque_rectangle_needed(s) )
+    return rectangle(0, 0, 0, 0);
+
+  const std::string image_path( get_image_full_path(s) );
+
+  if ( image_path.empty() )
+    return compute_opaque_rectangle(s);
+
+  const std::string algorithm( get_algorithm_signature() );
+  rectangle result;
+
+  if ( !m_opaque_rectangle_cache.find
+       ( image_path, s.get_clip_rectangle(), algorithm, result ) )
+    {
+      result = compute_opaque_rectangle(s);
+      m_opaque_rectangle_cache.insert
+        ( image_path, s.get_clip_rectangle(), algorithm, result );
+    }
+
+  return result;
+} // compilation_context::load_or_compute_opaque_rectangle()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Compute the opaque rectangle of a given sprite.
@@ -116,30 +428,135 @@ std::string bf::compilation_context::get_workspace_name() const
 bf::compilation_context::rectangle
 bf::compilation_context::compute_opaque_rectangle( const sprite& s )
 {
-  if ( (m_optimization_level < 1)
-       || (s.get_clip_width() == 0) || (s.get_clip_height() == 0) )
-    return rectangle(0, 0, 0, 0);
+  unsigned int width;
+  unsigned int height;
+  const alpha_channel alpha( get_alpha_channel(s, width, height) );
+  rectangle result;
+
+  compute_opaque_rectangle_task
+    ( alpha, width, height, m_opaque_rectangle_algorithm, &result );
+
+  return result;
+} // compilation_context::compute_opaque_rectangle()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the alpha channel of the image of a sprite, with the first row at
+ *        the bottom.
+ * \param s The sprite whose alpha channel is returned.
+ * \param width (out) The width of the image.
+ * \param height (out) The height of the image.
+ * \return The alpha channel, row by row, or a null pointer if the image has no
+ *         alpha channel or if the opaque rectangle must not be computed.
+ */
+bf::compilation_context::alpha_channel
+bf::compilation_context::get_alpha_channel
+( const sprite& s, unsigned int& width, unsigned int& height )
+{
+  width = 0;
+  height = 0;
+
+  if ( !is_opaque_rectangle_needed(s) )
+    return alpha_channel();
 
   const std::pair<wxBitmap, wxPoint> source = m_image_cache.get_image(s);
   wxImage image( source.first.ConvertToImage().Mirror(false) );
 
+  width = image.GetWidth();
+  height = image.GetHeight();
+
+  if ( !image.HasAlpha() && image.HasMask() )
+    image.InitAlpha();
+
+  if ( !image.HasAlpha() )
+    return alpha_channel();
+
+  const unsigned char* const alpha( image.GetAlpha() );
+
+  return alpha_channel
+    ( new std::vector<unsigned char>( alpha, alpha + width * height ) );
+} // compilation_context::get_alpha_channel()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get a string identifying the algorithm used by this context to
+ *        compute the opaque rectangles.
+ */
+std::string bf::compilation_context::get_algorithm_signature() const
+{
+  return get_algorithm_signature( m_opaque_rectangle_algorithm );
+} // compilation_context::get_algorithm_signature()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compute the opaque rectangle of an alpha channel. This method does
+ *        not access the members of the class, thus it can be executed in any
+ *        thread.
+ * \param alpha The alpha channel, with the first row at the bottom. A null
+ *        pointer means that the image is fully opaque.
+ * \param width The width of the image.
+ * \param height The height of the image.
+ * \param algorithm The algorithm used to compute the rectangle.
+ * \param result (out) The opaque rectangle.
+ */
+void bf::compilation_context::compute_opaque_rectangle_task
+( alpha_channel alpha, unsigned int width, unsigned int height,
+  opaque_rectangle_algorithm algorithm, rectangle* result )
+{
+  if ( alpha )
+    *result =
+      compute_opaque_rectangle( &(*alpha)[0], width, height, algorithm );
+  else
+    *result = compute_opaque_rectangle( NULL, width, height, algorithm );
+} // compilation_context::compute_opaque_rectangle_task()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compute the opaque rectangle of an alpha channel.
+ * \param alpha The alpha channel, with the first row at the bottom. A null
+ *        pointer means that the image is fully opaque.
+ * \param width The width of the image.
+ * \param height The height of the image.
+ * \param algorithm The algorithm used to compute the rectangle.
+ */
+bf::compilation_context::rectangle
+bf::compilation_context::compute_opaque_rectangle
+( const unsigned char* alpha, unsigned int width, unsigned int height,
+  opaque_rectangle_algorithm algorithm )
+{
+  if ( (width == 0) || (height == 0) )
+    return rectangle(0, 0, 0, 0);
+  else if ( algorithm == branch_and_bound_algorithm )
+    return compute_opaque_rectangle_branch_and_bound( alpha, width, height );
+  else
+    return compute_opaque_rectangle_histogram( alpha, width, height );
+} // compilation_context::compute_opaque_rectangle()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compute the opaque rectangle of an alpha channel with the ler_solver.
+ * \param alpha The alpha channel, with the first row at the bottom. A null
+ *        pointer means that the image is fully opaque.
+ * \param width The width of the image.
+ * \param height The height of the image.
+ */
+bf::compilation_context::rectangle
+bf::compilation_context::compute_opaque_rectangle_branch_and_bound
+( const unsigned char* alpha, unsigned int width, unsigned int height )
+{
   ler_problem pb;
   ler_base_problem::rectangle r
     ( ler_base_problem::point(0, 0),
-      ler_base_problem::point
-      (s.get_clip_width() - 1, s.get_clip_height() - 1) );
+      ler_base_problem::point(width - 1, height - 1) );
   
   pb.set_bounding_rectangle(r);
 
-  if ( !image.HasAlpha() && image.HasMask() )
-    image.InitAlpha();
-
-  if ( image.HasAlpha() )
+  if ( alpha != NULL )
     {
       // ler_problem expects the points to be inserted column per column.
-      for ( unsigned int i = 0; i != s.get_clip_width(); ++i )
-        for ( unsigned int j = 0; j != s.get_clip_height(); ++j )
-          if ( image.GetAlpha(i, j) != 255 )
+      for ( unsigned int i = 0; i != width; ++i )
+        for ( unsigned int j = 0; j != height; ++j )
+          if ( alpha[ j * width + i ] != 255 )
             pb.add_forbidden_point( ler_base_problem::point(i, j) );
     }
 
@@ -152,4 +569,26 @@ bf::compilation_context::compute_opaque_rectangle( const sprite& s )
     r = ler_base_problem::rectangle(0, 0, 0, 0);
 
   return r;
-} // compilation_context::compute_opaque_rectangle()
+} // compilation_context::compute_opaque_rectangle_branch_and_bound()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compute the opaque rectangle of an alpha channel with the
+ *        ler_histogram_solver.
+ * \param alpha The alpha channel, with the first row at the bottom. A null
+ *        pointer means that the image is fully opaque.
+ * \param width The width of the image.
+ * \param height The height of the image.
+ */
+bf::compilation_context::rectangle
+bf::compilation_context::compute_opaque_rectangle_histogram
+( const unsigned char* alpha, unsigned int width, unsigned int height )
+{
+  ler_histogram_solver solver( alpha, width, height );
+  solver.resolve();
+
+  if ( solver.is_solved() )
+    return solver.get_solution();
+  else
+    return rectangle(0, 0, 0, 0);
+} // compilation_context::compute_opaque_rectangle_histogram()
@@ -0,0 +1,180 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bf::compilation_manifest class.
+ * \author Julien Jorge
+ */
+#include "bf/compilation_manifest.hpp"
+
+#include "bf/file_hash.hpp"
+
+#include <fstream>
+
+#include <boost/filesystem/operations.hpp>
+#include <claw/logger.hpp>
+
+/*----------------------------------------------------------------------------*/
+const std::string
+bf::compilation_manifest::s_file_header( "bear-factory manifest 1" );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param compiled_file_path The path to the compiled file described by the
+ *        manifest.
+ */
+bf::compilation_manifest::compilation_manifest
+( const std::string& compiled_file_path )
+  : m_compiled_file_path(compiled_file_path)
+{
+
+} // compilation_manifest::compilation_manifest()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the compiled file is up to date with its inputs.
+ * \param signature A description of the compiler. The file is not up to date
+ *        if it has been built with another compiler.
+ * \param hashes The hashes of the inputs.
+ * \param reason (out) Why the file is not up to date.
+ */
+bool bf::compilation_manifest::is_up_to_date
+( const std::string& signature, file_hash& hashes, std::string& reason ) const
+{
+  if ( !boost::filesystem::exists( m_compiled_file_path ) )
+    {
+      reason = "the compiled file does not exist";
+      return false;
+    }
+
+  std::string previous_signature;
+  hash_map inputs;
+
+  if ( !load( previous_signature, inputs ) )
+    {
+      reason = "there is no manifest of a previous compilation";
+      return false;
+    }
+
+  if ( previous_signature != signature )
+    {
+      reason = "it has been compiled with another version of the editor";
+      return false;
+    }
+
+  for ( hash_map::const_iterator it=inputs.begin(); it!=inputs.end(); ++it )
+    {
+      const std::string hash( hashes.get_hash(it->first) );
+
+      if ( hash.empty() )
+        {
+          reason = "'" + it->first + "' can't be read anymore";
+          return false;
+        }
+      else if ( hash != it->second )
+        {
+          reason = "'" + it->first + "' has changed";
+          return false;
+        }
+    }
+
+  return true;
+} // compilation_manifest::is_up_to_date()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Save the manifest of a compilation.
+ * \param signature A description of the compiler.
+ * \param inputs The paths of the files used to build the compiled file.
+ * \param hashes The hashes of the inputs.
+ *
+ * If one of the inputs can't be read then the manifest is removed, such that
+ * the next compilation builds the file again.
+ */
+void bf::compilation_manifest::save
+( const std::string& signature, const std::set<std::string>& inputs,
+  file_hash& hashes ) const
+{
+  const std::string path( get_manifest_path() );
+  std::ofstream f( path.c_str() );
+
+  f << s_file_header << '\n' << signature << '\n';
+
+  for ( std::set<std::string>::const_iterator it=inputs.begin();
+        it!=inputs.end(); ++it )
+    {
+      const std::string hash( hashes.get_hash(*it) );
+
+      if ( hash.empty() )
+        {
+          f.close();
+          remove();
+          return;
+        }
+
+      f << hash << ' ' << *it << '\n';
+    }
+
+  if ( !f )
+    claw::logger << claw::log_warning << "Can't write the manifest '"
+                 << path << "'." << std::endl;
+} // compilation_manifest::save()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove the manifest, such that the next compilation builds the file
+ *        again.
+ */
+void bf::compilation_manifest::remove() const
+{
+  boost::system::error_code error;
+  boost::filesystem::remove( get_manifest_path(), error );
+} // compilation_manifest::remove()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the manifest.
+ * \param signature (out) The description of the compiler that built the file.
+ * \param inputs (out) The hashes of the inputs, associated with their paths.
+ * \return false if the manifest can't be read.
+ */
+bool bf::compilation_manifest::load
+( std::string& signature, hash_map& inputs ) const
+{
+  std::ifstream f( get_manifest_path().c_str() );
+  std::string line;
+
+  if ( !std::getline(f, line) || (line != s_file_header) )
+    return false;
+
+  if ( !std::getline(f, signature) )
+    return false;
+
+  while ( std::getline(f, line) )
+    {
+      const std::string::size_type pos( line.find(' ') );
+
+      if ( pos == std::string::npos )
+        return false;
+
+      inputs[ line.substr(pos + 1) ] = line.substr(0, pos);
+    }
+
+  return true;
+} // compilation_manifest::load()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the path to the file in which the manifest is saved.
+ */
+std::string bf::compilation_manifest::get_manifest_path() const
+{
+  return m_compiled_file_path + ".deps";
+} // compilation_manifest::get_manifest_path()
@@ -0,0 +1,75 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bf::file_hash class.
+ * \author Julien Jorge
+ */
+#include "bf/file_hash.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <boost/cstdint.hpp>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the hash of the content of a file.
+ * \param path The path to the file.
+ * \return The hash of the file or an empty string if the file can't be read.
+ */
+std::string bf::file_hash::get_hash( const std::string& path )
+{
+  std::map<std::string, std::string>::const_iterator it = m_hash.find(path);
+
+  if ( it == m_hash.end() )
+    it = m_hash.insert( std::make_pair(path, compute_hash(path)) ).first;
+
+  return it->second;
+} // file_hash::get_hash()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compute the hash of the content of a file, without using the cache.
+ * \param path The path to the file.
+ * \return The 64 bits FNV-1a hash of the file followed by its size, or an
+ *         empty string if the file can't be read.
+ */
+std::string bf::file_hash::compute_hash( const std::string& path )
+{
+  std::ifstream f( path.c_str(), std::ios::binary );
+
+  if ( !f )
+    return std::string();
+
+  boost::uint64_t hash( 14695981039346656037ULL );
+  std::size_t size(0);
+  char buffer[4096];
+
+  while ( f )
+    {
+      f.read( buffer, sizeof(buffer) );
+      const std::streamsize n( f.gcount() );
+
+      for ( std::streamsize i=0; i!=n; ++i )
+        {
+          hash ^= (unsigned char)buffer[i];
+          hash *= 1099511628211ULL;
+        }
+
+      size += n;
+    }
+
+  std::ostringstream oss;
+  oss << std::hex << std::setfill('0') << std::setw(16) << hash
+      << '-' << std::dec << size;
+
+  return oss.str();
+} // file_hash::compute_hash()
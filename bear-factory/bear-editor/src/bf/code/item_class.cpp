@@ -16,12 +16,34 @@
 #include <claw/logger.hpp>
 #include <claw/assert.hpp>
 #include <algorithm>
+#include <limits>
+
+/*----------------------------------------------------------------------------*/
+const std::size_t bf::item_class::not_a_field =
+  std::numeric_limits<std::size_t>::max();
+
+namespace bf
+{
+  /**
+   * \brief Compare the entries of the field table of an item class with the
+   *        name of a field.
+   */
+  struct item_class_field_entry_less
+  {
+    template<typename Entry>
+    bool operator()( const Entry& e, const std::string& name ) const
+    {
+      return e.name < name;
+    }
+  }; // struct item_class_field_entry_less
+} // namespace bf
 
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
  */
 bf::item_class::item_class()
+  : m_fields_resolved(false)
 {
 
 } // item_class::item_class()
@@ -32,6 +54,7 @@ bf::item_class::item_class()
  * \param that The item to copy from.
  */
 bf::item_class::item_class( const item_class& that )
+  : m_fields_resolved(false)
 {
   copy(that);
 } // item_class::item_class()
@@ -42,6 +65,8 @@ bf::item_class::item_class( const item_class& that )
  */
 bf::item_class::~item_class()
 {
+  unlink_super_classes();
+  unlink_sub_classes();
   clear();
 } // item_class::~item_class()
 
@@ -54,6 +79,7 @@ bf::item_class& bf::item_class::operator=( const item_class& that )
 {
   if ( this != &that )
     {
+      unlink_super_classes();
       clear();
       copy(that);
     }
@@ -112,7 +138,10 @@ bf::item_class::add_field( const std::string& name, const type_field& field )
   field_map_type::iterator it = m_field.find(name);
 
   if ( it == m_field.end() )
-    m_field[name] = field.clone();
+    {
+      m_field[name] = field.clone();
+      fields_changed();
+    }
   else
     claw::logger << claw::log_error << "Field '" << name << "' already exists."
                  << std::endl;
@@ -223,6 +252,8 @@ bool bf::item_class::has_super_class( const std::string& super_class ) const
 void bf::item_class::add_super_class( item_class const* super_class )
 {
   m_super_classes.push_back(super_class);
+  super_class->m_sub_classes.push_back(this);
+  fields_changed();
 } // item_class::add_super_class()
 
 /*----------------------------------------------------------------------------*/
@@ -243,7 +274,11 @@ void bf::item_class::remove_super_class( const std::string& super_class )
       ++it;
 
   if ( found )
-    m_super_classes.erase(it);
+    {
+      (*it)->m_sub_classes.remove(this);
+      m_super_classes.erase(it);
+      fields_changed();
+    }
 } // item_class::remove_super_class()
 
 /*----------------------------------------------------------------------------*/
@@ -256,6 +291,7 @@ void
 bf::item_class::new_default_value( const std::string& f, const std::string& v )
 {
   m_default_value[f] = v;
+  fields_changed();
 } // item_class::new_default_value()
 
 /*----------------------------------------------------------------------------*/
@@ -265,28 +301,12 @@ bf::item_class::new_default_value( const std::string& f, const std::string& v )
  */
 std::string bf::item_class::get_default_value( const std::string& f ) const
 {
-  std::string result;
-  string_map_type::const_iterator it = m_default_value.find(f);
+  const std::size_t index( get_field_index(f) );
 
-  if ( it!=m_default_value.end() )
-    result = it->second;
+  if ( index == not_a_field )
+    return search_default_value(f);
   else
-    {
-      field_map_type::const_iterator itf = m_field.find(f);
-
-      if ( itf!=m_field.end() )
-        result = itf->second->get_default_value();
-      else
-        {
-          const_super_class_iterator it_p = super_class_begin();
-
-          for ( it_p=m_super_classes.begin();
-                result.empty() && it_p!=super_class_end(); ++it_p )
-            result = it_p->get_default_value(f);
-        }
-    }
-
-  return result;
+    return get_field_table()[index].default_value;
 } // item_class::get_default_value()
 
 /*----------------------------------------------------------------------------*/
@@ -301,6 +321,7 @@ void bf::item_class::add_removed_field( const std::string& f )
                 == m_removed_fields.end() );
 
   m_removed_fields.push_back(f);
+  fields_changed();
 } // item_class::add_removed_field()
 
 /*----------------------------------------------------------------------------*/
@@ -324,22 +345,68 @@ bool bf::item_class::is_removed_field( const std::string& f ) const
 void bf::item_class::get_field_names_in_hierarchy
 ( std::list<std::string>& f ) const
 {
-  std::list<std::string> fields;
-  std::list<std::string> removed;
+  const field_table_type& table( get_field_table() );
+  f.clear();
 
-  get_all_field_names_in_hierarchy(fields);
-  get_removed_fields_names_in_hierarchy(removed);
+  for ( field_index_list::const_iterator it=m_fields_in_hierarchy.begin();
+        it!=m_fields_in_hierarchy.end(); ++it )
+    f.push_back( table[*it].name );
+} // item_class::get_field_names_in_hierarchy()
 
-  fields.sort();
-  removed.sort();
-  f.clear();
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the indices of the fields of this class and its super classes
+ *        that are not removed, in the order of their names.
+ */
+const bf::item_class::field_index_list&
+bf::item_class::get_field_indices_in_hierarchy() const
+{
+  get_field_table();
+  return m_fields_in_hierarchy;
+} // item_class::get_field_indices_in_hierarchy()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of fields in this class and its super classes,
+ *        including the removed fields.
+ */
+std::size_t bf::item_class::get_field_count() const
+{
+  return get_field_table().size();
+} // item_class::get_field_count()
 
-  std::set_difference
-    ( fields.begin(), fields.end(), removed.begin(), removed.end(),
-      std::back_inserter(f) );
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the index of a field of this class or of its super classes.
+ * \param field_name The name of the field.
+ * \return The index of the field or not_a_field if there is no such field.
+ */
+std::size_t
+bf::item_class::get_field_index( const std::string& field_name ) const
+{
+  const field_table_type& table( get_field_table() );
+  const field_table_type::const_iterator it
+    ( std::lower_bound
+      ( table.begin(), table.end(), field_name,
+        item_class_field_entry_less() ) );
 
-  f.unique();
-} // item_class::get_field_names_in_hierarchy()
+  if ( (it == table.end()) || (it->name != field_name) )
+    return not_a_field;
+  else
+    return it - table.begin();
+} // item_class::get_field_index()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the description of a field, given its index.
+ * \param index The index of the field, as returned by get_field_index().
+ */
+const bf::type_field& bf::item_class::get_field_at( std::size_t index ) const
+{
+  CLAW_PRECOND( index < get_field_table().size() );
+
+  return *get_field_table()[index].field;
+} // item_class::get_field_at()
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -350,9 +417,8 @@ const bf::type_field&
 bf::item_class::get_field( const std::string& field_name ) const
 {
   CLAW_PRECOND( has_field(field_name) );
-  const type_field* result = search_field(field_name);
 
-  return *result;
+  return get_field_at( get_field_index(field_name) );
 } // item_class::get_field()
 
 /*----------------------------------------------------------------------------*/
@@ -471,26 +537,74 @@ bool bf::item_class::field_unicity_test(std::string& error_msg) const
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Tell if this class, or one of the parent classes, has a field with a
- *        given name.
- * \param name The name of the field we are looking for.
+ * \brief Build the table of the fields of this class and of its super classes
+ *        if the class or one of its super classes has been modified since the
+ *        table was built.
+ *
+ * The table is otherwise built at the first search of a field. The classes
+ * must be resolved before being searched from several threads, since the
+ * searches do not modify a resolved class.
  */
-bool bf::item_class::has_field( const std::string& name ) const
+void bf::item_class::resolve_fields() const
 {
-  bool result = false;
-  field_map_type::const_iterator it = m_field.find( name );
+  if ( !m_fields_resolved )
+    build_field_table();
+} // item_class::resolve_fields()
 
-  if ( it != m_field.end() )
-    result = true;
-  else
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Build the table of the fields of this class and of its super classes,
+ *        such that the next searches of the fields do not have to walk through
+ *        the hierarchy.
+ */
+void bf::item_class::build_field_table() const
+{
+  std::list<std::string> names;
+  get_all_field_names_in_hierarchy(names);
+  names.sort();
+  names.unique();
+
+  m_field_table.clear();
+  m_field_table.reserve( names.size() );
+
+  for ( std::list<std::string>::const_iterator it=names.begin();
+        it!=names.end(); ++it )
     {
-      const_super_class_iterator it;
+      field_entry e;
+      e.name = *it;
+      e.field = search_field(*it);
+      e.default_value = search_default_value(*it);
 
-      for ( it=super_class_begin(); !result && (it!=super_class_end()); ++it)
-        result = it->has_field( name );
+      m_field_table.push_back(e);
     }
 
-  return result;
+  std::list<std::string> removed;
+  get_removed_fields_names_in_hierarchy(removed);
+  removed.sort();
+
+  m_fields_in_hierarchy.clear();
+
+  for ( std::size_t i=0; i!=m_field_table.size(); ++i )
+    if ( !std::binary_search
+         ( removed.begin(), removed.end(), m_field_table[i].name ) )
+      m_fields_in_hierarchy.push_back(i);
+
+  m_fields_resolved = true;
+} // item_class::build_field_table()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if this class, or one of the parent classes, has a field with a
+ *        given name.
+ * \param name The name of the field we are looking for.
+ */
+bool bf::item_class::has_field( const std::string& name ) const
+{
+  // The classes being loaded are searched without building their tables.
+  if ( !m_fields_resolved )
+    return search_field( name ) != NULL;
+
+  return get_field_index( name ) != not_a_field;
 } // item_class::has_field()
 
 /*----------------------------------------------------------------------------*/
@@ -503,20 +617,10 @@ bool bf::item_class::has_field( const std::string& name ) const
 bool bf::item_class::has_field
 ( const std::string& name, type_field::field_type t ) const
 {
-  bool result = false;
-  field_map_type::const_iterator it = m_field.find( name );
+  const std::size_t index( get_field_index( name ) );
 
-  if ( it != m_field.end() )
-    result = it->second->get_field_type() == t;
-  else
-    {
-      const_super_class_iterator it;
-
-      for (it=super_class_begin(); !result && (it!=super_class_end()); ++it)
-        result = it->has_field( name, t );
-    }
-
-  return result;
+  return (index != not_a_field)
+    && (get_field_table()[index].field->get_field_type() == t);
 } // item_class::has_field()
 
 /*----------------------------------------------------------------------------*/
@@ -531,8 +635,79 @@ void bf::item_class::clear()
     delete it->second;
 
   m_field.clear();
+  m_field_table.clear();
+  m_fields_in_hierarchy.clear();
+  m_fields_resolved = false;
 } // item_class::clear()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Register this class as a sub class of its super classes.
+ */
+void bf::item_class::link_super_classes()
+{
+  for ( super_class_list::const_iterator it=m_super_classes.begin();
+        it!=m_super_classes.end(); ++it )
+    (*it)->m_sub_classes.push_back(this);
+} // item_class::link_super_classes()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove this class from the sub classes of its super classes and
+ *        forget the super classes.
+ */
+void bf::item_class::unlink_super_classes()
+{
+  for ( super_class_list::const_iterator it=m_super_classes.begin();
+        it!=m_super_classes.end(); ++it )
+    (*it)->m_sub_classes.remove(this);
+
+  m_super_classes.clear();
+} // item_class::unlink_super_classes()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove this class from the super classes of the classes inheriting
+ *        from it, such that they do not keep a pointer on a deleted class.
+ */
+void bf::item_class::unlink_sub_classes()
+{
+  std::list<item_class*> sub_classes;
+  sub_classes.swap(m_sub_classes);
+
+  for ( std::list<item_class*>::const_iterator it=sub_classes.begin();
+        it!=sub_classes.end(); ++it )
+    {
+      (*it)->m_super_classes.remove(this);
+      (*it)->fields_changed();
+    }
+} // item_class::unlink_sub_classes()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Mark the table of the fields of this class and of all the classes
+ *        inheriting from it as outdated. They are built again when they are
+ *        searched or resolved.
+ */
+void bf::item_class::fields_changed()
+{
+  m_fields_resolved = false;
+
+  for ( std::list<item_class*>::const_iterator it=m_sub_classes.begin();
+        it!=m_sub_classes.end(); ++it )
+    (*it)->fields_changed();
+} // item_class::fields_changed()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the table of the fields of the class and of its super classes.
+ */
+const bf::item_class::field_table_type& bf::item_class::get_field_table() const
+{
+  resolve_fields();
+  return m_field_table;
+} // item_class::get_field_table()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Copy all fields from an other item class.
@@ -554,6 +729,9 @@ void bf::item_class::copy( const item_class& that )
 
   for (it=that.m_field.begin(); it!=that.m_field.end(); ++it)
     m_field[it->first] = it->second->clone();
+
+  link_super_classes();
+  fields_changed();
 } // item_class::copy()
 
 /*----------------------------------------------------------------------------*/
@@ -581,6 +759,38 @@ bf::item_class::search_field( const std::string& field_name ) const
   return result;
 } // item_class::search_field()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Search the default value of a field of this class or a parent class,
+ *        walking through the hierarchy.
+ * \param f The name of the field.
+ */
+std::string bf::item_class::search_default_value( const std::string& f ) const
+{
+  std::string result;
+  string_map_type::const_iterator it = m_default_value.find(f);
+
+  if ( it!=m_default_value.end() )
+    result = it->second;
+  else
+    {
+      field_map_type::const_iterator itf = m_field.find(f);
+
+      if ( itf!=m_field.end() )
+        result = itf->second->get_default_value();
+      else
+        {
+          const_super_class_iterator it_p;
+
+          for ( it_p=super_class_begin();
+                result.empty() && it_p!=super_class_end(); ++it_p )
+            result = it_p->search_default_value(f);
+        }
+    }
+
+  return result;
+} // item_class::search_default_value()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get all the names of the fields whose values are set by this class and
@@ -14,51 +14,48 @@
 #include "bf/item_class_pool.hpp"
 
 #include "bf/class_not_found.hpp"
+#include "bf/item_class_snapshot.hpp"
 #include "bf/item_class_xml_parser.hpp"
 #include "bf/path_configuration.hpp"
 #include "bf/scan_dir.hpp"
+#include "bf/task_pool.hpp"
+#include "bf/wx_facilities.hpp"
 
 #include <claw/assert.hpp>
 #include <claw/logger.hpp>
 #include <claw/exception.hpp>
 
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <wx/mstream.h>
+
+#include <fstream>
+#include <sstream>
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
- * \param c The map where we associate a file with its class.
+ * \param c The vector in which the paths of the files are stored.
  */
 bf::item_class_pool::open_item_class_file::open_item_class_file
-( std::map<std::string, std::string>& c )
+( std::vector<std::string>& c )
   : class_files(c)
 {
 } // item_class_pool::open_item_class_file::open_item_class_file()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Add a class and its file.
+ * \brief Add a file describing a class.
  * \param path The path to the file describing the class.
  */
 void bf::item_class_pool::open_item_class_file::operator()
   ( const std::string& path )
 {
-  try
-    {
-      const std::string class_name =
-        item_class_xml_parser::get_item_class_name(path);
-
-      if ( class_files.find(class_name) != class_files.end() )
-        claw::logger << claw::log_error << "Duplicated item class '"
-                     << class_name << "' in '" << path << '\'' << std::endl;
-      else
-        class_files[class_name] = path;
-    }
-  catch(std::exception& e)
-    {
-      claw::logger << claw::log_error << path << ": " << e.what() << std::endl;
-    }
+  class_files.push_back(path);
 } // item_class_pool::open_item_class_file::operator()()
 
-
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
@@ -123,6 +120,24 @@ bf::item_class_pool::get_item_class_ptr( const std::string& class_name ) const
     return it->second;
 } // item_class_pool::get_item_class()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the path to the file describing an item class.
+ * \param class_name The name of the item class.
+ * \return The path to the file or an empty string if there is no such class.
+ */
+std::string
+bf::item_class_pool::get_item_class_file( const std::string& class_name ) const
+{
+  std::map<std::string, std::string>::const_iterator it =
+    m_item_class_file.find(class_name);
+
+  if ( it == m_item_class_file.end() )
+    return std::string();
+  else
+    return it->second;
+} // item_class_pool::get_item_class_file()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get a constant iterator on the begining of the pool.
@@ -145,12 +160,22 @@ bf::item_class_pool::const_iterator bf::item_class_pool::end() const
 /**
  * \brief Read all item files from a given directory and in its subdirectories.
  * \param w The workspace used.
+ *
+ * The classes are taken from the snapshot of the previous loading if their
+ * files did not change since then. Otherwise the files are parsed and a new
+ * snapshot is saved.
  */
 void bf::item_class_pool::scan_directory( const std::string& w )
 {
+  const boost::posix_time::ptime start
+    ( boost::posix_time::microsec_clock::universal_time() );
+
   std::vector<std::string> ext(1);
   ext[0] = ".xml";
 
+  std::vector< std::vector<std::string> > directories;
+  std::vector<std::string> all_files;
+
   if ( path_configuration::get_instance().has_workspace( w ) )
     {
       workspace::path_list_const_iterator it;
@@ -160,21 +185,118 @@ void bf::item_class_pool::scan_directory( const std::string& w )
       for ( it = work.item_class_begin(); 
             it != work.item_class_end(); ++it )
         {
-          std::map<std::string, std::string> files;
-          
-          open_item_class_file f(files);
+          directories.push_back( std::vector<std::string>() );
+
+          open_item_class_file f( directories.back() );
           scan_dir<open_item_class_file> scan;
           
           scan( *it, f, ext.begin(), ext.end() );
-          
-          while ( !files.empty() )
-            load_class( files.begin()->first, files );
+
+          all_files.insert
+            ( all_files.end(), directories.back().begin(),
+              directories.back().end() );
         }
     }
 
-  field_unicity_test();
+  const item_class_snapshot snapshot( w );
+  const bool from_snapshot
+    ( snapshot.load( all_files, m_item_class, m_item_class_file ) );
+
+  if ( !from_snapshot )
+    {
+      load_files( directories );
+      field_unicity_test();
+      snapshot.save( all_files, m_item_class, m_item_class_file );
+    }
+
+  resolve_fields();
+
+  const boost::posix_time::time_duration duration
+    ( boost::posix_time::microsec_clock::universal_time() - start );
+
+  claw::logger << claw::log_verbose << m_item_class.size()
+               << " item classes loaded "
+               << ( from_snapshot ? "from the snapshot" : "from the XML files" )
+               << " in " << duration.total_milliseconds() << " ms."
+               << std::endl;
 } // item_class_pool::scan_directory()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the item classes described in some files.
+ * \param directories The paths of the files, grouped by directory.
+ *
+ * The files are read in parallel, then the XML documents and the classes are
+ * built in the calling thread, directory after directory, such that the super
+ * classes are built before the classes inheriting from them. The documents
+ * are not built by the threads since wxWidgets does not guarantee that its
+ * XML parser and its conversions of strings can be used outside the main
+ * thread.
+ */
+void bf::item_class_pool::load_files
+( const std::vector< std::vector<std::string> >& directories )
+{
+  std::vector<parsed_file> parsed;
+
+  for ( std::size_t i=0; i!=directories.size(); ++i )
+    for ( std::size_t j=0; j!=directories[i].size(); ++j )
+      {
+        parsed.push_back( parsed_file() );
+        parsed.back().path = directories[i][j];
+        parsed.back().read = false;
+      }
+
+  {
+    const unsigned int threads( boost::thread::hardware_concurrency() );
+    task_pool tasks( threads, 2 * threads );
+
+    for ( std::size_t i=0; i!=parsed.size(); ++i )
+      tasks.push( boost::bind( &item_class_pool::read_file, &parsed[i] ) );
+
+    tasks.wait();
+  }
+
+  std::size_t index(0);
+
+  for ( std::size_t i=0; i!=directories.size(); ++i )
+    {
+      parsed_file_map files;
+
+      for ( std::size_t j=0; j!=directories[i].size(); ++j, ++index )
+        {
+          parsed_file& f( parsed[index] );
+
+          if ( !parse_file(f) )
+            {
+              claw::logger << claw::log_error << "Cannot load the XML file '"
+                           << f.path << '\'' << std::endl;
+              continue;
+            }
+
+          try
+            {
+              const std::string class_name =
+                item_class_xml_parser::get_item_class_name(*f.document);
+
+              if ( files.find(class_name) != files.end() )
+                claw::logger << claw::log_error << "Duplicated item class '"
+                             << class_name << "' in '" << f.path << '\''
+                             << std::endl;
+              else
+                files[class_name] = &f;
+            }
+          catch(std::exception& e)
+            {
+              claw::logger << claw::log_error << f.path << ": " << e.what()
+                           << std::endl;
+            }
+        }
+
+      while ( !files.empty() )
+        load_class( files.begin()->first, files );
+    }
+} // item_class_pool::load_files()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Read the file of an item class.
@@ -182,7 +304,7 @@ void bf::item_class_pool::scan_directory( const std::string& w )
  * \param files The files associated to the item classes.
  */
 void bf::item_class_pool::load_class
-( const std::string& name, std::map<std::string, std::string>& files )
+( const std::string& name, parsed_file_map& files )
 {
   std::list<std::string> pending;
   pending.push_front(name);
@@ -195,9 +317,11 @@ void bf::item_class_pool::load_class
       try
         {
           item_class_xml_parser r;
+          const parsed_file& f( *files[class_name] );
 
-          item = r.read( *this, files[class_name] );
+          item = r.read( *this, *f.document );
           m_item_class[item->get_class_name()] = item;
+          m_item_class_file[item->get_class_name()] = f.path;
           pending.pop_front();
           files.erase(class_name);
         }
@@ -234,6 +358,49 @@ void bf::item_class_pool::load_class
     }
 } // item_class_pool::load_classes()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the content of an item class file. This method is called by the
+ *        threads of load_files() and does not use wxWidgets.
+ * \param f The file to read. It is marked as not read if the file can't be
+ *        opened, the error being reported by the calling thread.
+ */
+void bf::item_class_pool::read_file( parsed_file* f )
+{
+  std::ifstream is( f->path.c_str(), std::ios::in | std::ios::binary );
+  std::ostringstream content;
+
+  if ( is && (content << is.rdbuf()) )
+    {
+      f->content = content.str();
+      f->read = true;
+    }
+} // item_class_pool::read_file()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Build the XML document of an item class file from the content read
+ *        by read_file(). This method must be called in the main thread.
+ * \param f The file whose document is built.
+ * \return true if the document has been built.
+ */
+bool bf::item_class_pool::parse_file( parsed_file& f )
+{
+  if ( !f.read )
+    return false;
+
+  wxMemoryInputStream is( f.content.data(), f.content.size() );
+  boost::shared_ptr<wxXmlDocument> doc( new wxXmlDocument );
+  const bool result( doc->Load(is) );
+
+  if ( result )
+    f.document = doc;
+
+  std::string().swap( f.content );
+
+  return result;
+} // item_class_pool::parse_file()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Test, for each classe, the unicity of fields.
@@ -262,5 +429,17 @@ void bf::item_class_pool::field_unicity_test()
     {
       delete m_item_class[*it2];
       m_item_class.erase(*it2);
+      m_item_class_file.erase(*it2);
     }
 } // item_class_pool::control_sprite_size()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Build the tables of the fields of all the classes, once they are all
+ *        loaded, such that they can be searched from several threads.
+ */
+void bf::item_class_pool::resolve_fields() const
+{
+  for ( const_iterator it=begin(); it!=end(); ++it )
+    it->resolve_fields();
+} // item_class_pool::resolve_fields()
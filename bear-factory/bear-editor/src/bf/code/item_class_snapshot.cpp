@@ -0,0 +1,713 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bf::item_class_snapshot class.
+ * \author Julien Jorge
+ */
+#include "bf/item_class_snapshot.hpp"
+
+#include "bf/item_class.hpp"
+#include "bf/path_configuration.hpp"
+#include "bf/type_field_interval.hpp"
+#include "bf/type_field_set.hpp"
+#include "bf/version.hpp"
+#include "bf/wx_facilities.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <wx/intl.h>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <claw/assert.hpp>
+#include <claw/logger.hpp>
+
+/*----------------------------------------------------------------------------*/
+const std::string
+bf::item_class_snapshot::s_file_header( "bear-factory item-classes 2" );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param workspace_name The name of the workspace whose classes are saved.
+ */
+bf::item_class_snapshot::item_class_snapshot
+( const std::string& workspace_name )
+  : m_workspace_name(workspace_name)
+{
+
+} // item_class_snapshot::item_class_snapshot()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Load the item classes from the snapshot.
+ * \param files The paths of the XML files of the item classes, in the order in
+ *        which they are read.
+ * \param classes (out) The classes read in the snapshot.
+ * \param class_files (out) The path to the file of each class.
+ * \return false if the snapshot does not exist, is invalid or does not match
+ *         \a files. In this case \a classes and \a class_files are not
+ *         modified.
+ */
+bool bf::item_class_snapshot::load
+( const std::vector<std::string>& files, item_class_map& classes,
+  class_file_map& class_files ) const
+{
+  std::ifstream f
+    ( get_snapshot_file_path().c_str(), std::ios::in | std::ios::binary );
+  std::string header;
+  std::string signature;
+
+  if ( !read(f, header) || (header != s_file_header)
+       || !read(f, signature) || (signature != get_signature(files)) )
+    return false;
+
+  item_class_map result;
+  class_file_map result_files;
+  bool valid;
+
+  try
+    {
+      valid = read_classes(f, result, result_files);
+    }
+  catch( std::exception& e )
+    {
+      claw::logger << claw::log_warning << "Error in the snapshot '"
+                   << get_snapshot_file_path() << "': " << e.what()
+                   << std::endl;
+      valid = false;
+    }
+
+  if ( !valid )
+    {
+      claw::logger << claw::log_warning << "Ignoring the invalid snapshot '"
+                   << get_snapshot_file_path() << "'." << std::endl;
+
+      for ( item_class_map::iterator it=result.begin(); it!=result.end();
+            ++it )
+        delete it->second;
+
+      return false;
+    }
+
+  classes.swap(result);
+  class_files.swap(result_files);
+
+  return true;
+} // item_class_snapshot::load()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Save the item classes in the snapshot.
+ * \param files The paths of the XML files of the item classes, in the order in
+ *        which they have been read.
+ * \param classes The classes to save.
+ * \param class_files The path to the file of each class.
+ *
+ * The snapshot is written in a temporary file with a unique name, which is
+ * then renamed, such that a concurrent process never reads a partially
+ * written file nor writes in the same temporary file.
+ */
+void bf::item_class_snapshot::save
+( const std::vector<std::string>& files, const item_class_map& classes,
+  const class_file_map& class_files ) const
+{
+  if ( !path_configuration::get_instance().create_config_directory() )
+    return;
+
+  const std::string path( get_snapshot_file_path() );
+  const std::string temporary_path
+    ( boost::filesystem::unique_path( path + ".%%%%-%%%%-%%%%.tmp" )
+      .string() );
+
+  boost::system::error_code error;
+
+  {
+    std::ofstream f
+      ( temporary_path.c_str(), std::ios::out | std::ios::binary );
+
+    write( f, s_file_header );
+    write( f, get_signature(files) );
+    write( f, (unsigned int)classes.size() );
+
+    for ( item_class_map::const_iterator it=classes.begin();
+          it!=classes.end(); ++it )
+      {
+        const class_file_map::const_iterator file
+          ( class_files.find(it->first) );
+
+        if ( file == class_files.end() )
+          write( f, std::string() );
+        else
+          write( f, file->second );
+
+        write_class( f, *it->second );
+      }
+
+    if ( !f )
+      {
+        claw::logger << claw::log_warning << "Can't write the snapshot '"
+                     << temporary_path << "'." << std::endl;
+        f.close();
+        boost::filesystem::remove( temporary_path, error );
+        return;
+      }
+  }
+
+  boost::filesystem::rename( temporary_path, path, error );
+
+  if ( error )
+    {
+      claw::logger << claw::log_warning << "Can't write the snapshot '"
+                   << path << "': " << error.message() << std::endl;
+      boost::filesystem::remove( temporary_path, error );
+    }
+} // item_class_snapshot::save()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the item classes saved in the snapshot.
+ * \param is The stream from which the classes are read.
+ * \param classes (out) The classes.
+ * \param class_files (out) The path to the file of each class.
+ * \return false if the snapshot is invalid.
+ *
+ * The classes are created in a first pass, then their super classes are set,
+ * then the fields removed by each class are set, since a class can only
+ * remove the fields of its super classes.
+ */
+bool bf::item_class_snapshot::read_classes
+( std::istream& is, item_class_map& classes, class_file_map& class_files ) const
+{
+  unsigned int count;
+
+  if ( !read(is, count) )
+    return false;
+
+  string_list_map super_classes;
+  string_list_map removed_fields;
+
+  for ( unsigned int i=0; i!=count; ++i )
+    {
+      std::string file;
+
+      if ( !read(is, file) )
+        return false;
+
+      std::list<std::string> super;
+      std::list<std::string> removed;
+      item_class* c( read_class(is, super, removed) );
+
+      if ( c == NULL )
+        return false;
+
+      const std::string& name( c->get_class_name() );
+
+      if ( classes.find(name) != classes.end() )
+        {
+          delete c;
+          return false;
+        }
+
+      classes[name] = c;
+
+      if ( !file.empty() )
+        class_files[name] = file;
+
+      super_classes[name].swap(super);
+      removed_fields[name].swap(removed);
+    }
+
+  for ( string_list_map::const_iterator it=super_classes.begin();
+        it!=super_classes.end(); ++it )
+    for ( std::list<std::string>::const_iterator s=it->second.begin();
+          s!=it->second.end(); ++s )
+      {
+        const item_class_map::const_iterator super( classes.find(*s) );
+
+        if ( super == classes.end() )
+          return false;
+
+        classes[it->first]->add_super_class( super->second );
+      }
+
+  for ( string_list_map::const_iterator it=removed_fields.begin();
+        it!=removed_fields.end(); ++it )
+    for ( std::list<std::string>::const_iterator f=it->second.begin();
+          f!=it->second.end(); ++f )
+      {
+        item_class* c( classes[it->first] );
+
+        if ( !c->has_field(*f) )
+          return false;
+
+        c->add_removed_field(*f);
+      }
+
+  return true;
+} // item_class_snapshot::read_classes()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read an item class, without its super classes and the fields it
+ *        removes.
+ * \param is The stream from which the class is read.
+ * \param super_classes (out) The names of the super classes of the class.
+ * \param removed_fields (out) The names of the fields removed by the class.
+ * \return The class or NULL if the snapshot is invalid.
+ */
+bf::item_class* bf::item_class_snapshot::read_class
+( std::istream& is, std::list<std::string>& super_classes,
+  std::list<std::string>& removed_fields ) const
+{
+  std::string name, description, url, category, color;
+  unsigned int fixable;
+  unsigned int field_count;
+
+  if ( !read(is, name) || !read(is, description) || !read(is, url)
+       || !read(is, category) || !read(is, color) || !read(is, fixable)
+       || !read(is, super_classes) || !read(is, field_count) )
+    return NULL;
+
+  item_class* result = new item_class;
+  result->set_class_name(name);
+  result->set_description(description);
+  result->set_url(url);
+  result->set_category(category);
+  result->set_color(color);
+  result->set_fixable(fixable != 0);
+
+  for ( unsigned int i=0; i!=field_count; ++i )
+    {
+      type_field* f( read_field(is) );
+
+      if ( f == NULL )
+        {
+          delete result;
+          return NULL;
+        }
+
+      result->add_field( f->get_name(), *f );
+      delete f;
+    }
+
+  std::list<std::string> default_values;
+
+  if ( !read(is, default_values) || (default_values.size() % 2 != 0)
+       || !read(is, removed_fields) )
+    {
+      delete result;
+      return NULL;
+    }
+
+  while ( !default_values.empty() )
+    {
+      const std::string field( default_values.front() );
+      default_values.pop_front();
+      result->new_default_value( field, default_values.front() );
+      default_values.pop_front();
+    }
+
+  return result;
+} // item_class_snapshot::read_class()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the description of a field.
+ * \param is The stream from which the field is read.
+ * \return The field or NULL if the snapshot is invalid.
+ */
+bf::type_field* bf::item_class_snapshot::read_field( std::istream& is ) const
+{
+  std::string name, description, default_value;
+  unsigned int field_type, range_type, required, is_list;
+  std::list<std::string> preceding;
+
+  if ( !read(is, name) || !read(is, field_type) || !read(is, range_type)
+       || !read(is, required) || !read(is, is_list) || !read(is, description)
+       || !read(is, default_value) || !read(is, preceding)
+       || (field_type > type_field::easing_field_type) )
+    return NULL;
+
+  const type_field::field_type ft
+    ( static_cast<type_field::field_type>(field_type) );
+  type_field* result(NULL);
+
+  if ( range_type == type_field::field_range_set )
+    {
+      std::list<std::string> values;
+
+      if ( read(is, values) )
+        result = new type_field_set( name, ft, values );
+    }
+  else if ( range_type == type_field::field_range_interval )
+    {
+      if ( ft == type_field::integer_field_type )
+        {
+          int min, max;
+
+          if ( read(is, min) && read(is, max) )
+            result = new type_field_interval<int>( name, min, max );
+        }
+      else if ( ft == type_field::u_integer_field_type )
+        {
+          unsigned int min, max;
+
+          if ( read(is, min) && read(is, max) )
+            result = new type_field_interval<unsigned int>( name, min, max );
+        }
+      else if ( ft == type_field::real_field_type )
+        {
+          double min, max;
+
+          if ( read(is, min) && read(is, max) )
+            result = new type_field_interval<double>( name, min, max );
+        }
+    }
+  else if ( range_type == type_field::field_range_free )
+    result = new type_field( name, ft );
+
+  if ( result != NULL )
+    {
+      result->set_required( required != 0 );
+      result->set_is_list( is_list != 0 );
+      result->set_description( description );
+      result->set_default_value( default_value );
+      result->set_preceding( preceding );
+    }
+
+  return result;
+} // item_class_snapshot::read_field()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write an item class.
+ * \param os The stream in which the class is written.
+ * \param c The class to write.
+ */
+void bf::item_class_snapshot::write_class
+( std::ostream& os, const item_class& c ) const
+{
+  write( os, c.m_class_name );
+  write( os, c.m_description );
+  write( os, c.m_url );
+  write( os, c.m_category );
+  write( os, c.m_color );
+  write( os, (unsigned int)(c.m_fixable ? 1 : 0) );
+
+  std::list<std::string> names;
+
+  for ( item_class::const_super_class_iterator it=c.super_class_begin();
+        it!=c.super_class_end(); ++it )
+    names.push_back( it->get_class_name() );
+
+  write( os, names );
+  write( os, (unsigned int)c.m_field.size() );
+
+  for ( item_class::field_iterator it=c.field_begin(); it!=c.field_end();
+        ++it )
+    write_field( os, *it );
+
+  names.clear();
+
+  for ( item_class::string_map_type::const_iterator it=
+          c.m_default_value.begin();
+        it!=c.m_default_value.end(); ++it )
+    {
+      names.push_back( it->first );
+      names.push_back( it->second );
+    }
+
+  write( os, names );
+  write( os, c.m_removed_fields );
+} // item_class_snapshot::write_class()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the description of a field.
+ * \param os The stream in which the field is written.
+ * \param f The field to write.
+ */
+void bf::item_class_snapshot::write_field
+( std::ostream& os, const type_field& f ) const
+{
+  write( os, f.get_name() );
+  write( os, (unsigned int)f.get_field_type() );
+  write( os, (unsigned int)f.get_range_type() );
+  write( os, (unsigned int)(f.get_required() ? 1 : 0) );
+  write( os, (unsigned int)(f.is_list() ? 1 : 0) );
+  write( os, f.get_description() );
+  write( os, f.get_default_value() );
+  write
+    ( os,
+      std::list<std::string>
+      ( f.get_preceding().begin(), f.get_preceding().end() ) );
+
+  if ( f.get_range_type() == type_field::field_range_set )
+    {
+      std::list<std::string> values;
+      f.get_set(values);
+      write( os, values );
+    }
+  else if ( f.get_range_type() == type_field::field_range_interval )
+    switch ( f.get_field_type() )
+      {
+      case type_field::integer_field_type:
+        {
+          int min, max;
+          f.get_interval(min, max);
+          write( os, min );
+          write( os, max );
+          break;
+        }
+      case type_field::u_integer_field_type:
+        {
+          unsigned int min, max;
+          f.get_interval(min, max);
+          write( os, min );
+          write( os, max );
+          break;
+        }
+      case type_field::real_field_type:
+        {
+          double min, max;
+          f.get_interval(min, max);
+          write( os, min );
+          write( os, max );
+          break;
+        }
+      default:
+        {
+          CLAW_FAIL( "Interval on a field which is not a number." );
+        }
+      }
+} // item_class_snapshot::write_field()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get a string describing the files from which the classes are read.
+ *        The snapshot is valid only if its signature is the signature of the
+ *        current files.
+ * \param files The paths of the XML files of the item classes.
+ *
+ * The descriptions of the fields are translated when the classes are read,
+ * thus the signature also contains the language of the program. It also
+ * contains the version of the editor, since the classes read from the XML
+ * files may change with the parser.
+ */
+std::string bf::item_class_snapshot::get_signature
+( const std::vector<std::string>& files ) const
+{
+  std::ostringstream result;
+
+  result << BF_VERSION_STRING << '\n';
+
+  if ( wxGetLocale() != NULL )
+    result << wx_to_std_string( wxGetLocale()->GetCanonicalName() );
+
+  for ( std::size_t i=0; i!=files.size(); ++i )
+    {
+      boost::system::error_code error;
+      const boost::uintmax_t size
+        ( boost::filesystem::file_size( files[i], error ) );
+      const std::time_t date
+        ( boost::filesystem::last_write_time( files[i], error ) );
+
+      result << '\n' << files[i] << '|' << size << '|' << date;
+    }
+
+  return result.str();
+} // item_class_snapshot::get_signature()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the path to the file in which the snapshot is saved.
+ */
+std::string bf::item_class_snapshot::get_snapshot_file_path() const
+{
+  std::string name( m_workspace_name );
+  std::replace( name.begin(), name.end(), '/', '_' );
+
+  return path_configuration::get_instance().get_config_directory()
+    + "item-classes-" + name;
+} // item_class_snapshot::get_snapshot_file_path()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a string.
+ * \param is The stream from which the value is read.
+ * \param s (out) The value.
+ *
+ * The string is read by blocks, such that an invalid length does not allocate
+ * more memory than the size of the stream.
+ */
+bool bf::item_class_snapshot::read( std::istream& is, std::string& s )
+{
+  unsigned int length;
+
+  if ( !read(is, length) )
+    return false;
+
+  s.clear();
+
+  char buffer[4096];
+
+  while ( (length != 0) && !is.fail() )
+    {
+      const std::size_t n( std::min<std::size_t>(length, sizeof(buffer)) );
+
+      is.read( buffer, n );
+      s.append( buffer, is.gcount() );
+      length -= n;
+    }
+
+  return !is.fail();
+} // item_class_snapshot::read()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read an unsigned integer, stored in four bytes in little endian order.
+ * \param is The stream from which the value is read.
+ * \param i (out) The value.
+ */
+bool bf::item_class_snapshot::read( std::istream& is, unsigned int& i )
+{
+  unsigned char bytes[4];
+
+  if ( !is.read( reinterpret_cast<char*>(bytes), 4 ) )
+    return false;
+
+  i = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16)
+    | ((unsigned int)bytes[3] << 24);
+
+  return true;
+} // item_class_snapshot::read()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a signed integer.
+ * \param is The stream from which the value is read.
+ * \param i (out) The value.
+ */
+bool bf::item_class_snapshot::read( std::istream& is, int& i )
+{
+  unsigned int u;
+
+  if ( !read(is, u) )
+    return false;
+
+  i = u;
+  return true;
+} // item_class_snapshot::read()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a real number, stored as the bytes of the value.
+ * \param is The stream from which the value is read.
+ * \param d (out) The value.
+ */
+bool bf::item_class_snapshot::read( std::istream& is, double& d )
+{
+  is.read( reinterpret_cast<char*>(&d), sizeof(d) );
+  return !is.fail();
+} // item_class_snapshot::read()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a list of strings.
+ * \param is The stream from which the value is read.
+ * \param s (out) The value.
+ */
+bool
+bf::item_class_snapshot::read( std::istream& is, std::list<std::string>& s )
+{
+  unsigned int count;
+
+  if ( !read(is, count) )
+    return false;
+
+  for ( unsigned int i=0; i!=count; ++i )
+    {
+      s.push_back( std::string() );
+
+      if ( !read(is, s.back()) )
+        return false;
+    }
+
+  return true;
+} // item_class_snapshot::read()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a string.
+ * \param os The stream in which the value is written.
+ * \param s The value.
+ */
+void bf::item_class_snapshot::write( std::ostream& os, const std::string& s )
+{
+  write( os, (unsigned int)s.size() );
+  os.write( s.data(), s.size() );
+} // item_class_snapshot::write()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write an unsigned integer in four bytes, in little endian order.
+ * \param os The stream in which the value is written.
+ * \param i The value.
+ */
+void bf::item_class_snapshot::write( std::ostream& os, unsigned int i )
+{
+  const char bytes[4] =
+    { char(i & 0xFF), char((i >> 8) & 0xFF), char((i >> 16) & 0xFF),
+      char((i >> 24) & 0xFF) };
+
+  os.write( bytes, 4 );
+} // item_class_snapshot::write()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a signed integer.
+ * \param os The stream in which the value is written.
+ * \param i The value.
+ */
+void bf::item_class_snapshot::write( std::ostream& os, int i )
+{
+  write( os, (unsigned int)i );
+} // item_class_snapshot::write()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a real number. The snapshot is local to the computer, thus the
+ *        bytes of the value are written as is.
+ * \param os The stream in which the value is written.
+ * \param d The value.
+ */
+void bf::item_class_snapshot::write( std::ostream& os, double d )
+{
+  os.write( reinterpret_cast<const char*>(&d), sizeof(d) );
+} // item_class_snapshot::write()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a list of strings.
+ * \param os The stream in which the value is written.
+ * \param s The value.
+ */
+void bf::item_class_snapshot::write
+( std::ostream& os, const std::list<std::string>& s )
+{
+  write( os, (unsigned int)s.size() );
+
+  for ( std::list<std::string>::const_iterator it=s.begin(); it!=s.end(); ++it )
+    write( os, *it );
+} // item_class_snapshot::write()
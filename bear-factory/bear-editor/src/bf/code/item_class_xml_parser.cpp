@@ -38,7 +38,18 @@ std::string bf::item_class_xml_parser::get_item_class_name
     throw std::ios_base::failure
       ( "Cannot load the XML file '" + file_path + "'" );
 
-  wxXmlNode* node = doc.GetRoot();
+  return get_item_class_name( doc );
+} // item_class_xml_parser::get_item_class_name()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the name of the item class described in an XML document.
+ * \param doc The document describing the class.
+ */
+std::string
+bf::item_class_xml_parser::get_item_class_name( const wxXmlDocument& doc )
+{
+  const wxXmlNode* node = doc.GetRoot();
 
   if ( node->GetName() != wxT("item") )
     throw xml::bad_node( wx_to_std_string(node->GetName()) );
@@ -66,6 +77,18 @@ bf::item_class* bf::item_class_xml_parser::read
     throw std::ios_base::failure
       ( "Cannot load the XML file '" + file_path + "'" );
 
+  return read( pool, doc );
+} // item_class_xml_parser::read()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read an item class from an XML document.
+ * \param pool The pool of item classes in which we take the parent classes.
+ * \param doc The document describing the class.
+ */
+bf::item_class* bf::item_class_xml_parser::read
+( const item_class_pool& pool, const wxXmlDocument& doc ) const
+{
   item_class* result = new item_class;
 
   try
@@ -238,14 +238,13 @@ void bf::item_instance::set_id( const std::string& id )
 void bf::item_instance::rename_item_reference_fields
 ( const std::map<std::string, std::string>& map_id)
 {
-  std::list<std::string> fields;
-  std::list<std::string>::const_iterator it;
-
-  m_class->get_field_names_in_hierarchy(fields);
+  const item_class::field_index_list& fields
+    ( m_class->get_field_indices_in_hierarchy() );
+  item_class::field_index_list::const_iterator it;
 
   for ( it=fields.begin(); it!=fields.end(); ++it )
     {
-      const type_field& f = m_class->get_field(*it);
+      const type_field& f = m_class->get_field_at(*it);
 
       if( f.get_field_type() == type_field::item_reference_field_type )
         {
@@ -337,6 +336,31 @@ bool bf::item_instance::has_a_reference_to( const std::string& id ) const
   return false;
 } // item_instance::has_a_reference_to()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the identifiers of the instances referenced by this one.
+ * \param ids (out) The identifiers of the referenced instances.
+ */
+void bf::item_instance::get_referenced_identifiers
+( std::set<std::string>& ids ) const
+{
+  item_reference_type_map::const_iterator it;
+
+  for ( it=m_item_reference.begin(); it!=m_item_reference.end(); ++it )
+    ids.insert( it->second.get_value() );
+
+  item_reference_type_list_map::const_iterator it_list;
+
+  for ( it_list=m_item_reference_list.begin();
+      it_list!=m_item_reference_list.end(); ++it_list )
+    {
+      std::list<item_reference_type>::const_iterator iti;
+
+      for ( iti=it_list->second.begin(); iti!=it_list->second.end(); ++iti )
+        ids.insert( iti->get_value() );
+    }
+} // item_instance::get_referenced_identifiers()
+
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -348,13 +372,13 @@ void bf::item_instance::get_item_reference_field_names
 ( std::set<std::string> & item_reference_fields, 
   std::set<std::string> & item_reference_list_fields ) const
 {
-  std::list<std::string> all_fields;
-  get_class().get_field_names_in_hierarchy( all_fields );
+  const item_class::field_index_list& all_fields
+    ( get_class().get_field_indices_in_hierarchy() );
 
-  std::list<std::string>::const_iterator it;
+  item_class::field_index_list::const_iterator it;
   for ( it = all_fields.begin(); it != all_fields.end(); ++it )
     {
-      type_field field = get_class().get_field(*it);
+      const type_field& field = get_class().get_field_at(*it);
       if ( field.get_field_type() == type_field::item_reference_field_type )
         {
           if ( field.is_list() )
@@ -393,12 +417,15 @@ void bf::item_instance::set_fixed( bool b )
 void bf::item_instance::compile
 ( compiled_file& f, compilation_context& c ) const
 {
+  c.add_item_class_dependency( *m_class );
+
   f << get_fixed();
 
-  std::list<std::string> fields;
+  item_class::field_index_list fields;
+  sort_fields(fields);
 
-  for( sort_fields(fields); !fields.empty(); fields.pop_front() )
-    compile_field( f, m_class->get_field(fields.front()), c );
+  for( std::size_t i=0; i!=fields.size(); ++i )
+    compile_field( f, m_class->get_field_at(fields[i]), c );
 } // item_instance::compile()
 
 /*----------------------------------------------------------------------------*/
@@ -441,14 +468,13 @@ void bf::item_instance::check_mass_for_fixed_item
 void bf::item_instance::check_id_required
 ( item_check_result& result, const std::set<std::string>& map_id ) const
 {
-  std::list<std::string> fields;
-  std::list<std::string>::const_iterator it;
-
-  m_class->get_field_names_in_hierarchy(fields);
+  const item_class::field_index_list& fields
+    ( m_class->get_field_indices_in_hierarchy() );
+  item_class::field_index_list::const_iterator it;
 
   for ( it=fields.begin(); it!=fields.end(); ++it )
     {
-      const type_field& f = m_class->get_field(*it);
+      const type_field& f = m_class->get_field_at(*it);
       if( (f.get_field_type() == type_field::item_reference_field_type)
           && has_value(f) )
         {
@@ -487,26 +513,25 @@ void bf::item_instance::check_id_required
  */
 void bf::item_instance::check_required_fields( item_check_result& result ) const
 {
-  std::list<std::string> fields;
-  std::list<std::string>::const_iterator it;
-
-  m_class->get_field_names_in_hierarchy(fields);
+  const item_class::field_index_list& fields
+    ( m_class->get_field_indices_in_hierarchy() );
+  item_class::field_index_list::const_iterator it;
 
   for ( it=fields.begin(); it!=fields.end(); ++it )
     {
-      const type_field& f = m_class->get_field(*it);
+      const type_field& f = m_class->get_field_at(*it);
       if( f.get_required() && !has_value(f) )
-        result.add( check_error( *it, "Field value is required." ) );
+        result.add( check_error( f.get_name(), "Field value is required." ) );
     }
 } // item_instance::check_required_fields()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Get the name of the fields, ordered so that fields depending on other
- *        fields are after them in the list.
- * \param fields (out) The name of the fields.
+ * \brief Get the indices of the fields having a value, ordered so that fields
+ *        depending on other fields are after them in the list.
+ * \param fields (out) The indices of the fields in the table of the class.
  */
-void bf::item_instance::sort_fields( std::list<std::string>& fields ) const
+void bf::item_instance::sort_fields( item_class::field_index_list& fields ) const
 {
   std::set<std::string> all_fields;
 
@@ -536,36 +561,53 @@ void bf::item_instance::sort_fields( std::list<std::string>& fields ) const
   copy_field_names( m_color_list, all_fields );
   copy_field_names( m_easing_list, all_fields );
 
-  while ( !all_fields.empty() )
+  std::vector<bool> remaining( m_class->get_field_count(), false );
+  std::set<std::string>::const_iterator it;
+
+  for ( it=all_fields.begin(); it!=all_fields.end(); ++it )
     {
-      const std::string field_name( *all_fields.begin() );
-      insert_field( field_name, fields, all_fields );
+      const std::size_t index( m_class->get_field_index(*it) );
+      CLAW_PRECOND( index != item_class::not_a_field );
+
+      remaining[index] = true;
     }
+
+  fields.reserve( all_fields.size() );
+
+  // The table of the fields is sorted by name, thus the fields are inserted in
+  // the same order than the names in all_fields.
+  for ( std::size_t i=0; i!=remaining.size(); ++i )
+    insert_field( i, fields, remaining );
 } // item_instance::sort_fields()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Get the name of the fields, ordered so that fields depending on other
- *        fields are after them in the list.
- * \param field_name The name of the field to insert.
- * \param fields (out) The name of the fields.
- * \param all_fields (in/out) All the remaining fields to insert.
+ * \brief Insert a field in a list of fields, after the fields it depends on.
+ * \param index The index of the field to insert.
+ * \param fields (out) The indices of the fields.
+ * \param remaining (in/out) Tell for each field if it remains to be inserted.
  */
 void bf::item_instance::insert_field
-( const std::string& field_name, std::list<std::string>& fields,
-  std::set<std::string>& all_fields ) const
+( std::size_t index, item_class::field_index_list& fields,
+  std::vector<bool>& remaining ) const
 {
-  if ( all_fields.find(field_name) != all_fields.end() )
+  if ( remaining[index] )
     {
-      all_fields.erase(field_name);
+      remaining[index] = false;
 
+      const std::set<std::string>& preceding
+        ( m_class->get_field_at(index).get_preceding() );
       std::set<std::string>::const_iterator it;
 
-      for ( it=m_class->get_field(field_name).get_preceding().begin();
-            it!=m_class->get_field(field_name).get_preceding().end(); ++it )
-        insert_field(*it, fields, all_fields);
+      for ( it=preceding.begin(); it!=preceding.end(); ++it )
+        {
+          const std::size_t p( m_class->get_field_index(*it) );
+
+          if ( p != item_class::not_a_field )
+            insert_field(p, fields, remaining);
+        }
 
-      fields.push_back( field_name );
+      fields.push_back( index );
     }
 } // item_instance::insert_field()
 
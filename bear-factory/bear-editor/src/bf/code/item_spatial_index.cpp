@@ -0,0 +1,369 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bf::item_spatial_index class.
+ * \author Julien Jorge
+ */
+#include "bf/item_spatial_index.hpp"
+
+#include <claw/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param lvl The level of the grid.
+ * \param cx The column of the cell.
+ * \param cy The row of the cell.
+ */
+bf::item_spatial_index::cell_key::cell_key
+( unsigned int lvl, long cx, long cy )
+  : level(lvl), x(cx), y(cy)
+{
+
+} // item_spatial_index::cell_key::cell_key()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compare two cells, ordered by level, then by column, then by row.
+ * \param that The cell to compare to.
+ */
+bool bf::item_spatial_index::cell_key::operator<( const cell_key& that ) const
+{
+  if ( level != that.level )
+    return level < that.level;
+  else if ( x != that.x )
+    return x < that.x;
+  else
+    return y < that.y;
+} // item_spatial_index::cell_key::operator<()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param b The box of the item.
+ * \param c The cell in which the item is stored.
+ * \param r The rank of the item in the order of insertion.
+ */
+bf::item_spatial_index::entry::entry
+( const rectangle_type& b, const cell_key& c, std::size_t r )
+  : box(b), cell(c), rank(r)
+{
+
+} // item_spatial_index::entry::entry()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param cell_size The size of the cells of the first level.
+ */
+bf::item_spatial_index::item_spatial_index( coordinate_type cell_size )
+  : m_cell_size(cell_size), m_next_rank(0)
+{
+  CLAW_PRECOND( cell_size > 0 );
+} // item_spatial_index::item_spatial_index()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Insert an item in the index.
+ * \param item The item to insert.
+ * \param box The box of the item.
+ * \remark If the item is already in the index, its box is updated and it
+ *         keeps its rank in the order of insertion.
+ */
+void bf::item_spatial_index::insert
+( item_instance* item, const rectangle_type& box )
+{
+  std::size_t rank( m_next_rank );
+
+  if ( contains(item) )
+    {
+      rank = m_entries.find(item)->second.rank;
+      erase(item);
+    }
+  else
+    ++m_next_rank;
+
+  const cell_key cell( get_cell(box) );
+
+  m_cells[cell].push_back(item);
+  m_entries.insert( entry_map::value_type( item, entry(box, cell, rank) ) );
+
+  if ( m_level_count.size() <= cell.level )
+    m_level_count.resize( cell.level + 1, 0 );
+
+  ++m_level_count[cell.level];
+} // item_spatial_index::insert()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove an item from the index.
+ * \param item The item to remove.
+ */
+void bf::item_spatial_index::erase( item_instance* item )
+{
+  const entry_map::iterator it( m_entries.find(item) );
+
+  if ( it == m_entries.end() )
+    return;
+
+  const cell_key cell( it->second.cell );
+  const cell_map::iterator itc( m_cells.find(cell) );
+
+  CLAW_PRECOND( itc != m_cells.end() );
+
+  item_list& items( itc->second );
+  const item_list::iterator iti( std::find(items.begin(), items.end(), item) );
+
+  CLAW_PRECOND( iti != items.end() );
+
+  *iti = items.back();
+  items.pop_back();
+
+  if ( items.empty() )
+    m_cells.erase(itc);
+
+  --m_level_count[cell.level];
+  m_entries.erase(it);
+} // item_spatial_index::erase()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove all the items from the index.
+ */
+void bf::item_spatial_index::clear()
+{
+  m_cells.clear();
+  m_entries.clear();
+  m_level_count.clear();
+  m_next_rank = 0;
+} // item_spatial_index::clear()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if an item is in the index.
+ * \param item The item to search.
+ */
+bool bf::item_spatial_index::contains( item_instance* item ) const
+{
+  return m_entries.find(item) != m_entries.end();
+} // item_spatial_index::contains()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the box with which an item has been inserted.
+ * \param item The item.
+ * \pre contains(item)
+ */
+const bf::rectangle_type&
+bf::item_spatial_index::get_box( item_instance* item ) const
+{
+  CLAW_PRECOND( contains(item) );
+
+  return m_entries.find(item)->second.box;
+} // item_spatial_index::get_box()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of items in the index.
+ */
+std::size_t bf::item_spatial_index::size() const
+{
+  return m_entries.size();
+} // item_spatial_index::size()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if there is no item in the index.
+ */
+bool bf::item_spatial_index::empty() const
+{
+  return m_entries.empty();
+} // item_spatial_index::empty()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Find the items whose box includes a given point.
+ * \param pos The point.
+ * \param result (out) The items found, in the order of their insertion.
+ */
+void bf::item_spatial_index::find
+( const position_type& pos, item_list& result ) const
+{
+  item_list candidates;
+  find_candidates( rectangle_type(pos, pos), candidates );
+
+  std::size_t n(0);
+
+  for ( std::size_t i=0; i!=candidates.size(); ++i )
+    if ( get_box(candidates[i]).includes(pos) )
+      {
+        candidates[n] = candidates[i];
+        ++n;
+      }
+
+  candidates.resize(n);
+  sort_by_rank( candidates );
+
+  result.insert( result.end(), candidates.begin(), candidates.end() );
+} // item_spatial_index::find()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Find the items whose box intersects a given box.
+ * \param box The box.
+ * \param result (out) The items found, in the order of their insertion.
+ */
+void bf::item_spatial_index::find
+( const rectangle_type& box, item_list& result ) const
+{
+  item_list candidates;
+  find_candidates( box, candidates );
+
+  std::size_t n(0);
+
+  for ( std::size_t i=0; i!=candidates.size(); ++i )
+    if ( box.intersects( get_box(candidates[i]) ) )
+      {
+        candidates[n] = candidates[i];
+        ++n;
+      }
+
+  candidates.resize(n);
+  sort_by_rank( candidates );
+
+  result.insert( result.end(), candidates.begin(), candidates.end() );
+} // item_spatial_index::find()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the cell in which an item is stored.
+ * \param box The box of the item.
+ */
+bf::item_spatial_index::cell_key
+bf::item_spatial_index::get_cell( const rectangle_type& box ) const
+{
+  // The cells are strictly larger than the box such that the box never
+  // reaches the border of the second cell after its own.
+  const coordinate_type box_size( std::max( box.width(), box.height() ) );
+  unsigned int level(0);
+  coordinate_type cell_size( m_cell_size );
+
+  while ( (box_size >= cell_size) && (level != 64) )
+    {
+      cell_size *= 2;
+      ++level;
+    }
+
+  return cell_key
+    ( level, get_column( box.left(), cell_size ),
+      get_column( box.bottom(), cell_size ) );
+} // item_spatial_index::get_cell()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the size of the cells of a given level.
+ * \param level The level of the grid.
+ */
+bf::coordinate_type
+bf::item_spatial_index::get_cell_size( unsigned int level ) const
+{
+  return std::ldexp( m_cell_size, level );
+} // item_spatial_index::get_cell_size()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the index of the column containing a coordinate.
+ * \param x The coordinate.
+ * \param cell_size The size of the cells.
+ */
+long bf::item_spatial_index::get_column
+( coordinate_type x, coordinate_type cell_size )
+{
+  return (long)std::floor( x / cell_size );
+} // item_spatial_index::get_column()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Find the items stored in the cells that may contain a box
+ *        intersecting a given box.
+ * \param box The box.
+ * \param result (out) The items found.
+ */
+void bf::item_spatial_index::find_candidates
+( const rectangle_type& box, item_list& result ) const
+{
+  for ( unsigned int level=0; level!=m_level_count.size(); ++level )
+    if ( m_level_count[level] != 0 )
+      {
+        const coordinate_type cell_size( get_cell_size(level) );
+
+        // The items of a cell overlap the next cell on each axis.
+        find_in_cells
+          ( level, get_column( box.left(), cell_size ) - 1,
+            get_column( box.bottom(), cell_size ) - 1,
+            get_column( box.right(), cell_size ),
+            get_column( box.top(), cell_size ), result );
+      }
+} // item_spatial_index::find_candidates()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Sort some items of the index in the order of their insertion.
+ * \param items The items to sort.
+ */
+void bf::item_spatial_index::sort_by_rank( item_list& items ) const
+{
+  std::vector< std::pair<std::size_t, item_instance*> > ranked;
+  ranked.reserve( items.size() );
+
+  for ( std::size_t i=0; i!=items.size(); ++i )
+    ranked.push_back
+      ( std::make_pair( m_entries.find(items[i])->second.rank, items[i] ) );
+
+  std::sort( ranked.begin(), ranked.end() );
+
+  for ( std::size_t i=0; i!=ranked.size(); ++i )
+    items[i] = ranked[i].second;
+} // item_spatial_index::sort_by_rank()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Find the items stored in a range of cells of a given level.
+ * \param level The level of the grid.
+ * \param min_x The first column of the range.
+ * \param min_y The first row of the range.
+ * \param max_x The last column of the range.
+ * \param max_y The last row of the range.
+ * \param result (out) The items found.
+ */
+void bf::item_spatial_index::find_in_cells
+( unsigned int level, long min_x, long min_y, long max_x, long max_y,
+  item_list& result ) const
+{
+  cell_map::const_iterator it
+    ( m_cells.lower_bound( cell_key(level, min_x, min_y) ) );
+
+  // Only the non empty cells are visited, jumping over the rows out of the
+  // range.
+  while ( (it != m_cells.end()) && (it->first.level == level)
+          && (it->first.x <= max_x) )
+    if ( it->first.y < min_y )
+      it = m_cells.lower_bound( cell_key(level, it->first.x, min_y) );
+    else if ( it->first.y > max_y )
+      it = m_cells.lower_bound( cell_key(level, it->first.x + 1, min_y) );
+    else
+      {
+        result.insert( result.end(), it->second.begin(), it->second.end() );
+        ++it;
+      }
+} // item_spatial_index::find_in_cells()
@@ -0,0 +1,291 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bf::opaque_rectangle_cache class.
+ * \author Julien Jorge
+ */
+#include "bf/opaque_rectangle_cache.hpp"
+
+#include "bf/path_configuration.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <boost/filesystem/operations.hpp>
+#include <claw/logger.hpp>
+
+/*----------------------------------------------------------------------------*/
+const std::string
+bf::opaque_rectangle_cache::s_file_header( "bear-factory opaque-rectangles 2" );
+
+const std::time_t bf::opaque_rectangle_cache::s_max_age( 60 * 24 * 60 * 60 );
+const std::time_t bf::opaque_rectangle_cache::s_use_resolution( 24 * 60 * 60 );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param workspace_name The name of the workspace whose rectangles are cached.
+ */
+bf::opaque_rectangle_cache::opaque_rectangle_cache
+( const std::string& workspace_name )
+  : m_workspace_name(workspace_name), m_modified(false)
+{
+
+} // opaque_rectangle_cache::opaque_rectangle_cache()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Load the entries saved by a previous compilation. The entries
+ *        currently in the cache are replaced.
+ */
+void bf::opaque_rectangle_cache::load()
+{
+  m_rectangles.clear();
+  m_modified = false;
+
+  read_file( get_cache_file_path(), m_rectangles );
+} // opaque_rectangle_cache::load()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Save the entries in the cache file, if they have changed since the
+ *        last load or save.
+ *
+ * The entries added in the file by other compilations since the load are
+ * kept, and the entries unused for s_max_age seconds are dropped. The entries
+ * are written in a temporary file whose name is unique to this process, which
+ * is then renamed, such that a concurrent compilation never reads a partially
+ * written file. Two compilations saving at the very same time may still lose
+ * the new entries of one of them, which will be computed again.
+ */
+void bf::opaque_rectangle_cache::save() const
+{
+  if ( !m_modified
+       || !path_configuration::get_instance().create_config_directory() )
+    return;
+
+  const std::string path( get_cache_file_path() );
+
+  rectangle_map entries;
+  read_file( path, entries );
+
+  for ( rectangle_map::const_iterator it=m_rectangles.begin();
+        it!=m_rectangles.end(); ++it )
+    merge_entry( entries, it->first, it->second );
+
+  const std::time_t now( std::time(NULL) );
+  std::size_t dropped(0);
+
+  for ( rectangle_map::iterator it=entries.begin(); it!=entries.end(); )
+    if ( now - it->second.last_use > s_max_age )
+      {
+        entries.erase(it++);
+        ++dropped;
+      }
+    else
+      ++it;
+
+  if ( dropped != 0 )
+    claw::logger << claw::log_verbose << "Dropping " << dropped
+                 << " unused opaque rectangles from the cache." << std::endl;
+
+  boost::system::error_code error;
+  const std::string temporary_path
+    ( boost::filesystem::unique_path( path + ".%%%%-%%%%-%%%%.tmp", error )
+      .string() );
+
+  if ( error )
+    {
+      claw::logger << claw::log_warning << "Can't write the cache file '"
+                   << path << "': " << error.message() << std::endl;
+      return;
+    }
+
+  {
+    std::ofstream f( temporary_path.c_str() );
+
+    f << s_file_header << '\n';
+
+    for ( rectangle_map::const_iterator it=entries.begin();
+          it!=entries.end(); ++it )
+      f << it->first << ' ' << it->second.box.left() << ' '
+        << it->second.box.bottom() << ' ' << it->second.box.right() << ' '
+        << it->second.box.top() << ' ' << it->second.last_use << '\n';
+
+    if ( !f )
+      {
+        claw::logger << claw::log_warning << "Can't write the cache file '"
+                     << temporary_path << "'." << std::endl;
+        f.close();
+        boost::filesystem::remove( temporary_path, error );
+        return;
+      }
+  }
+
+  boost::filesystem::rename( temporary_path, path, error );
+
+  if ( error )
+    {
+      claw::logger << claw::log_warning << "Can't write the cache file '"
+                   << path << "': " << error.message() << std::endl;
+      boost::filesystem::remove( temporary_path, error );
+    }
+  else
+    m_modified = false;
+} // opaque_rectangle_cache::save()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Search the opaque rectangle of a sprite in the cache.
+ * \param image_path The full path to the image of the sprite.
+ * \param clip The clip rectangle of the sprite.
+ * \param algorithm The signature of the algorithm used to compute the opaque
+ *        rectangle.
+ * \param result (out) The opaque rectangle, if found.
+ * \return true if the rectangle has been found.
+ */
+bool bf::opaque_rectangle_cache::find
+( const std::string& image_path, const clip_rectangle& clip,
+  const std::string& algorithm, rectangle& result )
+{
+  const std::string key( make_key(image_path, clip, algorithm) );
+
+  if ( key.empty() )
+    return false;
+
+  const rectangle_map::iterator it( m_rectangles.find(key) );
+
+  if ( it == m_rectangles.end() )
+    return false;
+
+  const std::time_t now( std::time(NULL) );
+
+  if ( now - it->second.last_use > s_use_resolution )
+    {
+      it->second.last_use = now;
+      m_modified = true;
+    }
+
+  result = it->second.box;
+  return true;
+} // opaque_rectangle_cache::find()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Insert the opaque rectangle of a sprite in the cache.
+ * \param image_path The full path to the image of the sprite.
+ * \param clip The clip rectangle of the sprite.
+ * \param algorithm The signature of the algorithm used to compute the opaque
+ *        rectangle.
+ * \param r The opaque rectangle.
+ */
+void bf::opaque_rectangle_cache::insert
+( const std::string& image_path, const clip_rectangle& clip,
+  const std::string& algorithm, const rectangle& r )
+{
+  const std::string key( make_key(image_path, clip, algorithm) );
+
+  if ( !key.empty() )
+    {
+      entry& e( m_rectangles[key] );
+      e.box = r;
+      e.last_use = std::time(NULL);
+      m_modified = true;
+    }
+} // opaque_rectangle_cache::insert()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the entries of a cache file and merge them with some entries.
+ * \param path The path to the cache file.
+ * \param entries (in/out) The entries to which the entries of the file are
+ *        added.
+ */
+void bf::opaque_rectangle_cache::read_file
+( const std::string& path, rectangle_map& entries )
+{
+  std::ifstream f( path.c_str() );
+  std::string line;
+
+  if ( !std::getline(f, line) || (line != s_file_header) )
+    return;
+
+  while ( std::getline(f, line) )
+    {
+      std::istringstream iss(line);
+      std::string key;
+      unsigned int left, bottom, right, top;
+      entry e;
+
+      if ( iss >> key >> left >> bottom >> right >> top >> e.last_use )
+        {
+          e.box = rectangle(left, bottom, right, top);
+          merge_entry( entries, key, e );
+        }
+    }
+} // opaque_rectangle_cache::read_file()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add an entry in a set of entries. If the key is already there, the
+ *        most recent date of use is kept.
+ * \param entries The entries in which the entry is added.
+ * \param key The key of the entry.
+ * \param e The entry to add.
+ */
+void bf::opaque_rectangle_cache::merge_entry
+( rectangle_map& entries, const std::string& key, const entry& e )
+{
+  const rectangle_map::iterator it( entries.find(key) );
+
+  if ( it == entries.end() )
+    entries[key] = e;
+  else if ( it->second.last_use < e.last_use )
+    it->second = e;
+} // opaque_rectangle_cache::merge_entry()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the path to the file in which the cache is saved.
+ */
+std::string bf::opaque_rectangle_cache::get_cache_file_path() const
+{
+  std::string name( m_workspace_name );
+  std::replace( name.begin(), name.end(), '/', '_' );
+
+  return path_configuration::get_instance().get_config_directory()
+    + "opaque-rectangles-" + name;
+} // opaque_rectangle_cache::get_cache_file_path()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Build the key of an entry of the cache.
+ * \param image_path The full path to the image of the sprite.
+ * \param clip The clip rectangle of the sprite.
+ * \param algorithm The signature of the algorithm used to compute the opaque
+ *        rectangle.
+ * \return The key or an empty string if the image can't be read.
+ */
+std::string bf::opaque_rectangle_cache::make_key
+( const std::string& image_path, const clip_rectangle& clip,
+  const std::string& algorithm )
+{
+  const std::string hash( m_image_hash.get_hash(image_path) );
+
+  if ( hash.empty() )
+    return hash;
+
+  std::ostringstream oss;
+  oss << hash << '|' << clip.position.x << '|' << clip.position.y << '|'
+      << clip.width << '|' << clip.height << '|' << algorithm;
+
+  return oss.str();
+} // opaque_rectangle_cache::make_key()
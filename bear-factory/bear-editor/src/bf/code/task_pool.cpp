@@ -0,0 +1,147 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bf::task_pool class.
+ * \author Julien Jorge
+ */
+#include "bf/task_pool.hpp"
+
+#include <claw/exception.hpp>
+
+#include <algorithm>
+
+#include <boost/bind.hpp>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param thread_count The number of threads executing the tasks.
+ * \param max_pending The maximum number of tasks waiting to be executed.
+ */
+bf::task_pool::task_pool( unsigned int thread_count, std::size_t max_pending )
+  : m_max_pending( std::max<std::size_t>(1, max_pending) ), m_running(0),
+    m_stop(false)
+{
+  for ( unsigned int i=0; i!=thread_count; ++i )
+    m_threads.create_thread( boost::bind( &task_pool::run, this ) );
+} // task_pool::task_pool()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor. The pending tasks are executed before the destruction.
+ */
+bf::task_pool::~task_pool()
+{
+  {
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_stop = true;
+  }
+
+  m_task_pushed.notify_all();
+  m_threads.join_all();
+} // task_pool::~task_pool()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add a task to execute. The call blocks while there are too many tasks
+ *        waiting to be executed, unless it is done by a task of the pool.
+ * \param t The task to execute.
+ */
+void bf::task_pool::push( const task_type& t )
+{
+  if ( m_threads.size() == 0 )
+    {
+      execute(t);
+      return;
+    }
+
+  // A task waiting for room in the queue would wait for the other tasks,
+  // which may wait for it too.
+  const bool from_task( m_threads.is_this_thread_in() );
+
+  {
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    while ( !from_task && (m_tasks.size() >= m_max_pending) )
+      m_task_done.wait(lock);
+
+    m_tasks.push_back(t);
+  }
+
+  m_task_pushed.notify_one();
+} // task_pool::push()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Wait until all the tasks are done.
+ *
+ * If a task has thrown an exception, a claw::exception is thrown with the
+ * same message.
+ */
+void bf::task_pool::wait()
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+
+  while ( !m_tasks.empty() || (m_running != 0) )
+    m_task_done.wait(lock);
+
+  if ( !m_error.empty() )
+    {
+      const std::string error(m_error);
+      m_error.clear();
+      throw claw::exception(error);
+    }
+} // task_pool::wait()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief The procedure executed by the threads of the pool.
+ */
+void bf::task_pool::run()
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+
+  while ( !m_stop || !m_tasks.empty() )
+    if ( m_tasks.empty() )
+      m_task_pushed.wait(lock);
+    else
+      {
+        const task_type t( m_tasks.front() );
+        m_tasks.pop_front();
+        ++m_running;
+
+        lock.unlock();
+        execute(t);
+        lock.lock();
+
+        --m_running;
+        m_task_done.notify_all();
+      }
+} // task_pool::run()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Execute a task and keep the message of the exception it may throw.
+ * \param t The task to execute.
+ */
+void bf::task_pool::execute( const task_type& t )
+{
+  try
+    {
+      t();
+    }
+  catch( std::exception& e )
+    {
+      boost::mutex::scoped_lock lock(m_mutex);
+
+      if ( m_error.empty() )
+        m_error = e.what();
+    }
+} // task_pool::execute()
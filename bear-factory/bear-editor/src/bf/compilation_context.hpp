@@ -15,16 +15,22 @@
 #ifndef __BF_COMPILATION_CONTEXT_HPP__
 #define __BF_COMPILATION_CONTEXT_HPP__
 
+#include "bf/opaque_rectangle_cache.hpp"
 #include "bf/sprite_image_cache.hpp"
 #include "bf/libeditor_export.hpp"
 
 #include <map>
+#include <set>
 #include <string>
+#include <vector>
 
 #include <claw/rectangle.hpp>
 
+#include <boost/shared_ptr.hpp>
+
 namespace bf
 {
+  class item_class;
   class sprite;
   class workspace_environment;
 
@@ -39,11 +45,28 @@ namespace bf
     /** \brief The type of the opaque rectangles. */
     typedef claw::math::box_2d<unsigned int> rectangle;
 
+    /**
+     * \brief The algorithms available to compute the opaque rectangles.
+     */
+    enum opaque_rectangle_algorithm
+    {
+      /** \brief The branch and bound search of ler_solver. */
+      branch_and_bound_algorithm,
+
+      /** \brief The linear time search of ler_histogram_solver. */
+      histogram_algorithm
+
+    }; // enum opaque_rectangle_algorithm
+
   private:
     /** \brief The type of the structure associating its opaque rectangle to
         each sprite. */
     typedef std::map<sprite, rectangle> opaque_rectangle_map;
 
+    /** \brief The type of the alpha channels shared with the threads computing
+        the opaque rectangles. */
+    typedef boost::shared_ptr< const std::vector<unsigned char> > alpha_channel;
+
     /** \brief The type of the structure associating its the compiled identifier
         to each item identifier. */
     typedef std::map<std::string, unsigned int> identifier_map;
@@ -51,17 +74,53 @@ namespace bf
   public:
     compilation_context
       ( unsigned int optimization_level, workspace_environment& env );
+    compilation_context
+      ( unsigned int optimization_level, workspace_environment& env,
+        opaque_rectangle_algorithm algorithm );
+    ~compilation_context();
+
+    static void set_default_opaque_rectangle_algorithm
+      ( opaque_rectangle_algorithm algorithm );
+    static opaque_rectangle_algorithm get_default_opaque_rectangle_algorithm();
+    static std::string
+      get_algorithm_signature( opaque_rectangle_algorithm algorithm );
 
     rectangle get_opaque_rectangle
       ( const sprite& s, const std::string& image_name );
+    void defer_opaque_rectangles();
+    void compute_deferred_opaque_rectangles( unsigned int jobs );
 
     unsigned int get_compiled_identifier( const std::string& item ) const;
     void set_compiled_identifier( const std::string& item, unsigned int id );
     void clear_compiled_identifiers();
     std::string get_workspace_name() const;
 
+    void add_dependency( const std::string& path );
+    void add_item_class_dependency( const item_class& c );
+    const std::set<std::string>& get_dependencies() const;
+    void clear_dependencies();
+
   private:
+    bool is_opaque_rectangle_needed( const sprite& s ) const;
+    bool is_opaque_rectangle_computed( const sprite& s ) const;
+    std::string get_image_full_path( const sprite& s ) const;
+    rectangle load_or_compute_opaque_rectangle( const sprite& s );
     rectangle compute_opaque_rectangle( const sprite& s );
+    alpha_channel
+      get_alpha_channel
+      ( const sprite& s, unsigned int& width, unsigned int& height );
+    std::string get_algorithm_signature() const;
+
+    static void compute_opaque_rectangle_task
+      ( alpha_channel alpha, unsigned int width, unsigned int height,
+        opaque_rectangle_algorithm algorithm, rectangle* result );
+    static rectangle compute_opaque_rectangle
+      ( const unsigned char* alpha, unsigned int width, unsigned int height,
+        opaque_rectangle_algorithm algorithm );
+    static rectangle compute_opaque_rectangle_branch_and_bound
+      ( const unsigned char* alpha, unsigned int width, unsigned int height );
+    static rectangle compute_opaque_rectangle_histogram
+      ( const unsigned char* alpha, unsigned int width, unsigned int height );
 
   private:
     /** \brief The sprite image cache stores the images used to compute the
@@ -71,15 +130,38 @@ namespace bf
     /** \brief The opaque rectangle associated with each sprite. */
     opaque_rectangle_map m_opaque_rectangle;
 
+    /** \brief The opaque rectangles computed during the previous
+        compilations. */
+    opaque_rectangle_cache m_opaque_rectangle_cache;
+
+    /** \brief Tell if the computation of the opaque rectangles is deferred to
+        the next call to compute_deferred_opaque_rectangles(). */
+    bool m_defer_opaque_rectangles;
+
+    /** \brief The sprites whose opaque rectangle has been requested while the
+        computation was deferred. */
+    std::set<sprite> m_deferred_opaque_rectangles;
+
     /** \brief The compiled identifier associated with each item identifier. */
     identifier_map m_identifier;
 
+    /** \brief The paths of the files used by the resources compiled since the
+        last call to clear_dependencies(). */
+    std::set<std::string> m_dependencies;
+
     /** \brief The optimisation level during the compilation. */
     unsigned int m_optimization_level;
 
+    /** \brief The algorithm used to compute the opaque rectangles. */
+    opaque_rectangle_algorithm m_opaque_rectangle_algorithm;
+
     /** \brief The workspace environment to use. */
     workspace_environment& m_workspace;
 
+    /** \brief The algorithm used to compute the opaque rectangles when the
+        constructor does not receive one. */
+    static opaque_rectangle_algorithm s_default_opaque_rectangle_algorithm;
+
   }; // class compilation_context
 } // namespace bf
 
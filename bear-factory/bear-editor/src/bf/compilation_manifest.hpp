@@ -0,0 +1,69 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The list of the files used to build a compiled file.
+ * \author Julien Jorge
+ */
+#ifndef __BF_COMPILATION_MANIFEST_HPP__
+#define __BF_COMPILATION_MANIFEST_HPP__
+
+#include "bf/libeditor_export.hpp"
+
+#include <map>
+#include <set>
+#include <string>
+
+namespace bf
+{
+  class file_hash;
+
+  /**
+   * \brief The list of the files used to build a compiled file, with the hash
+   *        of their content at the time of the compilation.
+   *
+   * The manifest is saved next to the compiled file, in a file with the same
+   * name followed by ".deps". It tells if the compiled file must be built
+   * again, that is if one of its inputs has changed since the compilation.
+   *
+   * \author Julien Jorge
+   */
+  class BEAR_EDITOR_EXPORT compilation_manifest
+  {
+  private:
+    /** \brief The type of the map associating the hash of their content with
+        the paths of the inputs. */
+    typedef std::map<std::string, std::string> hash_map;
+
+  public:
+    explicit compilation_manifest( const std::string& compiled_file_path );
+
+    bool is_up_to_date
+    ( const std::string& signature, file_hash& hashes,
+      std::string& reason ) const;
+    void save
+    ( const std::string& signature, const std::set<std::string>& inputs,
+      file_hash& hashes ) const;
+    void remove() const;
+
+  private:
+    bool load( std::string& signature, hash_map& inputs ) const;
+    std::string get_manifest_path() const;
+
+  private:
+    /** \brief The path to the compiled file. */
+    const std::string m_compiled_file_path;
+
+    /** \brief The first line of the manifest files. */
+    static const std::string s_file_header;
+
+  }; // class compilation_manifest
+} // namespace bf
+
+#endif // __BF_COMPILATION_MANIFEST_HPP__
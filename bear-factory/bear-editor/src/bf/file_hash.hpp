@@ -0,0 +1,47 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A cache of the hashes of the content of some files.
+ * \author Julien Jorge
+ */
+#ifndef __BF_FILE_HASH_HPP__
+#define __BF_FILE_HASH_HPP__
+
+#include "bf/libeditor_export.hpp"
+
+#include <map>
+#include <string>
+
+namespace bf
+{
+  /**
+   * \brief A cache of the hashes of the content of some files.
+   *
+   * The hash of a file is computed the first time it is requested, then reused
+   * for the next requests.
+   *
+   * \author Julien Jorge
+   */
+  class BEAR_EDITOR_EXPORT file_hash
+  {
+  public:
+    std::string get_hash( const std::string& path );
+
+    static std::string compute_hash( const std::string& path );
+
+  private:
+    /** \brief The hashes already computed, associated with the path of the
+        files. */
+    std::map<std::string, std::string> m_hash;
+
+  }; // class file_hash
+} // namespace bf
+
+#endif // __BF_FILE_HASH_HPP__
@@ -17,6 +17,7 @@
 #include <string>
 #include <map>
 #include <list>
+#include <vector>
 #include <claw/functional.hpp>
 #include <claw/iterator.hpp>
 
@@ -25,12 +26,16 @@
 
 namespace bf
 {
+  class item_class_snapshot;
+
   /**
    * \brief A class that stores the type of the fields of an item class.
    * \author Julien Jorge
    */
   class BEAR_EDITOR_EXPORT item_class
   {
+    friend class item_class_snapshot;
+
   public:
     /** \brief The list of parent classes. */
     typedef std::list<item_class const*> super_class_list;
@@ -55,9 +60,38 @@ namespace bf
       claw::const_dereference<item_class> >
     ::iterator_type const_super_class_iterator;
 
+    /** \brief The indices of some fields in the field table of the class. */
+    typedef std::vector<std::size_t> field_index_list;
+
   private:
     typedef std::map<std::string, std::string> string_map_type;
 
+    /**
+     * \brief A field of the class or of its super classes, as stored in the
+     *        flattened field table.
+     */
+    struct field_entry
+    {
+      /** \brief The name of the field. */
+      std::string name;
+
+      /** \brief The description of the field. */
+      const type_field* field;
+
+      /** \brief The default value of the field in this class. */
+      std::string default_value;
+
+    }; // struct field_entry
+
+    /** \brief The table of all the fields of the class and of its super
+        classes, sorted by name. */
+    typedef std::vector<field_entry> field_table_type;
+
+  public:
+    /** \brief The value returned by get_field_index() for a field that does
+        not exist. */
+    static const std::size_t not_a_field;
+
   public:
     item_class();
     item_class( const item_class& that );
@@ -91,7 +125,11 @@ namespace bf
     bool is_removed_field( const std::string& f ) const;
 
     void get_field_names_in_hierarchy( std::list<std::string>& f ) const;
+    const field_index_list& get_field_indices_in_hierarchy() const;
 
+    std::size_t get_field_count() const;
+    std::size_t get_field_index( const std::string& field_name ) const;
+    const type_field& get_field_at( std::size_t index ) const;
     const type_field& get_field( const std::string& field_name ) const;
     const std::string& get_description() const;
     const std::string& get_url() const;
@@ -107,11 +145,20 @@ namespace bf
 
     bool field_unicity_test(std::string& error_msg) const;
 
+    void resolve_fields() const;
+
   private:
     void clear();
     void copy( const item_class& that );
+    void link_super_classes();
+    void unlink_super_classes();
+    void unlink_sub_classes();
+    void fields_changed();
+    void build_field_table() const;
+    const field_table_type& get_field_table() const;
 
     const type_field* search_field( const std::string& field_name ) const;
+    std::string search_default_value( const std::string& f ) const;
 
     void
     get_removed_fields_names_in_hierarchy( std::list<std::string>& f ) const;
@@ -149,6 +196,22 @@ namespace bf
         class. */
     std::list<std::string> m_removed_fields;
 
+    /** \brief The classes inheriting from this one, whose field tables are
+        built again when this class is modified. */
+    mutable std::list<item_class*> m_sub_classes;
+
+    /** \brief All the fields of the class and of its super classes, sorted by
+        name, with their default values. */
+    mutable field_table_type m_field_table;
+
+    /** \brief The indices in m_field_table of the fields that are not removed
+        by the class or its super classes. */
+    mutable field_index_list m_fields_in_hierarchy;
+
+    /** \brief Tell if m_field_table is up to date with the class and its super
+        classes. */
+    mutable bool m_fields_resolved;
+
   }; // class item_class
 } // namespace bf
 
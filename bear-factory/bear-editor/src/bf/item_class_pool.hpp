@@ -15,11 +15,16 @@
 #define __BF_ITEM_CLASS_POOL_HPP__
 
 #include <boost/filesystem/convenience.hpp>
+#include <boost/shared_ptr.hpp>
 #include <map>
+#include <string>
+#include <vector>
 
 #include "bf/item_class.hpp"
 #include "bf/libeditor_export.hpp"
 
+class wxXmlDocument;
+
 namespace bf
 {
   /**
@@ -36,15 +41,37 @@ namespace bf
         files. */
     struct open_item_class_file
     {
-      open_item_class_file( std::map<std::string, std::string>& c );
+      open_item_class_file( std::vector<std::string>& c );
 
       void operator()( const std::string& path );
 
       /** \brief The files found in the directory. */
-      std::map<std::string, std::string>& class_files;
+      std::vector<std::string>& class_files;
 
     }; // struct open_item_class_file
 
+    /** \brief An item class file whose XML document has been loaded. */
+    struct parsed_file
+    {
+      /** \brief The path to the file. */
+      std::string path;
+
+      /** \brief Tell if the content of the file has been read. */
+      bool read;
+
+      /** \brief The content of the file, dropped once the document is
+          built. */
+      std::string content;
+
+      /** \brief The XML document of the file, NULL if it can't be loaded. */
+      boost::shared_ptr<wxXmlDocument> document;
+
+    }; // struct parsed_file
+
+    /** \brief The map associating the loaded files with the name of the
+        classes they describe. */
+    typedef std::map<std::string, const parsed_file*> parsed_file_map;
+
   public:
     /** \brief Iterator on all the classes. */
     typedef claw::wrapped_iterator
@@ -62,17 +89,22 @@ namespace bf
     bool has_item_class( const std::string& class_name ) const;
     const item_class& get_item_class( const std::string& class_name ) const;
     const item_class* get_item_class_ptr( const std::string& class_name ) const;
+    std::string get_item_class_file( const std::string& class_name ) const;
 
     const_iterator begin() const;
     const_iterator end() const;
 
   private:
     void scan_directory( const std::string& dir_path );
+    void load_files
+    ( const std::vector< std::vector<std::string> >& directories );
+    void load_class( const std::string& name, parsed_file_map& files );
 
-    void load_class
-    ( const std::string& name, std::map<std::string, std::string>& files );
+    static void read_file( parsed_file* f );
+    static bool parse_file( parsed_file& f );
 
     void field_unicity_test();
+    void resolve_fields() const;
 
     // not implemented
     item_class_pool& operator=( const item_class_pool& that );
@@ -82,6 +114,9 @@ namespace bf
     /** \brief The item classes. */
     item_class_map m_item_class;
 
+    /** \brief The path to the file describing each item class. */
+    std::map<std::string, std::string> m_item_class_file;
+
   }; // class item_class_pool
 } // namespace bf
 
@@ -0,0 +1,102 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A binary copy of the item classes of a workspace.
+ * \author Julien Jorge
+ */
+#ifndef __BF_ITEM_CLASS_SNAPSHOT_HPP__
+#define __BF_ITEM_CLASS_SNAPSHOT_HPP__
+
+#include "bf/libeditor_export.hpp"
+
+#include <iosfwd>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace bf
+{
+  class item_class;
+  class type_field;
+
+  /**
+   * \brief A binary copy of the item classes of a workspace, saved in the
+   *        configuration directory.
+   *
+   * The snapshot is saved once the item classes have been read from their XML
+   * files. It is used instead of these files as long as the list of the files,
+   * their sizes and their modification dates do not change.
+   *
+   * \author Julien Jorge
+   */
+  class BEAR_EDITOR_EXPORT item_class_snapshot
+  {
+  public:
+    /** \brief The map associating the item classes with their name. */
+    typedef std::map<std::string, item_class*> item_class_map;
+
+    /** \brief The map associating the path of their file with the names of the
+        item classes. */
+    typedef std::map<std::string, std::string> class_file_map;
+
+  private:
+    /** \brief The names of the super classes of each class, and the fields
+        they remove, read in the snapshot. */
+    typedef std::map< std::string, std::list<std::string> > string_list_map;
+
+  public:
+    explicit item_class_snapshot( const std::string& workspace_name );
+
+    bool load
+    ( const std::vector<std::string>& files, item_class_map& classes,
+      class_file_map& class_files ) const;
+    void save
+    ( const std::vector<std::string>& files, const item_class_map& classes,
+      const class_file_map& class_files ) const;
+
+  private:
+    bool read_classes
+    ( std::istream& is, item_class_map& classes,
+      class_file_map& class_files ) const;
+    item_class* read_class
+    ( std::istream& is, std::list<std::string>& super_classes,
+      std::list<std::string>& removed_fields ) const;
+    type_field* read_field( std::istream& is ) const;
+
+    void write_class( std::ostream& os, const item_class& c ) const;
+    void write_field( std::ostream& os, const type_field& f ) const;
+
+    std::string get_signature( const std::vector<std::string>& files ) const;
+    std::string get_snapshot_file_path() const;
+
+    static bool read( std::istream& is, std::string& s );
+    static bool read( std::istream& is, unsigned int& i );
+    static bool read( std::istream& is, int& i );
+    static bool read( std::istream& is, double& d );
+    static bool read( std::istream& is, std::list<std::string>& s );
+
+    static void write( std::ostream& os, const std::string& s );
+    static void write( std::ostream& os, unsigned int i );
+    static void write( std::ostream& os, int i );
+    static void write( std::ostream& os, double d );
+    static void write( std::ostream& os, const std::list<std::string>& s );
+
+  private:
+    /** \brief The name of the workspace whose classes are saved. */
+    const std::string m_workspace_name;
+
+    /** \brief The first bytes of the snapshot files. */
+    static const std::string s_file_header;
+
+  }; // class item_class_snapshot
+} // namespace bf
+
+#endif // __BF_ITEM_CLASS_SNAPSHOT_HPP__
@@ -36,9 +36,12 @@ namespace bf
   {
   public:
     static std::string get_item_class_name( const std::string& file_path );
+    static std::string get_item_class_name( const wxXmlDocument& doc );
 
     item_class* read
     ( const item_class_pool& pool, const std::string& file_path ) const;
+    item_class*
+    read( const item_class_pool& pool, const wxXmlDocument& doc ) const;
 
   private:
     void parse_item_node
@@ -165,6 +165,7 @@ namespace bf
     void delete_value( const type_field& f );
 
     bool has_a_reference_to( const std::string& id ) const;
+    void get_referenced_identifiers( std::set<std::string>& ids ) const;
     void get_item_reference_field_names
       ( std::set<std::string> & item_reference_fields, 
         std::set<std::string> & item_reference_list_fields ) const;
@@ -185,10 +186,10 @@ namespace bf
       ( item_check_result& result, const std::set<std::string>& map_id ) const;
     void check_required_fields( item_check_result& result ) const;
 
-    void sort_fields( std::list<std::string>& fields ) const;
+    void sort_fields( std::vector<std::size_t>& fields ) const;
     void insert_field
-    ( const std::string& field_name, std::list<std::string>& fields,
-      std::set<std::string>& all_fields ) const;
+    ( std::size_t index, std::vector<std::size_t>& fields,
+      std::vector<bool>& remaining ) const;
 
     void compile_field
     ( compiled_file& f, const type_field& field, compilation_context& c ) const;
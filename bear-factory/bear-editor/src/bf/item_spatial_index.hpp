@@ -0,0 +1,137 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A spatial index of the boxes of some items.
+ * \author Julien Jorge
+ */
+#ifndef __BF_ITEM_SPATIAL_INDEX_HPP__
+#define __BF_ITEM_SPATIAL_INDEX_HPP__
+
+#include "bf/types.hpp"
+#include "bf/libeditor_export.hpp"
+
+#include <map>
+#include <vector>
+
+namespace bf
+{
+  class item_instance;
+
+  /**
+   * \brief A spatial index of the boxes of some items.
+   *
+   * The boxes are stored in a hierarchy of grids whose cells are twice as
+   * large at each level. A box is stored in the cell containing its bottom
+   * left corner, at the first level whose cells are larger than the box, so
+   * it overlaps at most four cells of its level. The non empty cells are kept
+   * in an ordered map, thus a point is searched in four cells per level in
+   * use, each cell being found in logarithmic time.
+   *
+   * The index never dereferences the items, it just stores their addresses.
+   * The searches return the items in the order in which they have been
+   * inserted, such that the results do not depend on the addresses of the
+   * items.
+   *
+   * \author Julien Jorge
+   */
+  class BEAR_EDITOR_EXPORT item_spatial_index
+  {
+  public:
+    /** \brief The type of the list of items returned by the searches. */
+    typedef std::vector<item_instance*> item_list;
+
+  private:
+    /** \brief The coordinates of a cell in the hierarchy of grids. */
+    struct cell_key
+    {
+      cell_key( unsigned int lvl, long cx, long cy );
+
+      bool operator<( const cell_key& that ) const;
+
+      /** \brief The level of the grid. */
+      unsigned int level;
+
+      /** \brief The column of the cell. */
+      long x;
+
+      /** \brief The row of the cell. */
+      long y;
+
+    }; // struct cell_key
+
+    /** \brief The position of an item in the index. */
+    struct entry
+    {
+      entry( const rectangle_type& b, const cell_key& c, std::size_t r );
+
+      /** \brief The box of the item. */
+      rectangle_type box;
+
+      /** \brief The cell in which the item is stored. */
+      cell_key cell;
+
+      /** \brief The rank of the item in the order of insertion. */
+      std::size_t rank;
+
+    }; // struct entry
+
+    /** \brief The items stored in each non empty cell. */
+    typedef std::map<cell_key, item_list> cell_map;
+
+    /** \brief The position of each item in the index. */
+    typedef std::map<item_instance*, entry> entry_map;
+
+  public:
+    explicit item_spatial_index( coordinate_type cell_size = 64 );
+
+    void insert( item_instance* item, const rectangle_type& box );
+    void erase( item_instance* item );
+    void clear();
+
+    bool contains( item_instance* item ) const;
+    const rectangle_type& get_box( item_instance* item ) const;
+    std::size_t size() const;
+    bool empty() const;
+
+    void find( const position_type& pos, item_list& result ) const;
+    void find( const rectangle_type& box, item_list& result ) const;
+
+  private:
+    cell_key get_cell( const rectangle_type& box ) const;
+    coordinate_type get_cell_size( unsigned int level ) const;
+
+    static long get_column( coordinate_type x, coordinate_type cell_size );
+
+    void find_candidates( const rectangle_type& box, item_list& result ) const;
+    void sort_by_rank( item_list& items ) const;
+    void find_in_cells
+    ( unsigned int level, long min_x, long min_y, long max_x, long max_y,
+      item_list& result ) const;
+
+  private:
+    /** \brief The size of the cells of the first level. */
+    coordinate_type m_cell_size;
+
+    /** \brief The items stored in each non empty cell. */
+    cell_map m_cells;
+
+    /** \brief The position of each item in the index. */
+    entry_map m_entries;
+
+    /** \brief The number of items stored in each level. */
+    std::vector<std::size_t> m_level_count;
+
+    /** \brief The rank given to the next inserted item. */
+    std::size_t m_next_rank;
+
+  }; // class item_spatial_index
+} // namespace bf
+
+#endif // __BF_ITEM_SPATIAL_INDEX_HPP__
@@ -0,0 +1,148 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the ler_histogram_solver class.
+ * \author Julien Jorge
+ */
+#include "bf/opaque_rectangle/ler_histogram_solver.hpp"
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param alpha The alpha channel of the image, row by row. If this pointer is
+ *        null, the whole image is considered as opaque.
+ * \param width The width of the image.
+ * \param height The height of the image.
+ */
+bf::ler_histogram_solver::ler_histogram_solver
+( const unsigned char* alpha, unsigned int width, unsigned int height )
+  : m_alpha(alpha), m_width(width), m_height(height),
+    m_solution(0, 0, 0, 0), m_solution_area(0)
+{
+
+} // ler_histogram_solver::ler_histogram_solver()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Search the largest opaque rectangle.
+ */
+void bf::ler_histogram_solver::resolve()
+{
+  m_solution = rectangle(0, 0, 0, 0);
+  m_solution_area = 0;
+
+  if ( (m_width == 0) || (m_height == 0) )
+    return;
+
+  if ( m_alpha == NULL )
+    {
+      m_solution =
+        rectangle( point(0, 0), point(m_width - 1, m_height - 1) );
+      m_solution_area = m_width * m_height;
+      return;
+    }
+
+  m_heights.assign( m_width, 0 );
+  m_stack.clear();
+  m_stack.reserve( m_width + 1 );
+
+  for ( unsigned int y=0; y!=m_height; ++y )
+    {
+      update_heights(y);
+      search_in_row(y);
+    }
+} // ler_histogram_solver::resolve()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get if the problem has a solution.
+ */
+bool bf::ler_histogram_solver::is_solved() const
+{
+  return m_solution_area != 0;
+} // ler_histogram_solver::is_solved()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the solution of the problem.
+ */
+const bf::ler_histogram_solver::rectangle&
+bf::ler_histogram_solver::get_solution() const
+{
+  return m_solution;
+} // ler_histogram_solver::get_solution()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Update the height of the opaque columns ending on a given row.
+ * \param y The index of the row.
+ */
+void bf::ler_histogram_solver::update_heights( unsigned int y )
+{
+  const unsigned char* row( m_alpha + y * m_width );
+
+  for ( unsigned int x=0; x!=m_width; ++x )
+    if ( row[x] == 255 )
+      ++m_heights[x];
+    else
+      m_heights[x] = 0;
+} // ler_histogram_solver::update_heights()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Search the largest rectangle whose top is on a given row, using the
+ *        histogram of the heights of the opaque columns.
+ * \param y The index of the row.
+ */
+void bf::ler_histogram_solver::search_in_row( unsigned int y )
+{
+  m_stack.clear();
+
+  for ( unsigned int x=0; x<=m_width; ++x )
+    {
+      const unsigned int h( (x == m_width) ? 0 : m_heights[x] );
+
+      while ( !m_stack.empty() && (m_heights[m_stack.back()] >= h) )
+        {
+          const unsigned int column_height( m_heights[m_stack.back()] );
+          m_stack.pop_back();
+
+          const unsigned int left
+            ( m_stack.empty() ? 0 : m_stack.back() + 1 );
+
+          if ( column_height != 0 )
+            update_solution( left, x - 1, y, column_height );
+        }
+
+      if ( x != m_width )
+        m_stack.push_back(x);
+    }
+} // ler_histogram_solver::search_in_row()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Keep a rectangle as the solution if it is larger than the current
+ *        one.
+ * \param left The index of the leftmost column of the rectangle.
+ * \param right The index of the rightmost column of the rectangle.
+ * \param y The index of the last row of the rectangle.
+ * \param h The number of rows of the rectangle.
+ */
+void bf::ler_histogram_solver::update_solution
+( unsigned int left, unsigned int right, unsigned int y, unsigned int h )
+{
+  const unsigned int area( (right - left + 1) * h );
+
+  if ( area > m_solution_area )
+    {
+      m_solution_area = area;
+      m_solution = rectangle( point(left, y + 1 - h), point(right, y) );
+    }
+} // ler_histogram_solver::update_solution()
@@ -0,0 +1,88 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A linear time solver for the largest opaque rectangle in an alpha
+ *        channel.
+ * \author Julien Jorge
+ */
+#ifndef __BF_LER_HISTOGRAM_SOLVER_HPP__
+#define __BF_LER_HISTOGRAM_SOLVER_HPP__
+
+#include "bf/opaque_rectangle/ler_base_problem.hpp"
+
+#include <vector>
+
+namespace bf
+{
+  /**
+   * \brief A linear time solver for the largest opaque rectangle in an alpha
+   *        channel.
+   *
+   * The rows of the alpha channel are processed one after the other. For each
+   * row we maintain the height of the column of opaque pixels ending on each
+   * pixel of the row, then the largest rectangle under this histogram is found
+   * with a monotonic stack. The whole resolution is done in
+   * O(width * height).
+   *
+   * The coordinates of the solution are expressed in the same system than the
+   * alpha channel, the first row having y = 0.
+   *
+   * \author Julien Jorge
+   */
+  class ler_histogram_solver
+  {
+  public:
+    typedef ler_base_problem::point point;
+
+    typedef ler_base_problem::rectangle rectangle;
+
+  public:
+    ler_histogram_solver
+    ( const unsigned char* alpha, unsigned int width, unsigned int height );
+
+    void resolve();
+    bool is_solved() const;
+    const rectangle& get_solution() const;
+
+  private:
+    void update_heights( unsigned int y );
+    void search_in_row( unsigned int y );
+    void update_solution
+    ( unsigned int left, unsigned int right, unsigned int y, unsigned int h );
+
+  private:
+    /** \brief The alpha channel, row by row. A null pointer means that every
+        pixel is opaque. */
+    const unsigned char* m_alpha;
+
+    /** \brief The width of the alpha channel. */
+    const unsigned int m_width;
+
+    /** \brief The height of the alpha channel. */
+    const unsigned int m_height;
+
+    /** \brief For each column, the number of consecutive opaque pixels ending
+        on the current row. */
+    std::vector<unsigned int> m_heights;
+
+    /** \brief The indices of the columns of increasing heights, used to find
+        the largest rectangle in a row. */
+    std::vector<unsigned int> m_stack;
+
+    /** \brief The solution. */
+    rectangle m_solution;
+
+    /** \brief The area of the solution. */
+    unsigned int m_solution_area;
+
+  }; // ler_histogram_solver
+} // namespace bf
+
+#endif // __BF_LER_HISTOGRAM_SOLVER_HPP__
@@ -0,0 +1,119 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A persistent cache of the opaque rectangles computed for the sprites.
+ * \author Julien Jorge
+ */
+#ifndef __BF_OPAQUE_RECTANGLE_CACHE_HPP__
+#define __BF_OPAQUE_RECTANGLE_CACHE_HPP__
+
+#include "bf/file_hash.hpp"
+#include "bf/libeditor_export.hpp"
+
+#include <ctime>
+#include <map>
+#include <string>
+
+#include <claw/rectangle.hpp>
+
+namespace bf
+{
+  /**
+   * \brief A persistent cache of the opaque rectangles computed for the
+   *        sprites.
+   *
+   * The entries are identified by the hash of the content of the image, the
+   * clip rectangle of the sprite and the signature of the algorithm used to
+   * compute the rectangle. Thus an entry stays valid as long as the image does
+   * not change, whatever its path is.
+   *
+   * Each entry remembers the date of its last use. The entries which have not
+   * been used for a while, like those of the images which have been modified
+   * or removed, are dropped when the cache is saved.
+   *
+   * \author Julien Jorge
+   */
+  class BEAR_EDITOR_EXPORT opaque_rectangle_cache
+  {
+  public:
+    /** \brief The type of the opaque rectangles. */
+    typedef claw::math::box_2d<unsigned int> rectangle;
+
+    /** \brief The type of the clip rectangles of the sprites. */
+    typedef claw::math::rectangle<unsigned int> clip_rectangle;
+
+  private:
+    /** \brief An entry of the cache. */
+    struct entry
+    {
+      /** \brief The opaque rectangle. */
+      rectangle box;
+
+      /** \brief The date of the last use of the entry. */
+      std::time_t last_use;
+
+    }; // struct entry
+
+    /** \brief The type of the map associating the entries with their keys. */
+    typedef std::map<std::string, entry> rectangle_map;
+
+  public:
+    explicit opaque_rectangle_cache( const std::string& workspace_name );
+
+    void load();
+    void save() const;
+
+    bool find
+    ( const std::string& image_path, const clip_rectangle& clip,
+      const std::string& algorithm, rectangle& result );
+    void insert
+    ( const std::string& image_path, const clip_rectangle& clip,
+      const std::string& algorithm, const rectangle& r );
+
+  private:
+    static void read_file( const std::string& path, rectangle_map& entries );
+    static void merge_entry
+    ( rectangle_map& entries, const std::string& key, const entry& e );
+
+    std::string get_cache_file_path() const;
+    std::string make_key
+    ( const std::string& image_path, const clip_rectangle& clip,
+      const std::string& algorithm );
+
+  private:
+    /** \brief The name of the workspace whose rectangles are cached. */
+    const std::string m_workspace_name;
+
+    /** \brief The rectangles in the cache. */
+    rectangle_map m_rectangles;
+
+    /** \brief The hashes of the images. */
+    file_hash m_image_hash;
+
+    /** \brief Tell if some entries have been inserted since the last load or
+        save. */
+    mutable bool m_modified;
+
+    /** \brief The first line of the cache files, used to detect the files of
+        a different format. */
+    static const std::string s_file_header;
+
+    /** \brief The duration, in seconds, after which an unused entry is
+        dropped. */
+    static const std::time_t s_max_age;
+
+    /** \brief The duration, in seconds, after which the date of the last use
+        of an entry is updated in the file. */
+    static const std::time_t s_use_resolution;
+
+  }; // class opaque_rectangle_cache
+} // namespace bf
+
+#endif // __BF_OPAQUE_RECTANGLE_CACHE_HPP__
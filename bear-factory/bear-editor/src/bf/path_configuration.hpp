@@ -84,10 +84,11 @@ namespace bf
     const workspaces_map& get_workspaces() const;
     std::string search_workspace( const std::string& path ) const;
 
+    bool create_config_directory() const;
+
   private:
     void load();
 
-    bool create_config_directory() const;
     bool create_config_file() const;
 
     bool find_random_file_name
@@ -0,0 +1,93 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A pool of threads executing some tasks.
+ * \author Julien Jorge
+ */
+#ifndef __BF_TASK_POOL_HPP__
+#define __BF_TASK_POOL_HPP__
+
+#include "bf/libeditor_export.hpp"
+
+#include <deque>
+#include <string>
+
+#include <boost/function.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/utility.hpp>
+
+namespace bf
+{
+  /**
+   * \brief A pool of threads executing some tasks.
+   *
+   * The tasks are executed in an unspecified order. The number of tasks waiting
+   * to be executed is bounded, such that the producer of the tasks is blocked
+   * while the workers are late. The tasks pushed by the tasks of the pool are
+   * never blocked, thus the tasks pushing other tasks must bound the resources
+   * they use by themselves.
+   *
+   * When the pool has no thread, the tasks are executed immediately by
+   * push().
+   *
+   * \author Julien Jorge
+   */
+  class BEAR_EDITOR_EXPORT task_pool:
+    public boost::noncopyable
+  {
+  public:
+    /** \brief The type of the tasks executed by the pool. */
+    typedef boost::function<void ()> task_type;
+
+  public:
+    task_pool( unsigned int thread_count, std::size_t max_pending );
+    ~task_pool();
+
+    void push( const task_type& t );
+    void wait();
+
+  private:
+    void run();
+    void execute( const task_type& t );
+
+  private:
+    /** \brief The threads executing the tasks. */
+    boost::thread_group m_threads;
+
+    /** \brief The mutex protecting the access to the members of the pool. */
+    boost::mutex m_mutex;
+
+    /** \brief Notified when a task is added or when the pool is stopped. */
+    boost::condition_variable m_task_pushed;
+
+    /** \brief Notified when a task is done. */
+    boost::condition_variable m_task_done;
+
+    /** \brief The tasks waiting to be executed. */
+    std::deque<task_type> m_tasks;
+
+    /** \brief The maximum number of tasks waiting to be executed. */
+    const std::size_t m_max_pending;
+
+    /** \brief The number of tasks being executed. */
+    std::size_t m_running;
+
+    /** \brief Tells the threads to stop once the tasks are done. */
+    bool m_stop;
+
+    /** \brief The message of the first exception thrown by a task. */
+    std::string m_error;
+
+  }; // class task_pool
+} // namespace bf
+
+#endif // __BF_TASK_POOL_HPP__
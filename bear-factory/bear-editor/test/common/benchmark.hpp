@@ -0,0 +1,59 @@
+/**
+ * \file
+ *
+ * The tools shared by the tests generating their data and timing the
+ * algorithms.
+ */
+#ifndef __TEST_BENCHMARK_HPP__
+#define __TEST_BENCHMARK_HPP__
+
+#include <chrono>
+
+namespace test
+{
+  /**
+   * A linear congruential generator, such that the generated data is the same
+   * on every platform.
+   */
+  inline unsigned int next_random( unsigned int& seed )
+  {
+    seed = seed * 1103515245 + 12345;
+    return (seed / 65536) % 32768;
+  }
+
+  /**
+   * Measures the time spent in consecutive steps.
+   */
+  class stopwatch
+  {
+  public:
+    typedef std::chrono::steady_clock clock_type;
+
+  public:
+    stopwatch()
+      : m_last( clock_type::now() )
+    {
+
+    }
+
+    /**
+     * Gets the time elapsed since the construction or the previous call, in
+     * the unit of Duration.
+     */
+    template<typename Duration>
+    typename Duration::rep lap()
+    {
+      const clock_type::time_point now( clock_type::now() );
+      const clock_type::duration result( now - m_last );
+
+      m_last = now;
+
+      return std::chrono::duration_cast<Duration>( result ).count();
+    }
+
+  private:
+    clock_type::time_point m_last;
+  };
+}
+
+#endif // __TEST_BENCHMARK_HPP__
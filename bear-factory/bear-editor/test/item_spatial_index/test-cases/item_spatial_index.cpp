@@ -0,0 +1,274 @@
+#include "benchmark.hpp"
+
+#include "bf/item_spatial_index.hpp"
+
+#define BOOST_TEST_MODULE bf::item_spatial_index
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace test
+{
+  /**
+   * A generated level: the items are never dereferenced by the index, so
+   * their addresses are taken in a buffer.
+   */
+  struct level
+  {
+    std::vector<char> storage;
+    std::vector<bf::rectangle_type> boxes;
+
+    bf::item_instance* item( std::size_t i ) const
+    {
+      return reinterpret_cast<bf::item_instance*>
+        ( const_cast<char*>( &storage[i] ) );
+    }
+  };
+
+  static double random_coordinate( unsigned int& seed, double size )
+  {
+    return (double)next_random(seed) / 32767 * size - size / 8;
+  }
+
+  static bf::rectangle_type random_box
+  ( unsigned int& seed, double level_size, double max_item_size )
+  {
+    const double x( random_coordinate( seed, level_size ) );
+    const double y( random_coordinate( seed, level_size ) );
+    double w( (double)next_random(seed) / 32767 * max_item_size );
+    double h( (double)next_random(seed) / 32767 * max_item_size );
+
+    // some items are huge and some have no size
+    if ( next_random(seed) % 50 == 0 )
+      w *= 40;
+
+    if ( next_random(seed) % 10 == 0 )
+      h = 0;
+
+    return bf::rectangle_type( x, y, x + w, y + h );
+  }
+
+  static level generate_level
+  ( std::size_t count, double level_size, unsigned int seed )
+  {
+    level result;
+    result.storage.resize( count );
+
+    for ( std::size_t i=0; i!=count; ++i )
+      result.boxes.push_back( random_box( seed, level_size, 300 ) );
+
+    return result;
+  }
+
+  static void fill( const level& lvl, bf::item_spatial_index& index )
+  {
+    for ( std::size_t i=0; i!=lvl.boxes.size(); ++i )
+      index.insert( lvl.item( i ), lvl.boxes[i] );
+  }
+
+  static bf::item_spatial_index::item_list
+  scan( const level& lvl, const bf::position_type& pos )
+  {
+    bf::item_spatial_index::item_list result;
+
+    for ( std::size_t i=0; i!=lvl.boxes.size(); ++i )
+      if ( lvl.boxes[i].includes(pos) )
+        result.push_back( lvl.item(i) );
+
+    return result;
+  }
+
+  static bf::item_spatial_index::item_list
+  scan( const level& lvl, const bf::rectangle_type& box )
+  {
+    bf::item_spatial_index::item_list result;
+
+    for ( std::size_t i=0; i!=lvl.boxes.size(); ++i )
+      if ( box.intersects( lvl.boxes[i] ) )
+        result.push_back( lvl.item(i) );
+
+    return result;
+  }
+
+  static void check_same_results
+  ( const level& lvl, const bf::item_spatial_index& index, unsigned int seed )
+  {
+    for ( unsigned int i=0; i!=500; ++i )
+      {
+        const bf::position_type pos
+          ( random_coordinate( seed, 10000 ),
+            random_coordinate( seed, 10000 ) );
+
+        bf::item_spatial_index::item_list found;
+        index.find( pos, found );
+
+        const bf::item_spatial_index::item_list expected( scan( lvl, pos ) );
+        BOOST_CHECK( found == expected );
+      }
+
+    for ( unsigned int i=0; i!=200; ++i )
+      {
+        const bf::rectangle_type box( random_box( seed, 10000, 2000 ) );
+
+        bf::item_spatial_index::item_list found;
+        index.find( box, found );
+
+        const bf::item_spatial_index::item_list expected( scan( lvl, box ) );
+        BOOST_CHECK( found == expected );
+      }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( empty_index )
+{
+  const bf::item_spatial_index index;
+  bf::item_spatial_index::item_list found;
+
+  index.find( bf::position_type( 0, 0 ), found );
+  index.find( bf::rectangle_type( -100, -100, 100, 100 ), found );
+
+  BOOST_CHECK( index.empty() );
+  BOOST_CHECK( found.empty() );
+}
+
+BOOST_AUTO_TEST_CASE( border_of_the_cells )
+{
+  const test::level lvl( test::generate_level( 3, 0, 1 ) );
+  bf::item_spatial_index index( 64 );
+
+  // a box as large as a cell, ending on the border of the second cell
+  index.insert( lvl.item(0), bf::rectangle_type( 0, 0, 63.9, 63.9 ) );
+  index.insert( lvl.item(1), bf::rectangle_type( 64, 64, 128, 128 ) );
+  index.insert( lvl.item(2), bf::rectangle_type( -130, -1, -2, -1 ) );
+
+  bf::item_spatial_index::item_list found;
+  index.find( bf::position_type( 128, 128 ), found );
+  BOOST_REQUIRE_EQUAL( found.size(), 1 );
+  BOOST_CHECK( found[0] == lvl.item(1) );
+
+  found.clear();
+  index.find( bf::position_type( -2, -1 ), found );
+  BOOST_REQUIRE_EQUAL( found.size(), 1 );
+  BOOST_CHECK( found[0] == lvl.item(2) );
+
+  found.clear();
+  index.find( bf::rectangle_type( -2, -1, 0, 0 ), found );
+  BOOST_CHECK_EQUAL( found.size(), 2 );
+}
+
+BOOST_AUTO_TEST_CASE( order_of_insertion )
+{
+  const test::level lvl( test::generate_level( 3, 0, 1 ) );
+  bf::item_spatial_index index;
+
+  // the items are inserted in the reverse order of their addresses
+  index.insert( lvl.item(2), bf::rectangle_type( 0, 0, 10, 10 ) );
+  index.insert( lvl.item(1), bf::rectangle_type( 5, 5, 500, 500 ) );
+  index.insert( lvl.item(0), bf::rectangle_type( 8, 8, 9, 9 ) );
+
+  // moving an item does not change its rank
+  index.insert( lvl.item(2), bf::rectangle_type( 1, 1, 20, 20 ) );
+
+  bf::item_spatial_index::item_list found;
+  index.find( bf::position_type( 8, 8 ), found );
+  BOOST_REQUIRE_EQUAL( found.size(), 3 );
+  BOOST_CHECK( found[0] == lvl.item(2) );
+  BOOST_CHECK( found[1] == lvl.item(1) );
+  BOOST_CHECK( found[2] == lvl.item(0) );
+
+  found.clear();
+  index.find( bf::rectangle_type( 0, 0, 8, 8 ), found );
+  BOOST_REQUIRE_EQUAL( found.size(), 3 );
+  BOOST_CHECK( found[0] == lvl.item(2) );
+  BOOST_CHECK( found[1] == lvl.item(1) );
+  BOOST_CHECK( found[2] == lvl.item(0) );
+}
+
+BOOST_AUTO_TEST_CASE( same_results_as_a_scan )
+{
+  const test::level lvl( test::generate_level( 5000, 10000, 42 ) );
+  bf::item_spatial_index index;
+  test::fill( lvl, index );
+
+  BOOST_CHECK_EQUAL( index.size(), lvl.boxes.size() );
+  test::check_same_results( lvl, index, 7 );
+}
+
+BOOST_AUTO_TEST_CASE( move_and_remove_items )
+{
+  test::level lvl( test::generate_level( 5000, 10000, 42 ) );
+  bf::item_spatial_index index;
+  test::fill( lvl, index );
+
+  unsigned int seed( 13 );
+
+  for ( std::size_t i=0; i<lvl.boxes.size(); i+=3 )
+    {
+      lvl.boxes[i] = test::random_box( seed, 10000, 300 );
+      index.insert( lvl.item(i), lvl.boxes[i] );
+    }
+
+  BOOST_CHECK_EQUAL( index.size(), lvl.boxes.size() );
+
+  // the removed items are moved far away from the searched area in the
+  // reference level.
+  for ( std::size_t i=1; i<lvl.boxes.size(); i+=4 )
+    {
+      lvl.boxes[i] = bf::rectangle_type( 1e9, 1e9, 1e9, 1e9 );
+      index.erase( lvl.item(i) );
+      BOOST_CHECK( !index.contains( lvl.item(i) ) );
+    }
+
+  test::check_same_results( lvl, index, 17 );
+
+  index.clear();
+  BOOST_CHECK( index.empty() );
+}
+
+BOOST_AUTO_TEST_CASE( benchmark )
+{
+  typedef std::chrono::microseconds us;
+  typedef std::chrono::milliseconds ms;
+
+  const test::level lvl( test::generate_level( 50000, 100000, 3 ) );
+  bf::item_spatial_index index;
+
+  test::stopwatch watch;
+  test::fill( lvl, index );
+  const ms::rep fill_time( watch.lap<ms>() );
+
+  unsigned int seed( 5 );
+  std::size_t index_hits(0);
+
+  for ( unsigned int i=0; i!=1000; ++i )
+    {
+      bf::item_spatial_index::item_list found;
+      index.find
+        ( bf::position_type
+          ( test::random_coordinate( seed, 100000 ),
+            test::random_coordinate( seed, 100000 ) ), found );
+      index_hits += found.size();
+    }
+
+  const us::rep index_time( watch.lap<us>() );
+
+  seed = 5;
+  std::size_t scan_hits(0);
+
+  for ( unsigned int i=0; i!=1000; ++i )
+    scan_hits +=
+      test::scan
+      ( lvl,
+        bf::position_type
+        ( test::random_coordinate( seed, 100000 ),
+          test::random_coordinate( seed, 100000 ) ) ).size();
+
+  const us::rep scan_time( watch.lap<us>() );
+
+  BOOST_CHECK_EQUAL( index_hits, scan_hits );
+
+  BOOST_TEST_MESSAGE
+    ( "50000 items, insertion: " << fill_time << " ms; 1000 points, index: "
+      << index_time << " us, scan: " << scan_time << " us" );
+}
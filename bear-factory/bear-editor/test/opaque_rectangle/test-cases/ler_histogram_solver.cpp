@@ -0,0 +1,196 @@
+#include "benchmark.hpp"
+
+#include "bf/opaque_rectangle/ler_histogram_solver.hpp"
+#include "bf/opaque_rectangle/ler_problem.hpp"
+#include "bf/opaque_rectangle/ler_solver.hpp"
+
+#define BOOST_TEST_MODULE bf::ler_histogram_solver
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace test
+{
+  struct mask
+  {
+    unsigned int width;
+    unsigned int height;
+    std::vector<unsigned char> alpha;
+  };
+
+  static mask generate_mask
+  ( unsigned int width, unsigned int height, unsigned int transparency,
+    unsigned int seed )
+  {
+    mask result;
+    result.width = width;
+    result.height = height;
+    result.alpha.resize( width * height );
+
+    for ( std::size_t i=0; i!=result.alpha.size(); ++i )
+      if ( next_random(seed) % 100 < transparency )
+        result.alpha[i] = next_random(seed) % 255;
+      else
+        result.alpha[i] = 255;
+
+    return result;
+  }
+
+  static unsigned int area( const bf::ler_base_problem::rectangle& r )
+  {
+    return (r.width() + 1) * (r.height() + 1);
+  }
+
+  static unsigned int branch_and_bound_area( const mask& m )
+  {
+    bf::ler_problem pb;
+    pb.set_bounding_rectangle
+      ( bf::ler_base_problem::rectangle
+        ( bf::ler_base_problem::point(0, 0),
+          bf::ler_base_problem::point(m.width - 1, m.height - 1) ) );
+
+    for ( unsigned int x=0; x!=m.width; ++x )
+      for ( unsigned int y=0; y!=m.height; ++y )
+        if ( m.alpha[ y * m.width + x ] != 255 )
+          pb.add_forbidden_point( bf::ler_base_problem::point(x, y) );
+
+    bf::ler_solver solver(pb);
+    solver.resolve();
+
+    if ( solver.is_solved() )
+      return area( solver.get_solution() );
+    else
+      return 0;
+  }
+
+  static unsigned int exhaustive_area( const mask& m )
+  {
+    // transparent[y][x] is the number of transparent pixels in [0, x) x [0, y)
+    std::vector< std::vector<unsigned int> > transparent
+      ( m.height + 1, std::vector<unsigned int>( m.width + 1, 0 ) );
+
+    for ( unsigned int y=0; y!=m.height; ++y )
+      for ( unsigned int x=0; x!=m.width; ++x )
+        transparent[y + 1][x + 1] =
+          transparent[y][x + 1] + transparent[y + 1][x] - transparent[y][x]
+          + ( m.alpha[ y * m.width + x ] != 255 ? 1 : 0 );
+
+    unsigned int result(0);
+
+    for ( unsigned int bottom=0; bottom!=m.height; ++bottom )
+      for ( unsigned int top=bottom + 1; top<=m.height; ++top )
+        for ( unsigned int left=0; left!=m.width; ++left )
+          for ( unsigned int right=left + 1; right<=m.width; ++right )
+            if ( transparent[top][right] - transparent[bottom][right]
+                 - transparent[top][left] + transparent[bottom][left] == 0 )
+              result =
+                std::max( result, (top - bottom) * (right - left) );
+
+    return result;
+  }
+
+  static unsigned int histogram_area( const mask& m )
+  {
+    bf::ler_histogram_solver solver( &m.alpha[0], m.width, m.height );
+    solver.resolve();
+
+    if ( solver.is_solved() )
+      return area( solver.get_solution() );
+    else
+      return 0;
+  }
+
+  static bool is_opaque
+  ( const mask& m, const bf::ler_base_problem::rectangle& r )
+  {
+    for ( unsigned int x=r.left(); x<=r.right(); ++x )
+      for ( unsigned int y=r.bottom(); y<=r.top(); ++y )
+        if ( m.alpha[ y * m.width + x ] != 255 )
+          return false;
+
+    return true;
+  }
+}
+
+BOOST_AUTO_TEST_CASE( fully_opaque )
+{
+  const test::mask m( test::generate_mask( 13, 7, 0, 1 ) );
+  bf::ler_histogram_solver solver( &m.alpha[0], m.width, m.height );
+  solver.resolve();
+
+  BOOST_REQUIRE( solver.is_solved() );
+  BOOST_CHECK_EQUAL( solver.get_solution().left(), 0 );
+  BOOST_CHECK_EQUAL( solver.get_solution().bottom(), 0 );
+  BOOST_CHECK_EQUAL( solver.get_solution().right(), 12 );
+  BOOST_CHECK_EQUAL( solver.get_solution().top(), 6 );
+}
+
+BOOST_AUTO_TEST_CASE( fully_transparent )
+{
+  const test::mask m( test::generate_mask( 13, 7, 100, 1 ) );
+  bf::ler_histogram_solver solver( &m.alpha[0], m.width, m.height );
+  solver.resolve();
+
+  BOOST_CHECK( !solver.is_solved() );
+}
+
+BOOST_AUTO_TEST_CASE( no_alpha_channel )
+{
+  bf::ler_histogram_solver solver( NULL, 8, 3 );
+  solver.resolve();
+
+  BOOST_REQUIRE( solver.is_solved() );
+  BOOST_CHECK_EQUAL( test::area( solver.get_solution() ), 24 );
+}
+
+BOOST_AUTO_TEST_CASE( same_area_as_exhaustive_search )
+{
+  unsigned int seed( 42 );
+
+  for ( unsigned int i=0; i!=200; ++i )
+    {
+      const unsigned int width( 1 + test::next_random(seed) % 24 );
+      const unsigned int height( 1 + test::next_random(seed) % 24 );
+      const unsigned int transparency( test::next_random(seed) % 40 );
+
+      const test::mask m
+        ( test::generate_mask
+          ( width, height, transparency, test::next_random(seed) ) );
+
+      bf::ler_histogram_solver solver( &m.alpha[0], m.width, m.height );
+      solver.resolve();
+
+      BOOST_CHECK_EQUAL
+        ( test::histogram_area(m), test::exhaustive_area(m) );
+
+      if ( solver.is_solved() )
+        BOOST_CHECK( test::is_opaque( m, solver.get_solution() ) );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( benchmark )
+{
+  typedef std::chrono::microseconds us;
+  typedef std::chrono::milliseconds ms;
+
+  const test::mask small( test::generate_mask( 64, 64, 5, 7 ) );
+
+  test::stopwatch watch;
+  test::branch_and_bound_area(small);
+  const us::rep bb_time( watch.lap<us>() );
+  const unsigned int h_area( test::histogram_area(small) );
+  const us::rep h_time( watch.lap<us>() );
+
+  BOOST_CHECK_EQUAL( h_area, test::exhaustive_area(small) );
+
+  const test::mask large( test::generate_mask( 2048, 2048, 1, 7 ) );
+
+  watch.lap<us>();
+  test::histogram_area(large);
+  const ms::rep large_time( watch.lap<ms>() );
+
+  BOOST_TEST_MESSAGE
+    ( "64x64, branch and bound: " << bb_time << " us, histogram: " << h_time
+      << " us; 2048x2048, histogram: " << large_time << " ms" );
+}
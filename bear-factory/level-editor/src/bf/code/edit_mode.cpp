@@ -120,25 +120,21 @@ bf::item_instance* bf::edit_mode::first_item
 
   for ( std::size_t i( layers.size() ); i != 0; --i )
     {
-      const layer& the_layer( lvl.get_layer( layers[ i - 1 ] ) );
+      const std::vector<item_instance*> items
+        ( lvl.get_layer( layers[ i - 1 ] ).find_items_at( pos ) );
 
-      for ( layer::item_iterator it( the_layer.item_begin() );
-            it != the_layer.item_end(); ++it )
+      for ( std::size_t j=0; j!=items.size(); ++j )
         {
-          const rectangle_type box( lvl.get_visual_box( *it ) );
+          const rectangle_type box( lvl.get_visual_box( *items[j] ) );
+          const coordinate_type dist =
+            std::max
+            ( std::max( pos.x - box.left(), box.right() - pos.x),
+              std::max( pos.y - box.top(), box.bottom() - pos.y) );
 
-          if ( box.includes(pos) )
+          if ( dist < min_max_dist )
             {
-              const coordinate_type dist =
-                std::max
-                ( std::max( pos.x - box.left(), box.right() - pos.x),
-                  std::max( pos.y - box.top(), box.bottom() - pos.y) );
-
-              if ( dist < min_max_dist )
-                {
-                  result = &(*it);
-                  min_max_dist = dist;
-                }
+              result = items[j];
+              min_max_dist = dist;
             }
         }
     }
@@ -161,15 +157,12 @@ bf::item_instance* bf::edit_mode::first_selected_item
   for ( std::size_t i( layers.size() ); i != 0; --i )
     {
       const item_selection& selection( lvl.get_selection( layers[ i - 1 ] ) );
+      const std::vector<item_instance*> items
+        ( lvl.get_layer( layers[ i - 1 ] ).find_items_at( pos ) );
 
-      for ( item_selection::const_iterator it( selection.begin() );
-            it!=selection.end(); ++it )
-        {
-          const rectangle_type box( lvl.get_visual_box( **it ) ); 
-
-          if ( box.includes( pos ) )
-            return *it;
-        }
+      for ( std::size_t j=0; j!=items.size(); ++j )
+        if ( selection.is_selected( items[j] ) )
+          return items[j];
     }
 
   return NULL;
@@ -190,16 +183,10 @@ bf::edit_mode::find_items_at( const gui_level& lvl, position_type pos ) const
 
   for ( std::size_t i( layers.size() ); i != 0; --i )
     {
-      const layer& the_layer( lvl.get_layer( layers[ i - 1 ] ) );
+      const std::vector<item_instance*> items
+        ( lvl.get_layer( layers[ i - 1 ] ).find_items_at( pos ) );
 
-      for ( layer::item_iterator it( the_layer.item_begin() );
-            it != the_layer.item_end(); ++it )
-        {
-          const rectangle_type box( lvl.get_visual_box( *it ) );
-
-          if ( box.includes( pos ) )
-            result.push_back( &(*it) );
-        }
+      result.insert( result.end(), items.begin(), items.end() );
     }
 
   return result;
@@ -220,12 +207,10 @@ bf::edit_mode::pick_items( const gui_level& lvl, rectangle_type box ) const
 
   for ( std::size_t i( layers.size() ); i != 0; --i )
     {
-      const layer& the_layer( lvl.get_layer( layers[ i - 1 ] ) );
+      const std::vector<item_instance*> items
+        ( lvl.get_layer( layers[ i - 1 ] ).find_items_in( box ) );
 
-      for ( layer::item_iterator it( the_layer.item_begin() );
-            it != the_layer.item_end(); ++it)
-        if ( box.intersects( lvl.get_visual_box( *it ) ) )
-          result.push_back( &(*it) );
+      result.insert( result.end(), items.begin(), items.end() );
     }
 
   return result;
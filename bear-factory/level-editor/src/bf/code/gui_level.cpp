@@ -367,22 +367,5 @@ bool bf::gui_level::check_item_position() const
 bf::rectangle_type
 bf::gui_level::get_visual_box( const item_instance& item ) const
 {
-  double x( item.get_rendering_parameters().get_left() );
-  double y( item.get_rendering_parameters().get_bottom() );
-  double w( item.get_rendering_parameters().get_width() );
-  double h( item.get_rendering_parameters().get_height() );
-
-  if ( w == 0 )
-    {
-      x -= 10;
-      w = 20;
-    }
-
-  if ( h == 0 )
-    {
-      y -= 10;
-      h = 20;
-    }
-
-  return rectangle_type( x, y, x + w, y + h );
+  return layer::get_visual_box( item );
 } // gui_level::get_visual_box()
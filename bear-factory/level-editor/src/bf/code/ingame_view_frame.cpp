@@ -14,6 +14,7 @@
 #include "bf/ingame_view_frame.hpp"
 
 #include "bf/clone_selection_dialog.hpp"
+#include "bf/compilation_manifest.hpp"
 #include "bf/error_check_level_dialog.hpp"
 #include "bf/grid_properties_frame.hpp"
 #include "bf/gui_level.hpp"
@@ -1148,6 +1149,10 @@ bool bf::ingame_view_frame::compile_level_no_check( unsigned int o )
       compiled_file cf(f);
       m_ingame_view->compile( cf, o );
       set_compile_changed(false);
+
+      // The level may differ from its file, thus the command line compilation
+      // must not consider the compiled file as up to date.
+      compilation_manifest( std_path ).remove();
     }
   else
     {
@@ -36,7 +36,8 @@ bf::layer::layer
   bool fit_level, unsigned int width, unsigned int height, 
   const std::string& tag)
   : m_fit_level(fit_level), m_width(width), m_height(height),
-    m_layer_type(layer_type), m_layer_name(layer_name), m_tag(tag)
+    m_layer_type(layer_type), m_layer_name(layer_name), m_tag(tag),
+    m_revision(0)
 {
   CLAW_PRECOND( width > 0 );
   CLAW_PRECOND( height > 0 );
@@ -48,6 +49,7 @@ bf::layer::layer
  * \param that The layer to copy from.
  */
 bf::layer::layer( const layer& that )
+  : m_revision(0)
 {
   assign(that);
 } // layer::layer()
@@ -93,6 +95,13 @@ void bf::layer::resize( unsigned int width, unsigned int height )
 
   m_width = width;
   m_height = height;
+  ++m_revision;
+
+  m_misplaced_item.clear();
+
+  for ( item_set_type::iterator it=m_item.begin(); it!=m_item.end(); ++it )
+    if ( is_misplaced(**it) )
+      m_misplaced_item.insert(*it);
 } // layer::resize()
 
 /*----------------------------------------------------------------------------*/
@@ -125,6 +134,7 @@ void bf::layer::set_name( const std::string& name )
 void bf::layer::set_tag( const std::string& tag )
 {
   m_tag = tag;
+  ++m_revision;
 } // layer::set_tag()
 
 /*----------------------------------------------------------------------------*/
@@ -144,6 +154,7 @@ std::string bf::layer::get_tag() const
 void bf::layer::add_item( item_instance* item )
 {
   m_item.insert(item);
+  index_item(item);
 
   if ( evaluate_filters_on_item(*item) )
     m_filtered_item.insert(item);
@@ -163,9 +174,161 @@ void bf::layer::remove_item( item_instance* item )
   if ( evaluate_filters_on_item(*item) )
     m_filtered_item.erase(item);
 
+  m_index.erase(item);
+  m_misplaced_item.erase(item);
+  unindex_identifiers(item);
   m_item.erase(item);
+  ++m_revision;
 } // layer::remove_item()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Update the box, the identifier and the references of an item in the
+ *        indices used to find the items, after a change of its position, of
+ *        its size or of its fields.
+ * \param item The item whose box has changed.
+ */
+void bf::layer::update_item_box( item_instance* item )
+{
+  CLAW_PRECOND( m_item.find(item) != m_item.end() );
+
+  index_item(item);
+} // layer::update_item_box()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Change the identifier of an item of the layer.
+ * \param item The item to rename.
+ * \param id The new identifier of the item.
+ * \remark The references to the item are not updated.
+ */
+void bf::layer::set_item_id( item_instance* item, const std::string& id )
+{
+  CLAW_PRECOND( m_item.find(item) != m_item.end() );
+
+  item->set_id(id);
+  index_item(item);
+} // layer::set_item_id()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Rename the identifiers referenced in the fields of the items.
+ * \param m The new identifier associated with each renamed identifier.
+ */
+void bf::layer::rename_item_references
+( const std::map<std::string, std::string>& m )
+{
+  item_set_type items;
+  std::map<std::string, std::string>::const_iterator it;
+
+  // The items are collected first such that the references are renamed only
+  // once in each item.
+  for ( it=m.begin(); it!=m.end(); ++it )
+    {
+      const reference_index_type::const_iterator itr
+        ( m_referencing_items.find(it->first) );
+
+      if ( itr != m_referencing_items.end() )
+        items.insert( itr->second.begin(), itr->second.end() );
+    }
+
+  for ( item_set_type::iterator iti=items.begin(); iti!=items.end(); ++iti )
+    {
+      (*iti)->rename_item_reference_fields(m);
+      index_item(*iti);
+    }
+} // layer::rename_item_references()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Find the items whose visual box includes a given point.
+ * \param pos The point.
+ * \remark Only the items returned by item_begin()/item_end() are considered.
+ *         They are returned in the order in which they have been added to
+ *         the layer, which does not depend on their addresses.
+ */
+std::vector<bf::item_instance*>
+bf::layer::find_items_at( const position_type& pos ) const
+{
+  std::vector<item_instance*> result;
+
+  m_index.find( pos, result );
+  filter_items( result );
+
+  // The index contains the display boxes, which include the visual boxes.
+  std::size_t n(0);
+
+  for ( std::size_t i=0; i!=result.size(); ++i )
+    if ( get_visual_box( *result[i] ).includes(pos) )
+      {
+        result[n] = result[i];
+        ++n;
+      }
+
+  result.resize(n);
+
+  return result;
+} // layer::find_items_at()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Find the items whose visual box intersects a given box.
+ * \param box The box.
+ * \remark Only the items returned by item_begin()/item_end() are considered.
+ *         They are returned in the order in which they have been added to
+ *         the layer, which does not depend on their addresses.
+ */
+std::vector<bf::item_instance*>
+bf::layer::find_items_in( const rectangle_type& box ) const
+{
+  std::vector<item_instance*> result;
+
+  m_index.find( box, result );
+  filter_items( result );
+
+  std::size_t n(0);
+
+  for ( std::size_t i=0; i!=result.size(); ++i )
+    if ( box.intersects( get_visual_box( *result[i] ) ) )
+      {
+        result[n] = result[i];
+        ++n;
+      }
+
+  result.resize(n);
+
+  return result;
+} // layer::find_items_in()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Find the items whose display box intersects a given box.
+ * \param box The box.
+ * \remark Only the items returned by item_begin()/item_end() are considered.
+ *         They are returned in the order in which they have been added to
+ *         the layer, which does not depend on their addresses.
+ */
+std::vector<bf::item_instance*>
+bf::layer::find_displayed_items( const rectangle_type& box ) const
+{
+  std::vector<item_instance*> result;
+
+  m_index.find( box, result );
+  filter_items( result );
+
+  return result;
+} // layer::find_displayed_items()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get a number that changes each time the items of the layer or their
+ *        display change.
+ */
+std::size_t bf::layer::get_revision() const
+{
+  return m_revision;
+} // layer::get_revision()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Find an item with a given id.
@@ -174,17 +337,23 @@ void bf::layer::remove_item( item_instance* item )
 bf::layer::item_iterator
 bf::layer::find_item_by_id( const std::string& id ) const
 {
-  bool found = false;
-  item_iterator it = item_begin_no_filter();
-  item_iterator eit( item_end_no_filter() );
+  if ( id.empty() )
+    return item_end_no_filter();
 
-  while ( !found && (it!=eit) )
-    if ( it->get_id() == id )
-      found = true;
-    else
-      ++it;
+  const std::pair<id_index_type::const_iterator, id_index_type::const_iterator>
+    range( m_items_by_id.equal_range(id) );
+
+  if ( range.first == range.second )
+    return item_end_no_filter();
+
+  // If several items have the identifier, the first one in the layer is
+  // returned.
+  item_instance* result( range.first->second );
 
-  return it;
+  for ( id_index_type::const_iterator it=range.first; it!=range.second; ++it )
+    result = std::min( result, it->second );
+
+  return m_item.find(result);
 } // layer::find_item_by_id()
 
 /*----------------------------------------------------------------------------*/
@@ -202,6 +371,23 @@ std::list<bf::item_instance*> bf::layer::get_identified_items() const
   return result;
 } // layer::get_identified_items()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the items whose fields reference a given identifier.
+ * \param id The referenced identifier.
+ */
+std::vector<bf::item_instance*>
+bf::layer::get_referencing_items( const std::string& id ) const
+{
+  const reference_index_type::const_iterator it
+    ( m_referencing_items.find(id) );
+
+  if ( it == m_referencing_items.end() )
+    return std::vector<item_instance*>();
+  else
+    return std::vector<item_instance*>( it->second.begin(), it->second.end() );
+} // layer::get_referencing_items()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Add an item at the end of the list of the prioritized items for the
@@ -504,6 +690,7 @@ bf::layer& bf::layer::operator=( const layer& that )
 void bf::layer::add_filter( const item_filter& filter )
 {
   m_filters.push_back(filter);
+  ++m_revision;
 
   item_set_type::iterator it;
 
@@ -525,6 +712,8 @@ void bf::layer::remove_filter( const item_filter& filter )
   if ( itf!=m_filters.end() )
     m_filters.erase( itf );
 
+  ++m_revision;
+
   item_set_type::iterator it(m_filtered_item.begin());
 
   while ( it!=m_filtered_item.end() )
@@ -546,22 +735,70 @@ bool bf::layer::check_item_position() const
 {
   bool result = true;
 
-  layer::item_iterator it;
+  item_set_type::const_iterator it;
 
-  for (it = item_begin(); it != item_end() && result; ++it)
-    {
-      const item_rendering_parameters& r( it->get_rendering_parameters() );
-      
-      result = 
-        r.get_right() >= 0 && 
-        r.get_top() >= 0 &&
-        r.get_left() <= get_width() &&
-        r.get_bottom() <= get_height();   
-    }
+  for ( it=m_misplaced_item.begin();
+        (it!=m_misplaced_item.end()) && result; ++it )
+    result = !m_filters.empty()
+      && (m_filtered_item.find(*it) == m_filtered_item.end());
 
   return result;
 } // layer::check_item_position()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the box in which an item is displayed and picked in the editor.
+ * \param item The item to bound.
+ */
+bf::rectangle_type bf::layer::get_visual_box( const item_instance& item )
+{
+  double x( item.get_rendering_parameters().get_left() );
+  double y( item.get_rendering_parameters().get_bottom() );
+  double w( item.get_rendering_parameters().get_width() );
+  double h( item.get_rendering_parameters().get_height() );
+
+  if ( w == 0 )
+    {
+      x -= 10;
+      w = 20;
+    }
+
+  if ( h == 0 )
+    {
+      y -= 10;
+      h = 20;
+    }
+
+  return rectangle_type( x, y, x + w, y + h );
+} // layer::get_visual_box()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the box bounding the visual box of an item and its sprite, moved
+ *        by the gap.
+ * \param item The item to bound.
+ */
+bf::rectangle_type bf::layer::get_display_box( const item_instance& item )
+{
+  const rectangle_type box( get_visual_box(item) );
+  const item_rendering_parameters& r( item.get_rendering_parameters() );
+
+  double gap_x( r.get_gap_x() );
+  double gap_y( r.get_gap_y() );
+
+  if ( r.is_mirrored() )
+    gap_x = -gap_x;
+
+  if ( r.is_flipped() )
+    gap_y = -gap_y;
+
+  return rectangle_type
+    ( std::min( box.left(), box.left() + gap_x ),
+      std::min( box.bottom(), box.bottom() + gap_y ),
+      std::max( box.right(), box.right() + gap_x ),
+      std::max( box.top(), box.top() + gap_y ) );
+} // layer::get_display_box()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Remove all items.
@@ -574,6 +811,12 @@ void bf::layer::clear()
     delete *it;
 
   m_item.clear();
+  m_index.clear();
+  m_misplaced_item.clear();
+  m_items_by_id.clear();
+  m_referencing_items.clear();
+  m_identifiers.clear();
+  ++m_revision;
 } // layer::clear()
 
 /*----------------------------------------------------------------------------*/
@@ -600,9 +843,130 @@ void bf::layer::assign( const layer& that )
 
   for ( item_set_type::const_iterator it=that.m_item.begin();
         it!=that.m_item.end(); ++it )
-    m_item.insert( new item_instance( **it ) );
+    {
+      item_instance* const item( new item_instance( **it ) );
+      m_item.insert( item );
+      index_item( item );
+    }
 } // layer::assign()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Store the current box, identifier and references of an item in the
+ *        indices and check if the item is in the bounds of the layer.
+ * \param item The item to index.
+ */
+void bf::layer::index_item( item_instance* item )
+{
+  m_index.insert( item, get_display_box(*item) );
+  index_identifiers( item );
+  ++m_revision;
+
+  if ( is_misplaced(*item) )
+    m_misplaced_item.insert(item);
+  else
+    m_misplaced_item.erase(item);
+} // layer::index_item()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Store the current identifier of an item and the identifiers it
+ *        references in the indices.
+ * \param item The item to index.
+ */
+void bf::layer::index_identifiers( item_instance* item )
+{
+  unindex_identifiers( item );
+
+  item_identifiers& ids( m_identifiers[item] );
+  ids.id = item->get_id();
+  item->get_referenced_identifiers( ids.references );
+
+  if ( !ids.id.empty() )
+    m_items_by_id.insert( id_index_type::value_type( ids.id, item ) );
+
+  std::set<std::string>::const_iterator it;
+
+  for ( it=ids.references.begin(); it!=ids.references.end(); ++it )
+    m_referencing_items[*it].insert( item );
+} // layer::index_identifiers()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove the identifier of an item and the identifiers it references
+ *        from the indices.
+ * \param item The item to remove.
+ */
+void bf::layer::unindex_identifiers( item_instance* item )
+{
+  const identifiers_map_type::iterator itm( m_identifiers.find(item) );
+
+  if ( itm == m_identifiers.end() )
+    return;
+
+  const item_identifiers& ids( itm->second );
+
+  if ( !ids.id.empty() )
+    {
+      id_index_type::iterator it( m_items_by_id.equal_range(ids.id).first );
+
+      while ( it->second != item )
+        ++it;
+
+      m_items_by_id.erase( it );
+    }
+
+  std::set<std::string>::const_iterator it;
+
+  for ( it=ids.references.begin(); it!=ids.references.end(); ++it )
+    {
+      const reference_index_type::iterator itr( m_referencing_items.find(*it) );
+
+      itr->second.erase( item );
+
+      if ( itr->second.empty() )
+        m_referencing_items.erase( itr );
+    }
+
+  m_identifiers.erase( itm );
+} // layer::unindex_identifiers()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if an item is displayed outside the bounds of the layer.
+ * \param item The item to check.
+ */
+bool bf::layer::is_misplaced( const item_instance& item ) const
+{
+  const item_rendering_parameters& r( item.get_rendering_parameters() );
+
+  return (r.get_right() < 0) || (r.get_top() < 0)
+    || (r.get_left() > get_width()) || (r.get_bottom() > get_height());
+} // layer::is_misplaced()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove from a list the items that are not returned by
+ *        item_begin()/item_end().
+ * \param items (in/out) The items to filter.
+ */
+void bf::layer::filter_items( std::vector<item_instance*>& items ) const
+{
+  if ( m_filters.empty() )
+    return;
+
+  std::size_t n(0);
+
+  for ( std::size_t i=0; i!=items.size(); ++i )
+    if ( m_filtered_item.find(items[i]) != m_filtered_item.end() )
+      {
+        items[n] = items[i];
+        ++n;
+      }
+
+  items.resize(n);
+} // layer::filter_items()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Sort referenced items such that the referenced is before the
@@ -705,26 +1069,46 @@ bool bf::layer::evaluate_filters_on_item( const item_instance& item ) const
  */
 void bf::layer::check_priorities( layer_check_result& result ) const
 {
+  std::map<item_instance*, std::size_t> priority;
   item_list_type::const_iterator it;
+  std::size_t p(0);
+
+  for ( it=m_priority.begin(); it!=m_priority.end(); ++it, ++p )
+    priority[*it] = p;
 
-  for ( it=m_priority.begin(); it!=m_priority.end(); ++it )
+  p = 0;
+
+  // An item conflicts with the prioritized items referencing it before it.
+  for ( it=m_priority.begin(); it!=m_priority.end(); ++it, ++p )
     if ( (*it)->get_id().empty() )
       result.add( *it, check_error("Prioritized items must have an id.") );
     else
       {
-        item_list_type::const_iterator next=it;
-
-        for ( ++next; next!=m_priority.end(); ++next )
-          if ( (*it)->has_a_reference_to((*next)->get_id()) )
-            {
-              const check_error error
-                ( (*it)->get_id() + "/" + (*next)->get_id(),
-                    "The build order is in conflict with the dependency based "
-                    "on the fields.");
-
-              result.add(*next, error);
-              result.add(*it, error);
-            }
+        const reference_index_type::const_iterator itr
+          ( m_referencing_items.find((*it)->get_id()) );
+
+        if ( itr == m_referencing_items.end() )
+          continue;
+
+        item_set_type::const_iterator ref;
+
+        for ( ref=itr->second.begin(); ref!=itr->second.end(); ++ref )
+          {
+            const std::map<item_instance*, std::size_t>::const_iterator itp
+              ( priority.find(*ref) );
+
+            if ( (itp != priority.end()) && (itp->second < p)
+                 && !(*ref)->get_id().empty() )
+              {
+                const check_error error
+                  ( (*ref)->get_id() + "/" + (*it)->get_id(),
+                    "The build order is in conflict with the dependency "
+                    "based on the fields.");
+
+                result.add(*it, error);
+                result.add(*ref, error);
+              }
+          }
       }
 } // layer::check_priorities()
 
@@ -737,25 +1121,35 @@ void bf::layer::check_priorities( layer_check_result& result ) const
 void bf::layer::check_unique_identifiers
 ( layer_check_result& result, std::set<std::string>& identifiers ) const
 {
-  std::map<std::string, item_instance*> map_id;
+  id_index_type::const_iterator it( m_items_by_id.begin() );
 
-  item_set_type::const_iterator it;
-  for ( it=m_item.begin(); it!=m_item.end(); ++it )
-    if ( !(*it)->get_id().empty() )
-      {
-        if ( map_id.find((*it)->get_id()) != map_id.end() )
-          {
-            item_instance* other = map_id[(*it)->get_id()];
-            const check_error error
-              ( (*it)->get_id(), "This identifier is already in use." );
+  // The items having the same identifier are consecutive in the index.
+  while ( it != m_items_by_id.end() )
+    {
+      const std::string& id( it->first );
+      const std::pair<id_index_type::const_iterator,
+                      id_index_type::const_iterator>
+        range( m_items_by_id.equal_range(id) );
 
-            result.add( other, error );
-            result.add( *it, error );
-          }
-        else
-          {
-            map_id[(*it)->get_id()] = *it;
-            identifiers.insert( (*it)->get_id() );
-          }
-      }
+      identifiers.insert( id );
+
+      if ( std::distance( range.first, range.second ) > 1 )
+        {
+          item_instance* first( range.first->second );
+
+          for ( it=range.first; it!=range.second; ++it )
+            first = std::min( first, it->second );
+
+          const check_error error( id, "This identifier is already in use." );
+
+          for ( it=range.first; it!=range.second; ++it )
+            if ( it->second != first )
+              {
+                result.add( first, error );
+                result.add( it->second, error );
+              }
+        }
+
+      it = range.second;
+    }
 } // layer::check_unique_identifiers()
@@ -270,6 +270,38 @@ std::size_t bf::level::get_layer_by_item( const item_instance& item ) const
   return result;
 } // level::get_layer_by_item()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Update the box of an item in the index of its layer, after a change
+ *        of its position, of its size or of its fields.
+ * \param item The item whose box has changed.
+ * \remark Nothing is done if the item is not in the level.
+ */
+void bf::level::update_item_box( item_instance* item )
+{
+  const std::size_t index( get_layer_by_item(*item) );
+
+  if ( index != layers_count() )
+    get_layer(index).update_item_box(item);
+} // level::update_item_box()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Change the identifier of an item.
+ * \param item The item to rename.
+ * \param id The new identifier of the item.
+ * \remark The references to the item are not updated.
+ */
+void bf::level::set_item_id( item_instance* item, const std::string& id )
+{
+  const std::size_t index( get_layer_by_item(*item) );
+
+  if ( index != layers_count() )
+    get_layer(index).set_item_id(item, id);
+  else
+    item->set_id(id);
+} // level::set_item_id()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Generates a new identifier.
@@ -288,6 +320,24 @@ void bf::level::generate_valid_id( std::string& id ) const
  */
 void bf::level::generate_valid_id
 ( std::string& id, const std::set<std::string>& avoid ) const
+{
+  std::map<std::string, std::size_t> suffixes;
+  generate_valid_id( id, avoid, suffixes );
+} // level::generate_valid_id()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Generates a new identifier.
+ * \param id (in) The desired identifier, (out) a valid identifier.
+ * \param avoid A set of names to avoid.
+ * \param suffixes (in/out) The last numeric suffix used for each prefix in the
+ *        previous calls. It allows to generate many identifiers with the same
+ *        prefix without testing the same suffixes again, as long as no
+ *        identifier is removed from the level between the calls.
+ */
+void bf::level::generate_valid_id
+( std::string& id, const std::set<std::string>& avoid,
+  std::map<std::string, std::size_t>& suffixes ) const
 {
   if ( find_item_by_id(id).first || ( avoid.find(id) != avoid.end() ) )
     {
@@ -304,7 +354,7 @@ void bf::level::generate_valid_id
             prefix = prefix.substr(0, p);
           }
 
-      std::size_t index(0);
+      std::size_t& index( suffixes[prefix + sep] );
 
       while ( id.empty() )
         {
@@ -332,12 +382,13 @@ void bf::level::fix_identifiers
   std::map<std::string, std::string> id_map;
   std::vector<item_instance*>::const_iterator it;
   std::set<std::string> avoid;
+  std::map<std::string, std::size_t> suffixes;
 
   for (it=items.begin(); it!=items.end(); ++it)
     if ( !(*it)->get_id().empty() )
       {
         std::string id( (*it)->get_id() );
-        generate_valid_id(id, avoid);
+        generate_valid_id(id, avoid, suffixes);
         avoid.insert(id);
 
         id_map[(*it)->get_id()] = id;
@@ -14,7 +14,9 @@
 #include "bf/level_editor.hpp"
 
 #include "bf/compilation_context.hpp"
+#include "bf/compilation_manifest.hpp"
 #include "bf/config_frame.hpp"
+#include "bf/file_hash.hpp"
 #include "bf/gui_level.hpp"
 #include "bf/image_pool.hpp"
 #include "bf/layer_check_result.hpp"
@@ -25,14 +27,21 @@
 #include "bf/path_configuration.hpp"
 #include "bf/splash_screen.hpp"
 #include "bf/level_editor.hpp"
+#include "bf/version.hpp"
 #include "bf/workspace_environment.hpp"
 #include "bf/wx_facilities.hpp"
 
 #include <wx/tooltip.h>
 #include <claw/logger.hpp>
 #include <claw/exception.hpp>
+#include <boost/filesystem/operations.hpp>
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
 #include <limits>
+#include <map>
+#include <sstream>
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -142,9 +151,25 @@ void bf::level_editor::update( const wxString& path ) const
           
           lvl = reader.load( path, env );
 
-          std::ofstream f( wx_to_std_string(path).c_str() );
-          writer.save( f, *lvl, env );
+          std::ostringstream updated;
+          writer.save( updated, *lvl, env );
           delete lvl;
+          lvl = NULL;
+
+          const std::string std_path( wx_to_std_string(path) );
+          std::ifstream current( std_path.c_str() );
+          const std::string content
+            ( (std::istreambuf_iterator<char>(current)),
+              std::istreambuf_iterator<char>() );
+
+          if ( content == updated.str() )
+            claw::logger << claw::log_verbose << std_path
+                         << " is already up to date." << std::endl;
+          else
+            {
+              std::ofstream f( std_path.c_str() );
+              f << updated.str();
+            }
         }
     }
   catch(...)
@@ -164,35 +189,291 @@ void bf::level_editor::update( const wxString& path ) const
 void bf::level_editor::compile_level
 ( const level& lvl, const wxString& path ) const
 {
-  std::string std_path( wx_to_std_string(path) );
-  std::size_t pos = std_path.rfind(".lvl");
+  std::string w = 
+    path_configuration::get_instance().search_workspace
+    ( wx_to_std_string(path) );
+      
+  if ( ! w.empty() )
+    {
+      workspace_environment env(w);
+      compilation_context context
+        ( std::numeric_limits<unsigned int>::max(), env );
 
-  if ( pos != std::string::npos )
-    std_path = std_path.substr(0, pos);
+      compile_level( lvl, path, context );
+    }
+} // level_editor::compile_level()
 
-  std_path += ".cl";
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compile a level in a given context.
+ * \param lvl The level to compile.
+ * \param path The path to the level file.
+ * \param context The context in which the compilation is done.
+ *
+ * The manifest of the compiled level is saved next to it, with the files used
+ * by the compilation. It is assumed that \a lvl is the content of the file
+ * \a path.
+ */
+void bf::level_editor::compile_level
+( const level& lvl, const wxString& path, compilation_context& context ) const
+{
+  const std::string std_path( get_compiled_level_path(path) );
+  const compilation_manifest manifest( std_path );
+
+  manifest.remove();
+  context.clear_dependencies();
 
-  std::ofstream f( std_path.c_str() );
+  {
+    std::ofstream f( std_path.c_str() );
 
-  if (f)
+    if (f)
+      {
+        compiled_file cf(f);
+        lvl.compile(cf, context);
+      }
+    else
+      throw claw::exception("Can't open the level file.");
+  }
+
+  std::set<std::string> inputs( context.get_dependencies() );
+  inputs.insert
+    ( boost::filesystem::system_complete( wx_to_std_string(path) ).string() );
+
+  file_hash hashes;
+  manifest.save( get_compiler_signature(), inputs, hashes );
+} // level_editor::compile_level()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compile the levels passed on the command line. The levels whose
+ *        inputs have not changed since their last compilation are skipped,
+ *        unless the compilation is forced. When several threads are allowed,
+ *        the levels of a same workspace are compiled together with
+ *        compile_batch().
+ * \param paths The paths to the level files.
+ * \return true if all the levels have been compiled.
+ */
+bool bf::level_editor::compile_files( const std::vector<wxString>& paths ) const
+{
+  std::vector<wxString> outdated;
+  file_hash hashes;
+
+  for ( std::size_t i=0; i!=paths.size(); ++i )
+    if ( !is_up_to_date( paths[i], hashes ) )
+      outdated.push_back( paths[i] );
+
+  claw::logger << claw::log_verbose << outdated.size() << " of "
+               << paths.size() << " levels to compile." << std::endl;
+
+  if ( get_jobs() <= 1 )
+    return base_editor_application::compile_files( outdated );
+
+  typedef std::map< std::string, std::vector<wxString> > workspace_map;
+
+  workspace_map workspaces;
+
+  for ( std::size_t i=0; i!=outdated.size(); ++i )
     {
-      std::string w = 
-        path_configuration::get_instance().search_workspace
-        ( wx_to_std_string(path) );
-      
-      if ( ! w.empty() )
-        {
-          workspace_environment env(w);
-          
-          compiled_file cf(f);
-          compilation_context context
-            ( std::numeric_limits<unsigned int>::max(), env );
-          lvl.compile(cf, context);
-        }
+      const std::string w
+        ( path_configuration::get_instance().search_workspace
+          ( wx_to_std_string(outdated[i]) ) );
+
+      if ( w.empty() )
+        claw::logger << claw::log_warning << "No workspace found for '"
+                     << wx_to_std_string(outdated[i]) << "'." << std::endl;
+      else
+        workspaces[w].push_back( outdated[i] );
     }
+
+  bool result(true);
+
+  for ( workspace_map::const_iterator it=workspaces.begin();
+        it!=workspaces.end(); ++it )
+    result = compile_batch( it->first, it->second ) && result;
+
+  return result;
+} // level_editor::compile_files()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compile several levels of a same workspace.
+ * \param workspace_name The name of the workspace of the levels.
+ * \param paths The paths to the level files.
+ * \return true if all the levels have been compiled.
+ *
+ * The levels share the same workspace environment and compilation context,
+ * thus the item classes and the images are loaded once. The levels are loaded
+ * and compiled one at a time, by chunks of a few levels given to
+ * compile_batch_chunk(), such that only the levels of a chunk are in memory.
+ * Only the computation of the opaque rectangles uses several threads.
+ */
+bool bf::level_editor::compile_batch
+( const std::string& workspace_name, const std::vector<wxString>& paths ) const
+{
+  workspace_environment env(workspace_name);
+  compilation_context context
+    ( std::numeric_limits<unsigned int>::max(), env );
+  const std::size_t chunk_size( 4 * get_jobs() );
+  bool result(true);
+
+  for ( std::size_t i=0; i<paths.size(); i+=chunk_size )
+    {
+      const std::vector<wxString> chunk
+        ( paths.begin() + i,
+          paths.begin() + std::min( i + chunk_size, paths.size() ) );
+
+      result = compile_batch_chunk( env, context, chunk ) && result;
+    }
+
+  return result;
+} // level_editor::compile_batch()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compile some levels of a same workspace.
+ * \param env The workspace environment of the levels.
+ * \param context The context in which the levels are compiled.
+ * \param paths The paths to the level files.
+ * \return true if all the levels have been compiled.
+ *
+ * A first compilation, whose output is discarded, collects the sprites of the
+ * levels. Their opaque rectangles are then computed in parallel by get_jobs()
+ * threads and the levels are finally compiled in their files, in the order of
+ * \a paths. Since the rectangles do not depend on the order of their
+ * computation, the files are the same than with a serial compilation.
+ */
+bool bf::level_editor::compile_batch_chunk
+( workspace_environment& env, compilation_context& context,
+  const std::vector<wxString>& paths ) const
+{
+  level_file_xml_reader reader;
+  std::vector<level*> levels( paths.size(), (level*)NULL );
+  bool result(true);
+
+  context.defer_opaque_rectangles();
+
+  try
+    {
+      for ( std::size_t i=0; i!=paths.size(); ++i )
+        try
+          {
+            claw::logger << claw::log_verbose << "Loading "
+                         << wx_to_std_string(paths[i]) << std::endl;
+
+            levels[i] = reader.load( paths[i], env );
+
+            if ( !check_level(*levels[i]) )
+              throw claw::exception("Invalid level.");
+
+            std::ostream discarded(NULL);
+            compiled_file cf(discarded);
+            levels[i]->compile(cf, context);
+          }
+        catch(std::exception& e)
+          {
+            std::cerr << "Error when processing '"
+                      << wx_to_std_string(paths[i]) << "': " << e.what()
+                      << std::endl;
+            delete levels[i];
+            levels[i] = NULL;
+            result = false;
+          }
+
+      claw::logger << claw::log_verbose << "Computing the opaque rectangles"
+                   << " with " << get_jobs() << " threads." << std::endl;
+
+      context.compute_deferred_opaque_rectangles( get_jobs() );
+
+      for ( std::size_t i=0; i!=paths.size(); ++i )
+        if ( levels[i] != NULL )
+          {
+            try
+              {
+                claw::logger << claw::log_verbose << "Compiling "
+                             << wx_to_std_string(paths[i]) << std::endl;
+                compile_level( *levels[i], paths[i], context );
+              }
+            catch(std::exception& e)
+              {
+                std::cerr << "Error when processing '"
+                          << wx_to_std_string(paths[i]) << "': " << e.what()
+                          << std::endl;
+                result = false;
+              }
+
+            delete levels[i];
+            levels[i] = NULL;
+          }
+    }
+  catch(...)
+    {
+      for ( std::size_t i=0; i!=levels.size(); ++i )
+        delete levels[i];
+
+      throw;
+    }
+
+  return result;
+} // level_editor::compile_batch_chunk()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the compiled file of a level is up to date with the files it
+ *        has been built from, and report the reason why it is not.
+ * \param path The path to the level file.
+ * \param hashes The hashes of the files.
+ */
+bool bf::level_editor::is_up_to_date
+( const wxString& path, file_hash& hashes ) const
+{
+  std::string reason;
+  bool result(false);
+
+  if ( is_forced() )
+    reason = "the compilation is forced";
   else
-    throw claw::exception("Can't open the level file.");
-} // level_editor::compile_level()
+    result =
+      compilation_manifest( get_compiled_level_path(path) ).is_up_to_date
+      ( get_compiler_signature(), hashes, reason );
+
+  if ( result )
+    claw::logger << claw::log_verbose << wx_to_std_string(path)
+                 << " is up to date." << std::endl;
+  else
+    claw::logger << claw::log_verbose << wx_to_std_string(path)
+                 << " will be compiled: " << reason << '.' << std::endl;
+
+  return result;
+} // level_editor::is_up_to_date()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the path to the compiled file of a level.
+ * \param path The path to the level file.
+ */
+std::string bf::level_editor::get_compiled_level_path( const wxString& path )
+{
+  std::string std_path( wx_to_std_string(path) );
+  std::size_t pos = std_path.rfind(".lvl");
+
+  if ( pos != std::string::npos )
+    std_path = std_path.substr(0, pos);
+
+  return std_path + ".cl";
+} // level_editor::get_compiled_level_path()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the description of the compiler stored in the manifests of the
+ *        compiled levels. It includes the algorithm used to compute the opaque
+ *        rectangles, since the compiled files depend on it.
+ */
+std::string bf::level_editor::get_compiler_signature()
+{
+  return BF_VERSION_STRING ", level editor, "
+    + compilation_context::get_algorithm_signature
+    ( compilation_context::get_default_opaque_rectangle_algorithm() );
+} // level_editor::get_compiler_signature()
 
 /*----------------------------------------------------------------------------*/
 /**
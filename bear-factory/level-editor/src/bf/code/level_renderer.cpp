@@ -22,8 +22,19 @@
 #include "bf/wx_facilities.hpp"
 #include "bf/wx_type_cast.hpp"
 
+#include <wx/dcmemory.h>
+#include <wx/image.h>
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <sstream>
+
 /*----------------------------------------------------------------------------*/
 const wxCoord bf::level_renderer::s_grip_size = 10;
+const wxCoord bf::level_renderer::s_tile_size = 256;
+const std::size_t bf::level_renderer::s_max_tiles_per_layer = 128;
+const wxCoord bf::level_renderer::s_render_margin = 64;
 
 
 
@@ -41,7 +52,7 @@ bf::level_renderer::level_renderer
     m_display_id(true), m_display_relationship(true),
     m_bright_background(false), m_display_continuity_hint(false),
     m_image_cache( new sprite_image_cache(env) ),
-    m_zoom(100)
+    m_zoom(100), m_rendering_tile(false), m_tile_origin(0, 0)
 {
 
 } // level_renderer::level_renderer()
@@ -144,12 +155,12 @@ wxPoint bf::level_renderer::get_position_in_layer
 {
   CLAW_PRECOND( index < get_level().layers_count() );
   
-  wxPoint pos_view( compute_local_view_position( index ) );
+  const wxPoint origin( get_layer_origin( index ) );
 
   return 
-    wxPoint( zoom((wxCoord)position.x) - pos_view.x,
-             pos_view.y + m_view.height - zoom((wxCoord)position.y) 
-             - zoom((wxCoord)height) );
+    wxPoint( zoom((wxCoord)position.x) - origin.x,
+             - zoom((wxCoord)position.y) - zoom((wxCoord)height)
+             - origin.y );
 } // level_renderer::get_position_in_layer()
 
 /*----------------------------------------------------------------------------*/
@@ -500,39 +511,267 @@ const bf::gui_level& bf::level_renderer::get_level() const
  * \brief Render all layers.
  * \param dc The device context for the drawings.
  */
-void bf::level_renderer::render_layers( wxGCDC& dc ) const
+void bf::level_renderer::render_layers( wxGCDC& dc )
 {
-  const wxRect vis_box
-    ( unzoom(m_view.GetPosition()), unzoom(m_view.GetSize()) );
+  update_tiles();
 
   for (unsigned int i=0; i!=get_level().layers_count(); ++i)
     if ( get_level().layer_is_visible(i) )
       {
-        const layer& the_layer = get_level().get_layer(i);
-        layer::item_iterator it;
-        std::multimap<int, item_instance*> z_order;
-
-        for (it=the_layer.item_begin(); it!=the_layer.item_end(); ++it)
+        if ( can_use_tiles(i) )
+          render_layer_tiles( dc, i );
+        else
           {
-            wxRect box = get_presence_box(*it);
-            box.SetPosition
-              ( get_position_in_layer
-                (box.GetPosition(), i,
-                 box.GetSize().y) + unzoom(m_view.GetPosition()) );
-
-            if ( box.Intersects(vis_box)  )
-              z_order.insert
-                ( std::pair<int, item_instance*>
-                  (it->get_rendering_parameters().get_pos_z(), &(*it)) );
-          }
+            std::multimap<int, item_instance*> z_order;
+            find_displayed_items
+              ( z_order, i, wxRect( wxPoint(0, 0), m_view.GetSize() ) );
 
-        render_items( dc, z_order, i );
+            render_items( dc, z_order, i );
 
-        if ( i == get_level().get_active_layer_index() )
-          render_drag(dc, z_order, i);
+            if ( i == get_level().get_active_layer_index() )
+              render_drag(dc, z_order, i);
+          }
       }
 } // level_renderer::render_layers()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Render the visible part of a layer with the tiles of its items,
+ *        rendering the missing tiles.
+ * \param dc The device context for the drawings.
+ * \param index The index of the layer.
+ */
+void bf::level_renderer::render_layer_tiles( wxGCDC& dc, unsigned int index )
+{
+  const layer& the_layer( get_level().get_layer(index) );
+  layer_tiles_map::iterator it_layer( m_tiles.find(&the_layer) );
+
+  if ( it_layer == m_tiles.end() )
+    it_layer =
+      m_tiles.insert( layer_tiles_map::value_type(&the_layer, layer_tiles()) )
+      .first;
+  else if ( (it_layer->second.index != index)
+            || (it_layer->second.revision != the_layer.get_revision()) )
+    it_layer->second.tiles.clear();
+
+  layer_tiles& cache( it_layer->second );
+  cache.index = index;
+  cache.revision = the_layer.get_revision();
+
+  const wxPoint origin( get_layer_origin(index) );
+  const wxCoord min_x( std::floor( (double)origin.x / s_tile_size ) );
+  const wxCoord min_y( std::floor( (double)origin.y / s_tile_size ) );
+  const wxCoord max_x
+    ( std::floor( (double)(origin.x + m_view.width - 1) / s_tile_size ) );
+  const wxCoord max_y
+    ( std::floor( (double)(origin.y + m_view.height - 1) / s_tile_size ) );
+
+  std::set<tile_position> visible;
+
+  for ( wxCoord x=min_x; x<=max_x; ++x )
+    for ( wxCoord y=min_y; y<=max_y; ++y )
+      {
+        const tile_position tile( x, y );
+        std::map<tile_position, wxBitmap>::const_iterator it
+          ( cache.tiles.find(tile) );
+
+        if ( it == cache.tiles.end() )
+          it = cache.tiles.insert
+            ( std::make_pair( tile, render_tile( dc, index, tile ) ) ).first;
+
+        visible.insert(tile);
+        dc.DrawBitmap
+          ( it->second, x * s_tile_size - origin.x,
+            y * s_tile_size - origin.y, true );
+      }
+
+  if ( cache.tiles.size() > s_max_tiles_per_layer )
+    {
+      std::map<tile_position, wxBitmap>::iterator it( cache.tiles.begin() );
+
+      while ( it != cache.tiles.end() )
+        if ( visible.find(it->first) == visible.end() )
+          cache.tiles.erase( it++ );
+        else
+          ++it;
+    }
+
+  // The relationships may cross the tiles, thus they are rendered above them.
+  if ( m_display_relationship )
+    {
+      std::multimap<int, item_instance*> z_order;
+      find_displayed_items
+        ( z_order, index, wxRect( wxPoint(0, 0), m_view.GetSize() ) );
+      render_relationships( dc, z_order, index );
+    }
+} // level_renderer::render_layer_tiles()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Render the items of a layer in a tile.
+ * \param model The device context whose font and colors are used in the tile.
+ * \param index The index of the layer.
+ * \param tile The position of the tile.
+ */
+wxBitmap bf::level_renderer::render_tile
+( const wxDC& model, unsigned int index, const tile_position& tile )
+{
+  wxImage image( s_tile_size, s_tile_size );
+  image.InitAlpha();
+  std::fill
+    ( image.GetAlpha(), image.GetAlpha() + s_tile_size * s_tile_size, 0 );
+
+  wxBitmap result( image, 32 );
+
+  m_rendering_tile = true;
+  m_tile_origin =
+    wxPoint( tile.first * s_tile_size, tile.second * s_tile_size );
+
+  {
+    wxMemoryDC memory_dc( result );
+    wxGCDC dc( memory_dc );
+
+    dc.SetFont( model.GetFont() );
+    dc.SetTextForeground( model.GetTextForeground() );
+    dc.SetTextBackground( model.GetTextBackground() );
+    dc.SetBackgroundMode( model.GetBackgroundMode() );
+
+    std::multimap<int, item_instance*> z_order;
+    find_displayed_items
+      ( z_order, index, wxRect( 0, 0, s_tile_size, s_tile_size ) );
+
+    render_items( dc, z_order, index );
+  }
+
+  m_rendering_tile = false;
+
+  return result;
+} // level_renderer::render_tile()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if a layer can be rendered with tiles. The active layer and the
+ *        layers whose display depends on the selection or on the errors are
+ *        rendered directly.
+ * \param index The index of the layer.
+ */
+bool bf::level_renderer::can_use_tiles( unsigned int index ) const
+{
+  if ( index == get_level().get_active_layer_index() )
+    return false;
+  else if ( get_level().has_selection(index) )
+    return false;
+  else
+    {
+      level_check_result::layer_iterator it;
+
+      for ( it=m_check_result.layer_begin(); it!=m_check_result.layer_end();
+            ++it )
+        if ( (it->first == &get_level().get_layer(index))
+             && !it->second.is_ok() )
+          return false;
+
+      return true;
+    }
+} // level_renderer::can_use_tiles()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get a string describing the display options that change the
+ *        rendering of the tiles.
+ */
+std::string bf::level_renderer::get_tile_signature() const
+{
+  std::ostringstream result;
+
+  result << m_zoom << ' ' << m_graphic_drawing << m_wireframe_drawing
+         << m_display_id << m_display_continuity_hint;
+
+  if ( !get_level().empty() )
+    result << ' ' << get_level().get_active_layer_index() << ' '
+           << get_level().get_active_layer().get_tag();
+
+  return result.str();
+} // level_renderer::get_tile_signature()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove the tiles rendered with other display options or for the
+ *        layers removed from the level.
+ */
+void bf::level_renderer::update_tiles()
+{
+  const std::string signature( get_tile_signature() );
+
+  if ( signature != m_tile_signature )
+    {
+      m_tiles.clear();
+      m_tile_signature = signature;
+    }
+  else
+    {
+      std::set<const layer*> layers;
+
+      for (unsigned int i=0; i!=get_level().layers_count(); ++i)
+        layers.insert( &get_level().get_layer(i) );
+
+      layer_tiles_map::iterator it( m_tiles.begin() );
+
+      while ( it != m_tiles.end() )
+        if ( layers.find(it->first) == layers.end() )
+          m_tiles.erase( it++ );
+        else
+          ++it;
+    }
+} // level_renderer::update_tiles()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the position, in a zoomed layer whose y-axis is directed toward
+ *        the bottom, of the point rendered at the top left corner of the view
+ *        or of the tile being rendered.
+ * \param index The index of the layer.
+ */
+wxPoint bf::level_renderer::get_layer_origin( unsigned int index ) const
+{
+  if ( m_rendering_tile )
+    return m_tile_origin;
+  else
+    {
+      const wxPoint view( compute_local_view_position( index ) );
+      return wxPoint( view.x, - view.y - m_view.height );
+    }
+} // level_renderer::get_layer_origin()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the items of a layer displayed in a part of the view or of the
+ *        tile being rendered, ordered by increasing z.
+ * \param z_order (out) The items.
+ * \param index The index of the layer.
+ * \param area The part of the view or of the tile.
+ */
+void bf::level_renderer::find_displayed_items
+( std::multimap<int, item_instance*>& z_order, unsigned int index,
+  const wxRect& area ) const
+{
+  const wxPoint origin( get_layer_origin(index) );
+  const wxRect box( area.GetPosition() + origin, area.GetSize() );
+  const wxCoord margin( unzoom(s_render_margin) + 1 );
+
+  const rectangle_type r
+    ( unzoom( box.GetLeft() ) - margin, - unzoom( box.GetBottom() ) - margin,
+      unzoom( box.GetRight() ) + margin, - unzoom( box.GetTop() ) + margin );
+
+  const std::vector<item_instance*> items
+    ( get_level().get_layer(index).find_displayed_items(r) );
+
+  for ( std::size_t i=0; i!=items.size(); ++i )
+    z_order.insert
+      ( std::pair<int, item_instance*>
+        ( items[i]->get_rendering_parameters().get_pos_z(), items[i] ) );
+} // level_renderer::find_displayed_items()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Render a set of items.
@@ -572,15 +811,31 @@ void bf::level_renderer::render_items
     for (it=z_order.begin(); it!=z_order.end(); ++it)
       render_item_id(dc, *it->second, i);
 
-  if ( m_display_relationship )
-    for (it=z_order.begin(); it!=z_order.end(); ++it)
-      render_relationship( dc, *it->second, z_order, i );
+  if ( m_display_relationship && !m_rendering_tile )
+    render_relationships( dc, z_order, i );
 
   if ( m_display_continuity_hint )
     for (it=z_order.begin(); it!=z_order.end(); ++it)
       render_continuity_hint( dc, *it->second, i );
 } // level_renderer::render_items()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Render the relationship among a set of items.
+ * \param dc The device context for the drawings.
+ * \param z_order The items.
+ * \param i The index of the layer in which the items are.
+ */
+void bf::level_renderer::render_relationships
+( wxDC& dc, const std::multimap<int, item_instance*>& z_order,
+  unsigned int i ) const
+{
+  std::multimap<int, item_instance*>::const_iterator it;
+
+  for (it=z_order.begin(); it!=z_order.end(); ++it)
+    render_relationship( dc, *it->second, z_order, i );
+} // level_renderer::render_relationships()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Render the relationship among items.
@@ -1739,37 +1994,3 @@ wxPen bf::level_renderer::get_display_pen
 
   return result;
 } // level_renderer::get_display_pen()
-
-/*----------------------------------------------------------------------------*/
-/**
- * \brief Gets the box bounding box of an item and its sprite, if any.
- * \param item The item to bound.
- */
-wxRect bf::level_renderer::get_presence_box( const item_instance& item ) const
-{
-  wxRect result( rectangle_to_wx( get_level().get_visual_box(item) ) );
-
-  wxPoint pos_gap( result.GetPosition() );
-
-  if ( item.get_rendering_parameters().is_mirrored() )
-    pos_gap.x -= item.get_rendering_parameters().get_gap_x();
-  else
-    pos_gap.x += item.get_rendering_parameters().get_gap_x();
-
-  if ( item.get_rendering_parameters().is_flipped() )
-    pos_gap.y -= item.get_rendering_parameters().get_gap_y();
-  else
-    pos_gap.y += item.get_rendering_parameters().get_gap_y();
-
-  wxPoint pos_min( std::min(result.GetPosition().x, pos_gap.x),
-                   std::min(result.GetPosition().y, pos_gap.y) );
-
-  wxPoint pos_max( std::max(result.GetPosition().x, pos_gap.x),
-                   std::max(result.GetPosition().y, pos_gap.y) );
-
-  result.SetPosition( pos_min );
-  result.width += pos_max.x - pos_min.x;
-  result.height += pos_max.y - pos_min.y;
-
-  return result;
-} // level_renderer::get_presence_box()
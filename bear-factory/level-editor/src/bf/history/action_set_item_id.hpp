@@ -65,7 +65,7 @@ namespace bf
     static wxString get_action_description();
 
   private:
-    void drop_item_identifiers();
+    void drop_item_identifiers( gui_level& lvl );
 
     void clear_identifiers( gui_level& lvl );
 
@@ -13,6 +13,7 @@
  */
 #include "bf/history/action_set_item_bottom.hpp"
 
+#include "bf/gui_level.hpp"
 #include "bf/item_instance.hpp"
 
 #include <wx/intl.h>
@@ -34,6 +35,8 @@ void bf::action_set_item_bottom::execute( gui_level& lvl )
   const double p( m_item->get_rendering_parameters().get_bottom() );
   m_item->get_rendering_parameters().set_bottom(m_position);
   m_position = p;
+
+  lvl.update_item_box(m_item);
 } // action_set_item_bottom::execute()
 
 /*----------------------------------------------------------------------------*/
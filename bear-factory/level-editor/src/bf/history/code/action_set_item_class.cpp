@@ -13,6 +13,7 @@
  */
 #include "bf/history/action_set_item_class.hpp"
 
+#include "bf/gui_level.hpp"
 #include "bf/item_class.hpp"
 #include "bf/wx_facilities.hpp"
 
@@ -39,6 +40,7 @@ void bf::action_set_item_class::execute( gui_level& lvl )
   CLAW_PRECOND( m_item != NULL );
 
   m_item->set_class( m_class );
+  lvl.update_item_box(m_item);
 } // action_set_item_class::execute()
 
 /*----------------------------------------------------------------------------*/
@@ -47,6 +49,7 @@ void bf::action_set_item_class::undo( gui_level& lvl )
   CLAW_PRECOND( m_item != NULL );
 
   *m_item = m_backup;
+  lvl.update_item_box(m_item);
 } // action_set_item_class::undo()
 
 /*----------------------------------------------------------------------------*/
@@ -24,6 +24,7 @@
 #include <wx/intl.h>
 #include <claw/assert.hpp>
 #include <limits>
+#include <set>
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -73,7 +74,7 @@ void bf::action_set_item_id::execute( gui_level& lvl )
   if ( m_layer_index >= lvl.layers_count() )
     m_layer_index = lvl.get_layer_by_item( **m_item.begin() );
 
-  drop_item_identifiers();
+  drop_item_identifiers( lvl );
 
   if ( m_id.empty() )
     clear_identifiers( lvl );
@@ -105,7 +106,7 @@ void bf::action_set_item_id::undo( gui_level& lvl )
 
   for ( item_collection::const_iterator it=m_item.begin();
         it!=m_item.end(); ++it )
-    (*it)->set_id( m_old_identifiers[ *it ] );
+    lvl.set_item_id( *it, m_old_identifiers[ *it ] );
 } // action_set_item_id::undo()
 
 /*----------------------------------------------------------------------------*/
@@ -141,8 +142,9 @@ wxString bf::action_set_item_id::get_action_description()
  * \brief Saves the old identifiers for the undo and clear the items'
  * identifiers in order to avoid conflicts in the next calls to
  * lvl.generate_valid_id().
+ * \param lvl The level in which the items are.
  */
-void bf::action_set_item_id::drop_item_identifiers()
+void bf::action_set_item_id::drop_item_identifiers( gui_level& lvl )
 {
   m_old_identifiers.clear();
 
@@ -150,7 +152,7 @@ void bf::action_set_item_id::drop_item_identifiers()
         it!=m_item.end(); ++it )
     {
       m_old_identifiers[ *it ] = (*it)->get_id();
-      (*it)->set_id( std::string() );
+      lvl.set_item_id( *it, std::string() );
     }
 } // action_set_item_id::drop_item_identifiers()
 
@@ -167,11 +169,21 @@ void bf::action_set_item_id::clear_identifiers( gui_level& lvl )
 
   m_clear_references_action = new action_group;
 
-  layer::item_iterator it;
-  const layer::item_iterator ite = lvl.get_layer(m_layer_index).item_end();
+  const layer& the_layer( lvl.get_layer(m_layer_index) );
+  std::set<item_instance*> items;
 
-  for ( it = lvl.get_layer(m_layer_index).item_begin(); it != ite; ++it )
-    create_clear_field_actions( *it );
+  for ( item_to_id_map::const_iterator it=m_old_identifiers.begin();
+        it!=m_old_identifiers.end(); ++it )
+    if ( !it->second.empty() )
+      {
+        const std::vector<item_instance*> referencing
+          ( the_layer.get_referencing_items( it->second ) );
+        items.insert( referencing.begin(), referencing.end() );
+      }
+
+  for ( std::set<item_instance*>::const_iterator it=items.begin();
+        it!=items.end(); ++it )
+    create_clear_field_actions( **it );
 
   m_clear_references_action->execute( lvl );
 } // action_set_item_id::clear_identifiers()
@@ -285,15 +297,16 @@ void bf::action_set_item_id::rename_items( gui_level& lvl ) const
   CLAW_PRECOND( !m_id.empty() );
 
   id_to_id_map id_map;
+  std::map<std::string, std::size_t> suffixes;
   
   for ( item_collection::const_iterator it=m_item.begin();
         it!=m_item.end(); ++it )
     {
       std::string id( m_id );
-      lvl.generate_valid_id(id);
+      lvl.generate_valid_id( id, std::set<std::string>(), suffixes );
 
       id_map[ m_old_identifiers.find( *it )->second ] = id;
-      (*it)->set_id( id );
+      lvl.set_item_id( *it, id );
     }
 
   rename_item_references( lvl, id_map );
@@ -329,9 +342,5 @@ void
 bf::action_set_item_id::rename_item_references
 ( gui_level& lvl, id_to_id_map m ) const
 {
-  layer::item_iterator it;
-  const layer::item_iterator ite = lvl.get_layer(m_layer_index).item_end();
-
-  for ( it = lvl.get_layer(m_layer_index).item_begin(); it != ite; ++it )
-    it->rename_item_reference_fields(m);
+  lvl.get_layer(m_layer_index).rename_item_references(m);
 } // action_set_item_id::restore_identifiers()
@@ -13,6 +13,7 @@
  */
 #include "bf/history/action_set_slope_curve.hpp"
 
+#include "bf/gui_level.hpp"
 #include "bf/item_instance.hpp"
 #include "bf/item_class_pool.hpp"
 
@@ -83,6 +84,8 @@ void bf::action_set_slope_curve::execute( gui_level& lvl )
   m_left_y = left_y;
   m_right_x = right_x;
   m_right_y = right_y;
+
+  lvl.update_item_box(m_item);
 } // action_set_slope_curve::execute()
 
 /*----------------------------------------------------------------------------*/
@@ -12,6 +12,7 @@
  * \author Julien Jorge
  */
 
+#include "bf/gui_level.hpp"
 #include "bf/human_readable.hpp"
 #include "bf/item_class.hpp"
 #include "bf/item_instance.hpp"
@@ -64,6 +65,8 @@ void bf::action_set_item_field<ValueType>::execute( gui_level& lvl )
 
   m_value = old_value;
   m_has_value = has_old_value;
+
+  lvl.update_item_box(m_item);
 } // action_set_item_field::execute()
 
 /*----------------------------------------------------------------------------*/
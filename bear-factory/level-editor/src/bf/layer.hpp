@@ -15,6 +15,8 @@
 #define __BF_LAYER_HPP__
 
 #include "bf/item_instance.hpp"
+#include "bf/item_spatial_index.hpp"
+#include "bf/types.hpp"
 
 #include "bf/item_filter/item_filter.hpp"
 
@@ -25,6 +27,8 @@
 #include <list>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace bf
 {
@@ -49,6 +53,29 @@ namespace bf
     typedef std::list<item_filter> filter_list;
     typedef filter_list::const_iterator const_filter_iterator;
 
+  private:
+    /** \brief The identifier of an item and the identifiers it references, as
+        they are stored in the indices. */
+    struct item_identifiers
+    {
+      /** \brief The identifier of the item. */
+      std::string id;
+
+      /** \brief The identifiers referenced in the fields of the item. */
+      std::set<std::string> references;
+
+    }; // struct item_identifiers
+
+    /** \brief The items having each identifier. */
+    typedef std::unordered_multimap<std::string, item_instance*> id_index_type;
+
+    /** \brief The items referencing each identifier. */
+    typedef std::unordered_map<std::string, item_set_type>
+    reference_index_type;
+
+    /** \brief The identifiers stored in the indices for each item. */
+    typedef std::map<item_instance*, item_identifiers> identifiers_map_type;
+
   public:
     explicit layer( const std::string& layer_type = "decoration_layer",
                     const std::string& layer_name = "", bool fit_level = true,
@@ -69,9 +96,23 @@ namespace bf
 
     void add_item( item_instance* item );
     void remove_item( item_instance* item );
+    void update_item_box( item_instance* item );
+    void set_item_id( item_instance* item, const std::string& id );
+    void rename_item_references( const std::map<std::string, std::string>& m );
+
+    std::vector<item_instance*>
+    find_items_at( const position_type& pos ) const;
+    std::vector<item_instance*>
+    find_items_in( const rectangle_type& box ) const;
+    std::vector<item_instance*>
+    find_displayed_items( const rectangle_type& box ) const;
+
+    std::size_t get_revision() const;
 
     item_iterator find_item_by_id( const std::string& id ) const;
     std::list<item_instance*> get_identified_items() const;
+    std::vector<item_instance*>
+    get_referencing_items( const std::string& id ) const;
 
     void prioritize( item_instance* item );
     void prioritize( item_instance* item, std::size_t p );
@@ -110,9 +151,18 @@ namespace bf
 
     bool check_item_position() const;
 
+    static rectangle_type get_visual_box( const item_instance& item );
+    static rectangle_type get_display_box( const item_instance& item );
+
   private:
     void clear();
     void assign( const layer& that );
+
+    void index_item( item_instance* item );
+    void index_identifiers( item_instance* item );
+    void unindex_identifiers( item_instance* item );
+    bool is_misplaced( const item_instance& item ) const;
+    void filter_items( std::vector<item_instance*>& items ) const;
     void sort_and_identify
     ( std::list<item_instance*>& referenced, compilation_context& c ) const;
     void sort_by_dependency
@@ -151,12 +201,32 @@ namespace bf
     /** \brief The filters on the items returned by item_begin()/item_end(). */
     filter_list m_filters;
 
+    /** \brief The display boxes of the items, for the picking and the
+        rendering. */
+    item_spatial_index m_index;
+
+    /** \brief The items displayed outside the bounds of the layer. */
+    item_set_type m_misplaced_item;
+
+    /** \brief The items having each identifier. */
+    id_index_type m_items_by_id;
+
+    /** \brief The items referencing each identifier. */
+    reference_index_type m_referencing_items;
+
+    /** \brief The identifiers stored in the indices for each item. */
+    identifiers_map_type m_identifiers;
+
     /** \brief The prioritized items. */
     item_list_type m_priority;
 
     /** \brief The tag of the layer. */
     std::string m_tag;
 
+    /** \brief A number incremented each time the items or their display
+        change. */
+    std::size_t m_revision;
+
   }; // class layer
 } // namespace bf
 
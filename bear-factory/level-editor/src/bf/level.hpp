@@ -63,10 +63,15 @@ namespace bf
     std::pair<bool, layer::item_iterator>
     find_item_by_id( const std::string& id ) const;
     std::size_t get_layer_by_item( const item_instance& item ) const;
+    void update_item_box( item_instance* item );
+    void set_item_id( item_instance* item, const std::string& id );
 
     void generate_valid_id( std::string& id ) const;
     void generate_valid_id
     ( std::string& id, const std::set<std::string>& avoid ) const;
+    void generate_valid_id
+    ( std::string& id, const std::set<std::string>& avoid,
+      std::map<std::string, std::size_t>& suffixes ) const;
     void fix_identifiers
     ( const std::vector<item_instance*>& new_items ) const;
 
@@ -18,8 +18,12 @@
 #include "bf/configuration.hpp"
 #include "bf/item_class_pool.hpp"
 
+#include <vector>
+
 namespace bf
 {
+  class compilation_context;
+  class file_hash;
   class item_instance;
   class item_check_result;
   class layer;
@@ -46,8 +50,24 @@ namespace bf
     void compile( const wxString& path ) const;
     void update( const wxString& path ) const;
     void compile_level( const level& lvl, const wxString& path ) const;
+    void compile_level
+    ( const level& lvl, const wxString& path,
+      compilation_context& context ) const;
 
   private:
+    bool compile_files( const std::vector<wxString>& paths ) const;
+    bool compile_batch
+    ( const std::string& workspace_name,
+      const std::vector<wxString>& paths ) const;
+    bool compile_batch_chunk
+    ( workspace_environment& env, compilation_context& context,
+      const std::vector<wxString>& paths ) const;
+
+    bool is_up_to_date( const wxString& path, file_hash& hashes ) const;
+
+    static std::string get_compiled_level_path( const wxString& path );
+    static std::string get_compiler_signature();
+
     bool do_init_app(const workspace_environment & default_env);
     bool do_command_line_init();
     void init_config();
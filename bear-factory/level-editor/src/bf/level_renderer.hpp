@@ -18,10 +18,12 @@
 #include "bf/level_check_result.hpp"
 #include "bf/sprite_with_position.hpp"
 
+#include <wx/bitmap.h>
 #include <wx/dcgraph.h>
 
 #include <list>
 #include <map>
+#include <string>
 
 namespace bf
 {
@@ -38,6 +40,27 @@ namespace bf
    */
   class level_renderer
   {
+  private:
+    /** \brief The position of a tile, in tiles, in the zoomed layer. */
+    typedef std::pair<wxCoord, wxCoord> tile_position;
+
+    /** \brief The tiles in which the items of a layer are rendered. */
+    struct layer_tiles
+    {
+      /** \brief The index of the layer when the tiles were rendered. */
+      unsigned int index;
+
+      /** \brief The revision of the layer when the tiles were rendered. */
+      std::size_t revision;
+
+      /** \brief The rendered tiles. */
+      std::map<tile_position, wxBitmap> tiles;
+
+    }; // struct layer_tiles
+
+    /** \brief The tiles of the layers rendered with tiles. */
+    typedef std::map<const layer*, layer_tiles> layer_tiles_map;
+
   public:
     explicit level_renderer( const gui_level& lvl, workspace_environment& env );
     ~level_renderer();
@@ -107,11 +130,25 @@ namespace bf
     const layer& get_active_layer() const;
     const gui_level& get_level() const;
 
-    void render_layers( wxGCDC& dc ) const;
+    void render_layers( wxGCDC& dc );
+    void render_layer_tiles( wxGCDC& dc, unsigned int index );
+    wxBitmap render_tile
+    ( const wxDC& model, unsigned int index, const tile_position& tile );
+    bool can_use_tiles( unsigned int index ) const;
+    std::string get_tile_signature() const;
+    void update_tiles();
+
+    wxPoint get_layer_origin( unsigned int index ) const;
+    void find_displayed_items
+    ( std::multimap<int, item_instance*>& z_order, unsigned int index,
+      const wxRect& area ) const;
 
     void render_items
     ( wxGCDC& dc, const std::multimap<int, item_instance*>& z_order,
       unsigned int i ) const;
+    void render_relationships
+    ( wxDC& dc, const std::multimap<int, item_instance*>& z_order,
+      unsigned int i ) const;
 
     void render_relationship
     ( wxDC& dc, const item_instance& item,
@@ -208,8 +245,6 @@ namespace bf
     wxPen
     get_display_pen( const item_instance& item, unsigned int index ) const;
 
-    wxRect get_presence_box( const item_instance& item ) const;
-
   private:
     /** \brief The level to render. */
     const gui_level& m_level;
@@ -253,6 +288,28 @@ namespace bf
     /** \brief The result of the last check on the level. */
     level_check_result m_check_result;
 
+    /** \brief The tiles of the layers rendered with tiles. */
+    layer_tiles_map m_tiles;
+
+    /** \brief The display options with which the tiles were rendered. */
+    std::string m_tile_signature;
+
+    /** \brief Tell if the items are currently rendered in a tile. */
+    bool m_rendering_tile;
+
+    /** \brief The position of the tile being rendered, in the zoomed layer. */
+    wxPoint m_tile_origin;
+
+    /** \brief The size of the tiles in which the layers are rendered. */
+    static const wxCoord s_tile_size;
+
+    /** \brief The maximum number of tiles kept for a layer. */
+    static const std::size_t s_max_tiles_per_layer;
+
+    /** \brief The margin around the visible area in which the items are
+        rendered, such that their identifiers and their grips are not cut. */
+    static const wxCoord s_render_margin;
+
     /** \brief The size of grip in the corner of the selected item. */
     static const wxCoord s_grip_size;
 
@@ -18,8 +18,19 @@
 #include <claw/image.hpp>
 #include <claw/math.hpp>
 
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <iostream>
 #include <string>
 #include <set>
+#include <vector>
+
+namespace bf
+{
+  class task_pool;
+}
 
 namespace ptb
 {
@@ -37,7 +48,17 @@ namespace ptb
      * - -max-x maximum size of the sub images on the X-coordinates,
      * - -max-y maximum size of the sub images on the Y-coordinates,
      * - --file-prefix the prefix of the name of the files,
+     * - --jobs the number of threads processing the images,
+     * - --memory-budget the maximum size in megabytes of the decoded images,
      * - --help Print help and exit.
+     *
+     * The files are decoded and their sub images are encoded by a pool of
+     * threads. A file is decoded only if the images already decoded and not
+     * yet saved leave enough room in the memory budget for an image as large
+     * as the largest image seen so far. The declarations of the layers and the
+     * error messages are printed in the order of the files once all the files
+     * are processed.
+     *
      * \author Julien Jorge
      */
     class application:
@@ -58,6 +79,27 @@ namespace ptb
 
       }; // struct sub_image_info
 
+      /**
+       * \brief The messages produced by the processing of a file.
+       */
+      struct file_report
+      {
+        /** \brief The declaration of the decoration layer, if requested. */
+        std::string layer;
+
+        /** \brief The error about the file itself. */
+        std::string error;
+
+        /** \brief The error about each sub image, empty if the sub image has
+            been saved. */
+        std::vector<std::string> sub_image_errors;
+
+      }; // struct file_report
+
+      /** \brief The type of the pointer to an image shared by the tasks saving
+          its sub images. */
+      typedef boost::shared_ptr<const claw::graphic::image> image_pointer;
+
     public:
       application( int& argc, char** &argv );
 
@@ -68,22 +110,32 @@ namespace ptb
       void check_arguments( int& argc, char** &argv );
       void store_files( int& argc, char** &argv );
 
-      void process_file( const std::string& name );
-      void process_file( std::istream& is, const std::string& name );
+      void process_files();
+      void process_file
+      ( bf::task_pool& pool, const std::string& name, file_report& report );
+      void process_file
+      ( bf::task_pool& pool, std::istream& is, const std::string& name,
+        file_report& report );
 
       claw::graphic::image* load_image( std::istream& is ) const;
-      void split_image( const claw::graphic::image& img,
-      const std::string& name ) const;
+      void split_image
+      ( bf::task_pool& pool, const image_pointer& img, const std::string& name,
+        file_report& report ) const;
 
-      void save_image( const claw::graphic::image& img,
-           const sub_image_info& infos ) const;
+      void save_image( image_pointer img, const sub_image_info& infos,
+                       std::string& error ) const;
 
-      void output_as_layer( const claw::graphic::image& img,
+      void output_as_layer( std::ostream& os, const claw::graphic::image& img,
           const std::vector<sub_image_info>& infos ) const;
 
       void get_sub_images_info( const claw::graphic::image& img,
         std::vector<sub_image_info>& infos,
-        const std::string& name ) const;
+        const std::string& name,
+        const claw::math::coordinate_2d<unsigned int>& max ) const;
+
+      void reserve_decoding();
+      void image_decoded( std::size_t size );
+      void release_image( const claw::graphic::image* img, std::size_t size );
 
       void factorize( unsigned int n, std::vector<unsigned int>& vals,
           unsigned int max ) const;
@@ -103,9 +155,6 @@ namespace ptb
       /** \brief The position of the picture in the layer. */
       claw::math::coordinate_2d<unsigned int> m_pos;
 
-      /** \brief Maximum size of the sub images. */
-      claw::math::coordinate_2d<unsigned int> m_max;
-
       /** \brief Tell if we must output the declaration of a decoration
     layer. */
       bool m_output_as_layer;
@@ -119,6 +168,28 @@ namespace ptb
       /** \brief The type of the ouput files. */
       std::string m_output_type;
 
+      /** \brief The number of threads processing the images. */
+      unsigned int m_jobs;
+
+      /** \brief The maximum size, in bytes, of the decoded images kept in
+          memory. */
+      std::size_t m_memory_budget;
+
+      /** \brief The mutex protecting the accounting of the memory. */
+      boost::mutex m_memory_mutex;
+
+      /** \brief Notified when an image is decoded or released. */
+      boost::condition_variable m_memory_released;
+
+      /** \brief The size of the decoded images not released yet. */
+      std::size_t m_memory_in_use;
+
+      /** \brief The number of files being decoded. */
+      std::size_t m_decoding;
+
+      /** \brief The size of the largest decoded image. */
+      std::size_t m_largest_image;
+
     }; // class application
   } // namespace ic
 } // namespace ptb
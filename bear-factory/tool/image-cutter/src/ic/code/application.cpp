@@ -13,6 +13,9 @@
  */
 #include "application.hpp"
 
+#include "bf/task_pool.hpp"
+
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -24,6 +27,9 @@
 #include <claw/bitmap.hpp>
 #include <claw/assert.hpp>
 
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
@@ -32,7 +38,10 @@
  */
 ptb::ic::application::application( int& argc, char** &argv )
   : claw::application(argc, argv), m_quit(false), m_pos(0, 0),
-    m_output_as_layer(false), m_output_folder("./"), m_output_type("png")
+    m_output_as_layer(false), m_output_folder("./"), m_output_type("png"),
+    m_jobs( boost::thread::hardware_concurrency() ),
+    m_memory_budget( 512 * 1024 * 1024 ), m_memory_in_use(0), m_decoding(0),
+    m_largest_image(0)
 {
   check_arguments( argc, argv );
 } // application::application()
@@ -53,12 +62,7 @@ int ptb::ic::application::run()
           result = -1;
         }
       else
-        {
-          std::set<std::string>::const_iterator it;
-
-          for (it=m_files.begin(); it!=m_files.end(); ++it)
-            process_file(*it);
-        }
+        process_files();
     }
 
   return result;
@@ -101,6 +105,12 @@ void ptb::ic::application::check_arguments( int& argc, char** &argv )
   m_arguments.add("-Y", "--max-y",
                   "The maximum size of the sub images on the Y-coordinates",
                   true);
+  m_arguments.add("-j", "--jobs",
+                  "The number of threads processing the images. Default is "
+                  "the number of processors.", true);
+  m_arguments.add("-m", "--memory-budget",
+                  "The maximum size in megabytes of the decoded images kept "
+                  "in memory. Default is 512.", true);
   m_arguments.add("-h", "--help", "Print this message and exit.", true);
 
   m_arguments.parse( argc, argv );
@@ -118,6 +128,14 @@ void ptb::ic::application::check_arguments( int& argc, char** &argv )
   if ( m_arguments.has_value("--output-folder") )
     m_output_folder = m_arguments.get_string("--output-folder") + "/";
 
+  if ( m_arguments.has_value("--jobs") )
+    m_jobs = std::max( 1, m_arguments.get_integer("--jobs") );
+
+  if ( m_arguments.has_value("--memory-budget") )
+    m_memory_budget =
+      (std::size_t)std::max( 1, m_arguments.get_integer("--memory-budget") )
+      * 1024 * 1024;
+
   if ( m_files.size() == 1 )
     {
       if ( m_arguments.has_value("-x") )
@@ -196,59 +214,112 @@ void ptb::ic::application::store_files( int& argc, char** &argv )
         }
 } // application::store_files()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Process all the files with the pool of threads and print the reports
+ *        in the order of the files.
+ */
+void ptb::ic::application::process_files()
+{
+  std::vector<file_report> reports( m_files.size() );
+
+  {
+    bf::task_pool pool( m_jobs, 2 * m_jobs );
+    std::set<std::string>::const_iterator it;
+    std::size_t i(0);
+
+    for (it=m_files.begin(); it!=m_files.end(); ++it, ++i)
+      {
+        reserve_decoding();
+        pool.push
+          ( boost::bind
+            ( static_cast<void (application::*)
+              (bf::task_pool&, const std::string&, file_report&)>
+              ( &application::process_file ),
+              this, boost::ref(pool), *it, boost::ref(reports[i]) ) );
+      }
+
+    pool.wait();
+  }
+
+  for (std::size_t i=0; i!=reports.size(); ++i)
+    {
+      if ( !reports[i].error.empty() )
+        std::cerr << reports[i].error << std::endl;
+
+      for (std::size_t j=0; j!=reports[i].sub_image_errors.size(); ++j)
+        if ( !reports[i].sub_image_errors[j].empty() )
+          std::cout << reports[i].sub_image_errors[j] << std::endl;
+
+      std::cout << reports[i].layer;
+    }
+} // application::process_files()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Process a file.
+ * \param pool The pool in which the sub images are saved.
  * \param name The name of the file to process.
+ * \param report (out) The messages about the file.
+ * \pre reserve_decoding() has been called for this file.
  */
-void ptb::ic::application::process_file( const std::string& name )
+void ptb::ic::application::process_file
+( bf::task_pool& pool, const std::string& name, file_report& report )
 {
   if ( name == "-" )
-    process_file( std::cin, "stdin" );
+    process_file( pool, std::cin, "stdin", report );
   else
     {
       std::ifstream f(name.c_str());
 
       if (f)
         {
-          process_file(f, name);
+          process_file(pool, f, name, report);
           f.close();
         }
       else
-        std::cerr << "Can't open file for reading: " << name << std::endl;
+        {
+          image_decoded(0);
+          report.error = "Can't open file for reading: " + name;
+        }
     }
 } // application::process_file() [std::string]
 
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Process a file.
+ * \param pool The pool in which the sub images are saved.
  * \param is The file to process.
  * \param name The name of the file.
+ * \param report (out) The messages about the file.
+ * \pre reserve_decoding() has been called for this file.
  */
-void ptb::ic::application::process_file( std::istream& is,
-                                         const std::string& name )
+void ptb::ic::application::process_file
+( bf::task_pool& pool, std::istream& is, const std::string& name,
+  file_report& report )
 {
   claw::graphic::image* img = load_image(is);
 
   if (img)
     {
-      if ( m_arguments.has_value("--max-x") )
-        m_max.x = m_arguments.get_integer("--max-x");
-      else
-        m_max.x = img->width();
+      const std::size_t size
+        ( img->width() * img->height()
+          * sizeof(claw::graphic::image::pixel_type) );
 
-      if ( m_arguments.has_value("--max-y") )
-        m_max.y = m_arguments.get_integer("--max-y");
-      else
-        m_max.y = img->height();
+      image_decoded(size);
 
-      split_image(*img, name);
+      // The image is released by the last task saving one of its parts.
+      const image_pointer p
+        ( img,
+          boost::bind( &application::release_image, this, _1, size ) );
 
-      delete img;
+      split_image(pool, p, name, report);
     }
   else
-    std::cerr << "Unhandled image format: " << name << std::endl;
-
+    {
+      image_decoded(0);
+      report.error = "Unhandled image format: " + name;
+    }
 } // application::process_file() [std::istream]
 
 /*----------------------------------------------------------------------------*/
@@ -268,23 +339,43 @@ claw::graphic::image* ptb::ic::application::load_image( std::istream& is ) const
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Cut the image in smallest images.
+ * \brief Cut the image in smallest images, saved by the tasks of a pool.
+ * \param pool The pool in which the sub images are saved.
  * \param img The image to split.
  * \param name The name of the image.
+ * \param report (out) The messages about the image.
  */
-void ptb::ic::application::split_image( const claw::graphic::image& img,
-                                        const std::string& name ) const
+void ptb::ic::application::split_image
+( bf::task_pool& pool, const image_pointer& img, const std::string& name,
+  file_report& report ) const
 {
+  claw::math::coordinate_2d<unsigned int> max( img->width(), img->height() );
+
+  if ( m_arguments.has_value("--max-x") )
+    max.x = m_arguments.get_integer("--max-x");
+
+  if ( m_arguments.has_value("--max-y") )
+    max.y = m_arguments.get_integer("--max-y");
+
   std::vector<sub_image_info> infos;
-  std::vector<sub_image_info>::const_iterator it;
 
-  get_sub_images_info( img, infos, name );
+  get_sub_images_info( *img, infos, name, max );
+
+  // Each task writes its own error, thus the vector is not resized after.
+  report.sub_image_errors.resize( infos.size() );
 
-  for (it=infos.begin(); it!=infos.end(); ++it)
-    save_image( img, *it );
+  for (std::size_t i=0; i!=infos.size(); ++i)
+    pool.push
+      ( boost::bind
+        ( &application::save_image, this, img, infos[i],
+          boost::ref(report.sub_image_errors[i]) ) );
 
   if ( m_output_as_layer )
-    output_as_layer( img, infos );
+    {
+      std::ostringstream oss;
+      output_as_layer( oss, *img, infos );
+      report.layer = oss.str();
+    }
 } // application::split_image()
 
 /*----------------------------------------------------------------------------*/
@@ -292,9 +383,10 @@ void ptb::ic::application::split_image( const claw::graphic::image& img,
  * \brief Save a part of the source image.
  * \param img The image to split.
  * \param infos Informations about the part to save.
+ * \param error (out) The error message, if the part cannot be saved.
  */
-void ptb::ic::application::save_image( const claw::graphic::image& img,
-                                       const sub_image_info& infos ) const
+void ptb::ic::application::save_image
+( image_pointer img, const sub_image_info& infos, std::string& error ) const
 {
   std::string output_name = m_output_folder + infos.path;
   std::ofstream f( output_name.c_str() );
@@ -305,7 +397,7 @@ void ptb::ic::application::save_image( const claw::graphic::image& img,
                                           -infos.box.position.y );
       claw::graphic::image part( infos.box.width, infos.box.height );
 
-      part.partial_copy( img, pos );
+      part.partial_copy( *img, pos );
 
       if ( m_output_type == "tga" )
         claw::graphic::targa::writer( part, f, true );
@@ -319,50 +411,51 @@ void ptb::ic::application::save_image( const claw::graphic::image& img,
       f.close();
     }
   else
-    std::cout << "Can't open file for writing: " << output_name << std::endl;
+    error = "Can't open file for writing: " + output_name;
 } // application::save_image()
 
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Ouptut a decoration layer declaration of the sub images.
+ * \param os The stream in which the declaration is written.
  * \param img The image we have splitted.
  * \param infos Informations about the parts of the images.
  */
 void ptb::ic::application::output_as_layer
-( const claw::graphic::image& img,
+( std::ostream& os, const claw::graphic::image& img,
   const std::vector<sub_image_info>& infos ) const
 {
-  std::cout << "<?xml version=\"1.0\" encoding=\"utf-8\"?>" << std::endl;
-  std::cout << "<level width='" << img.width() << "' height='"
-            << img.height() << "'>\n";
-  std::cout << "  <layer class_name='decoration_layer' width='" << img.width()
-            << "' height='" << img.height() << "' fit_level='0'>\n\n";
-  std::cout << "  <items>\n\n";
+  os << "<?xml version=\"1.0\" encoding=\"utf-8\"?>" << std::endl;
+  os << "<level width='" << img.width() << "' height='"
+     << img.height() << "'>\n";
+  os << "  <layer class_name='decoration_layer' width='" << img.width()
+     << "' height='" << img.height() << "' fit_level='0'>\n\n";
+  os << "  <items>\n\n";
 
   for (unsigned int i=0; i!=infos.size(); ++i)
-    std::cout << "    <item class_name='bear::decorative_item' fixed='true'>\n"
-              << "      <fields>\n"
-              << "        <field name='base_item.position.left'>\n"
-              << "          <real value='" << infos[i].box.position.x + m_pos.x
-              << "'/>\n"
-              << "        </field>\n"
-              << "        <field name='base_item.position.bottom'>\n"
-              << "          <real value='"
-              << img.height()
-      - (infos[i].box.position.y + infos[i].box.height + m_pos.y)
-              << "'/>\n"
-              << "        </field>\n"
-              << "        <field name='item_with_decoration.sprite'>\n"
-              << "          <sprite image='" << infos[i].path << "' x='0' "
-              << "y='0' clip_width='" << infos[i].box.width << "' clip_height='"
-              << infos[i].box.height << "'/>\n"
-              << "        </field>\n"
-              << "      </fields>\n"
-              << "    </item>\n\n";
-
-  std::cout << "  </items>\n";
-  std::cout << "  </layer><!-- decoration_layer -->\n"
-            << "</level>\n" << std::endl;
+    os << "    <item class_name='bear::decorative_item' fixed='true'>\n"
+       << "      <fields>\n"
+       << "        <field name='base_item.position.left'>\n"
+       << "          <real value='" << infos[i].box.position.x + m_pos.x
+       << "'/>\n"
+       << "        </field>\n"
+       << "        <field name='base_item.position.bottom'>\n"
+       << "          <real value='"
+       << img.height()
+         - (infos[i].box.position.y + infos[i].box.height + m_pos.y)
+       << "'/>\n"
+       << "        </field>\n"
+       << "        <field name='item_with_decoration.sprite'>\n"
+       << "          <sprite image='" << infos[i].path << "' x='0' "
+       << "y='0' clip_width='" << infos[i].box.width << "' clip_height='"
+       << infos[i].box.height << "'/>\n"
+       << "        </field>\n"
+       << "      </fields>\n"
+       << "    </item>\n\n";
+
+  os << "  </items>\n";
+  os << "  </layer><!-- decoration_layer -->\n"
+     << "</level>\n" << std::endl;
 } // application::output_as_layer()
 
 /*----------------------------------------------------------------------------*/
@@ -371,15 +464,17 @@ void ptb::ic::application::output_as_layer
  * \param img The image we're splitting.
  * \param infos (out) The informations you want.
  * \param name The name of the image we're splitting.
+ * \param max Maximum size of the sub images.
  */
 void ptb::ic::application::get_sub_images_info
 ( const claw::graphic::image& img, std::vector<sub_image_info>& infos,
-  const std::string& name ) const
+  const std::string& name,
+  const claw::math::coordinate_2d<unsigned int>& max ) const
 {
   std::vector<unsigned int> x_sizes, y_sizes;
 
-  factorize( img.width(), x_sizes, m_max.x );
-  factorize( img.height(), y_sizes, m_max.y );
+  factorize( img.width(), x_sizes, max.x );
+  factorize( img.height(), y_sizes, max.y );
 
   std::string file_prefix;
 
@@ -423,6 +518,66 @@ void ptb::ic::application::get_sub_images_info
     }
 } // application::get_sub_images_info()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Wait until the memory budget allows to decode one more image.
+ *
+ * The size of the next image is unknown until it is decoded, thus it is
+ * estimated with the size of the largest image decoded so far. A file is
+ * always decoded when no other image is in memory, even if it exceeds the
+ * budget.
+ */
+void ptb::ic::application::reserve_decoding()
+{
+  boost::mutex::scoped_lock lock(m_memory_mutex);
+
+  while ( ((m_memory_in_use != 0) || (m_decoding != 0))
+          && ( (m_largest_image == 0)
+               || ( m_memory_in_use + (m_decoding + 1) * m_largest_image
+                    > m_memory_budget ) ) )
+    m_memory_released.wait(lock);
+
+  ++m_decoding;
+} // application::reserve_decoding()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Account for an image decoded after a call to reserve_decoding().
+ * \param size The size of the decoded image, zero if the file has not been
+ *        decoded.
+ */
+void ptb::ic::application::image_decoded( std::size_t size )
+{
+  {
+    boost::mutex::scoped_lock lock(m_memory_mutex);
+
+    --m_decoding;
+    m_memory_in_use += size;
+    m_largest_image = std::max( m_largest_image, size );
+  }
+
+  m_memory_released.notify_all();
+} // application::image_decoded()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Delete an image once all its sub images are saved.
+ * \param img The image to delete.
+ * \param size The size accounted for the image by image_decoded().
+ */
+void ptb::ic::application::release_image
+( const claw::graphic::image* img, std::size_t size )
+{
+  delete img;
+
+  {
+    boost::mutex::scoped_lock lock(m_memory_mutex);
+    m_memory_in_use -= size;
+  }
+
+  m_memory_released.notify_all();
+} // application::release_image()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get The decomposition of an integer by the sum of powers of two.